@@ -7,12 +7,24 @@ See License.txt for details.
 // Local includes
 #include "vtkIGSIORecursiveCriticalSection.h"
 #include "igsioCommon.h"
+#include "igsioFlatMap.h"
+#include "igsioTrackedFrame.h"
+#include "igsioXmlTagReader.h"
 #include "igsioXmlUtils.h"
+#include "vtkIGSIOTrackedFrameList.h"
 
 // VTK includes
+#include <vtkImageData.h>
 #include <vtkSmartPointer.h>
 #include <vtksys/CommandLineArguments.hxx>
 
+// STL includes
+#include <algorithm>
+#include <clocale>
+#include <cstring>
+#include <string>
+#include <utility>
+
 namespace
 {
   static const double DOUBLE_THRESHOLD = 0.0001;
@@ -115,6 +127,62 @@ namespace
     return IGSIO_SUCCESS;
   }
 
+  //----------------------------------------------------------------------------
+  igsioStatus TestXmlTagReader()
+  {
+    // Declarations, comments and CDATA sections are skipped, references and whitespace in attribute values are decoded
+    const char* validXml = "<?xml version=\"1.0\"?>\n<!DOCTYPE Root [<!ELEMENT Root ANY>]>\n<!-- <Skipped/> -->\n"
+                           "<Root Text='&lt;&amp;&gt;&quot;&apos;' Codes=\"&#65;&#x42;&#x20AC;\" >character data<![CDATA[<Skipped/>]]>\n"
+                           "  <Child Value=\"line&#10;break\nnew\tline\"/>\n</Root>\ntrailing character data";
+    igsioXmlTagReader reader(validXml);
+    if (!reader.ReadNextTag() || reader.GetName() != "Root" || reader.IsEndTag() || reader.IsEmptyElement()
+        || reader.GetAttribute("Text") == NULL || std::string(reader.GetAttribute("Text")) != "<&>\"'"
+        || reader.GetAttribute("Codes") == NULL || std::string(reader.GetAttribute("Codes")) != "AB\xE2\x82\xAC"
+        || reader.GetAttribute("text") != NULL)
+    {
+      LOG_ERROR("XML start tag is not read correctly");
+      return IGSIO_FAIL;
+    }
+    if (!reader.ReadNextTag() || reader.GetName() != "Child" || !reader.IsEmptyElement()
+        || reader.GetAttribute("Value") == NULL || std::string(reader.GetAttribute("Value")) != "line\nbreak new line"
+        || reader.GetAttribute("Text") != NULL)
+    {
+      LOG_ERROR("XML empty element tag is not read correctly");
+      return IGSIO_FAIL;
+    }
+    if (!reader.ReadNextTag() || reader.GetName() != "Root" || !reader.IsEndTag()
+        || reader.ReadNextTag() || reader.HasError())
+    {
+      LOG_ERROR("XML end tag or end of input is not read correctly");
+      return IGSIO_FAIL;
+    }
+
+    // Malformed and truncated tags stop reading with an error
+    const char* invalidXmls[] = { "<Root Value=unquoted />", "<Root Value=\"1\" Value2 />", "</Root Value=\"1\">", "< Root/>",
+                                  "<Root Value=\"a<b\"/>", "<Root Value=\"&unknown;\"/>", "<Root Value=\"&#0;\"/>", "<Root Value=\"&#x110000;\"/>",
+                                  "<Root Value=\"&#12a;\"/>", "<Root Value=\"&amp\"/>", "<Root Value=\"truncated", "<Root Value", "<!-- truncated comment",
+                                  "<![CDATA[ truncated", "<?xml version=\"1.0\"", "<!DOCTYPE Root [<!ELEMENT Root ANY>"
+                                };
+    for (size_t i = 0; i < sizeof(invalidXmls) / sizeof(invalidXmls[0]); ++i)
+    {
+      igsioXmlTagReader invalidReader(invalidXmls[i]);
+      if (invalidReader.ReadNextTag() || !invalidReader.HasError() || invalidReader.ReadNextTag())
+      {
+        LOG_ERROR("Invalid XML was accepted: " << invalidXmls[i]);
+        return IGSIO_FAIL;
+      }
+    }
+
+    // Input without tags is not an error
+    igsioXmlTagReader textReader("only character data");
+    if (textReader.ReadNextTag() || textReader.HasError())
+    {
+      LOG_ERROR("Character data without tags is not read correctly");
+      return IGSIO_FAIL;
+    }
+    return IGSIO_SUCCESS;
+  }
+
   igsioStatus TestValidTransformName(std::string from, std::string to)
   {
     igsioTransformName transformName;
@@ -173,6 +241,281 @@ namespace
 
     return IGSIO_SUCCESS;
   }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestFlatMap()
+  {
+    igsioFlatMap<unsigned int, std::string> fields;
+    fields[5] = "five";
+    fields[1] = "one";
+    fields[3] = "three";
+    fields[3] = "THREE";
+
+    // Elements must be sorted by key, regardless of the insertion order
+    const unsigned int expectedKeys[3] = { 1, 3, 5 };
+    if (fields.size() != 3 || !std::equal(expectedKeys, expectedKeys + 3, fields.begin(),
+                                          [](unsigned int key, const std::pair<unsigned int, std::string>& element) { return key == element.first; }))
+    {
+      LOG_ERROR("Flat map elements are not sorted by key");
+      return IGSIO_FAIL;
+    }
+    if (fields.find(3) == fields.end() || fields.find(3)->second != "THREE" || fields.find(4) != fields.end())
+    {
+      LOG_ERROR("Flat map lookup failed");
+      return IGSIO_FAIL;
+    }
+
+    igsioFlatMap<unsigned int, std::string> copiedFields(fields);
+    if (fields.erase(3) != 1 || fields.erase(3) != 0 || fields.size() != 2 || copiedFields.size() != 3)
+    {
+      LOG_ERROR("Flat map erase failed");
+      return IGSIO_FAIL;
+    }
+    fields.erase(fields.find(1));
+    if (fields.size() != 1 || fields.begin()->first != 5)
+    {
+      LOG_ERROR("Flat map erase by iterator failed");
+      return IGSIO_FAIL;
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestDoubleFormattingInCurrentLocale()
+  {
+    const double values[] = { 0.0, 1.0, -2.5, 0.1, 0.1 + 0.2, 1.0 / 3.0, 123456789.0123, 1e-300, -1.7976931348623157e308, 5e-324 };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+      char buffer[igsioCommon::DOUBLE_STRING_BUFFER_SIZE];
+      const int length = igsioCommon::FormatDouble(values[i], buffer);
+      const char* end = NULL;
+      if (length != static_cast<int>(strlen(buffer)) || strchr(buffer, ',') != NULL
+          || igsioCommon::ParseDouble(buffer, &end) != values[i] || *end != 0)
+      {
+        LOG_ERROR("Double value " << buffer << " does not read back to the formatted value");
+        return IGSIO_FAIL;
+      }
+    }
+
+    // Shortest representation must be used
+    std::string str;
+    igsioCommon::AppendDouble(str, 0.1);
+    str.push_back(' ');
+    igsioCommon::AppendDouble(str, 0.1 + 0.2);
+    if (str != "0.1 0.30000000000000004")
+    {
+      LOG_ERROR("Unexpected double formatting: " << str);
+      return IGSIO_FAIL;
+    }
+
+    double value(0);
+    if (igsioCommon::StringToDouble("1.5", value) != IGSIO_SUCCESS || value != 1.5
+        || igsioCommon::StringToDouble("1,5", value) == IGSIO_SUCCESS || igsioCommon::StringToDouble("", value) == IGSIO_SUCCESS)
+    {
+      LOG_ERROR("String to double conversion failed");
+      return IGSIO_FAIL;
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  // Numbers must be written and read with '.' decimal separator, even if the locale uses a different one
+  igsioStatus TestDoubleFormatting()
+  {
+    if (TestDoubleFormattingInCurrentLocale() != IGSIO_SUCCESS)
+    {
+      return IGSIO_FAIL;
+    }
+
+    const char* commaLocales[] = { "de_DE.UTF-8", "de_DE", "German_Germany.1252", "fr_FR.UTF-8" };
+    for (size_t i = 0; i < sizeof(commaLocales) / sizeof(commaLocales[0]); ++i)
+    {
+      if (setlocale(LC_NUMERIC, commaLocales[i]) == NULL)
+      {
+        continue;
+      }
+      const igsioStatus status = TestDoubleFormattingInCurrentLocale();
+      setlocale(LC_NUMERIC, "C");
+      if (status != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Double formatting failed with locale " << commaLocales[i]);
+        return IGSIO_FAIL;
+      }
+      break;
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestDrawLine()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+
+    // Solid lines set one pixel per step along the major axis, in any direction
+    vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(0, 19, 0, 19, 0, 0);
+    image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+    memset(image->GetScalarPointer(), 0, 20 * 20 * 4);
+    const std::array<float, 3> colour = { 10.f, 20.f, 30.f };
+    if (igsioCommon::DrawLine(*image, colour, igsioCommon::LINE_STYLE_SOLID, { 15, 10, 0 }, { 2, 3, 0 }, 0) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to draw solid line");
+      return IGSIO_FAIL;
+    }
+    int numberOfSetPixels = 0;
+    const unsigned char* pixel = static_cast<const unsigned char*>(image->GetScalarPointer());
+    for (int i = 0; i < 20 * 20; ++i, pixel += 4)
+    {
+      if (pixel[0] != 0)
+      {
+        numberOfSetPixels++;
+        if (pixel[0] != 10 || pixel[1] != 20 || pixel[2] != 30 || pixel[3] != 1)
+        {
+          LOG_ERROR("Unexpected line colour at pixel " << i);
+          status = IGSIO_FAIL;
+        }
+      }
+    }
+    if (numberOfSetPixels != 14 || *static_cast<unsigned char*>(image->GetScalarPointer(15, 10, 0)) != 10 || *static_cast<unsigned char*>(image->GetScalarPointer(2, 3, 0)) != 10)
+    {
+      LOG_ERROR("Unexpected solid line pixels: " << numberOfSetPixels << " pixels set (expected 14)");
+      status = IGSIO_FAIL;
+    }
+
+    // Source alpha is kept, pixels outside of the extent are skipped
+    memset(image->GetScalarPointer(), 0, 20 * 20 * 4);
+    if (igsioCommon::DrawLine(*image, colour, igsioCommon::LINE_STYLE_SOLID, { -10, -10, 0 }, { 29, 29, 0 }, 0, igsioCommon::ALPHA_BEHAVIOR_SOURCE) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to draw partially visible line");
+      return IGSIO_FAIL;
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+      const unsigned char* diagonalPixel = static_cast<const unsigned char*>(image->GetScalarPointer(i, i, 0));
+      if (diagonalPixel[0] != 10 || diagonalPixel[3] != 0)
+      {
+        LOG_ERROR("Unexpected diagonal line pixel at " << i);
+        status = IGSIO_FAIL;
+      }
+    }
+
+    // Dotted lines on a single component float image
+    vtkSmartPointer<vtkImageData> floatImage = vtkSmartPointer<vtkImageData>::New();
+    floatImage->SetExtent(0, 19, 0, 9, 0, 0);
+    floatImage->AllocateScalars(VTK_FLOAT, 1);
+    memset(floatImage->GetScalarPointer(), 0, 20 * 10 * sizeof(float));
+    if (igsioCommon::DrawLine(*floatImage, 0.5f, igsioCommon::LINE_STYLE_DOTS, { 0, 5, 0 }, { 18, 5, 0 }, 4) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to draw dotted line");
+      return IGSIO_FAIL;
+    }
+    for (int x = 0; x < 20; ++x)
+    {
+      const float expectedValue = (x % 6 == 0) ? 0.5f : 0.f;
+      if (*static_cast<float*>(floatImage->GetScalarPointer(x, 5, 0)) != expectedValue)
+      {
+        LOG_ERROR("Unexpected dotted line pixel at " << x);
+        status = IGSIO_FAIL;
+      }
+    }
+
+    // Scan lines drawn on all frames of a tracked frame list in parallel
+    const int dims[3] = { 32, 24, 1 };
+    vtkSmartPointer<vtkImageData> frameImage = vtkSmartPointer<vtkImageData>::New();
+    frameImage->SetExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+    frameImage->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    unsigned char* framePixel = static_cast<unsigned char*>(frameImage->GetScalarPointer());
+    for (int i = 0; i < dims[0] * dims[1] * dims[2]; ++i)
+    {
+      framePixel[i] = static_cast<unsigned char>((i * 37) % 251);
+    }
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    for (int i = 0; i < 8; ++i)
+    {
+      igsioTrackedFrame trackedFrame;
+      trackedFrame.GetImageData()->DeepCopyFrom(frameImage);
+      trackedFrameList->AddTrackedFrame(std::move(trackedFrame), vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    }
+    igsioCommon::PixelLineList scanLines;
+    for (int y = 0; y < dims[1]; y += 4)
+    {
+      scanLines.push_back(igsioCommon::PixelLine({ 0, y, 0 }, { dims[0] - 1, y, 0 }));
+    }
+    int extent[6] = { 0, dims[0] - 1, 0, dims[1] - 1, 0, 0 };
+    const int previousNumberOfThreads = igsioCommon::GetDrawScanLinesNumberOfThreads();
+    igsioCommon::SetDrawScanLinesNumberOfThreads(4);
+    if (igsioCommon::DrawScanLines(extent, 255.f, scanLines, trackedFrameList) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to draw scan lines on tracked frame list");
+      status = IGSIO_FAIL;
+    }
+    igsioCommon::SetDrawScanLinesNumberOfThreads(previousNumberOfThreads);
+    for (unsigned int frameIndex = 0; frameIndex < trackedFrameList->GetNumberOfTrackedFrames(); ++frameIndex)
+    {
+      vtkImageData* drawnImage = trackedFrameList->GetTrackedFrame(frameIndex)->GetImageData()->GetConstImage();
+      for (int y = 0; y < dims[1]; ++y)
+      {
+        for (int x = 0; x < dims[0]; ++x)
+        {
+          const unsigned char expectedValue = (y % 4 == 0) ? 255 : *static_cast<unsigned char*>(frameImage->GetScalarPointer(x, y, 0));
+          if (*static_cast<unsigned char*>(drawnImage->GetScalarPointer(x, y, 0)) != expectedValue)
+          {
+            LOG_ERROR("Unexpected scan line pixel in frame " << frameIndex << " at (" << x << ", " << y << ")");
+            return IGSIO_FAIL;
+          }
+        }
+      }
+    }
+
+    // Half of the frames share their pixels with a frame outside of the list, it must not be modified by drawing
+    const bool copyOnWriteWasEnabled = igsioVideoFrame::GetCopyOnWrite();
+    igsioVideoFrame::SetCopyOnWrite(true);
+    igsioVideoFrame originalFrame;
+    originalFrame.DeepCopyFrom(frameImage);
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> sharedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    for (int i = 0; i < 8; ++i)
+    {
+      igsioTrackedFrame trackedFrame;
+      if (i % 2 == 0)
+      {
+        trackedFrame.SetImageData(originalFrame);
+      }
+      else
+      {
+        trackedFrame.GetImageData()->DeepCopyFrom(frameImage);
+      }
+      sharedFrameList->AddTrackedFrame(std::move(trackedFrame), vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    }
+    if (!sharedFrameList->GetTrackedFrame(0)->GetImageData()->IsPixelBufferShared())
+    {
+      LOG_ERROR("Copy of a video frame does not share the pixel buffer with the original frame");
+      status = IGSIO_FAIL;
+    }
+    igsioCommon::SetDrawScanLinesNumberOfThreads(4);
+    if (igsioCommon::DrawScanLines(extent, 255.f, scanLines, sharedFrameList) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to draw scan lines on tracked frame list with shared pixel buffers");
+      status = IGSIO_FAIL;
+    }
+    igsioCommon::SetDrawScanLinesNumberOfThreads(previousNumberOfThreads);
+    igsioVideoFrame::SetCopyOnWrite(copyOnWriteWasEnabled);
+    if (memcmp(originalFrame.GetConstScalarPointer(), frameImage->GetScalarPointer(), originalFrame.GetFrameSizeInBytes()) != 0)
+    {
+      LOG_ERROR("Drawing scan lines on a copy of a video frame modified the original frame");
+      status = IGSIO_FAIL;
+    }
+    for (unsigned int frameIndex = 0; frameIndex < sharedFrameList->GetNumberOfTrackedFrames(); ++frameIndex)
+    {
+      const unsigned char* drawnPixels = static_cast<const unsigned char*>(sharedFrameList->GetTrackedFrame(frameIndex)->GetImageData()->GetConstScalarPointer());
+      if (drawnPixels == originalFrame.GetConstScalarPointer() || drawnPixels[0] != 255 || drawnPixels[dims[0]] != framePixel[dims[0]])
+      {
+        LOG_ERROR("Unexpected scan line pixels in frame " << frameIndex << " of the tracked frame list with shared pixel buffers");
+        status = IGSIO_FAIL;
+      }
+    }
+
+    return status;
+  }
 }
 
 int main(int argc, char** argv)
@@ -312,6 +655,30 @@ int main(int argc, char** argv)
     exit(EXIT_FAILURE);
   }
 
+  if (TestXmlTagReader() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("XML tag reader test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestFlatMap() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Flat map test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestDoubleFormatting() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Double formatting test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestDrawLine() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Draw line test failed");
+    return EXIT_FAILURE;
+  }
+
   LOG_INFO("Test finished successfully!");
   return EXIT_SUCCESS;
 }
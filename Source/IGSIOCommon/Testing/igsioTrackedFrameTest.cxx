@@ -0,0 +1,463 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioCommon.h"
+#include "igsioFieldNameTable.h"
+#include "igsioTrackedFrame.h"
+#include "igsioVideoFrame.h"
+
+// VTK includes
+#include <vtkPoints.h>
+#include <vtkSmartPointer.h>
+#include <vtkXMLDataElement.h>
+#include <vtksys/CommandLineArguments.hxx>
+
+// STL includes
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Transforms are stored in binary form, but must be accessible as frame fields as well
+  igsioStatus TestFrameTransformFields()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    const igsioTransformName probeToTracker("Probe", "Tracker");
+    double matrix[16] = { 1, 0, 0, 10.5, 0, 0, -1, 0.125, 0, 1, 0, -3, 0, 0, 0, 1 };
+
+    igsioTrackedFrame trackedFrame;
+    if (trackedFrame.SetFrameField("Custom", "value") != IGSIO_SUCCESS
+        || trackedFrame.SetFrameTransform(probeToTracker, matrix) != IGSIO_SUCCESS
+        || trackedFrame.SetFrameTransformStatus(probeToTracker, TOOL_OK) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to set frame fields");
+      return IGSIO_FAIL;
+    }
+
+    double storedMatrix[16] = { 0 };
+    ToolStatus toolStatus = TOOL_INVALID;
+    if (trackedFrame.GetFrameTransform(probeToTracker, storedMatrix) != IGSIO_SUCCESS || !std::equal(matrix, matrix + 16, storedMatrix)
+        || trackedFrame.GetFrameTransformStatus(probeToTracker, toolStatus) != IGSIO_SUCCESS || toolStatus != TOOL_OK)
+    {
+      LOG_ERROR("Stored frame transform differs from the transform that was set");
+      status = IGSIO_FAIL;
+    }
+
+    // String representation is created when the field is requested
+    const char* transformString = trackedFrame.GetFrameField("ProbeToTrackerTransform");
+    if (transformString == NULL || std::string(transformString) != "1 0 0 10.5 0 0 -1 0.125 0 1 0 -3 0 0 0 1 ")
+    {
+      LOG_ERROR("Unexpected transform field string: " << (transformString ? transformString : "NULL"));
+      status = IGSIO_FAIL;
+    }
+    const char* statusString = trackedFrame.GetFrameField("ProbeToTrackerTransformStatus");
+    if (statusString == NULL || std::string(statusString) != "OK")
+    {
+      LOG_ERROR("Unexpected transform status field string: " << (statusString ? statusString : "NULL"));
+      status = IGSIO_FAIL;
+    }
+
+    std::vector<std::string> fieldNames;
+    trackedFrame.GetFrameFieldNameList(fieldNames);
+    if (fieldNames.size() != 3 || fieldNames[0] != "Custom" || fieldNames[1] != "ProbeToTrackerTransform" || fieldNames[2] != "ProbeToTrackerTransformStatus"
+        || trackedFrame.GetCustomFields().size() != 3)
+    {
+      LOG_ERROR("Frame field name list does not contain the transform fields");
+      status = IGSIO_FAIL;
+    }
+
+    // Transforms set as strings (e.g., read from a file) are parsed, the field string is created from the parsed values
+    igsioTrackedFrame copiedFrame(trackedFrame);
+    copiedFrame.SetFrameField("ProbeToTrackerTransform", "2 0 0 1  0 2 0 2  0 0 2 3  0 0 0 1");
+    copiedFrame.SetFrameField("ProbeToTrackerTransformStatus", "MISSING");
+    if (copiedFrame.GetFrameTransform(probeToTracker, storedMatrix) != IGSIO_SUCCESS || storedMatrix[0] != 2 || storedMatrix[3] != 1 || storedMatrix[11] != 3
+        || copiedFrame.GetFrameTransformStatus(probeToTracker, toolStatus) != IGSIO_SUCCESS || toolStatus != TOOL_MISSING
+        || std::string(copiedFrame.GetFrameField("ProbeToTrackerTransform")) != "2 0 0 1 0 2 0 2 0 0 2 3 0 0 0 1 ")
+    {
+      LOG_ERROR("Transform set from a string is not parsed correctly");
+      status = IGSIO_FAIL;
+    }
+    if (trackedFrame.GetFrameTransform(probeToTracker, storedMatrix) != IGSIO_SUCCESS || !std::equal(matrix, matrix + 16, storedMatrix))
+    {
+      LOG_ERROR("Modifying a copied frame changed the transform of the original frame");
+      status = IGSIO_FAIL;
+    }
+
+    // Field strings are owned by the frame, a value returned for another frame does not overwrite them
+    if (strcmp(trackedFrame.GetFrameField("ProbeToTrackerTransform"), copiedFrame.GetFrameField("ProbeToTrackerTransform")) == 0
+        || transformString != trackedFrame.GetFrameField("ProbeToTrackerTransform")
+        || std::string(transformString) != "1 0 0 10.5 0 0 -1 0.125 0 1 0 -3 0 0 0 1 ")
+    {
+      LOG_ERROR("Transform field string of a frame was overwritten by another frame");
+      status = IGSIO_FAIL;
+    }
+
+    // The custom field map is kept until the fields are modified
+    const igsioTrackedFrame::FieldMapType& customFields = copiedFrame.GetCustomFields();
+    int numberOfCustomFields = 0;
+    for (igsioTrackedFrame::FieldMapType::const_iterator it = copiedFrame.GetCustomFields().begin(); it != copiedFrame.GetCustomFields().end(); ++it)
+    {
+      ++numberOfCustomFields;
+    }
+    if (&customFields != &copiedFrame.GetCustomFields() || numberOfCustomFields != 3 || customFields.find("ProbeToTrackerTransformStatus")->second != "MISSING")
+    {
+      LOG_ERROR("Custom fields are not kept between calls");
+      status = IGSIO_FAIL;
+    }
+    copiedFrame.SetFrameTransformStatus(probeToTracker, TOOL_OK);
+    if (copiedFrame.GetCustomFields().find("ProbeToTrackerTransformStatus")->second != "OK"
+        || std::string(copiedFrame.GetFrameField("ProbeToTrackerTransformStatus")) != "OK")
+    {
+      LOG_ERROR("Custom fields are not updated after the frame is modified");
+      status = IGSIO_FAIL;
+    }
+
+    if (trackedFrame.DeleteFrameField("ProbeToTrackerTransform") != IGSIO_SUCCESS || trackedFrame.IsFrameTransformNameDefined(probeToTracker)
+        || !trackedFrame.IsFrameFieldDefined("ProbeToTrackerTransformStatus"))
+    {
+      LOG_ERROR("Failed to delete transform field");
+      status = IGSIO_FAIL;
+    }
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  // Frames share the interned field names, queries must not add names to the table
+  igsioStatus TestFieldNameTable()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
+
+    const igsioFieldNameId statusFieldId = fieldNameTable->Intern("StylusToReferenceTransformStatus");
+    igsioFieldNameId transformFieldId(igsioFieldNameTable::INVALID_ID);
+    if (!fieldNameTable->Find("StylusToReferenceTransform", transformFieldId)
+        || fieldNameTable->Intern("StylusToReferenceTransform") != transformFieldId
+        || fieldNameTable->GetTransformFieldId(statusFieldId) != transformFieldId
+        || fieldNameTable->GetTransformFieldId(transformFieldId) != transformFieldId
+        || fieldNameTable->GetName(statusFieldId) != "StylusToReferenceTransformStatus")
+    {
+      LOG_ERROR("Transform field names are not interned correctly");
+      status = IGSIO_FAIL;
+    }
+
+    const igsioFieldNameId customFieldId = fieldNameTable->Intern("FieldNameTableTestField");
+    if (fieldNameTable->GetTransformFieldId(customFieldId) != igsioFieldNameTable::INVALID_ID
+        || fieldNameTable->GetName(customFieldId) != "FieldNameTableTestField")
+    {
+      LOG_ERROR("Custom field name is not interned correctly");
+      status = IGSIO_FAIL;
+    }
+
+    const unsigned int numberOfNames = fieldNameTable->GetNumberOfNames();
+    igsioTrackedFrame firstFrame;
+    igsioTrackedFrame secondFrame;
+    firstFrame.SetFrameField("FieldNameTableTestField", "1");
+    secondFrame.SetFrameField("FieldNameTableTestField", "2");
+    igsioFieldNameId unknownFieldId(igsioFieldNameTable::INVALID_ID);
+    if (firstFrame.GetFrameField("FieldNameTableUndefinedField") != NULL || firstFrame.IsFrameFieldDefined("FieldNameTableUndefinedField")
+        || fieldNameTable->Find("FieldNameTableUndefinedField", unknownFieldId) || fieldNameTable->GetNumberOfNames() != numberOfNames)
+    {
+      LOG_ERROR("Querying an undefined field added its name to the field name table");
+      status = IGSIO_FAIL;
+    }
+    if (std::string(firstFrame.GetFrameField("FieldNameTableTestField")) != "1" || std::string(secondFrame.GetFrameField("FieldNameTableTestField")) != "2")
+    {
+      LOG_ERROR("Frames sharing an interned field name do not keep their own values");
+      status = IGSIO_FAIL;
+    }
+
+    // The status name of a transform is interned with the transform, so a status that is set alone can be queried by name
+    igsioTrackedFrame statusOnlyFrame;
+    statusOnlyFrame.SetFrameTransformStatus(igsioTransformName("StatusOnly", "Reference"), TOOL_MISSING);
+    std::vector<std::string> fieldNames;
+    statusOnlyFrame.GetFrameFieldNameList(fieldNames);
+    const char* statusString = statusOnlyFrame.GetFrameField("StatusOnlyToReferenceTransformStatus");
+    if (fieldNames.size() != 1 || fieldNames[0] != "StatusOnlyToReferenceTransformStatus"
+        || statusString == NULL || std::string(statusString) != "MISSING"
+        || !statusOnlyFrame.IsFrameFieldDefined("StatusOnlyToReferenceTransformStatus")
+        || statusOnlyFrame.IsFrameFieldDefined("StatusOnlyToReferenceTransform")
+        || statusOnlyFrame.DeleteFrameField("StatusOnlyToReferenceTransformStatus") != IGSIO_SUCCESS
+        || statusOnlyFrame.IsFrameFieldDefined("StatusOnlyToReferenceTransformStatus"))
+    {
+      LOG_ERROR("Transform status field that is set without the transform cannot be queried by name");
+      status = IGSIO_FAIL;
+    }
+
+    // Names from untrusted input cannot grow a table beyond its maximum size
+    igsioFieldNameTable limitedTable;
+    std::ostringstream fieldName;
+    unsigned int numberOfInternedNames(0);
+    for (unsigned int i = 0; i <= igsioFieldNameTable::MAXIMUM_NUMBER_OF_NAMES; ++i)
+    {
+      fieldName.str("");
+      fieldName << "Field" << i;
+      if (limitedTable.Intern(fieldName.str()) != igsioFieldNameTable::INVALID_ID)
+      {
+        ++numberOfInternedNames;
+      }
+    }
+    igsioFieldNameId existingFieldId(igsioFieldNameTable::INVALID_ID);
+    if (numberOfInternedNames != igsioFieldNameTable::MAXIMUM_NUMBER_OF_NAMES || limitedTable.GetNumberOfNames() != igsioFieldNameTable::MAXIMUM_NUMBER_OF_NAMES
+        || !limitedTable.Find("Field0", existingFieldId) || limitedTable.Intern("Field0") != existingFieldId)
+    {
+      LOG_ERROR("Field name table size is not limited: " << limitedTable.GetNumberOfNames() << " names");
+      status = IGSIO_FAIL;
+    }
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  // The directly written XML must be the same as the printed XML element, and it must be read back by the XML reader
+  igsioStatus TestTrackedFrameXml()
+  {
+    const igsioTransformName probeToTracker("Probe", "Tracker");
+    const igsioTransformName stylusToTracker("Stylus", "Tracker");
+    // Values that are not exactly representable in binary, they must be written without rounding
+    const double timestamp = 1234567.890123;
+    double matrix[16] = { 1.0 / 3.0, -2.0 / 3.0, 0.1, 10.7, 2.0 / 7.0, 1.0 / 3.0, 0.2, -2.3, 0.3, -0.1, 1.0 / 9.0, -0.7, 0, 0, 0, 1 };
+
+    igsioTrackedFrame trackedFrame;
+    trackedFrame.SetTimestamp(timestamp);
+    trackedFrame.SetFrameField("Comment", "<\"quoted\" & 'escaped'>");
+    trackedFrame.SetFrameTransform(probeToTracker, matrix);
+    trackedFrame.SetFrameTransformStatus(probeToTracker, TOOL_OK);
+    trackedFrame.SetFrameTransform(stylusToTracker, matrix);
+    vtkSmartPointer<vtkPoints> fiducialPoints = vtkSmartPointer<vtkPoints>::New();
+    fiducialPoints->InsertNextPoint(1.5, 2, -3.25);
+    fiducialPoints->InsertNextPoint(4, 5, 6);
+    fiducialPoints->InsertNextPoint(7, 8.5, 9);
+    fiducialPoints->InsertNextPoint(1.0 / 3.0, 123456.789012345, -0.1);
+    trackedFrame.SetFiducialPointsCoordinatePx(fiducialPoints);
+
+    std::vector<std::vector<igsioTransformName> > requestedTransformsList(2);
+    requestedTransformsList[1].push_back(stylusToTracker);
+    std::string xml;
+    for (std::vector<std::vector<igsioTransformName> >::iterator requestedTransforms = requestedTransformsList.begin(); requestedTransforms != requestedTransformsList.end(); ++requestedTransforms)
+    {
+      vtkSmartPointer<vtkXMLDataElement> xmlElement = vtkSmartPointer<vtkXMLDataElement>::New();
+      std::ostringstream printedXml;
+      if (trackedFrame.PrintToXML(xmlElement, *requestedTransforms) != IGSIO_SUCCESS
+          || igsioCommon::XML::PrintXML(printedXml, vtkIndent(0), xmlElement) != IGSIO_SUCCESS
+          || trackedFrame.GetTrackedFrameInXmlData(xml, *requestedTransforms) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to serialize tracked frame to XML");
+        return IGSIO_FAIL;
+      }
+      if (xml != printedXml.str())
+      {
+        LOG_ERROR("Directly written XML differs from the printed XML element:\n" << xml << "\n" << printedXml.str());
+        return IGSIO_FAIL;
+      }
+    }
+
+    // Read back all fields and points
+    trackedFrame.GetTrackedFrameInXmlData(xml, requestedTransformsList[0]);
+    igsioTrackedFrame readFrame;
+    if (readFrame.SetTrackedFrameFromXmlData("<?xml version=\"1.0\"?>\n<!-- comment -->\n" + xml) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to read tracked frame from XML");
+      return IGSIO_FAIL;
+    }
+    double readMatrix[16] = { 0 };
+    double readPoint[3] = { 0 };
+    double writtenPoint[3] = { 0 };
+    fiducialPoints->GetPoint(3, writtenPoint);
+    if (readFrame.GetCustomFields() != trackedFrame.GetCustomFields() || readFrame.GetTimestamp() != timestamp
+        || readFrame.GetFrameTransform(probeToTracker, readMatrix) != IGSIO_SUCCESS || !std::equal(matrix, matrix + 16, readMatrix)
+        || readFrame.GetFiducialPointsCoordinatePx() == NULL || readFrame.GetFiducialPointsCoordinatePx()->GetNumberOfPoints() != 4)
+    {
+      LOG_ERROR("Tracked frame read from XML differs from the written frame");
+      return IGSIO_FAIL;
+    }
+    readFrame.GetFiducialPointsCoordinatePx()->GetPoint(3, readPoint);
+    if (!std::equal(writtenPoint, writtenPoint + 3, readPoint))
+    {
+      LOG_ERROR("Fiducial point read from XML differs from the written point");
+      return IGSIO_FAIL;
+    }
+
+    // Invalid XML must not modify the frame
+    const char* invalidXmls[] = { "", "<TrackedFrame>", "<TrackedFrame><FrameField Name=\"Comment\" Value=\"changed\" /></Segmentation>",
+                                  "<TrackedFrame /><TrackedFrame />", "<TrackedFrame><FrameField Name=\"Comment\" Value=\"&unknown;\" /></TrackedFrame>"
+                                };
+    for (size_t i = 0; i < sizeof(invalidXmls) / sizeof(invalidXmls[0]); ++i)
+    {
+      if (readFrame.SetTrackedFrameFromXmlData(invalidXmls[i]) == IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Invalid XML was accepted: " << invalidXmls[i]);
+        return IGSIO_FAIL;
+      }
+    }
+    if (std::string(readFrame.GetFrameField("Comment")) != "<\"quoted\" & 'escaped'>")
+    {
+      LOG_ERROR("Invalid XML modified the tracked frame");
+      return IGSIO_FAIL;
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestTrackedFrameBinaryData()
+  {
+    const igsioTransformName probeToTracker("Probe", "Tracker");
+    double matrix[16] = { 1, 0, 0, 10.5, 0, 1, 0, -2, 0, 0, 1, 0.25, 0, 0, 0, 1 };
+
+    const FrameSizeType frameSize = { 7, 5, 1 };
+    igsioVideoFrame image;
+    image.AllocateFrame(frameSize, VTK_SHORT, 1);
+    image.SetImageOrientation(US_IMG_ORIENT_MF);
+    image.SetImageType(US_IMG_BRIGHTNESS);
+    short* imagePixels = static_cast<short*>(image.GetScalarPointer());
+    for (unsigned int i = 0; i < frameSize[0] * frameSize[1]; ++i)
+    {
+      imagePixels[i] = static_cast<short>(i * 100 - 1000);
+    }
+
+    igsioTrackedFrame trackedFrame;
+    trackedFrame.SetImageData(image);
+    trackedFrame.SetTimestamp(12.5);
+    trackedFrame.SetFrameField("Comment", "binary");
+    trackedFrame.SetFrameTransform(probeToTracker, matrix);
+    trackedFrame.SetFrameTransformStatus(probeToTracker, TOOL_OUT_OF_VIEW);
+    vtkSmartPointer<vtkPoints> fiducialPoints = vtkSmartPointer<vtkPoints>::New();
+    fiducialPoints->InsertNextPoint(1.5, 2, -3.25);
+    trackedFrame.SetFiducialPointsCoordinatePx(fiducialPoints);
+
+    std::vector<unsigned char> binaryData;
+    if (trackedFrame.GetTrackedFrameInBinaryData(binaryData) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to serialize tracked frame to binary data");
+      return IGSIO_FAIL;
+    }
+
+    // Header without pixels followed by the pixels must be the same as the complete data
+    std::vector<unsigned char> headerData;
+    trackedFrame.GetTrackedFrameInBinaryData(headerData, false);
+    const unsigned long pixelDataSize = trackedFrame.GetImageData()->GetFrameSizeInBytes();
+    if (headerData.size() % 64 != 0 || headerData.size() + pixelDataSize != binaryData.size()
+        || !std::equal(headerData.begin(), headerData.end(), binaryData.begin())
+        || memcmp(&binaryData[headerData.size()], trackedFrame.GetImageData()->GetConstScalarPointer(), pixelDataSize) != 0)
+    {
+      LOG_ERROR("Binary data without pixels is not the prefix of the complete binary data");
+      return IGSIO_FAIL;
+    }
+
+    for (int copyPixelData = 0; copyPixelData < 2; ++copyPixelData)
+    {
+      igsioTrackedFrame readFrame;
+      readFrame.SetFrameField("Obsolete", "removed");
+      if (readFrame.SetTrackedFrameFromBinaryData(&binaryData[0], binaryData.size(), copyPixelData != 0) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to read tracked frame from binary data");
+        return IGSIO_FAIL;
+      }
+      double readMatrix[16] = { 0 };
+      ToolStatus readStatus(TOOL_INVALID);
+      igsioVideoFrame* readImage = readFrame.GetImageData();
+      if (readFrame.GetCustomFields() != trackedFrame.GetCustomFields() || readFrame.GetTimestamp() != 12.5
+          || readFrame.GetFrameTransform(probeToTracker, readMatrix) != IGSIO_SUCCESS || !std::equal(matrix, matrix + 16, readMatrix)
+          || readFrame.GetFrameTransformStatus(probeToTracker, readStatus) != IGSIO_SUCCESS || readStatus != TOOL_OUT_OF_VIEW
+          || readFrame.GetFiducialPointsCoordinatePx() == NULL || readFrame.GetFiducialPointsCoordinatePx()->GetPoint(0)[2] != -3.25
+          || readFrame.GetFrameSize() != frameSize || readImage->GetVTKScalarPixelType() != VTK_SHORT
+          || readImage->GetImageOrientation() != US_IMG_ORIENT_MF || readImage->GetImageType() != US_IMG_BRIGHTNESS
+          || memcmp(readImage->GetConstScalarPointer(), imagePixels, pixelDataSize) != 0)
+      {
+        LOG_ERROR("Tracked frame read from binary data differs from the written frame");
+        return IGSIO_FAIL;
+      }
+
+      // Without copying, the image uses the input buffer until it is modified
+      const unsigned char* pixelData = &binaryData[headerData.size()];
+      const bool pixelsInPlace = (readImage->GetConstScalarPointer() == pixelData);
+      if (pixelsInPlace != (copyPixelData == 0) || readImage->IsPixelBufferExternal() != (copyPixelData == 0))
+      {
+        LOG_ERROR("Pixels of the binary data are " << (pixelsInPlace ? "used in place" : "copied") << " with copyPixelData = " << copyPixelData);
+        return IGSIO_FAIL;
+      }
+      static_cast<short*>(readImage->GetScalarPointer())[0] = 1;
+      if (readImage->GetConstScalarPointer() == pixelData || reinterpret_cast<const short*>(pixelData)[0] != -1000)
+      {
+        LOG_ERROR("Modifying the image of the tracked frame changed the binary data");
+        return IGSIO_FAIL;
+      }
+    }
+
+    // Invalid data must not modify the frame
+    igsioTrackedFrame readFrame;
+    readFrame.SetFrameField("Comment", "unchanged");
+    std::vector<unsigned char> invalidData(binaryData);
+    invalidData[4] = 99; // version
+    if (readFrame.SetTrackedFrameFromBinaryData(&binaryData[0], headerData.size() - 64, false) == IGSIO_SUCCESS
+        || readFrame.SetTrackedFrameFromBinaryData(&binaryData[0], binaryData.size() - 1, false) == IGSIO_SUCCESS
+        || readFrame.SetTrackedFrameFromBinaryData(&invalidData[0], invalidData.size(), false) == IGSIO_SUCCESS
+        || std::string(readFrame.GetFrameField("Comment")) != "unchanged")
+    {
+      LOG_ERROR("Invalid binary data was accepted or it modified the tracked frame");
+      return IGSIO_FAIL;
+    }
+    return IGSIO_SUCCESS;
+  }
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  bool printHelp(false);
+  int verboseLevel = vtkIGSIOLogger::LOG_LEVEL_UNDEFINED;
+
+  vtksys::CommandLineArguments args;
+  args.Initialize(argc, argv);
+
+  args.AddArgument("--help", vtksys::CommandLineArguments::NO_ARGUMENT, &printHelp, "Print this help.");
+  args.AddArgument("--verbose", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &verboseLevel, "Verbose level (1=error only, 2=warning, 3=info, 4=debug, 5=trace)");
+
+  if (!args.Parse())
+  {
+    std::cerr << "Problem parsing arguments" << std::endl;
+    std::cout << "Help: " << args.GetHelp() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (printHelp)
+  {
+    std::cout << args.GetHelp() << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+
+  vtkIGSIOLogger::Instance()->SetLogLevel(verboseLevel);
+
+  if (TestFrameTransformFields() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Frame transform field test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestFieldNameTable() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Field name table test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestTrackedFrameXml() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Tracked frame XML test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestTrackedFrameBinaryData() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Tracked frame binary data test failed");
+    return EXIT_FAILURE;
+  }
+
+  LOG_INFO("Test completed successfully");
+  return EXIT_SUCCESS;
+}
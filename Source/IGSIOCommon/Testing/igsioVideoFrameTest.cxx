@@ -0,0 +1,1510 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioCommon.h"
+#include "igsioCpuFeatures.h"
+#include "igsioTrackedFrame.h"
+#include "igsioVideoFrame.h"
+#include "igsioVideoFrameBufferPool.h"
+#include "igsioVideoFrameKernels.h"
+#include "igsioVideoFrameView.h"
+#include "vtkIGSIOTrackedFrameList.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtksys/CommandLineArguments.hxx>
+
+// STL includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  void FillImage(vtkImageData* image, const int dims[3], int scalarType, int numberOfScalarComponents, unsigned int seed)
+  {
+    image->SetExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+    image->AllocateScalars(scalarType, numberOfScalarComponents);
+    unsigned char* pixel = static_cast<unsigned char*>(image->GetScalarPointer());
+    const size_t numberOfBytes = static_cast<size_t>(dims[0]) * dims[1] * dims[2] * numberOfScalarComponents * image->GetScalarSize();
+    for (size_t i = 0; i < numberOfBytes; ++i)
+    {
+      // simple linear congruential generator, so that the test is reproducible
+      seed = seed * 1103515245u + 12345u;
+      pixel[i] = static_cast<unsigned char>(seed >> 16);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Straightforward pixel-by-pixel implementation of the flip, used as reference
+  void FlipClipImageReference(vtkImageData* inputImage, const igsioVideoFrame::FlipInfoType& flipInfo, const std::array<int, 3>& clipOrigin, const std::array<int, 3>& clipSize, vtkImageData* outputImage)
+  {
+    int inputDims[3] = { 0, 0, 0 };
+    inputImage->GetDimensions(inputDims);
+    outputImage->SetExtent(0, clipSize[0] - 1, 0, clipSize[1] - 1, 0, clipSize[2] - 1);
+    outputImage->AllocateScalars(inputImage->GetScalarType(), inputImage->GetNumberOfScalarComponents());
+
+    const size_t pixelSize = inputImage->GetScalarSize() * inputImage->GetNumberOfScalarComponents();
+    const unsigned char* inputPixels = static_cast<const unsigned char*>(inputImage->GetScalarPointer());
+    unsigned char* outputPixels = static_cast<unsigned char*>(outputImage->GetScalarPointer());
+    for (int z = 0; z < clipSize[2]; ++z)
+    {
+      for (int y = 0; y < clipSize[1]; ++y)
+      {
+        for (int x = 0; x < clipSize[0]; ++x)
+        {
+          int sourceX = x;
+          if (flipInfo.hFlip)
+          {
+            sourceX = flipInfo.doubleColumn ? (clipSize[0] - 2 - (x - x % 2) + x % 2) : (clipSize[0] - 1 - x);
+          }
+          int sourceY = flipInfo.vFlip ? clipSize[1] - 1 - y : y;
+          const size_t inputOffset = ((static_cast<size_t>(clipOrigin[2] + z) * inputDims[1] + clipOrigin[1] + sourceY) * inputDims[0] + clipOrigin[0] + sourceX) * pixelSize;
+          const size_t outputOffset = ((static_cast<size_t>(z) * clipSize[1] + y) * clipSize[0] + x) * pixelSize;
+          memcpy(outputPixels + outputOffset, inputPixels + inputOffset, pixelSize);
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  bool IsImageEqual(vtkImageData* image1, vtkImageData* image2)
+  {
+    int dims1[3] = { 0, 0, 0 };
+    int dims2[3] = { 0, 0, 0 };
+    image1->GetDimensions(dims1);
+    image2->GetDimensions(dims2);
+    if (dims1[0] != dims2[0] || dims1[1] != dims2[1] || dims1[2] != dims2[2]
+        || image1->GetScalarType() != image2->GetScalarType()
+        || image1->GetNumberOfScalarComponents() != image2->GetNumberOfScalarComponents())
+    {
+      return false;
+    }
+    const size_t numberOfBytes = static_cast<size_t>(dims1[0]) * dims1[1] * dims1[2] * image1->GetNumberOfScalarComponents() * image1->GetScalarSize();
+    return memcmp(image1->GetScalarPointer(), image2->GetScalarPointer(), numberOfBytes) == 0;
+  }
+
+  //----------------------------------------------------------------------------
+  // Compare FlipClipImage with the reference implementation, using the scalar and the vectorized kernels
+  igsioStatus TestFlipClipImage(int scalarType, int numberOfScalarComponents, const int dims[3], const std::array<int, 3>& clipOrigin, const std::array<int, 3>& clipSize, const igsioVideoFrame::FlipInfoType& flipInfo)
+  {
+    vtkSmartPointer<vtkImageData> inputImage = vtkSmartPointer<vtkImageData>::New();
+    FillImage(inputImage, dims, scalarType, numberOfScalarComponents, dims[0] * 31 + dims[1] * 7 + numberOfScalarComponents);
+
+    std::array<int, 3> referenceClipSize = clipSize;
+    if (!igsioCommon::IsClippingRequested(clipOrigin, clipSize))
+    {
+      referenceClipSize[0] = dims[0];
+      referenceClipSize[1] = dims[1];
+      referenceClipSize[2] = dims[2];
+    }
+    vtkSmartPointer<vtkImageData> referenceImage = vtkSmartPointer<vtkImageData>::New();
+    FlipClipImageReference(inputImage, flipInfo, clipOrigin, referenceClipSize, referenceImage);
+
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    igsioCpuFeatures::InstructionSet instructionSets[2] = { igsioCpuFeatures::INSTRUCTION_SET_SCALAR, igsioCpuFeatures::GetDetectedInstructionSet() };
+    igsioStatus status = IGSIO_SUCCESS;
+    for (int i = 0; i < 2; ++i)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(instructionSets[i]);
+      vtkSmartPointer<vtkImageData> outputImage = vtkSmartPointer<vtkImageData>::New();
+      if (igsioVideoFrame::FlipClipImage(inputImage, flipInfo, clipOrigin, clipSize, outputImage) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("FlipClipImage failed using instruction set " << igsioCpuFeatures::GetInstructionSetAsString(instructionSets[i]));
+        status = IGSIO_FAIL;
+        continue;
+      }
+      if (!IsImageEqual(outputImage, referenceImage))
+      {
+        LOG_ERROR("FlipClipImage result differs from reference using instruction set " << igsioCpuFeatures::GetInstructionSetAsString(instructionSets[i])
+                  << ": scalar type " << scalarType << ", " << numberOfScalarComponents << " components, size " << dims[0] << "x" << dims[1] << "x" << dims[2]
+                  << ", hFlip " << flipInfo.hFlip << ", vFlip " << flipInfo.vFlip << ", doubleColumn " << flipInfo.doubleColumn);
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestFlipClipImages()
+  {
+    LOG_INFO("Test FlipClipImage, detected instruction set: " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetDetectedInstructionSet()));
+
+    const int scalarTypes[2] = { VTK_UNSIGNED_CHAR, VTK_UNSIGNED_SHORT };
+    const int sizes[4][3] = { { 1, 1, 1 }, { 38, 5, 1 }, { 67, 9, 2 }, { 130, 4, 1 } };
+    const std::array<int, 3> noClipOrigin = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+    const std::array<int, 3> noClipSize = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+
+    int numberOfFailures = 0;
+    for (int scalarTypeIndex = 0; scalarTypeIndex < 2; ++scalarTypeIndex)
+    {
+      for (int numberOfScalarComponents = 1; numberOfScalarComponents <= 4; ++numberOfScalarComponents)
+      {
+        for (int sizeIndex = 0; sizeIndex < 4; ++sizeIndex)
+        {
+          const int* dims = sizes[sizeIndex];
+          // All combinations of horizontal flip, vertical flip and double column
+          for (int flipCase = 0; flipCase < 8; ++flipCase)
+          {
+            igsioVideoFrame::FlipInfoType flipInfo;
+            flipInfo.hFlip = (flipCase < 4);
+            flipInfo.vFlip = (flipCase % 2 == 1);
+            flipInfo.doubleColumn = (flipCase % 4 >= 2);
+            if (flipInfo.doubleColumn && dims[0] % 2 != 0)
+            {
+              continue;
+            }
+
+            if (TestFlipClipImage(scalarTypes[scalarTypeIndex], numberOfScalarComponents, dims, noClipOrigin, noClipSize, flipInfo) != IGSIO_SUCCESS)
+            {
+              numberOfFailures++;
+            }
+
+            // Clipped region, starting at an odd column
+            if (dims[0] >= 8 && dims[1] >= 3)
+            {
+              std::array<int, 3> clipOrigin = { 3, 1, 0 };
+              std::array<int, 3> clipSize = { dims[0] - 5, dims[1] - 2, dims[2] };
+              if (flipInfo.doubleColumn && clipSize[0] % 2 != 0)
+              {
+                clipSize[0]--;
+              }
+              if (TestFlipClipImage(scalarTypes[scalarTypeIndex], numberOfScalarComponents, dims, clipOrigin, clipSize, flipInfo) != IGSIO_SUCCESS)
+              {
+                numberOfFailures++;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return (numberOfFailures == 0 ? IGSIO_SUCCESS : IGSIO_FAIL);
+  }
+  //----------------------------------------------------------------------------
+  // Multi-threaded and batch conversion must give the same result as single-threaded conversion
+  igsioStatus TestMultiThreadedFlipClip()
+  {
+    const int dims[3] = { 128, 96, 40 };
+    const std::array<int, 3> noClipOrigin = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+    const std::array<int, 3> noClipSize = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+    const int originalNumberOfThreads = igsioVideoFrame::GetFlipClipNumberOfThreads();
+
+    igsioVideoFrame::FlipInfoType flipInfos[3];
+    flipInfos[0].hFlip = true;
+    flipInfos[0].eFlip = true;
+    flipInfos[1].vFlip = true;
+    flipInfos[2].tranpose = igsioVideoFrame::TRANSPOSE_IJKtoKIJ;
+
+    igsioStatus status = IGSIO_SUCCESS;
+    for (int flipIndex = 0; flipIndex < 3; ++flipIndex)
+    {
+      const int numberOfFrames = 5;
+      std::vector<vtkSmartPointer<vtkImageData> > inputImages;
+      std::vector<vtkSmartPointer<vtkImageData> > singleThreadedImages;
+      std::vector<vtkImageData*> batchInputImages;
+      std::vector<vtkImageData*> batchOutputImages;
+      std::vector<vtkSmartPointer<vtkImageData> > batchOutputImageHolders;
+      for (int frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex)
+      {
+        vtkSmartPointer<vtkImageData> inputImage = vtkSmartPointer<vtkImageData>::New();
+        FillImage(inputImage, dims, VTK_UNSIGNED_SHORT, 1, frameIndex + 1);
+        inputImages.push_back(inputImage);
+        batchInputImages.push_back(inputImage);
+
+        igsioVideoFrame::SetFlipClipNumberOfThreads(1);
+        vtkSmartPointer<vtkImageData> singleThreadedImage = vtkSmartPointer<vtkImageData>::New();
+        if (igsioVideoFrame::FlipClipImage(inputImage, flipInfos[flipIndex], noClipOrigin, noClipSize, singleThreadedImage) != IGSIO_SUCCESS)
+        {
+          LOG_ERROR("Single-threaded FlipClipImage failed");
+          status = IGSIO_FAIL;
+        }
+        singleThreadedImages.push_back(singleThreadedImage);
+
+        igsioVideoFrame::SetFlipClipNumberOfThreads(0);
+        vtkSmartPointer<vtkImageData> multiThreadedImage = vtkSmartPointer<vtkImageData>::New();
+        if (igsioVideoFrame::FlipClipImage(inputImage, flipInfos[flipIndex], noClipOrigin, noClipSize, multiThreadedImage) != IGSIO_SUCCESS
+            || !IsImageEqual(multiThreadedImage, singleThreadedImage))
+        {
+          LOG_ERROR("Multi-threaded FlipClipImage result differs from single-threaded result (flip case " << flipIndex << ")");
+          status = IGSIO_FAIL;
+        }
+
+        vtkSmartPointer<vtkImageData> batchOutputImage = vtkSmartPointer<vtkImageData>::New();
+        batchOutputImageHolders.push_back(batchOutputImage);
+        batchOutputImages.push_back(batchOutputImage);
+      }
+
+      if (igsioVideoFrame::FlipClipImages(batchInputImages, flipInfos[flipIndex], noClipOrigin, noClipSize, batchOutputImages) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("FlipClipImages failed");
+        status = IGSIO_FAIL;
+        continue;
+      }
+      for (int frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex)
+      {
+        if (!IsImageEqual(batchOutputImages[frameIndex], singleThreadedImages[frameIndex]))
+        {
+          LOG_ERROR("FlipClipImages result differs from FlipClipImage result (flip case " << flipIndex << ", frame " << frameIndex << ")");
+          status = IGSIO_FAIL;
+        }
+      }
+    }
+
+    igsioVideoFrame::SetFlipClipNumberOfThreads(originalNumberOfThreads);
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  // The raw pointer FlipClipImage must give the same result as the vtkImageData version, also with padded rows and slices
+  igsioStatus TestRawPointerFlipClip()
+  {
+    const int dims[3] = { 37, 11, 3 };
+    const int numberOfScalarComponents = 3;
+    const size_t pixelSize = numberOfScalarComponents * sizeof(unsigned short);
+    const std::array<int, 3> clipOrigin = { 2, 1, 0 };
+    const std::array<int, 3> clipSize = { 30, 9, 3 };
+    const FrameSizeType inputSize = { static_cast<unsigned int>(dims[0]), static_cast<unsigned int>(dims[1]), static_cast<unsigned int>(dims[2]) };
+
+    vtkSmartPointer<vtkImageData> inputImage = vtkSmartPointer<vtkImageData>::New();
+    FillImage(inputImage, dims, VTK_UNSIGNED_SHORT, numberOfScalarComponents, 17);
+
+    // Copy the input into a buffer with padding at the end of each row and slice
+    const vtkIdType inputRowStride = dims[0] * pixelSize + 24;
+    const vtkIdType inputSliceStride = dims[1] * inputRowStride + 8;
+    std::vector<unsigned char> paddedInput(inputSliceStride * dims[2], 0);
+    const unsigned char* inputPixels = static_cast<const unsigned char*>(inputImage->GetScalarPointer());
+    for (int z = 0; z < dims[2]; ++z)
+    {
+      for (int y = 0; y < dims[1]; ++y)
+      {
+        memcpy(&paddedInput[z * inputSliceStride + y * inputRowStride], inputPixels + (static_cast<size_t>(z) * dims[1] + y) * dims[0] * pixelSize, dims[0] * pixelSize);
+      }
+    }
+
+    igsioVideoFrame::FlipInfoType flipInfos[4];
+    flipInfos[1].hFlip = true;
+    flipInfos[1].vFlip = true;
+    flipInfos[2].eFlip = true;
+    flipInfos[3].tranpose = igsioVideoFrame::TRANSPOSE_IJKtoKIJ;
+
+    igsioStatus status = IGSIO_SUCCESS;
+    for (int flipIndex = 0; flipIndex < 4; ++flipIndex)
+    {
+      vtkSmartPointer<vtkImageData> expectedImage = vtkSmartPointer<vtkImageData>::New();
+      if (igsioVideoFrame::FlipClipImage(inputImage, flipInfos[flipIndex], clipOrigin, clipSize, expectedImage) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("FlipClipImage failed (flip case " << flipIndex << ")");
+        status = IGSIO_FAIL;
+        continue;
+      }
+      int expectedDims[3] = { 0, 0, 0 };
+      expectedImage->GetDimensions(expectedDims);
+      FrameSizeType outputSize = igsioVideoFrame::GetFlipClipOutputSize(inputSize, flipInfos[flipIndex], clipOrigin, clipSize);
+      if (static_cast<int>(outputSize[0]) != expectedDims[0] || static_cast<int>(outputSize[1]) != expectedDims[1] || static_cast<int>(outputSize[2]) != expectedDims[2])
+      {
+        LOG_ERROR("GetFlipClipOutputSize result differs from FlipClipImage output size (flip case " << flipIndex << ")");
+        status = IGSIO_FAIL;
+        continue;
+      }
+
+      const vtkIdType outputRowStride = outputSize[0] * pixelSize + 16;
+      const vtkIdType outputSliceStride = outputSize[1] * outputRowStride;
+      std::vector<unsigned char> paddedOutput(outputSliceStride * outputSize[2], 0);
+      if (igsioVideoFrame::FlipClipImage(&paddedInput[0], inputSize, inputRowStride, inputSliceStride, VTK_UNSIGNED_SHORT, numberOfScalarComponents,
+                                         flipInfos[flipIndex], clipOrigin, clipSize, &paddedOutput[0], outputRowStride, outputSliceStride) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Raw pointer FlipClipImage failed (flip case " << flipIndex << ")");
+        status = IGSIO_FAIL;
+        continue;
+      }
+      const unsigned char* expectedPixels = static_cast<const unsigned char*>(expectedImage->GetScalarPointer());
+      bool isEqual = true;
+      for (unsigned int z = 0; z < outputSize[2] && isEqual; ++z)
+      {
+        for (unsigned int y = 0; y < outputSize[1] && isEqual; ++y)
+        {
+          isEqual = (memcmp(&paddedOutput[z * outputSliceStride + y * outputRowStride], expectedPixels + (static_cast<size_t>(z) * outputSize[1] + y) * outputSize[0] * pixelSize, outputSize[0] * pixelSize) == 0);
+        }
+      }
+      if (!isEqual)
+      {
+        LOG_ERROR("Raw pointer FlipClipImage result differs from vtkImageData result (flip case " << flipIndex << ")");
+        status = IGSIO_FAIL;
+      }
+    }
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  // Reverse the byte order of each scalar, used as reference for the byte swap kernels
+  void SwapBytesReference(unsigned char* buffer, size_t numberOfScalars, size_t scalarSize)
+  {
+    for (size_t i = 0; i < numberOfScalars; ++i)
+    {
+      std::reverse(buffer + i * scalarSize, buffer + (i + 1) * scalarSize);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Byte swapping fused into FlipClipImage must give the same result as flipping the native byte order image
+  igsioStatus TestByteSwapFlipClip()
+  {
+    const int dims[3] = { 38, 6, 3 };
+    const std::array<int, 3> clipOrigin = { 3, 1, 0 };
+    const std::array<int, 3> clipSize = { 30, 4, 3 };
+    const FrameSizeType inputSize = { static_cast<unsigned int>(dims[0]), static_cast<unsigned int>(dims[1]), static_cast<unsigned int>(dims[2]) };
+    const int scalarTypes[4] = { VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_FLOAT, VTK_DOUBLE };
+
+    igsioVideoFrame::FlipInfoType flipInfos[4];
+    flipInfos[1].hFlip = true;
+    flipInfos[1].vFlip = true;
+    flipInfos[2].eFlip = true;
+    flipInfos[3].tranpose = igsioVideoFrame::TRANSPOSE_IJKtoKIJ;
+
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    igsioCpuFeatures::InstructionSet instructionSets[2] = { igsioCpuFeatures::INSTRUCTION_SET_SCALAR, igsioCpuFeatures::GetDetectedInstructionSet() };
+    igsioStatus status = IGSIO_SUCCESS;
+    for (int i = 0; i < 2; ++i)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(instructionSets[i]);
+
+      // In-place and out-of-place kernel calls, with lengths that are not multiples of the vector size
+      for (size_t scalarSize = 1; scalarSize <= 8; scalarSize *= 2)
+      {
+        const size_t numberOfScalars = 77;
+        std::vector<unsigned char> input(numberOfScalars * scalarSize);
+        for (size_t b = 0; b < input.size(); ++b)
+        {
+          input[b] = static_cast<unsigned char>(b * 37 + 5);
+        }
+        std::vector<unsigned char> expected(input);
+        SwapBytesReference(&expected[0], numberOfScalars, scalarSize);
+        std::vector<unsigned char> output(input.size(), 0);
+        std::vector<unsigned char> inPlace(input);
+        if (!igsioVideoFrameKernels::SwapBytes(&output[0], &input[0], numberOfScalars, scalarSize)
+            || !igsioVideoFrameKernels::SwapBytes(&inPlace[0], &inPlace[0], numberOfScalars, scalarSize)
+            || output != expected || inPlace != expected)
+        {
+          LOG_ERROR("SwapBytes result differs from reference for " << scalarSize << "-byte scalars using instruction set " << igsioCpuFeatures::GetInstructionSetAsString(instructionSets[i]));
+          status = IGSIO_FAIL;
+        }
+      }
+
+      for (int scalarTypeIndex = 0; scalarTypeIndex < 4; ++scalarTypeIndex)
+      {
+        vtkSmartPointer<vtkImageData> inputImage = vtkSmartPointer<vtkImageData>::New();
+        FillImage(inputImage, dims, scalarTypes[scalarTypeIndex], 2, 23);
+        const size_t scalarSize = inputImage->GetScalarSize();
+        const size_t numberOfScalars = static_cast<size_t>(dims[0]) * dims[1] * dims[2] * 2;
+        std::vector<unsigned char> swappedInput(static_cast<const unsigned char*>(inputImage->GetScalarPointer()),
+                                                static_cast<const unsigned char*>(inputImage->GetScalarPointer()) + numberOfScalars * scalarSize);
+        SwapBytesReference(&swappedInput[0], numberOfScalars, scalarSize);
+
+        for (int flipIndex = 0; flipIndex < 4; ++flipIndex)
+        {
+          vtkSmartPointer<vtkImageData> expectedImage = vtkSmartPointer<vtkImageData>::New();
+          if (igsioVideoFrame::FlipClipImage(inputImage, flipInfos[flipIndex], clipOrigin, clipSize, expectedImage) != IGSIO_SUCCESS)
+          {
+            LOG_ERROR("FlipClipImage failed (flip case " << flipIndex << ")");
+            status = IGSIO_FAIL;
+            continue;
+          }
+          FrameSizeType outputSize = igsioVideoFrame::GetFlipClipOutputSize(inputSize, flipInfos[flipIndex], clipOrigin, clipSize);
+          std::vector<unsigned char> output(static_cast<size_t>(outputSize[0]) * outputSize[1] * outputSize[2] * 2 * scalarSize, 0);
+          if (igsioVideoFrame::FlipClipImage(&swappedInput[0], inputSize, 0, 0, scalarTypes[scalarTypeIndex], 2,
+                                             flipInfos[flipIndex], clipOrigin, clipSize, &output[0], 0, 0, true) != IGSIO_SUCCESS
+              || memcmp(&output[0], expectedImage->GetScalarPointer(), output.size()) != 0)
+          {
+            LOG_ERROR("Byte swapping FlipClipImage result differs from native byte order result (scalar type " << scalarTypes[scalarTypeIndex]
+                      << ", flip case " << flipIndex << ") using instruction set " << igsioCpuFeatures::GetInstructionSetAsString(instructionSets[i]));
+            status = IGSIO_FAIL;
+          }
+        }
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  // Pixels accessed through an oriented view must be the same as the pixels of the image produced by FlipClipImage
+  igsioStatus TestOrientedView()
+  {
+    const int dims[3] = { 22, 10, 3 };
+    const int numberOfScalarComponents = 2;
+    const std::array<int, 3> clipOrigin = { 3, 1, 1 };
+    const std::array<int, 3> clipSize = { 16, 8, 2 };
+
+    igsioVideoFrame frame;
+    FrameSizeType frameSize = { static_cast<unsigned int>(dims[0]), static_cast<unsigned int>(dims[1]), static_cast<unsigned int>(dims[2]) };
+    frame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, numberOfScalarComponents);
+    FillImage(frame.GetImage(), dims, VTK_UNSIGNED_CHAR, numberOfScalarComponents, 5);
+
+    igsioVideoFrame::FlipInfoType flipInfos[5];
+    flipInfos[1].hFlip = true;
+    flipInfos[1].eFlip = true;
+    flipInfos[2].vFlip = true;
+    flipInfos[2].doubleColumn = true;
+    flipInfos[3].hFlip = true;
+    flipInfos[3].doubleColumn = true;
+    flipInfos[3].doubleRow = true;
+    flipInfos[4].tranpose = igsioVideoFrame::TRANSPOSE_IJKtoKIJ;
+
+    igsioStatus status = IGSIO_SUCCESS;
+    for (int flipIndex = 0; flipIndex < 5; ++flipIndex)
+    {
+      for (int clip = 0; clip < 2; ++clip)
+      {
+        const std::array<int, 3> noClip = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+        const std::array<int, 3>& viewClipOrigin = (clip ? clipOrigin : noClip);
+        const std::array<int, 3>& viewClipSize = (clip ? clipSize : noClip);
+
+        vtkSmartPointer<vtkImageData> expectedImage = vtkSmartPointer<vtkImageData>::New();
+        igsioVideoFrameView view;
+        if (igsioVideoFrame::FlipClipImage(frame.GetConstImage(), flipInfos[flipIndex], viewClipOrigin, viewClipSize, expectedImage) != IGSIO_SUCCESS
+            || frame.GetOrientedClippedView(flipInfos[flipIndex], viewClipOrigin, viewClipSize, view) != IGSIO_SUCCESS)
+        {
+          LOG_ERROR("Failed to create oriented image or view (flip case " << flipIndex << ")");
+          status = IGSIO_FAIL;
+          continue;
+        }
+
+        const FrameSizeType viewSize = view.GetFrameSize();
+        int expectedDims[3] = { 0, 0, 0 };
+        expectedImage->GetDimensions(expectedDims);
+        if (static_cast<int>(viewSize[0]) != expectedDims[0] || static_cast<int>(viewSize[1]) != expectedDims[1] || static_cast<int>(viewSize[2]) != expectedDims[2])
+        {
+          LOG_ERROR("Oriented view size differs from FlipClipImage output size (flip case " << flipIndex << ")");
+          status = IGSIO_FAIL;
+          continue;
+        }
+
+        // Compare pixels accessed through the view, rows copied from the view and the materialized view
+        const size_t pixelSize = view.GetNumberOfBytesPerPixel();
+        const size_t rowSize = viewSize[0] * pixelSize;
+        const unsigned char* expectedPixel = static_cast<const unsigned char*>(expectedImage->GetScalarPointer());
+        std::vector<unsigned char> row(rowSize);
+        bool isEqual = true;
+        for (unsigned int z = 0; z < viewSize[2]; ++z)
+        {
+          for (unsigned int y = 0; y < viewSize[1]; ++y)
+          {
+            if (view.CopyRow(y, z, &row[0]) != IGSIO_SUCCESS || memcmp(&row[0], expectedPixel, rowSize) != 0)
+            {
+              isEqual = false;
+            }
+            for (unsigned int x = 0; x < viewSize[0]; ++x)
+            {
+              if (memcmp(view.GetPixelPointer(x, y, z), expectedPixel, pixelSize) != 0)
+              {
+                isEqual = false;
+              }
+              expectedPixel += pixelSize;
+            }
+          }
+        }
+        vtkSmartPointer<vtkImageData> materializedImage = vtkSmartPointer<vtkImageData>::New();
+        if (!isEqual || view.CopyTo(materializedImage) != IGSIO_SUCCESS || !IsImageEqual(materializedImage, expectedImage))
+        {
+          LOG_ERROR("Oriented view differs from FlipClipImage result (flip case " << flipIndex << ", clipping " << (clip ? "on" : "off") << ")");
+          status = IGSIO_FAIL;
+        }
+      }
+    }
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  // Buffers of deleted frames must be reused by new frames of the same size and type
+  igsioStatus TestFrameBufferPool()
+  {
+    igsioVideoFrameBufferPool* pool = igsioVideoFrameBufferPool::GetInstance();
+    const unsigned long long originalMaximumPooledSize = pool->GetMaximumPooledSizeInBytes();
+    pool->Trim();
+    pool->SetMaximumPooledSizeInBytes(16 * 1024 * 1024);
+    pool->ResetStatistics();
+
+    const FrameSizeType frameSize = { 640, 480, 1 };
+    const FrameSizeType otherFrameSize = { 320, 240, 1 };
+    void* firstBuffer = NULL;
+    {
+      igsioVideoFrame frame;
+      frame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 1);
+      firstBuffer = frame.GetScalarPointer();
+    }
+
+    igsioStatus status = IGSIO_SUCCESS;
+    {
+      igsioVideoFrame frame;
+      frame.AllocateFrame(otherFrameSize, VTK_UNSIGNED_CHAR, 1);
+      // Reallocation returns the small buffer and reuses the large one
+      frame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 1);
+      if (frame.GetScalarPointer() != firstBuffer || frame.GetFrameSizeInBytes() != frameSize[0] * frameSize[1])
+      {
+        LOG_ERROR("Pooled frame buffer is not reused");
+        status = IGSIO_FAIL;
+      }
+    }
+
+    igsioVideoFrameBufferPool::Statistics statistics = pool->GetStatistics();
+    if (statistics.NumberOfHits != 1 || statistics.NumberOfMisses != 2 || statistics.NumberOfReturnedBuffers != 3 || statistics.NumberOfPooledBuffers != 2
+        || statistics.PooledSizeInBytes != frameSize[0] * frameSize[1] + otherFrameSize[0] * otherFrameSize[1])
+    {
+      LOG_ERROR("Unexpected frame buffer pool statistics: hits " << statistics.NumberOfHits << ", misses " << statistics.NumberOfMisses
+                << ", returned " << statistics.NumberOfReturnedBuffers << ", pooled " << statistics.NumberOfPooledBuffers << " (" << statistics.PooledSizeInBytes << " bytes)");
+      status = IGSIO_FAIL;
+    }
+
+    pool->Trim();
+    statistics = pool->GetStatistics();
+    if (statistics.NumberOfPooledBuffers != 0 || statistics.PooledSizeInBytes != 0)
+    {
+      LOG_ERROR("Frame buffer pool is not empty after trimming");
+      status = IGSIO_FAIL;
+    }
+
+    pool->SetMaximumPooledSizeInBytes(originalMaximumPooledSize);
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  // Moving frames must transfer the pixel buffer instead of copying it
+  igsioStatus TestMoveFrames()
+  {
+    const FrameSizeType frameSize = { 64, 48, 1 };
+    igsioTrackedFrame trackedFrame;
+    trackedFrame.GetImageData()->AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 1);
+    trackedFrame.GetImageData()->FillBlank();
+    trackedFrame.SetTimestamp(12.5);
+    trackedFrame.SetFrameField("TestField", "TestValue");
+    const void* pixels = trackedFrame.GetImageData()->GetScalarPointer();
+
+    igsioStatus status = IGSIO_SUCCESS;
+    igsioVideoFrame videoFrame(std::move(*trackedFrame.GetImageData()));
+    if (videoFrame.GetScalarPointer() != pixels || trackedFrame.GetImageData()->IsImageValid())
+    {
+      LOG_ERROR("Move constructor of igsioVideoFrame copied the pixels or did not release the source image");
+      status = IGSIO_FAIL;
+    }
+    trackedFrame.SetImageData(std::move(videoFrame));
+    if (trackedFrame.GetImageData()->GetScalarPointer() != pixels || trackedFrame.GetFrameSize()[0] != frameSize[0] || videoFrame.IsImageValid())
+    {
+      LOG_ERROR("Moving image data into igsioTrackedFrame copied the pixels");
+      status = IGSIO_FAIL;
+    }
+
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    igsioTrackedFrame movedFrame(std::move(trackedFrame));
+    if (trackedFrameList->AddTrackedFrame(std::move(movedFrame), vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME) != IGSIO_SUCCESS
+        || trackedFrameList->GetNumberOfTrackedFrames() != 1)
+    {
+      LOG_ERROR("Failed to move frame into tracked frame list");
+      return IGSIO_FAIL;
+    }
+    igsioTrackedFrame* listFrame = trackedFrameList->GetTrackedFrame(0);
+    const char* fieldValue = listFrame->GetFrameField("TestField");
+    if (listFrame->GetImageData()->GetScalarPointer() != pixels || listFrame->GetTimestamp() != 12.5
+        || fieldValue == NULL || std::string(fieldValue) != "TestValue")
+    {
+      LOG_ERROR("Tracked frame moved into the list has different content");
+      status = IGSIO_FAIL;
+    }
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  igsioStatus TestCopyOnWrite()
+  {
+    const bool copyOnWriteWasEnabled = igsioVideoFrame::GetCopyOnWrite();
+    igsioVideoFrame::SetCopyOnWrite(true);
+
+    const FrameSizeType frameSize = { 64, 48, 1 };
+    igsioVideoFrame originalFrame;
+    originalFrame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 1);
+    originalFrame.FillBlank();
+    const void* originalPixels = originalFrame.GetConstScalarPointer();
+
+    igsioStatus status = IGSIO_SUCCESS;
+    igsioVideoFrame copiedFrame(originalFrame);
+    if (copiedFrame.GetConstScalarPointer() != originalPixels || !copiedFrame.IsPixelBufferShared() || !originalFrame.IsPixelBufferShared())
+    {
+      LOG_ERROR("Copy of a video frame does not share the pixel buffer with the original frame");
+      status = IGSIO_FAIL;
+    }
+
+    // Writing into the copy must not modify the original frame
+    unsigned char* copiedPixels = static_cast<unsigned char*>(copiedFrame.GetScalarPointer());
+    copiedPixels[0] = 123;
+    if (copiedPixels == originalPixels || copiedFrame.IsPixelBufferShared() || originalFrame.IsPixelBufferShared())
+    {
+      LOG_ERROR("Video frame was not detached from the shared pixel buffer when it was modified");
+      status = IGSIO_FAIL;
+    }
+    if (static_cast<const unsigned char*>(originalFrame.GetConstScalarPointer())[0] != 0 || copiedPixels[1] != 0)
+    {
+      LOG_ERROR("Modifying a copy of a video frame changed the original frame or the copy has invalid content");
+      status = IGSIO_FAIL;
+    }
+
+    // The original frame is the only user of its buffer now, so it is modified in place
+    if (originalFrame.GetScalarPointer() != originalPixels)
+    {
+      LOG_ERROR("Video frame that is not shared anymore was copied when it was modified");
+      status = IGSIO_FAIL;
+    }
+
+    // Reading the VTK image keeps the buffer shared, requesting it for writing detaches the frame
+    igsioVideoFrame imageCopyFrame(originalFrame);
+    if (imageCopyFrame.GetConstImage()->GetScalarPointer() != originalPixels || !imageCopyFrame.IsPixelBufferShared())
+    {
+      LOG_ERROR("Reading the image of a video frame detached it from the shared pixel buffer");
+      status = IGSIO_FAIL;
+    }
+    const igsioVideoFrame& constCopyFrame = imageCopyFrame;
+    if (constCopyFrame.GetImage() != constCopyFrame.GetConstImage() || constCopyFrame.GetScalarPointer() != originalPixels
+        || !imageCopyFrame.IsPixelBufferShared())
+    {
+      LOG_ERROR("Accessing the image of a const video frame detached it from the shared pixel buffer");
+      status = IGSIO_FAIL;
+    }
+    vtkImageData* copiedImage = imageCopyFrame.GetImage();
+    if (copiedImage == NULL || copiedImage->GetScalarPointer() == originalPixels || originalFrame.IsPixelBufferShared())
+    {
+      LOG_ERROR("Video frame was not detached from the shared pixel buffer when its image was requested for writing");
+      status = IGSIO_FAIL;
+    }
+
+    igsioVideoFrame::SetCopyOnWrite(copyOnWriteWasEnabled);
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  igsioStatus TestAlignedFrames()
+  {
+    const unsigned int previousAlignment = igsioVideoFrame::GetPixelBufferAlignment();
+    int oldVerboseLevel = vtkIGSIOLogger::Instance()->GetLogLevel();
+    vtkIGSIOLogger::Instance()->SetLogLevel(vtkIGSIOLogger::LOG_LEVEL_ERROR - 1); // invalid alignment error is expected
+    const igsioStatus invalidAlignmentStatus = igsioVideoFrame::SetPixelBufferAlignment(48);
+    vtkIGSIOLogger::Instance()->SetLogLevel(oldVerboseLevel);
+    if (invalidAlignmentStatus == IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Pixel buffer alignment that is not a power of two was accepted");
+      return IGSIO_FAIL;
+    }
+    if (igsioVideoFrame::SetPixelBufferAlignment(64) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to set pixel buffer alignment");
+      return IGSIO_FAIL;
+    }
+
+    igsioStatus status = IGSIO_SUCCESS;
+    // Odd sizes, so that a buffer following the previous one would not start at an aligned address by chance
+    const FrameSizeType frameSizes[2] = { { 13, 7, 1 }, { 33, 5, 3 } };
+    for (int i = 0; i < 2; ++i)
+    {
+      igsioVideoFrame frame;
+      if (frame.AllocateFrame(frameSizes[i], VTK_UNSIGNED_CHAR, 3) != IGSIO_SUCCESS || !frame.IsPixelBufferAligned(64))
+      {
+        LOG_ERROR("Pixel buffer of a " << frameSizes[i][0] << "x" << frameSizes[i][1] << "x" << frameSizes[i][2] << " frame is not aligned");
+        status = IGSIO_FAIL;
+        continue;
+      }
+      if (frame.GetRowStrideInBytes() != frameSizes[i][0] * 3 || frame.GetSliceStrideInBytes() != frameSizes[i][0] * frameSizes[i][1] * 3)
+      {
+        LOG_ERROR("Invalid strides: row " << frame.GetRowStrideInBytes() << " bytes, slice " << frame.GetSliceStrideInBytes() << " bytes");
+        status = IGSIO_FAIL;
+      }
+      frame.FillBlank();
+    }
+
+    igsioVideoFrame::SetPixelBufferAlignment(previousAlignment);
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  template<typename SampleType>
+  igsioStatus TestRfIqLayoutForType(igsioCommon::VTKScalarPixelType pixelType)
+  {
+    // Odd number of samples per line, so that the tail of the vectorized loops is exercised
+    const unsigned int samplesPerLine = 37;
+    const FrameSizeType frameSize = { 2 * samplesPerLine, 5, 2 };
+    igsioVideoFrame interleavedFrame;
+    interleavedFrame.AllocateFrame(frameSize, pixelType, 1);
+    interleavedFrame.SetImageType(US_IMG_RF_IQ_LINE);
+    interleavedFrame.SetImageOrientation(US_IMG_ORIENT_FM);
+    SampleType* samples = static_cast<SampleType*>(interleavedFrame.GetScalarPointer());
+    for (unsigned int i = 0; i < frameSize[0] * frameSize[1] * frameSize[2]; ++i)
+    {
+      samples[i] = static_cast<SampleType>(i % 2 == 0 ? i / 2 : -static_cast<int>(i / 2));
+    }
+
+    igsioVideoFrame separatedFrame;
+    if (igsioVideoFrame::ConvertRfIqLayout(interleavedFrame, separatedFrame, US_IMG_RF_I_LINE_Q_LINE) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to separate I and Q lines");
+      return IGSIO_FAIL;
+    }
+    FrameSizeType separatedFrameSize = { 0, 0, 0 };
+    separatedFrame.GetFrameSize(separatedFrameSize);
+    if (separatedFrameSize[0] != samplesPerLine || separatedFrameSize[1] != 2 * frameSize[1] || separatedFrameSize[2] != frameSize[2]
+        || separatedFrame.GetImageType() != US_IMG_RF_I_LINE_Q_LINE)
+    {
+      LOG_ERROR("Invalid frame size or image type after separating I and Q lines");
+      return IGSIO_FAIL;
+    }
+    const SampleType* separatedSamples = static_cast<const SampleType*>(separatedFrame.GetConstScalarPointer());
+    for (unsigned int line = 0; line < frameSize[1] * frameSize[2]; ++line)
+    {
+      for (unsigned int sample = 0; sample < samplesPerLine; ++sample)
+      {
+        if (separatedSamples[2 * line * samplesPerLine + sample] != samples[line * 2 * samplesPerLine + 2 * sample]
+            || separatedSamples[(2 * line + 1) * samplesPerLine + sample] != samples[line * 2 * samplesPerLine + 2 * sample + 1])
+        {
+          LOG_ERROR("Mismatch in separated I/Q data at line " << line << ", sample " << sample);
+          return IGSIO_FAIL;
+        }
+      }
+    }
+
+    if (separatedFrame.ConvertRfIqLayout(US_IMG_RF_IQ_LINE) != IGSIO_SUCCESS || separatedFrame.GetFrameSizeInBytes() != interleavedFrame.GetFrameSizeInBytes()
+        || memcmp(separatedFrame.GetConstScalarPointer(), interleavedFrame.GetConstScalarPointer(), interleavedFrame.GetFrameSizeInBytes()) != 0)
+    {
+      LOG_ERROR("Interleaving the separated I and Q lines did not restore the original frame");
+      return IGSIO_FAIL;
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestRfIqLayout()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    for (int instructionSet = igsioCpuFeatures::INSTRUCTION_SET_SCALAR; instructionSet <= igsioCpuFeatures::INSTRUCTION_SET_AVX2; ++instructionSet)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(static_cast<igsioCpuFeatures::InstructionSet>(instructionSet));
+      if (TestRfIqLayoutForType<short>(VTK_SHORT) != IGSIO_SUCCESS || TestRfIqLayoutForType<float>(VTK_FLOAT) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("RF I/Q layout conversion failed with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+    return status;
+  }
+  //----------------------------------------------------------------------------
+  // Fill a 16-bit frame with a ramp that covers values below, inside and above a typical display window
+  void FillRamp(igsioVideoFrame& frame, const FrameSizeType& frameSize)
+  {
+    frame.AllocateFrame(frameSize, VTK_UNSIGNED_SHORT, 1);
+    unsigned short* pixels = static_cast<unsigned short*>(frame.GetScalarPointer());
+    for (unsigned int i = 0; i < frameSize[0] * frameSize[1] * frameSize[2]; ++i)
+    {
+      pixels[i] = static_cast<unsigned short>((i * 37) % 5000);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  bool IsWindowLevelResultValid(const igsioVideoFrame& inputFrame, const igsioVideoFrame& outputFrame, double window, double level)
+  {
+    if (outputFrame.GetVTKScalarPixelType() != VTK_UNSIGNED_CHAR || outputFrame.GetFrameSizeInBytes() * 2 != inputFrame.GetFrameSizeInBytes())
+    {
+      return false;
+    }
+    const unsigned short* inputPixels = static_cast<const unsigned short*>(inputFrame.GetConstScalarPointer());
+    const unsigned char* outputPixels = static_cast<const unsigned char*>(outputFrame.GetConstScalarPointer());
+    for (unsigned long i = 0; i < outputFrame.GetFrameSizeInBytes(); ++i)
+    {
+      const double expected = std::max(0.0, std::min(255.0, (inputPixels[i] - (level - window / 2.0)) * 255.0 / window));
+      if (std::fabs(outputPixels[i] - expected) > 0.51)
+      {
+        LOG_ERROR("Window/level mismatch at pixel " << i << ": input " << inputPixels[i] << ", output " << static_cast<int>(outputPixels[i]) << ", expected " << expected);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestPixelTypeConversion()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    const double window = 3000;
+    const double level = 2000;
+    const FrameSizeType frameSize = { 123, 45, 1 };
+    igsioVideoFrame inputFrame;
+    FillRamp(inputFrame, frameSize);
+
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    for (int instructionSet = igsioCpuFeatures::INSTRUCTION_SET_SCALAR; instructionSet <= igsioCpuFeatures::INSTRUCTION_SET_AVX2; ++instructionSet)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(static_cast<igsioCpuFeatures::InstructionSet>(instructionSet));
+      igsioVideoFrame outputFrame;
+      if (igsioVideoFrame::ConvertPixelTypeWindowLevel(inputFrame, outputFrame, window, level) != IGSIO_SUCCESS
+          || !IsWindowLevelResultValid(inputFrame, outputFrame, window, level))
+      {
+        LOG_ERROR("Window/level conversion failed with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+
+    // Scale and offset into float
+    igsioVideoFrame floatFrame;
+    if (igsioVideoFrame::ConvertPixelType(inputFrame, floatFrame, VTK_FLOAT, 0.5, -10.0) != IGSIO_SUCCESS || floatFrame.GetVTKScalarPixelType() != VTK_FLOAT)
+    {
+      LOG_ERROR("Failed to convert unsigned short frame to float");
+      return IGSIO_FAIL;
+    }
+    const unsigned short* inputPixels = static_cast<const unsigned short*>(inputFrame.GetConstScalarPointer());
+    const float* floatPixels = static_cast<const float*>(floatFrame.GetConstScalarPointer());
+    for (unsigned int i = 0; i < frameSize[0] * frameSize[1]; ++i)
+    {
+      if (floatPixels[i] != inputPixels[i] * 0.5f - 10.0f)
+      {
+        LOG_ERROR("Float conversion mismatch at pixel " << i << ": " << floatPixels[i] << " instead of " << inputPixels[i] * 0.5f - 10.0f);
+        status = IGSIO_FAIL;
+        break;
+      }
+    }
+
+    // Batch conversion of a tracked frame list, on multiple threads
+    const int previousNumberOfThreads = igsioVideoFrame::GetPixelConversionNumberOfThreads();
+    igsioVideoFrame::SetPixelConversionNumberOfThreads(3);
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    for (int i = 0; i < 5; ++i)
+    {
+      igsioTrackedFrame trackedFrame;
+      trackedFrame.SetImageData(inputFrame);
+      trackedFrameList->AddTrackedFrame(std::move(trackedFrame), vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    }
+    if (trackedFrameList->ConvertPixelTypeWindowLevel(window, level) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to convert pixel type of tracked frame list");
+      status = IGSIO_FAIL;
+    }
+    for (unsigned int i = 0; i < trackedFrameList->GetNumberOfTrackedFrames(); ++i)
+    {
+      if (!IsWindowLevelResultValid(inputFrame, *trackedFrameList->GetTrackedFrame(i)->GetImageData(), window, level))
+      {
+        LOG_ERROR("Invalid pixels in frame " << i << " of the converted tracked frame list");
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioVideoFrame::SetPixelConversionNumberOfThreads(previousNumberOfThreads);
+
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestYuvConversion()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+
+    // Smooth color gradient with odd size, so that the last chroma samples cover a single row and column
+    const FrameSizeType frameSize = { 37, 21, 1 };
+    igsioVideoFrame rgbFrame;
+    rgbFrame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 3);
+    unsigned char* rgbPixels = static_cast<unsigned char*>(rgbFrame.GetScalarPointer());
+    for (unsigned int y = 0; y < frameSize[1]; ++y)
+    {
+      for (unsigned int x = 0; x < frameSize[0]; ++x)
+      {
+        unsigned char* pixel = rgbPixels + (y * frameSize[0] + x) * 3;
+        pixel[0] = static_cast<unsigned char>(x * 4);
+        pixel[1] = static_cast<unsigned char>(y * 6);
+        pixel[2] = static_cast<unsigned char>(255 - x * 2 - y * 3);
+      }
+    }
+    const unsigned int numberOfBytes = frameSize[0] * frameSize[1] * 3;
+
+    const char* fourCCs[] = { "I420", "NV12", "YUY2" };
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    for (int formatIndex = 0; formatIndex < 3; ++formatIndex)
+    {
+      const std::string fourCC = fourCCs[formatIndex];
+      if (!igsioVideoFrame::IsYuvFourCC(fourCC))
+      {
+        LOG_ERROR(fourCC << " is not recognized as a YUV format");
+        status = IGSIO_FAIL;
+        continue;
+      }
+
+      std::vector<unsigned char> referenceRgbPixels;
+      for (int instructionSet = igsioCpuFeatures::INSTRUCTION_SET_SCALAR; instructionSet <= igsioCpuFeatures::INSTRUCTION_SET_AVX2; ++instructionSet)
+      {
+        igsioCpuFeatures::SetMaximumInstructionSet(static_cast<igsioCpuFeatures::InstructionSet>(instructionSet));
+        vtkSmartPointer<vtkUnsignedCharArray> yuvData = vtkSmartPointer<vtkUnsignedCharArray>::New();
+        igsioVideoFrame decodedFrame;
+        if (igsioVideoFrame::ConvertRgbToYuv(rgbFrame, fourCC, yuvData) != IGSIO_SUCCESS
+            || static_cast<unsigned long>(yuvData->GetNumberOfValues()) != igsioVideoFrame::GetYuvDataSizeInBytes(fourCC, frameSize)
+            || igsioVideoFrame::ConvertYuvToRgb(yuvData->GetPointer(0), yuvData->GetNumberOfValues(), fourCC, frameSize, decodedFrame) != IGSIO_SUCCESS)
+        {
+          LOG_ERROR(fourCC << " conversion failed with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+          status = IGSIO_FAIL;
+          continue;
+        }
+
+        // Chroma subsampling of a smooth image only causes small differences
+        const unsigned char* decodedPixels = static_cast<const unsigned char*>(decodedFrame.GetConstScalarPointer());
+        for (unsigned int i = 0; i < numberOfBytes; ++i)
+        {
+          if (std::abs(static_cast<int>(decodedPixels[i]) - static_cast<int>(rgbPixels[i])) > 8)
+          {
+            LOG_ERROR(fourCC << " round trip mismatch at byte " << i << ": " << static_cast<int>(decodedPixels[i]) << " instead of " << static_cast<int>(rgbPixels[i]));
+            status = IGSIO_FAIL;
+            break;
+          }
+        }
+
+        // All implementations must give the same result
+        if (referenceRgbPixels.empty())
+        {
+          referenceRgbPixels.assign(decodedPixels, decodedPixels + numberOfBytes);
+        }
+        else if (memcmp(&referenceRgbPixels[0], decodedPixels, numberOfBytes) != 0)
+        {
+          LOG_ERROR(fourCC << " conversion result depends on the instruction set, mismatch with " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+          status = IGSIO_FAIL;
+        }
+      }
+      igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+    }
+
+    // Unsupported input
+    vtkSmartPointer<vtkUnsignedCharArray> yuvData = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    int oldVerboseLevel = vtkIGSIOLogger::Instance()->GetLogLevel();
+    vtkIGSIOLogger::Instance()->SetLogLevel(vtkIGSIOLogger::LOG_LEVEL_ERROR - 1); // unsupported format error is expected
+    const igsioStatus unsupportedFormatStatus = igsioVideoFrame::ConvertRgbToYuv(rgbFrame, "RV24", yuvData);
+    vtkIGSIOLogger::Instance()->SetLogLevel(oldVerboseLevel);
+    if (unsupportedFormatStatus == IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Conversion to an unknown YUV format was expected to fail");
+      status = IGSIO_FAIL;
+    }
+
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestDownsampling()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+
+    // Odd size, so that the last row and column are averaged with themselves. Large enough to be split between threads.
+    const FrameSizeType frameSize = { 261, 133, 3 };
+    igsioVideoFrame inputFrame;
+    FillRamp(inputFrame, frameSize);
+    inputFrame.SetImageOrientation(US_IMG_ORIENT_MF);
+    const unsigned short* inputPixels = static_cast<const unsigned short*>(inputFrame.GetConstScalarPointer());
+
+    const int previousNumberOfThreads = igsioVideoFrame::GetPixelConversionNumberOfThreads();
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    for (int instructionSet = igsioCpuFeatures::INSTRUCTION_SET_SCALAR; instructionSet <= igsioCpuFeatures::INSTRUCTION_SET_AVX2; ++instructionSet)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(static_cast<igsioCpuFeatures::InstructionSet>(instructionSet));
+      igsioVideoFrame::SetPixelConversionNumberOfThreads(instructionSet % 2 == 0 ? 1 : 3);
+      std::vector<igsioVideoFrame> pyramid;
+      if (igsioVideoFrame::BuildPyramid(inputFrame, pyramid, 2) != IGSIO_SUCCESS || pyramid.size() != 2)
+      {
+        LOG_ERROR("Failed to build image pyramid with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+        continue;
+      }
+
+      FrameSizeType halfSize = { 0, 0, 0 };
+      FrameSizeType quarterSize = { 0, 0, 0 };
+      pyramid[0].GetFrameSize(halfSize);
+      pyramid[1].GetFrameSize(quarterSize);
+      if (halfSize[0] != 131 || halfSize[1] != 67 || halfSize[2] != 3 || quarterSize[0] != 66 || quarterSize[1] != 34 || quarterSize[2] != 3
+          || pyramid[1].GetImageOrientation() != US_IMG_ORIENT_MF)
+      {
+        LOG_ERROR("Unexpected pyramid level size or orientation");
+        status = IGSIO_FAIL;
+        continue;
+      }
+
+      const unsigned short* halfPixels = static_cast<const unsigned short*>(pyramid[0].GetConstScalarPointer());
+      for (unsigned int z = 0; z < halfSize[2] && status == IGSIO_SUCCESS; ++z)
+      {
+        for (unsigned int y = 0; y < halfSize[1] && status == IGSIO_SUCCESS; ++y)
+        {
+          for (unsigned int x = 0; x < halfSize[0]; ++x)
+          {
+            const unsigned int x1 = std::min<unsigned int>(2 * x + 1, frameSize[0] - 1);
+            const unsigned int y1 = std::min<unsigned int>(2 * y + 1, frameSize[1] - 1);
+            const unsigned short* slice = inputPixels + z * frameSize[0] * frameSize[1];
+            const unsigned int sum = slice[2 * y * frameSize[0] + 2 * x] + slice[2 * y * frameSize[0] + x1] + slice[y1 * frameSize[0] + 2 * x] + slice[y1 * frameSize[0] + x1];
+            const unsigned short expected = static_cast<unsigned short>((sum + 2) / 4);
+            const unsigned short actual = halfPixels[(z * halfSize[1] + y) * halfSize[0] + x];
+            if (actual != expected)
+            {
+              LOG_ERROR("Downsampled pixel mismatch at (" << x << ", " << y << ", " << z << "): " << actual << " instead of " << expected);
+              status = IGSIO_FAIL;
+              break;
+            }
+          }
+        }
+      }
+
+      // Downsampling by 4 must give the same result as the second pyramid level
+      igsioVideoFrame quarterFrame;
+      if (igsioVideoFrame::Downsample(inputFrame, quarterFrame, 2) != IGSIO_SUCCESS || quarterFrame.GetFrameSizeInBytes() != pyramid[1].GetFrameSizeInBytes()
+          || memcmp(quarterFrame.GetConstScalarPointer(), pyramid[1].GetConstScalarPointer(), quarterFrame.GetFrameSizeInBytes()) != 0)
+      {
+        LOG_ERROR("Downsampling by 4 does not match the image pyramid");
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+    igsioVideoFrame::SetPixelConversionNumberOfThreads(previousNumberOfThreads);
+
+    // Thumbnails of a tracked frame list
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    for (int i = 0; i < 3; ++i)
+    {
+      igsioTrackedFrame trackedFrame;
+      trackedFrame.SetImageData(inputFrame);
+      trackedFrameList->AddTrackedFrame(std::move(trackedFrame), vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    }
+    if (trackedFrameList->CreateThumbnails(2) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to create thumbnails for tracked frame list");
+      return IGSIO_FAIL;
+    }
+    for (unsigned int i = 0; i < trackedFrameList->GetNumberOfTrackedFrames(); ++i)
+    {
+      FrameSizeType thumbnailSize = { 0, 0, 0 };
+      igsioTrackedFrame* trackedFrame = trackedFrameList->GetTrackedFrame(i);
+      if (!trackedFrame->HasThumbnail() || trackedFrame->GetThumbnail()->GetFrameSize(thumbnailSize) != IGSIO_SUCCESS || thumbnailSize[0] != 66 || thumbnailSize[1] != 34)
+      {
+        LOG_ERROR("Missing or invalid thumbnail in frame " << i);
+        status = IGSIO_FAIL;
+      }
+    }
+
+    // Interleaved RF data cannot be downsampled
+    igsioVideoFrame rfFrame(inputFrame);
+    rfFrame.SetImageType(US_IMG_RF_IQ_LINE);
+    igsioVideoFrame rfOutputFrame;
+    int oldVerboseLevel = vtkIGSIOLogger::Instance()->GetLogLevel();
+    vtkIGSIOLogger::Instance()->SetLogLevel(vtkIGSIOLogger::LOG_LEVEL_ERROR - 1); // RF data error is expected
+    const igsioStatus rfDownsampleStatus = igsioVideoFrame::Downsample(rfFrame, rfOutputFrame, 1);
+    vtkIGSIOLogger::Instance()->SetLogLevel(oldVerboseLevel);
+    if (rfDownsampleStatus == IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Downsampling of RF I/Q data was expected to fail");
+      status = IGSIO_FAIL;
+    }
+
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestImageHash()
+  {
+    // Reference values of the xxHash specification
+    const char* text = "Nobody inspects the spammish repetition";
+    if (igsioVideoFrameKernels::Hash64("", 0) != 0xEF46DB3751D8E999ULL || igsioVideoFrameKernels::Hash64("abc", 3) != 0x44BC2CF5AD770999ULL
+        || igsioVideoFrameKernels::Hash64(text, strlen(text)) != 0xFBCEA83C8A378BF1ULL)
+    {
+      LOG_ERROR("Hash64 does not match the XXH64 reference values");
+      return IGSIO_FAIL;
+    }
+
+    const FrameSizeType frameSize = { 123, 45, 1 };
+    igsioVideoFrame frame;
+    FillRamp(frame, frameSize);
+    igsioVideoFrame frameCopy(frame);
+    unsigned long long hash(0);
+    unsigned long long copyHash(0);
+    if (frame.ComputeHash(hash) != IGSIO_SUCCESS || frameCopy.ComputeHash(copyHash) != IGSIO_SUCCESS || hash != copyHash)
+    {
+      LOG_ERROR("Copies of a frame have different hashes");
+      return IGSIO_FAIL;
+    }
+    static_cast<unsigned short*>(frameCopy.GetScalarPointer())[1000]++;
+    if (frameCopy.ComputeHash(copyHash) != IGSIO_SUCCESS || hash == copyHash)
+    {
+      LOG_ERROR("Modified frame has the same hash as the original");
+      return IGSIO_FAIL;
+    }
+
+    unsigned long long parsedHash(0);
+    const std::string hashString = igsioVideoFrame::GetHashAsString(hash);
+    if (hashString.size() != 16 || igsioVideoFrame::GetHashFromString(hashString, parsedHash) != IGSIO_SUCCESS || parsedHash != hash)
+    {
+      LOG_ERROR("Hash string conversion failed: " << hashString);
+      return IGSIO_FAIL;
+    }
+
+    // The hash is cached in a frame field until new image data is set
+    igsioTrackedFrame trackedFrame;
+    trackedFrame.SetImageData(frame);
+    unsigned long long trackedFrameHash(0);
+    if (trackedFrame.UpdateImageHashField() != IGSIO_SUCCESS || hashString != trackedFrame.GetFrameField(igsioTrackedFrame::FIELD_IMAGE_HASH)
+        || trackedFrame.GetImageHash(trackedFrameHash) != IGSIO_SUCCESS || trackedFrameHash != hash)
+    {
+      LOG_ERROR("Tracked frame image hash field is invalid");
+      return IGSIO_FAIL;
+    }
+    trackedFrame.SetImageData(frameCopy);
+    if (trackedFrame.IsFrameFieldDefined(igsioTrackedFrame::FIELD_IMAGE_HASH) || trackedFrame.GetImageHash(trackedFrameHash) != IGSIO_SUCCESS || trackedFrameHash != copyHash)
+    {
+      LOG_ERROR("Tracked frame image hash was not invalidated by setting new image data");
+      return IGSIO_FAIL;
+    }
+
+    // Verification of a tracked frame list
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    trackedFrameList->AddTrackedFrame(&trackedFrame, vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    if (trackedFrameList->UpdateImageHashes() != IGSIO_SUCCESS || trackedFrameList->VerifyImageHashes() != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Image hash verification of tracked frame list failed");
+      return IGSIO_FAIL;
+    }
+    static_cast<unsigned short*>(trackedFrameList->GetTrackedFrame(0)->GetImageData()->GetScalarPointer())[0]++;
+    int oldVerboseLevel = vtkIGSIOLogger::Instance()->GetLogLevel();
+    vtkIGSIOLogger::Instance()->SetLogLevel(vtkIGSIOLogger::LOG_LEVEL_ERROR - 1); // mismatch errors are expected
+    const igsioStatus verifyStatus = trackedFrameList->VerifyImageHashes();
+    vtkIGSIOLogger::Instance()->SetLogLevel(oldVerboseLevel);
+    if (verifyStatus == IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Image hash verification did not detect modified pixels");
+      return IGSIO_FAIL;
+    }
+
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestFrameDifference()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    const FrameSizeType frameSize = { 201, 67, 1 };
+    igsioVideoFrame frame;
+    frame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 1);
+    unsigned char* pixels = static_cast<unsigned char*>(frame.GetScalarPointer());
+    for (unsigned int i = 0; i < frameSize[0] * frameSize[1]; ++i)
+    {
+      pixels[i] = static_cast<unsigned char>(i * 7);
+    }
+
+    // Change a 10x10 block inside the region of interest: 50 pixels by 1, 50 pixels by 5
+    igsioVideoFrame changedFrame(frame);
+    unsigned char* changedPixels = static_cast<unsigned char*>(changedFrame.GetScalarPointer());
+    for (unsigned int y = 20; y < 30; ++y)
+    {
+      for (unsigned int x = 100; x < 110; ++x)
+      {
+        unsigned char& pixel = changedPixels[y * frameSize[0] + x];
+        pixel = static_cast<unsigned char>(pixel < 128 ? pixel + (y < 25 ? 1 : 5) : pixel - (y < 25 ? 1 : 5));
+      }
+    }
+
+    const std::array<int, 3> regionOrigin = { 90, 10, 0 };
+    const std::array<int, 3> regionSize = { 40, 25, 1 };
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    for (int instructionSet = igsioCpuFeatures::INSTRUCTION_SET_SCALAR; instructionSet <= igsioCpuFeatures::INSTRUCTION_SET_AVX2; ++instructionSet)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(static_cast<igsioCpuFeatures::InstructionSet>(instructionSet));
+      igsioVideoFrame::FrameDifferenceType sameDifference;
+      igsioVideoFrame::FrameDifferenceType anyDifference;
+      igsioVideoFrame::FrameDifferenceType largeDifference;
+      igsioVideoFrame::FrameDifferenceType regionDifference;
+      if (igsioVideoFrame::ComputeFrameDifference(frame, frame, 0.0, sameDifference) != IGSIO_SUCCESS
+          || igsioVideoFrame::ComputeFrameDifference(frame, changedFrame, 0.0, anyDifference) != IGSIO_SUCCESS
+          || igsioVideoFrame::ComputeFrameDifference(changedFrame, frame, 2.0, largeDifference) != IGSIO_SUCCESS
+          || igsioVideoFrame::ComputeFrameDifference(frame, changedFrame, 0.0, regionOrigin, regionSize, regionDifference) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to compute frame difference with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+        continue;
+      }
+      const double numberOfPixels = frameSize[0] * frameSize[1];
+      if (sameDifference.SumOfAbsoluteDifferences != 0.0 || sameDifference.ChangedScalarRatio != 0.0
+          || anyDifference.SumOfAbsoluteDifferences != 300.0 || anyDifference.ChangedScalarRatio != 100 / numberOfPixels
+          || largeDifference.SumOfAbsoluteDifferences != 300.0 || largeDifference.ChangedScalarRatio != 50 / numberOfPixels
+          || regionDifference.NumberOfComparedScalars != 40 * 25 || regionDifference.MeanAbsoluteDifference != 300.0 / (40 * 25)
+          || regionDifference.ChangedScalarRatio != 100.0 / (40 * 25))
+      {
+        LOG_ERROR("Unexpected frame difference with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+
+    // Tracked frame list rejects frames with unchanged image
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    trackedFrameList->SetValidationRequirements(REQUIRE_CHANGED_IMAGE);
+    trackedFrameList->SetImageChangeThreshold(2.0);
+    const igsioVideoFrame* images[] = { &frame, &frame, &changedFrame, &changedFrame, &frame };
+    for (int i = 0; i < 5; ++i)
+    {
+      igsioTrackedFrame trackedFrame;
+      trackedFrame.SetImageData(*images[i]);
+      trackedFrame.SetTimestamp(i);
+      trackedFrameList->AddTrackedFrame(&trackedFrame, vtkIGSIOTrackedFrameList::SKIP_INVALID_FRAME);
+    }
+    if (trackedFrameList->GetNumberOfTrackedFrames() != 3)
+    {
+      LOG_ERROR("Unchanged frames were not rejected, number of frames in the list: " << trackedFrameList->GetNumberOfTrackedFrames());
+      status = IGSIO_FAIL;
+    }
+
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus TestImageStatistics()
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    const FrameSizeType frameSize = { 203, 61, 1 };
+    igsioVideoFrame frame;
+    frame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 1);
+    unsigned char* pixels = static_cast<unsigned char*>(frame.GetScalarPointer());
+    for (unsigned int i = 0; i < frameSize[0] * frameSize[1]; ++i)
+    {
+      pixels[i] = static_cast<unsigned char>((i * 13) % 251);
+    }
+
+    // Reference statistics of the region of interest
+    const std::array<int, 3> regionOrigin = { 7, 3, 0 };
+    const std::array<int, 3> regionSize = { 150, 40, 1 };
+    double minimum = 255.0;
+    double maximum = 0.0;
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    std::vector<unsigned long long> histogram(16, 0);
+    for (int y = regionOrigin[1]; y < regionOrigin[1] + regionSize[1]; ++y)
+    {
+      for (int x = regionOrigin[0]; x < regionOrigin[0] + regionSize[0]; ++x)
+      {
+        const double value = pixels[y * frameSize[0] + x];
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+        sum += value;
+        sumOfSquares += value * value;
+        histogram[static_cast<int>(value) / 16]++;
+      }
+    }
+    const double numberOfScalars = regionSize[0] * regionSize[1];
+    const double mean = sum / numberOfScalars;
+    const double standardDeviation = std::sqrt(sumOfSquares / numberOfScalars - mean * mean);
+
+    const igsioCpuFeatures::InstructionSet maximumInstructionSet = igsioCpuFeatures::GetMaximumInstructionSet();
+    for (int instructionSet = igsioCpuFeatures::INSTRUCTION_SET_SCALAR; instructionSet <= igsioCpuFeatures::INSTRUCTION_SET_AVX2; ++instructionSet)
+    {
+      igsioCpuFeatures::SetMaximumInstructionSet(static_cast<igsioCpuFeatures::InstructionSet>(instructionSet));
+      igsioVideoFrame::ImageStatisticsType statistics;
+      igsioVideoFrame::ImageStatisticsType statisticsWithHistogram;
+      if (frame.ComputeStatistics(statistics, regionOrigin, regionSize) != IGSIO_SUCCESS
+          || frame.ComputeStatistics(statisticsWithHistogram, regionOrigin, regionSize, 16) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to compute image statistics with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+        continue;
+      }
+      const igsioVideoFrame::ImageStatisticsType* results[2] = { &statistics, &statisticsWithHistogram };
+      for (int i = 0; i < 2; ++i)
+      {
+        if (results[i]->NumberOfScalars != numberOfScalars || results[i]->Minimum != minimum || results[i]->Maximum != maximum
+            || std::fabs(results[i]->Mean - mean) > 1e-9 || std::fabs(results[i]->StandardDeviation - standardDeviation) > 1e-6)
+        {
+          LOG_ERROR("Unexpected image statistics with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet())
+                    << ": min " << results[i]->Minimum << ", max " << results[i]->Maximum << ", mean " << results[i]->Mean << ", std " << results[i]->StandardDeviation);
+          status = IGSIO_FAIL;
+        }
+      }
+      if (statisticsWithHistogram.Histogram != histogram || statisticsWithHistogram.HistogramMinimum != 0.0 || statisticsWithHistogram.HistogramMaximum != 256.0)
+      {
+        LOG_ERROR("Unexpected histogram with instruction set " << igsioCpuFeatures::GetInstructionSetAsString(igsioCpuFeatures::GetInstructionSet()));
+        status = IGSIO_FAIL;
+      }
+    }
+    igsioCpuFeatures::SetMaximumInstructionSet(maximumInstructionSet);
+
+    // Floating point histogram range defaults to the range of the pixel values
+    igsioVideoFrame floatFrame;
+    if (igsioVideoFrame::ConvertPixelType(frame, floatFrame, VTK_FLOAT, 0.5, -10.0) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to convert frame to float");
+      return IGSIO_FAIL;
+    }
+    igsioVideoFrame::ImageStatisticsType floatStatistics;
+    if (floatFrame.ComputeStatistics(floatStatistics, 10) != IGSIO_SUCCESS
+        || floatStatistics.HistogramMinimum != -10.0 || floatStatistics.HistogramMaximum != 115.0 || floatStatistics.Histogram.size() != 10
+        || floatStatistics.Histogram[0] == 0 || floatStatistics.Histogram[9] == 0)
+    {
+      LOG_ERROR("Unexpected floating point image statistics: histogram range " << floatStatistics.HistogramMinimum << " - " << floatStatistics.HistogramMaximum);
+      status = IGSIO_FAIL;
+    }
+
+    // Statistics of a tracked frame list, computed in parallel
+    vtkSmartPointer<vtkIGSIOTrackedFrameList> trackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+    for (int i = 0; i < 6; ++i)
+    {
+      igsioTrackedFrame trackedFrame;
+      if (i != 2)
+      {
+        trackedFrame.SetImageData(frame);
+      }
+      trackedFrameList->AddTrackedFrame(std::move(trackedFrame), vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    }
+    const int previousNumberOfThreads = igsioVideoFrame::GetPixelConversionNumberOfThreads();
+    igsioVideoFrame::SetPixelConversionNumberOfThreads(3);
+    std::vector<igsioVideoFrame::ImageStatisticsType> listStatistics;
+    if (trackedFrameList->ComputeImageStatistics(listStatistics, regionOrigin, regionSize, 16) != IGSIO_SUCCESS || listStatistics.size() != 6)
+    {
+      LOG_ERROR("Failed to compute image statistics of tracked frame list");
+      status = IGSIO_FAIL;
+    }
+    else
+    {
+      for (size_t i = 0; i < listStatistics.size(); ++i)
+      {
+        const bool expectValid = (i != 2);
+        if ((listStatistics[i].NumberOfScalars > 0) != expectValid || (expectValid && listStatistics[i].Histogram != histogram))
+        {
+          LOG_ERROR("Unexpected image statistics of frame " << i << " of the tracked frame list");
+          status = IGSIO_FAIL;
+        }
+      }
+    }
+    igsioVideoFrame::SetPixelConversionNumberOfThreads(previousNumberOfThreads);
+
+    return status;
+  }
+
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  bool printHelp(false);
+  int verboseLevel = vtkIGSIOLogger::LOG_LEVEL_UNDEFINED;
+
+  vtksys::CommandLineArguments args;
+  args.Initialize(argc, argv);
+
+  args.AddArgument("--help", vtksys::CommandLineArguments::NO_ARGUMENT, &printHelp, "Print this help.");
+  args.AddArgument("--verbose", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &verboseLevel, "Verbose level (1=error only, 2=warning, 3=info, 4=debug, 5=trace)");
+
+  if (!args.Parse())
+  {
+    std::cerr << "Problem parsing arguments" << std::endl;
+    std::cout << "Help: " << args.GetHelp() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (printHelp)
+  {
+    std::cout << args.GetHelp() << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+
+  vtkIGSIOLogger::Instance()->SetLogLevel(verboseLevel);
+
+  if (TestFlipClipImages() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("FlipClipImage test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestMultiThreadedFlipClip() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Multi-threaded FlipClipImage test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestRawPointerFlipClip() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Raw pointer FlipClipImage test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestByteSwapFlipClip() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Byte swapping FlipClipImage test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestOrientedView() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Oriented view test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestFrameBufferPool() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Frame buffer pool test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestMoveFrames() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Frame move test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestCopyOnWrite() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Copy on write test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestAlignedFrames() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Aligned frame allocation test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestRfIqLayout() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("RF I/Q layout conversion test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestPixelTypeConversion() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Pixel type conversion test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestYuvConversion() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("YUV conversion test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestDownsampling() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Downsampling test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestImageHash() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Image hash test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestFrameDifference() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Frame difference test failed");
+    return EXIT_FAILURE;
+  }
+
+  if (TestImageStatistics() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Image statistics test failed");
+    return EXIT_FAILURE;
+  }
+
+  LOG_INFO("Test completed successfully");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Compares the speed of the cache blocked IJK to KIJ transposition in igsioVideoFrame::FlipClipImage
+// with a straightforward pixel-by-pixel implementation (that walks the input sequentially and
+// writes the output with a large stride). The results of the two implementations must be identical.
+
+// Local includes
+#include "igsioCommon.h"
+#include "igsioVideoFrame.h"
+#include "vtkIGSIOAccurateTimer.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+#include <vtksys/CommandLineArguments.hxx>
+
+// STL includes
+#include <cstring>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Pixel-by-pixel transposition, output(k, i, j) = input(i, j, k)
+  void TransposeReference(vtkImageData* inputImage, vtkImageData* outputImage)
+  {
+    int dims[3] = { 0, 0, 0 };
+    inputImage->GetDimensions(dims);
+    outputImage->SetExtent(0, dims[2] - 1, 0, dims[0] - 1, 0, dims[1] - 1);
+    outputImage->AllocateScalars(inputImage->GetScalarType(), inputImage->GetNumberOfScalarComponents());
+
+    const size_t pixelSize = inputImage->GetScalarSize() * inputImage->GetNumberOfScalarComponents();
+    const unsigned char* inputPixel = static_cast<const unsigned char*>(inputImage->GetScalarPointer());
+    unsigned char* outputPixels = static_cast<unsigned char*>(outputImage->GetScalarPointer());
+    for (int k = 0; k < dims[2]; ++k)
+    {
+      for (int j = 0; j < dims[1]; ++j)
+      {
+        for (int i = 0; i < dims[0]; ++i)
+        {
+          memcpy(outputPixels + ((static_cast<size_t>(j) * dims[0] + i) * dims[2] + k) * pixelSize, inputPixel, pixelSize);
+          inputPixel += pixelSize;
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  bool printHelp(false);
+  int verboseLevel = vtkIGSIOLogger::LOG_LEVEL_UNDEFINED;
+  int volumeSize = 256;
+  int numberOfComponents = 1;
+  int numberOfIterations = 5;
+
+  vtksys::CommandLineArguments args;
+  args.Initialize(argc, argv);
+
+  args.AddArgument("--help", vtksys::CommandLineArguments::NO_ARGUMENT, &printHelp, "Print this help.");
+  args.AddArgument("--verbose", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &verboseLevel, "Verbose level (1=error only, 2=warning, 3=info, 4=debug, 5=trace)");
+  args.AddArgument("--volume-size", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &volumeSize, "Number of voxels along each axis of the test volume (default: 256)");
+  args.AddArgument("--number-of-components", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &numberOfComponents, "Number of scalar components of the unsigned char test volume (default: 1)");
+  args.AddArgument("--iterations", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &numberOfIterations, "Number of repetitions of each transposition (default: 5)");
+
+  if (!args.Parse())
+  {
+    std::cerr << "Problem parsing arguments" << std::endl;
+    std::cout << "Help: " << args.GetHelp() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (printHelp)
+  {
+    std::cout << args.GetHelp() << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+
+  vtkIGSIOLogger::Instance()->SetLogLevel(verboseLevel);
+
+  if (volumeSize < 1 || numberOfComponents < 1 || numberOfIterations < 1)
+  {
+    LOG_ERROR("Volume size, number of components and iterations must be positive");
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkImageData> inputImage = vtkSmartPointer<vtkImageData>::New();
+  inputImage->SetExtent(0, volumeSize - 1, 0, volumeSize - 1, 0, volumeSize - 1);
+  inputImage->AllocateScalars(VTK_UNSIGNED_CHAR, numberOfComponents);
+  unsigned char* inputPixels = static_cast<unsigned char*>(inputImage->GetScalarPointer());
+  const size_t numberOfBytes = static_cast<size_t>(volumeSize) * volumeSize * volumeSize * numberOfComponents;
+  for (size_t i = 0; i < numberOfBytes; ++i)
+  {
+    inputPixels[i] = static_cast<unsigned char>(i * 7 + i / 251);
+  }
+
+  vtkSmartPointer<vtkImageData> referenceImage = vtkSmartPointer<vtkImageData>::New();
+  double startTime = vtkIGSIOAccurateTimer::GetSystemTime();
+  for (int i = 0; i < numberOfIterations; ++i)
+  {
+    TransposeReference(inputImage, referenceImage);
+  }
+  const double referenceTimeSec = (vtkIGSIOAccurateTimer::GetSystemTime() - startTime) / numberOfIterations;
+
+  igsioVideoFrame::FlipInfoType flipInfo;
+  flipInfo.tranpose = igsioVideoFrame::TRANSPOSE_IJKtoKIJ;
+  const std::array<int, 3> noClip = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+  vtkSmartPointer<vtkImageData> outputImage = vtkSmartPointer<vtkImageData>::New();
+  startTime = vtkIGSIOAccurateTimer::GetSystemTime();
+  for (int i = 0; i < numberOfIterations; ++i)
+  {
+    if (igsioVideoFrame::FlipClipImage(inputImage, flipInfo, noClip, noClip, outputImage) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("FlipClipImage failed");
+      return EXIT_FAILURE;
+    }
+  }
+  const double blockedTimeSec = (vtkIGSIOAccurateTimer::GetSystemTime() - startTime) / numberOfIterations;
+
+  int referenceDims[3] = { 0, 0, 0 };
+  int outputDims[3] = { 0, 0, 0 };
+  referenceImage->GetDimensions(referenceDims);
+  outputImage->GetDimensions(outputDims);
+  if (referenceDims[0] != outputDims[0] || referenceDims[1] != outputDims[1] || referenceDims[2] != outputDims[2]
+      || memcmp(referenceImage->GetScalarPointer(), outputImage->GetScalarPointer(), numberOfBytes) != 0)
+  {
+    LOG_ERROR("Blocked transposition result differs from the reference result");
+    return EXIT_FAILURE;
+  }
+
+  LOG_INFO("Transposition of a " << volumeSize << "^3 volume with " << numberOfComponents << " components: reference " << referenceTimeSec * 1000.0
+           << " ms, blocked " << blockedTimeSec * 1000.0 << " ms, speedup " << (blockedTimeSec > 0 ? referenceTimeSec / blockedTimeSec : 0.0) << "x");
+  return EXIT_SUCCESS;
+}
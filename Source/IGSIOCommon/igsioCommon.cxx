@@ -11,11 +11,21 @@ See License.txt for details.
 #include "vtkIGSIOAccurateTimer.h"
 
 // VTK includes
+#include <vtkImageData.h>
+#include <vtkMultiThreader.h>
+#include <vtkSmartPointer.h>
 #include <vtkXMLDataElement.h>
 #include <vtksys/SystemTools.hxx>
 
 // STL includes
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <limits>
 
@@ -25,6 +35,26 @@ See License.txt for details.
   #include <linux/limits.h>
 #endif
 
+#if defined(_MSC_VER) && _MSC_VER < 1900
+  // The buffers are always large enough, so the missing zero termination on truncation does not matter
+  #define snprintf _snprintf
+#endif
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Decimal separator used by printf and strtod in the current C locale
+  char GetLocaleDecimalPoint()
+  {
+    const struct lconv* localeConventions = localeconv();
+    if (localeConventions == NULL || localeConventions->decimal_point == NULL || localeConventions->decimal_point[0] == 0)
+    {
+      return '.';
+    }
+    return localeConventions->decimal_point[0];
+  }
+}
+
 //-------------------------------------------------------
 bool vtkIGSIOLogHelper::ShouldWeLog(bool errorPresent)
 {
@@ -385,6 +415,91 @@ std::string igsioCommon::Tail(const std::string& source, const std::string::size
 }
 
 
+//----------------------------------------------------------------------------
+int igsioCommon::FormatDouble(double value, char* buffer)
+{
+  // %g drops trailing zeros, so the first precision that reads back to the same value gives the shortest
+  // representation. 17 significant digits are always sufficient for a double.
+  int length = 0;
+  for (int precision = 15; precision <= 17; ++precision)
+  {
+    length = snprintf(buffer, DOUBLE_STRING_BUFFER_SIZE, "%.*g", precision, value);
+    if (!std::isfinite(value) || strtod(buffer, NULL) == value)
+    {
+      break;
+    }
+  }
+
+  const char decimalPoint = GetLocaleDecimalPoint();
+  if (decimalPoint != '.')
+  {
+    char* separator = strchr(buffer, decimalPoint);
+    if (separator != NULL)
+    {
+      *separator = '.';
+    }
+  }
+  return length;
+}
+
+//----------------------------------------------------------------------------
+void igsioCommon::AppendDouble(std::string& str, double value)
+{
+  char buffer[DOUBLE_STRING_BUFFER_SIZE];
+  const int length = FormatDouble(value, buffer);
+  str.append(buffer, length);
+}
+
+//----------------------------------------------------------------------------
+double igsioCommon::ParseDouble(const char* str, const char** endPtr)
+{
+  char* end = NULL;
+  const char decimalPoint = GetLocaleDecimalPoint();
+  if (decimalPoint == '.')
+  {
+    const double value = strtod(str, &end);
+    if (endPtr != NULL)
+    {
+      *endPtr = end;
+    }
+    return value;
+  }
+
+  // Copy the number to a local buffer, replacing '.' by the decimal separator that strtod expects
+  const int MAX_NUMBER_LENGTH = 64;
+  char buffer[MAX_NUMBER_LENGTH];
+  const char* start = str;
+  while (isspace(static_cast<unsigned char>(*start)))
+  {
+    ++start;
+  }
+  int length = 0;
+  for (; length < MAX_NUMBER_LENGTH - 1; ++length)
+  {
+    const char c = start[length];
+    if (c == '.')
+    {
+      buffer[length] = decimalPoint;
+    }
+    else if (isalnum(static_cast<unsigned char>(c)) || c == '+' || c == '-')
+    {
+      buffer[length] = c;
+    }
+    else
+    {
+      break;
+    }
+  }
+  buffer[length] = 0;
+
+  const double value = strtod(buffer, &end);
+  if (endPtr != NULL)
+  {
+    *endPtr = (end == buffer ? str : start + (end - buffer));
+  }
+  return value;
+}
+
 //-------------------------------------------------------
 std::string igsioCommon::Trim(const std::string& str)
 {
@@ -579,6 +694,175 @@ VTKIGSIOCOMMON_EXPORT std::vector<std::string> igsioCommon::SplitStringIntoToken
   return tokens;
 }
 
+namespace
+{
+  // Number of threads used by DrawScanLines on tracked frame lists, 0 means vtkMultiThreader default
+  std::atomic<int> DrawScanLinesNumberOfThreads(1);
+
+  //----------------------------------------------------------------------------
+  // Writes the line colour into pixels of a typed image, NumberOfValues is the number of components written per pixel
+  template<typename T, int NumberOfValues>
+  struct LinePixelWriter
+  {
+    T* Scalars;
+    vtkIdType Increments[3];
+    int Extent[6];
+    T Values[NumberOfValues];
+
+    void operator()(int x, int y, int z) const
+    {
+      if (x < this->Extent[0] || x > this->Extent[1] || y < this->Extent[2] || y > this->Extent[3] || z < this->Extent[4] || z > this->Extent[5])
+      {
+        // outside of the image extent
+        return;
+      }
+      T* pixel = this->Scalars + (x - this->Extent[0]) * this->Increments[0] + (y - this->Extent[2]) * this->Increments[1] + (z - this->Extent[4]) * this->Increments[2];
+      for (int component = 0; component < NumberOfValues; ++component)
+      {
+        pixel[component] = this->Values[component];
+      }
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  // Visit every voxel of a connected line between the two points (3D Bresenham, all octants)
+  template<typename PixelWriter>
+  void RasterizeSolidLine(const igsioCommon::PixelPoint& startPixel, const igsioCommon::PixelPoint& endPixel, const PixelWriter& writer)
+  {
+    const int dx = std::abs(endPixel[0] - startPixel[0]);
+    const int dy = std::abs(endPixel[1] - startPixel[1]);
+    const int dz = std::abs(endPixel[2] - startPixel[2]);
+    const int sx = (endPixel[0] >= startPixel[0]) ? 1 : -1;
+    const int sy = (endPixel[1] >= startPixel[1]) ? 1 : -1;
+    const int sz = (endPixel[2] >= startPixel[2]) ? 1 : -1;
+    const int dm = std::max(dx, std::max(dy, dz));
+    int x = startPixel[0];
+    int y = startPixel[1];
+    int z = startPixel[2];
+    int errorX = dm / 2;
+    int errorY = dm / 2;
+    int errorZ = dm / 2;
+    for (int step = 0; step <= dm; ++step)
+    {
+      writer(x, y, z);
+      errorX -= dx;
+      if (errorX < 0)
+      {
+        errorX += dm;
+        x += sx;
+      }
+      errorY -= dy;
+      if (errorY < 0)
+      {
+        errorY += dm;
+        y += sy;
+      }
+      errorZ -= dz;
+      if (errorZ < 0)
+      {
+        errorZ += dm;
+        z += sz;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Visit numberOfPoints evenly spaced points between the two points (numberOfPoints >= 2)
+  template<typename PixelWriter>
+  void RasterizeDottedLine(const igsioCommon::PixelPoint& startPixel, const igsioCommon::PixelPoint& endPixel, unsigned int numberOfPoints, const PixelWriter& writer)
+  {
+    const double directionVectorX = static_cast<double>(endPixel[0] - startPixel[0]) / (numberOfPoints - 1);
+    const double directionVectorY = static_cast<double>(endPixel[1] - startPixel[1]) / (numberOfPoints - 1);
+    const double directionVectorZ = static_cast<double>(endPixel[2] - startPixel[2]) / (numberOfPoints - 1);
+    for (unsigned int point = 0; point < numberOfPoints; ++point)
+    {
+      writer(static_cast<int>(startPixel[0] + directionVectorX * point),
+             static_cast<int>(startPixel[1] + directionVectorY * point),
+             static_cast<int>(startPixel[2] + directionVectorZ * point));
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T, int NumberOfValues>
+  void DrawLineTyped(vtkImageData& imageData, const std::array<float, 3>& colour, igsioCommon::LINE_STYLE style,
+                     const igsioCommon::PixelPoint& startPixel, const igsioCommon::PixelPoint& endPixel, unsigned int numberOfPoints)
+  {
+    LinePixelWriter<T, NumberOfValues> writer;
+    writer.Scalars = static_cast<T*>(imageData.GetScalarPointer());
+    imageData.GetIncrements(writer.Increments);
+    imageData.GetExtent(writer.Extent);
+    for (int component = 0; component < std::min(NumberOfValues, 3); ++component)
+    {
+      writer.Values[component] = static_cast<T>(colour[component]);
+    }
+    if (NumberOfValues > 3)
+    {
+      // TODO : is a component value from [0,1]?
+      writer.Values[NumberOfValues - 1] = static_cast<T>(1.f);
+    }
+
+    if (style == igsioCommon::LINE_STYLE_SOLID)
+    {
+      RasterizeSolidLine(startPixel, endPixel, writer);
+    }
+    else
+    {
+      RasterizeDottedLine(startPixel, endPixel, numberOfPoints, writer);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T>
+  void DrawLineTyped(vtkImageData& imageData, const std::array<float, 3>& colour, igsioCommon::LINE_STYLE style,
+                     const igsioCommon::PixelPoint& startPixel, const igsioCommon::PixelPoint& endPixel, unsigned int numberOfPoints, int numberOfValues)
+  {
+    switch (numberOfValues)
+    {
+      case 1:
+        DrawLineTyped<T, 1>(imageData, colour, style, startPixel, endPixel, numberOfPoints);
+        break;
+      case 2:
+        DrawLineTyped<T, 2>(imageData, colour, style, startPixel, endPixel, numberOfPoints);
+        break;
+      case 3:
+        DrawLineTyped<T, 3>(imageData, colour, style, startPixel, endPixel, numberOfPoints);
+        break;
+      default:
+        DrawLineTyped<T, 4>(imageData, colour, style, startPixel, endPixel, numberOfPoints);
+        break;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  struct DrawScanLinesThreadData
+  {
+    const std::vector<vtkImageData*>* Images;
+    int* InputImageExtent;
+    std::array<float, 3> Colour;
+    const igsioCommon::PixelLineList* ScanLineEndPoints;
+    std::vector<igsioStatus> ThreadStatus;
+  };
+
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE DrawScanLinesThreadFunction(void* arg)
+  {
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    DrawScanLinesThreadData* data = static_cast<DrawScanLinesThreadData*>(info->UserData);
+    igsioStatus status = IGSIO_SUCCESS;
+    // Interleave the frames between threads, each frame is drawn on a single thread
+    for (size_t i = info->ThreadID; i < data->Images->size(); i += info->NumberOfThreads)
+    {
+      if (igsioCommon::DrawScanLines(data->InputImageExtent, data->Colour, *data->ScanLineEndPoints, (*data->Images)[i]) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to draw scan lines on frame " << i);
+        status = IGSIO_FAIL;
+      }
+    }
+    data->ThreadStatus[info->ThreadID] = status;
+    return VTK_THREAD_RETURN_VALUE;
+  }
+}
+
 //----------------------------------------------------------------------------
 igsioStatus igsioCommon::DrawLine(vtkImageData& imageData, const std::array<float, 3>& colour, LINE_STYLE style,
                                   const std::array<int, 3>& startPixel, const std::array<int, 3>& endPixel,
@@ -620,45 +904,38 @@ igsioStatus igsioCommon::DrawLine(vtkImageData& imageData, const std::array<floa
     return IGSIO_FAIL;
   }
 
-  if (style == LINE_STYLE_SOLID)
+  if (style != LINE_STYLE_SOLID && numberOfPoints < 2)
   {
-    numberOfPoints = std::max(endPixel[0] - startPixel[0], endPixel[1] - startPixel[1]) + 1;
+    LOG_ERROR("Unable to draw a line with less than 1 point!");
+    return IGSIO_FAIL;
   }
-  else if (numberOfPoints < 2)
+
+  if (imageData.GetScalarPointer() == NULL)
   {
-    LOG_ERROR("Unable to draw a line with less than 1 point!");
+    LOG_ERROR("Unable to draw a line. Image has no pixel data.");
     return IGSIO_FAIL;
   }
 
-  int* extent = imageData.GetExtent();
-  double directionVectorX = static_cast<double>(endPixel[0] - startPixel[0]) / (numberOfPoints - 1);
-  double directionVectorY = static_cast<double>(endPixel[1] - startPixel[1]) / (numberOfPoints - 1);
-  double directionVectorZ = static_cast<double>(endPixel[2] - startPixel[2]) / (numberOfPoints - 1);
-  for (unsigned int point = 0; point < numberOfPoints; ++point)
+  const int numberOfScalarComponents = imageData.GetNumberOfScalarComponents();
+  if (numberOfScalarComponents < 1)
   {
-    unsigned int pixelCoordX = startPixel[0] + directionVectorX * point;
-    unsigned int pixelCoordY = startPixel[1] + directionVectorY * point;
-    unsigned int pixelCoordZ = startPixel[2] + directionVectorZ * point;
+    LOG_ERROR("Unable to draw a line. Invalid number of scalar components: " << numberOfScalarComponents);
+    return IGSIO_FAIL;
+  }
 
-    for (int component = 0; component < std::min(imageData.GetNumberOfScalarComponents(), 3); ++component)
-    {
-      if (pixelCoordX < static_cast<unsigned int>(extent[0]) || pixelCoordX > static_cast<unsigned int>(extent[1]) || pixelCoordY < static_cast<unsigned int>(extent[2]) || pixelCoordY > static_cast<unsigned int>(extent[3]))
-      {
-        // outside of the specified extent
-        continue;
-      }
-      imageData.SetScalarComponentFromFloat(pixelCoordX, pixelCoordY, pixelCoordZ, component, colour[component]);
-    }
-    if (imageData.GetNumberOfScalarComponents() > 3 && alphaBehavior == ALPHA_BEHAVIOR_OPAQUE)
-    {
-      if (pixelCoordX < static_cast<unsigned int>(extent[0]) || pixelCoordX > static_cast<unsigned int>(extent[1]) || pixelCoordY < static_cast<unsigned int>(extent[2]) || pixelCoordY > static_cast<unsigned int>(extent[3]))
-      {
-        // outside of the specified extent
-        continue;
-      }
-      // TODO : is a component value from [0,1]?
-      imageData.SetScalarComponentFromFloat(pixelCoordX, pixelCoordY, pixelCoordZ, 3, 1.f);
-    }
+  // Colour components are written to the first 3 components, alpha is written to the 4th if opaque
+  int numberOfValues = std::min(numberOfScalarComponents, 3);
+  if (numberOfScalarComponents > 3 && alphaBehavior == ALPHA_BEHAVIOR_OPAQUE)
+  {
+    numberOfValues = 4;
+  }
+
+  switch (imageData.GetScalarType())
+  {
+    vtkTemplateMacro(DrawLineTyped<VTK_TT>(imageData, colour, style, startPixel, endPixel, numberOfPoints, numberOfValues));
+    default:
+      LOG_ERROR("Unable to draw a line. Unsupported scalar type: " << imageData.GetScalarTypeAsString());
+      return IGSIO_FAIL;
   }
 
   return IGSIO_SUCCESS;
@@ -868,15 +1145,77 @@ VTKIGSIOCOMMON_EXPORT igsioStatus igsioCommon::DrawScanLines(int* inputImageExte
 {
   LOG_DEBUG("Processing " << trackedFrameList->GetNumberOfTrackedFrames() << " frames...");
 
-  igsioStatus result(IGSIO_SUCCESS);
+  // Get the images for writing on the calling thread. GetImage makes a private copy of pixel buffers that are
+  // shared with other frames or external, so the threads only write into buffers owned by the frames of this list.
+  std::vector<vtkImageData*> images;
+  images.reserve(trackedFrameList->GetNumberOfTrackedFrames());
   for (unsigned int frameIndex = 0; frameIndex < trackedFrameList->GetNumberOfTrackedFrames(); frameIndex++)
   {
-    LOG_DEBUG("Processing frame " << frameIndex);
-    igsioTrackedFrame* frame = trackedFrameList->GetTrackedFrame(frameIndex);
-    igsioCommon::DrawScanLines(inputImageExtent, colour, scanLineEndPoints, frame->GetImageData()->GetImage());
+    vtkImageData* image = trackedFrameList->GetTrackedFrame(frameIndex)->GetImageData()->GetImage();
+    if (image == NULL)
+    {
+      LOG_ERROR("Unable to draw scan lines. Frame " << frameIndex << " has no image data.");
+      return IGSIO_FAIL;
+    }
+    images.push_back(image);
+  }
+  if (images.empty())
+  {
+    return IGSIO_SUCCESS;
   }
 
-  return result;
+  int numberOfThreads = DrawScanLinesNumberOfThreads.load();
+  if (numberOfThreads <= 0)
+  {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  }
+  numberOfThreads = std::max(1, std::min(numberOfThreads, static_cast<int>(std::min<size_t>(images.size(), VTK_MAX_THREADS))));
+
+  if (numberOfThreads == 1)
+  {
+    igsioStatus result(IGSIO_SUCCESS);
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+      if (igsioCommon::DrawScanLines(inputImageExtent, colour, scanLineEndPoints, images[i]) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to draw scan lines on frame " << i);
+        result = IGSIO_FAIL;
+      }
+    }
+    return result;
+  }
+
+  DrawScanLinesThreadData threadData;
+  threadData.Images = &images;
+  threadData.InputImageExtent = inputImageExtent;
+  threadData.Colour = colour;
+  threadData.ScanLineEndPoints = &scanLineEndPoints;
+  threadData.ThreadStatus.resize(numberOfThreads, IGSIO_FAIL);
+  vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(DrawScanLinesThreadFunction, &threadData);
+  threader->SingleMethodExecute();
+
+  for (std::vector<igsioStatus>::iterator it = threadData.ThreadStatus.begin(); it != threadData.ThreadStatus.end(); ++it)
+  {
+    if (*it != IGSIO_SUCCESS)
+    {
+      return IGSIO_FAIL;
+    }
+  }
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void igsioCommon::SetDrawScanLinesNumberOfThreads(int numberOfThreads)
+{
+  DrawScanLinesNumberOfThreads = numberOfThreads;
+}
+
+//----------------------------------------------------------------------------
+int igsioCommon::GetDrawScanLinesNumberOfThreads()
+{
+  return DrawScanLinesNumberOfThreads.load();
 }
 
 //----------------------------------------------------------------------------
@@ -408,18 +408,41 @@ namespace igsioCommon
   typedef int VTKScalarPixelType;
   typedef int IGTLScalarPixelType;
 
+  //----------------------------------------------------------------------------
+  /*! Size of a buffer that can hold any string written by FormatDouble, including the terminating zero */
+  static const int DOUBLE_STRING_BUFFER_SIZE = 32;
+
+  /*!
+    Write the shortest decimal representation of value that is parsed back to exactly the same number
+    (e.g., 0.1 is written as "0.1", 0.1+0.2 as "0.30000000000000004"). The decimal separator is always '.',
+    regardless of the current locale. Does not allocate memory. Subnormal numbers may be written with more digits
+    than necessary, but they are still parsed back to the same number.
+    \param buffer Output buffer, must be at least DOUBLE_STRING_BUFFER_SIZE characters long
+    \return Number of characters written, not including the terminating zero
+  */
+  VTKIGSIOCOMMON_EXPORT int FormatDouble(double value, char* buffer);
+
+  /*! Append the shortest representation of value that is parsed back to the same number (see FormatDouble) */
+  VTKIGSIOCOMMON_EXPORT void AppendDouble(std::string& str, double value);
+
+  /*!
+    Locale-independent strtod: the decimal separator is always '.', regardless of the current locale.
+    \param endPtr If not NULL, set to the first character after the parsed number (to str if no number is found)
+  */
+  VTKIGSIOCOMMON_EXPORT double ParseDouble(const char* str, const char** endPtr);
+
   //----------------------------------------------------------------------------
   /*! Quick and robust string to int conversion */
   template<class T>
   igsioStatus StringToInt(const char* strPtr, T& result)
   {
-    if (strPtr == NULL || strlen(strPtr) == 0)
+    if (strPtr == NULL || *strPtr == 0)
     {
       return IGSIO_FAIL;
     }
     char* pEnd = NULL;
     result = static_cast<int>(strtol(strPtr, &pEnd, 10));
-    if (pEnd != strPtr + strlen(strPtr))
+    if (*pEnd != 0)
     {
       return IGSIO_FAIL;
     }
@@ -431,13 +454,13 @@ namespace igsioCommon
   template<class T>
   igsioStatus StringToUInt(const char* strPtr, T& result)
   {
-    if (strPtr == NULL || strlen(strPtr) == 0)
+    if (strPtr == NULL || *strPtr == 0)
     {
       return IGSIO_FAIL;
     }
     char* pEnd = NULL;
     result = static_cast<unsigned int>(strtol(strPtr, &pEnd, 10));
-    if (pEnd != strPtr + strlen(strPtr))
+    if (*pEnd != 0)
     {
       return IGSIO_FAIL;
     }
@@ -445,17 +468,17 @@ namespace igsioCommon
   }
 
   //----------------------------------------------------------------------------
-  /*! Quick and robust string to double conversion */
+  /*! Quick and robust string to double conversion, independent of the current locale (see ParseDouble) */
   template<class T>
   igsioStatus StringToDouble(const char* strPtr, T& result)
   {
-    if (strPtr == NULL || strlen(strPtr) == 0)
+    if (strPtr == NULL || *strPtr == 0)
     {
       return IGSIO_FAIL;
     }
-    char* pEnd = NULL;
-    result = strtod(strPtr, &pEnd);
-    if (pEnd != strPtr + strlen(strPtr))
+    const char* pEnd = NULL;
+    result = ParseDouble(strPtr, &pEnd);
+    if (*pEnd != 0)
     {
       return IGSIO_FAIL;
     }
@@ -480,13 +503,13 @@ namespace igsioCommon
   template<class T>
   igsioStatus StringToLong(const char* strPtr, T& result)
   {
-    if (strPtr == NULL || strlen(strPtr) == 0)
+    if (strPtr == NULL || *strPtr == 0)
     {
       return IGSIO_FAIL;
     }
     char* pEnd = NULL;
     result = strtol(strPtr, &pEnd, 10);
-    if (pEnd != strPtr + strlen(strPtr))
+    if (*pEnd != 0)
     {
       return IGSIO_FAIL;
     }
@@ -507,6 +530,10 @@ namespace igsioCommon
   };
 
   //----------------------------------------------------------------------------
+  /*!
+  Draw a line into the image. Solid lines set every pixel between the end points (Bresenham),
+  dotted lines set numberOfPoints evenly spaced pixels. Pixels outside of the image extent are skipped.
+  */
   VTKIGSIOCOMMON_EXPORT igsioStatus DrawLine(vtkImageData& imageData,
       const std::array<float, 3>& colour,
       LINE_STYLE style,
@@ -539,6 +566,13 @@ namespace igsioCommon
   VTKIGSIOCOMMON_EXPORT igsioStatus DrawScanLines(int* inputImageExtent, float greyValue, const PixelLineList& scanLineEndPoints, vtkImageData* imageData);
   VTKIGSIOCOMMON_EXPORT igsioStatus DrawScanLines(int* inputImageExtent, const std::array<float, 3>& colour, const PixelLineList& scanLineEndPoints, vtkImageData* imageData);
 
+  /*!
+  Set the maximum number of threads used by DrawScanLines on tracked frame lists, each frame is drawn on a single thread.
+  1 (default) draws all frames on the calling thread, 0 uses the number of processors.
+  */
+  VTKIGSIOCOMMON_EXPORT void SetDrawScanLinesNumberOfThreads(int numberOfThreads);
+  VTKIGSIOCOMMON_EXPORT int GetDrawScanLinesNumberOfThreads();
+
   //----------------------------------------------------------------------------
   template<typename T>
   static std::string ToString(T number)
@@ -0,0 +1,140 @@
+/*=Plus=header=begin======================================================
+  Program: Plus
+  Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+  See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioCpuFeatures.h"
+
+// STL includes
+#include <atomic>
+
+#if defined(IGSIO_SIMD_X86)
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
+
+namespace
+{
+  std::atomic<int> MaximumInstructionSet(igsioCpuFeatures::INSTRUCTION_SET_AVX2);
+
+#if defined(IGSIO_SIMD_X86)
+  //----------------------------------------------------------------------------
+  void CpuId(int leaf, int subLeaf, unsigned int regs[4])
+  {
+#if defined(_MSC_VER)
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuidex(info, leaf, subLeaf);
+    for (int i = 0; i < 4; ++i)
+    {
+      regs[i] = static_cast<unsigned int>(info[i]);
+    }
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  // Returns the XCR0 register, which tells which register states the operating system saves on context switch
+  unsigned long long GetXCR0()
+  {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+  }
+#endif
+
+  //----------------------------------------------------------------------------
+  igsioCpuFeatures::InstructionSet DetectInstructionSet()
+  {
+#if defined(IGSIO_SIMD_X86)
+    unsigned int regs[4] = { 0, 0, 0, 0 };
+    CpuId(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+    if (maxLeaf < 1)
+    {
+      return igsioCpuFeatures::INSTRUCTION_SET_SCALAR;
+    }
+
+    CpuId(1, 0, regs);
+    const bool hasSSE2 = (regs[3] & (1u << 26)) != 0;
+    const bool hasSSSE3 = (regs[2] & (1u << 9)) != 0;
+    const bool hasOSXSAVE = (regs[2] & (1u << 27)) != 0;
+    const bool hasAVX = (regs[2] & (1u << 28)) != 0;
+    if (!hasSSE2)
+    {
+      return igsioCpuFeatures::INSTRUCTION_SET_SCALAR;
+    }
+    if (!hasSSSE3)
+    {
+      return igsioCpuFeatures::INSTRUCTION_SET_SSE2;
+    }
+
+    // AVX2 requires that the OS saves the YMM registers (XCR0 bits 1 and 2)
+    bool hasAVX2 = false;
+    if (maxLeaf >= 7 && hasOSXSAVE && hasAVX && (GetXCR0() & 0x6) == 0x6)
+    {
+      CpuId(7, 0, regs);
+      hasAVX2 = (regs[1] & (1u << 5)) != 0;
+    }
+    return hasAVX2 ? igsioCpuFeatures::INSTRUCTION_SET_AVX2 : igsioCpuFeatures::INSTRUCTION_SET_SSSE3;
+#else
+    return igsioCpuFeatures::INSTRUCTION_SET_SCALAR;
+#endif
+  }
+}
+
+//----------------------------------------------------------------------------
+igsioCpuFeatures::InstructionSet igsioCpuFeatures::GetDetectedInstructionSet()
+{
+  static const InstructionSet detectedInstructionSet = DetectInstructionSet();
+  return detectedInstructionSet;
+}
+
+//----------------------------------------------------------------------------
+igsioCpuFeatures::InstructionSet igsioCpuFeatures::GetInstructionSet()
+{
+  const InstructionSet detected = GetDetectedInstructionSet();
+  const InstructionSet maximum = static_cast<InstructionSet>(MaximumInstructionSet.load());
+  return detected < maximum ? detected : maximum;
+}
+
+//----------------------------------------------------------------------------
+void igsioCpuFeatures::SetMaximumInstructionSet(InstructionSet instructionSet)
+{
+  MaximumInstructionSet.store(instructionSet);
+}
+
+//----------------------------------------------------------------------------
+igsioCpuFeatures::InstructionSet igsioCpuFeatures::GetMaximumInstructionSet()
+{
+  return static_cast<InstructionSet>(MaximumInstructionSet.load());
+}
+
+//----------------------------------------------------------------------------
+std::string igsioCpuFeatures::GetInstructionSetAsString(InstructionSet instructionSet)
+{
+  switch (instructionSet)
+  {
+    case INSTRUCTION_SET_SCALAR:
+      return "Scalar";
+    case INSTRUCTION_SET_SSE2:
+      return "SSE2";
+    case INSTRUCTION_SET_SSSE3:
+      return "SSSE3";
+    case INSTRUCTION_SET_AVX2:
+      return "AVX2";
+    default:
+      return "Unknown";
+  }
+}
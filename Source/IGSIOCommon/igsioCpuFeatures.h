@@ -0,0 +1,66 @@
+/*=Plus=header=begin======================================================
+  Program: Plus
+  Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+  See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioCpuFeatures_h
+#define __igsioCpuFeatures_h
+
+#include "vtkigsiocommon_export.h"
+
+#include <string>
+
+// Compiler support for x86 SIMD intrinsics. Kernels that use them are compiled for the
+// requested instruction set only (function target attributes), and selected at runtime
+// using igsioCpuFeatures, so the library still runs on CPUs without these extensions.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+  #define IGSIO_SIMD_X86
+  #if defined(_MSC_VER) && !defined(__clang__)
+    #define IGSIO_TARGET_SSE2
+    #define IGSIO_TARGET_SSSE3
+    #define IGSIO_TARGET_AVX2
+  #else
+    #define IGSIO_TARGET_SSE2 __attribute__((target("sse2")))
+    #define IGSIO_TARGET_SSSE3 __attribute__((target("ssse3")))
+    #define IGSIO_TARGET_AVX2 __attribute__((target("avx2")))
+  #endif
+#endif
+
+/*!
+  \class igsioCpuFeatures
+  \brief Runtime detection of the SIMD instruction sets supported by the CPU
+
+  Vectorized image processing kernels query GetInstructionSet() to choose an implementation.
+  SetMaximumInstructionSet() can be used to limit the selection (e.g., to compare vectorized
+  results with the scalar implementation in tests or benchmarks).
+
+  \ingroup igsioCommon
+*/
+class VTKIGSIOCOMMON_EXPORT igsioCpuFeatures
+{
+public:
+  /*! Instruction sets in increasing order of capability. Each level implies all previous ones. */
+  enum InstructionSet
+  {
+    INSTRUCTION_SET_SCALAR,
+    INSTRUCTION_SET_SSE2,
+    INSTRUCTION_SET_SSSE3,
+    INSTRUCTION_SET_AVX2
+  };
+
+  /*! Return the highest instruction set supported by the CPU and the operating system */
+  static InstructionSet GetDetectedInstructionSet();
+
+  /*! Return the instruction set that kernels should use (detected set, limited by the maximum instruction set) */
+  static InstructionSet GetInstructionSet();
+
+  /*! Limit the instruction set that kernels may use. Set to INSTRUCTION_SET_AVX2 to remove the limit. */
+  static void SetMaximumInstructionSet(InstructionSet instructionSet);
+  static InstructionSet GetMaximumInstructionSet();
+
+  /*! Return a human readable name of an instruction set */
+  static std::string GetInstructionSetAsString(InstructionSet instructionSet);
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioCommon.h"
+#include "igsioFieldNameTable.h"
+#include "igsioTrackedFrame.h"
+
+// STL includes
+#include <cstring>
+#include <limits>
+
+const igsioFieldNameId igsioFieldNameTable::INVALID_ID = std::numeric_limits<igsioFieldNameId>::max();
+const unsigned int igsioFieldNameTable::MAXIMUM_NUMBER_OF_NAMES = 65536;
+
+//----------------------------------------------------------------------------
+size_t igsioFieldNameTable::CStringHash::operator()(const char* str) const
+{
+  // FNV-1a, field names are short so a simple byte-wise hash is sufficient
+  size_t hash = static_cast<size_t>(2166136261u);
+  for (; *str != 0; ++str)
+  {
+    hash = (hash ^ static_cast<unsigned char>(*str)) * static_cast<size_t>(16777619u);
+  }
+  return hash;
+}
+
+//----------------------------------------------------------------------------
+bool igsioFieldNameTable::CStringEqual::operator()(const char* a, const char* b) const
+{
+  return strcmp(a, b) == 0;
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameTable* igsioFieldNameTable::GetInstance()
+{
+  static igsioFieldNameTable instance;
+  return &instance;
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameTable::igsioFieldNameTable()
+{
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameTable::~igsioFieldNameTable()
+{
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameId igsioFieldNameTable::Intern(const std::string& name)
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> tableGuard(&this->CriticalSection);
+  return this->InternInternal(name);
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameId igsioFieldNameTable::InternInternal(const std::string& name)
+{
+  IdMapType::const_iterator idIterator = this->Ids.find(name.c_str());
+  if (idIterator != this->Ids.end())
+  {
+    return idIterator->second;
+  }
+
+  // Status names are interned together with their transform name
+  static const std::string statusPostfix = igsioTrackedFrame::TransformStatusPostfix.substr(igsioTrackedFrame::TransformPostfix.length());
+  if (igsioTrackedFrame::IsTransformStatus(name))
+  {
+    const igsioFieldNameId transformFieldId = this->InternInternal(name.substr(0, name.length() - statusPostfix.length()));
+    if (transformFieldId == INVALID_ID)
+    {
+      return INVALID_ID;
+    }
+    idIterator = this->Ids.find(name.c_str());
+    if (idIterator != this->Ids.end())
+    {
+      return idIterator->second;
+    }
+    // The postfix of the name differs in letter case from the status name interned with the transform
+    return this->AddEntries(name, transformFieldId, std::string());
+  }
+
+  if (igsioTrackedFrame::IsTransform(name))
+  {
+    return this->AddEntries(name, static_cast<igsioFieldNameId>(this->Entries.size()), name + statusPostfix);
+  }
+  return this->AddEntries(name, INVALID_ID, std::string());
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameId igsioFieldNameTable::AddEntries(const std::string& name, igsioFieldNameId transformFieldId, const std::string& statusName)
+{
+  const size_t numberOfNewEntries = (statusName.empty() ? 1 : 2);
+  if (this->Entries.size() + numberOfNewEntries > MAXIMUM_NUMBER_OF_NAMES)
+  {
+    LOG_ERROR("Failed to intern field name " << name << " - the field name table is full (" << this->Entries.size() << " names)");
+    return INVALID_ID;
+  }
+
+  const igsioFieldNameId newId = static_cast<igsioFieldNameId>(this->Entries.size());
+  NameEntry entry;
+  entry.Name = name;
+  entry.TransformFieldId = transformFieldId;
+  this->Entries.push_back(entry);
+  this->Ids[this->Entries.back().Name.c_str()] = newId;
+  if (!statusName.empty())
+  {
+    entry.Name = statusName;
+    this->Entries.push_back(entry);
+    this->Ids[this->Entries.back().Name.c_str()] = newId + 1;
+  }
+  return newId;
+}
+
+//----------------------------------------------------------------------------
+bool igsioFieldNameTable::Find(const char* name, igsioFieldNameId& id) const
+{
+  if (name == NULL)
+  {
+    return false;
+  }
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> tableGuard(&this->CriticalSection);
+  IdMapType::const_iterator idIterator = this->Ids.find(name);
+  if (idIterator == this->Ids.end())
+  {
+    return false;
+  }
+  id = idIterator->second;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+const std::string& igsioFieldNameTable::GetName(igsioFieldNameId id) const
+{
+  static const std::string EMPTY_NAME;
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> tableGuard(&this->CriticalSection);
+  if (id >= this->Entries.size())
+  {
+    LOG_ERROR("Invalid field name identifier: " << id);
+    return EMPTY_NAME;
+  }
+  return this->Entries[id].Name;
+}
+
+//----------------------------------------------------------------------------
+igsioFieldNameId igsioFieldNameTable::GetTransformFieldId(igsioFieldNameId id) const
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> tableGuard(&this->CriticalSection);
+  if (id >= this->Entries.size())
+  {
+    return INVALID_ID;
+  }
+  return this->Entries[id].TransformFieldId;
+}
+
+//----------------------------------------------------------------------------
+unsigned int igsioFieldNameTable::GetNumberOfNames() const
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> tableGuard(&this->CriticalSection);
+  return static_cast<unsigned int>(this->Entries.size());
+}
@@ -0,0 +1,117 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioFieldNameTable_h
+#define __igsioFieldNameTable_h
+
+#include "vtkigsiocommon_export.h"
+#include "vtkIGSIORecursiveCriticalSection.h"
+
+// STL includes
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+/*! Compact identifier of an interned frame field name, see igsioFieldNameTable */
+typedef unsigned int igsioFieldNameId;
+
+/*!
+\class igsioFieldNameTable
+\brief Process-wide table of interned frame field names
+
+Tracked frames of a sequence usually share the same few dozen field names (Timestamp, ProbeToTrackerTransform,
+ProbeToTrackerTransformStatus, ...). Instead of storing the name strings in every frame, frames store the
+identifier of the name in this table. Identifiers are assigned in the order the names are first interned,
+they are valid for the lifetime of the process and are never reused. Names are never removed from the table,
+so the number of names is limited (see MAXIMUM_NUMBER_OF_NAMES) to prevent field names of untrusted input
+(e.g., files or network messages) from growing the table without bound.
+
+Transform names are classified when they are interned: the table stores for each name the identifier of the
+transform field it belongs to (the name itself for ...Transform fields, the name without the Status postfix for
+...TransformStatus fields), so frames do not need to compare strings to find the transform of a field.
+A transform name and its status name are always interned together, so the status field of a transform
+can be found even if only the transform (or only the status) was set.
+
+All methods are thread-safe.
+\ingroup igsioCommon
+*/
+class VTKIGSIOCOMMON_EXPORT igsioFieldNameTable
+{
+public:
+  /*! Identifier returned for names that are not (or not related to) an interned name */
+  static const igsioFieldNameId INVALID_ID;
+
+  /*! Maximum number of names in a table, Intern fails if adding a name would exceed it */
+  static const unsigned int MAXIMUM_NUMBER_OF_NAMES;
+
+  /*! Get the table used by igsioTrackedFrame */
+  static igsioFieldNameTable* GetInstance();
+
+  /*! Constructor */
+  igsioFieldNameTable();
+
+  /*! Destructor */
+  virtual ~igsioFieldNameTable();
+
+  /*!
+  Get the identifier of a name, adds the name to the table if it is not interned yet.
+  \return INVALID_ID if the name is not interned yet and the table is full
+  */
+  igsioFieldNameId Intern(const std::string& name);
+
+  /*!
+  Get the identifier of a name without adding it to the table. Use this for queries, so that looking up
+  undefined fields does not grow the table.
+  \return true if the name is interned
+  */
+  bool Find(const char* name, igsioFieldNameId& id) const;
+
+  /*! Get the name of an identifier. The returned reference remains valid for the lifetime of the table. */
+  const std::string& GetName(igsioFieldNameId id) const;
+
+  /*!
+  Get the identifier of the transform field that a field belongs to: the field itself for transform fields
+  (ending with "Transform"), the transform field for transform status fields (ending with "TransformStatus"),
+  INVALID_ID for any other fields.
+  */
+  igsioFieldNameId GetTransformFieldId(igsioFieldNameId id) const;
+
+  /*! Get the number of interned names */
+  unsigned int GetNumberOfNames() const;
+
+protected:
+  igsioFieldNameId InternInternal(const std::string& name);
+  /*! Add a name and optionally the status name of a transform, returns the identifier of the name or INVALID_ID if the table is full */
+  igsioFieldNameId AddEntries(const std::string& name, igsioFieldNameId transformFieldId, const std::string& statusName);
+
+  struct NameEntry
+  {
+    std::string Name;
+    igsioFieldNameId TransformFieldId;
+  };
+
+  /*! Hash and equality of C strings, so that lookups do not need to create temporary std::string objects */
+  struct CStringHash
+  {
+    size_t operator()(const char* str) const;
+  };
+  struct CStringEqual
+  {
+    bool operator()(const char* a, const char* b) const;
+  };
+  /*! Keys point to the names stored in Entries, which never move because only push_back is used on the deque */
+  typedef std::unordered_map<const char*, igsioFieldNameId, CStringHash, CStringEqual> IdMapType;
+
+  std::deque<NameEntry> Entries;
+  IdMapType Ids;
+  mutable vtkIGSIOSimpleRecursiveCriticalSection CriticalSection;
+
+private:
+  igsioFieldNameTable(const igsioFieldNameTable&);  // Not implemented.
+  void operator=(const igsioFieldNameTable&);  // Not implemented.
+};
+
+#endif
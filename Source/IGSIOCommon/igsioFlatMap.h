@@ -0,0 +1,101 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioFlatMap_h
+#define __igsioFlatMap_h
+
+// STL includes
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/*!
+\class igsioFlatMap
+\brief Associative container that stores its elements in a contiguous vector sorted by key
+
+Lookup is a binary search, insertion and removal shift the following elements. The container is intended for
+small maps that are copied and iterated much more often than modified (e.g., the fields of a tracked frame):
+copying and iterating it is a single pass over contiguous memory, while a std::map allocates every element
+in a separate node. The interface is the subset of std::map that is needed by the toolkit. As with std::vector,
+inserting or erasing elements invalidates all iterators and references.
+\ingroup igsioCommon
+*/
+template<typename KeyType, typename ValueType>
+class igsioFlatMap
+{
+public:
+  typedef std::pair<KeyType, ValueType> value_type;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  iterator begin() { return this->Elements.begin(); }
+  iterator end() { return this->Elements.end(); }
+  const_iterator begin() const { return this->Elements.begin(); }
+  const_iterator end() const { return this->Elements.end(); }
+
+  bool empty() const { return this->Elements.empty(); }
+  size_t size() const { return this->Elements.size(); }
+  void clear() { this->Elements.clear(); }
+  void reserve(size_t numberOfElements) { this->Elements.reserve(numberOfElements); }
+
+  /*! Get the element with the key, end() if not found */
+  iterator find(const KeyType& key)
+  {
+    iterator it = this->LowerBound(key);
+    return (it != this->Elements.end() && !(key < it->first)) ? it : this->Elements.end();
+  }
+
+  /*! Get the element with the key, end() if not found */
+  const_iterator find(const KeyType& key) const
+  {
+    const_iterator it = std::lower_bound(this->Elements.begin(), this->Elements.end(), key, IsElementKeyLess);
+    return (it != this->Elements.end() && !(key < it->first)) ? it : this->Elements.end();
+  }
+
+  /*! Get the value of the key, inserts a default constructed value if the key is not found */
+  ValueType& operator[](const KeyType& key)
+  {
+    iterator it = this->LowerBound(key);
+    if (it == this->Elements.end() || key < it->first)
+    {
+      it = this->Elements.insert(it, value_type(key, ValueType()));
+    }
+    return it->second;
+  }
+
+  /*! Remove an element, returns the iterator following the removed element */
+  iterator erase(iterator position)
+  {
+    return this->Elements.erase(position);
+  }
+
+  /*! Remove the element with the key, returns the number of removed elements */
+  size_t erase(const KeyType& key)
+  {
+    iterator it = this->find(key);
+    if (it == this->Elements.end())
+    {
+      return 0;
+    }
+    this->Elements.erase(it);
+    return 1;
+  }
+
+protected:
+  static bool IsElementKeyLess(const value_type& element, const KeyType& key)
+  {
+    return element.first < key;
+  }
+
+  iterator LowerBound(const KeyType& key)
+  {
+    return std::lower_bound(this->Elements.begin(), this->Elements.end(), key, IsElementKeyLess);
+  }
+
+  std::vector<value_type> Elements;
+};
+
+#endif
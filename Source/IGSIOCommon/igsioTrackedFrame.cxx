@@ -7,25 +7,320 @@ See License.txt for details.
 // IGSIO includes
 #include "igsioMath.h"
 #include "igsioTrackedFrame.h"
+#include "igsioXmlTagReader.h"
 
 // VTK includes
 #include <vtkImageData.h>
 #include <vtkMatrix4x4.h>
 #include <vtkPoints.h>
-#include <vtkXMLUtilities.h>
 #include <vtkXMLDataElement.h>
 
 // STD includes
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 // ************************* TrackedFrame ************************************
 //----------------------------------------------------------------------------
 
 const char* igsioTrackedFrame::FIELD_FRIENDLY_DEVICE_NAME = "FriendlyDeviceName";
+const char* igsioTrackedFrame::FIELD_IMAGE_HASH = "ImageHash";
 const std::string igsioTrackedFrame::TransformPostfix = "Transform";
 const std::string igsioTrackedFrame::TransformStatusPostfix = "TransformStatus";
-const int FLOATING_POINT_PRECISION = 16; // Number of digits used when writing transforms and timestamps
+
+namespace
+{
+  const std::string STATUS_POSTFIX = "Status";
+
+  //----------------------------------------------------------------------------
+  bool IsEqualCharInsensitive(char a, char b)
+  {
+    return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b));
+  }
+
+  //----------------------------------------------------------------------------
+  // Returns true if str is longer than postfix and ends with it (case insensitive). Does not create temporary strings.
+  bool EndsWithInsensitive(const std::string& str, const std::string& postfix)
+  {
+    if (str.length() <= postfix.length())
+    {
+      return false;
+    }
+    return std::equal(postfix.begin(), postfix.end(), str.end() - postfix.length(), IsEqualCharInsensitive);
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the name of the field that stores a transform (e.g., ProbeToTrackerTransform), which is the key of its entry
+  igsioStatus GetTransformFieldName(const igsioTransformName& transformName, std::string& fieldName)
+  {
+    if (transformName.GetTransformName(fieldName) != IGSIO_SUCCESS)
+    {
+      return IGSIO_FAIL;
+    }
+    if (igsioTrackedFrame::IsTransformStatus(fieldName))
+    {
+      fieldName.erase(fieldName.length() - STATUS_POSTFIX.length());
+    }
+    else if (!igsioTrackedFrame::IsTransform(fieldName))
+    {
+      fieldName.append(igsioTrackedFrame::TransformPostfix);
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  // Fields that are accessed on every frame are interned once
+  igsioFieldNameId GetTimestampFieldId()
+  {
+    static const igsioFieldNameId timestampFieldId = igsioFieldNameTable::GetInstance()->Intern("Timestamp");
+    return timestampFieldId;
+  }
+
+  //----------------------------------------------------------------------------
+  igsioFieldNameId GetImageHashFieldId()
+  {
+    static const igsioFieldNameId imageHashFieldId = igsioFieldNameTable::GetInstance()->Intern(igsioTrackedFrame::FIELD_IMAGE_HASH);
+    return imageHashFieldId;
+  }
+
+  //----------------------------------------------------------------------------
+  // Parse at most 16 whitespace separated numbers (locale independent). Returns the number of parsed elements.
+  int ParseTransformString(const char* transformString, double matrix[16])
+  {
+    int numberOfElements = 0;
+    while (numberOfElements < 16)
+    {
+      const char* end = NULL;
+      const double value = igsioCommon::ParseDouble(transformString, &end);
+      if (end == transformString)
+      {
+        break;
+      }
+      matrix[numberOfElements++] = value;
+      transformString = end;
+    }
+    return numberOfElements;
+  }
+
+  //----------------------------------------------------------------------------
+  // Number of spaces per nesting level, same as vtkIndent
+  const int XML_INDENT_SIZE = 2;
+
+  //----------------------------------------------------------------------------
+  // Append text with the XML special characters replaced by entities, same as igsioCommon::XML::PrintXML
+  void AppendXmlEscaped(std::string& xml, const char* text)
+  {
+    for (; *text != 0; ++text)
+    {
+      switch (*text)
+      {
+        case '&':
+          xml.append("&amp;");
+          break;
+        case '<':
+          xml.append("&lt;");
+          break;
+        case '>':
+          xml.append("&gt;");
+          break;
+        case '"':
+          xml.append("&quot;");
+          break;
+        case '\'':
+          xml.append("&apos;");
+          break;
+        default:
+          xml.push_back(*text);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void AppendXmlAttribute(std::string& xml, const char* name, const char* value)
+  {
+    xml.push_back(' ');
+    xml.append(name);
+    xml.append("=\"");
+    AppendXmlEscaped(xml, value);
+    xml.push_back('"');
+  }
+
+  //----------------------------------------------------------------------------
+  void AppendXmlElementStart(std::string& xml, int level, const char* name)
+  {
+    xml.append(XML_INDENT_SIZE * level, ' ');
+    xml.push_back('<');
+    xml.append(name);
+  }
+
+  //----------------------------------------------------------------------------
+  void AppendXmlElementEnd(std::string& xml, int level, const char* name)
+  {
+    xml.append(XML_INDENT_SIZE * level, ' ');
+    xml.append("</");
+    xml.append(name);
+    xml.append(">\n");
+  }
+
+  //----------------------------------------------------------------------------
+  // Binary data format, see igsioTrackedFrame::GetTrackedFrameInBinaryData
+  const char BINARY_DATA_MAGIC[4] = { 'I', 'G', 'T', 'F' };
+  const unsigned int BINARY_DATA_VERSION = 1;
+  const size_t BINARY_DATA_HEADER_SIZE = 64;
+  const size_t BINARY_DATA_PIXEL_ALIGNMENT = 64;
+  const unsigned int BINARY_DATA_FLAG_PIXELS_BIG_ENDIAN = 0x0001;
+  const unsigned int BINARY_DATA_TRANSFORM_MATRIX_DEFINED = 0x01;
+  const unsigned int BINARY_DATA_TRANSFORM_STATUS_DEFINED = 0x02;
+  const unsigned long long BINARY_DATA_NO_FIDUCIAL_POINTS = 0xFFFFFFFF;
+
+  //----------------------------------------------------------------------------
+  bool IsComputerBigEndian()
+  {
+    const unsigned short one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 0;
+  }
+
+  //----------------------------------------------------------------------------
+  // Appends little-endian integers, doubles and length-prefixed strings to a byte vector
+  class BinaryDataWriter
+  {
+  public:
+    explicit BinaryDataWriter(std::vector<unsigned char>& data)
+      : Data(data)
+    {
+    }
+
+    void AppendBytes(const void* bytes, size_t numberOfBytes)
+    {
+      const unsigned char* first = static_cast<const unsigned char*>(bytes);
+      this->Data.insert(this->Data.end(), first, first + numberOfBytes);
+    }
+
+    void AppendZeros(size_t numberOfBytes)
+    {
+      this->Data.resize(this->Data.size() + numberOfBytes, 0);
+    }
+
+    void AppendUnsigned(unsigned long long value, int numberOfBytes)
+    {
+      for (int i = 0; i < numberOfBytes; ++i)
+      {
+        this->Data.push_back(static_cast<unsigned char>(value >> (8 * i)));
+      }
+    }
+
+    // Overwrite a value that was appended earlier
+    void SetUnsigned(size_t position, unsigned long long value, int numberOfBytes)
+    {
+      for (int i = 0; i < numberOfBytes; ++i)
+      {
+        this->Data[position + i] = static_cast<unsigned char>(value >> (8 * i));
+      }
+    }
+
+    void AppendDouble(double value)
+    {
+      unsigned long long bits(0);
+      memcpy(&bits, &value, sizeof(bits));
+      this->AppendUnsigned(bits, 8);
+    }
+
+    void AppendString(const std::string& value)
+    {
+      this->AppendUnsigned(value.length(), 4);
+      this->AppendBytes(value.data(), value.length());
+    }
+
+  protected:
+    std::vector<unsigned char>& Data;
+  };
+
+  //----------------------------------------------------------------------------
+  // Reads the values written by BinaryDataWriter. Reading past the end of the data sets the error flag
+  // and returns zero values, so the caller only needs to check HasError after reading a block of values.
+  class BinaryDataReader
+  {
+  public:
+    BinaryDataReader(const unsigned char* data, size_t size)
+      : Data(data)
+      , Size(size)
+      , Position(0)
+      , Error(false)
+    {
+    }
+
+    size_t GetPosition() const { return this->Position; }
+
+    bool HasError() const { return this->Error; }
+
+    unsigned long long ReadUnsigned(int numberOfBytes)
+    {
+      unsigned long long value(0);
+      if (!this->Reserve(numberOfBytes))
+      {
+        return 0;
+      }
+      for (int i = 0; i < numberOfBytes; ++i)
+      {
+        value |= static_cast<unsigned long long>(this->Data[this->Position++]) << (8 * i);
+      }
+      return value;
+    }
+
+    double ReadDouble()
+    {
+      const unsigned long long bits = this->ReadUnsigned(8);
+      double value(0);
+      memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    void ReadString(std::string& value)
+    {
+      const size_t length = static_cast<size_t>(this->ReadUnsigned(4));
+      if (!this->Reserve(length))
+      {
+        value.clear();
+        return;
+      }
+      value.assign(reinterpret_cast<const char*>(this->Data + this->Position), length);
+      this->Position += length;
+    }
+
+  protected:
+    bool Reserve(size_t numberOfBytes)
+    {
+      if (this->Error || numberOfBytes > this->Size - this->Position)
+      {
+        this->Error = true;
+        return false;
+      }
+      return true;
+    }
+
+    const unsigned char* Data;
+    size_t Size;
+    size_t Position;
+    bool Error;
+  };
+}
+
+//----------------------------------------------------------------------------
+igsioTrackedFrame::FrameTransformEntry::FrameTransformEntry()
+  : NumberOfMatrixElements(0)
+  , Status(TOOL_INVALID)
+  , IsMatrixDefined(false)
+  , IsStatusDefined(false)
+{
+  for (int i = 0; i < 16; ++i)
+  {
+    this->Matrix[i] = (i % 5 == 0 ? 1.0 : 0.0);
+  }
+}
 
 //----------------------------------------------------------------------------
 igsioTrackedFrame::igsioTrackedFrame()
@@ -35,6 +330,7 @@ igsioTrackedFrame::igsioTrackedFrame()
   this->FrameSize[1] = 0;
   this->FrameSize[2] = 1; // single-slice frame by default
   this->FiducialPointsCoordinatePx = NULL;
+  this->CustomFieldsValid = false;
 }
 
 //----------------------------------------------------------------------------
@@ -51,6 +347,7 @@ igsioTrackedFrame::igsioTrackedFrame(const igsioTrackedFrame& frame)
   this->FrameSize[1] = 0;
   this->FrameSize[2] = 1; // single-slice frame by default
   this->FiducialPointsCoordinatePx = NULL;
+  this->CustomFieldsValid = false;
 
   *this = frame;
 }
@@ -65,7 +362,11 @@ igsioTrackedFrame& igsioTrackedFrame::operator=(igsioTrackedFrame const& tracked
   }
 
   this->FrameFields = trackedFrame.FrameFields;
+  this->FrameTransforms = trackedFrame.FrameTransforms;
+  this->InvalidateFieldStrings();
   this->ImageData = trackedFrame.ImageData;
+  // Copying an empty frame would keep the current pixels, so reset the thumbnail explicitly
+  this->Thumbnail = (trackedFrame.HasThumbnail() ? trackedFrame.Thumbnail : igsioVideoFrame());
   this->Timestamp = trackedFrame.Timestamp;
   this->FrameSize[0] = trackedFrame.FrameSize[0];
   this->FrameSize[1] = trackedFrame.FrameSize[1];
@@ -75,18 +376,172 @@ igsioTrackedFrame& igsioTrackedFrame::operator=(igsioTrackedFrame const& tracked
   return *this;
 }
 
+//----------------------------------------------------------------------------
+igsioTrackedFrame::igsioTrackedFrame(igsioTrackedFrame&& frame)
+  : ImageData(std::move(frame.ImageData))
+  , Thumbnail(std::move(frame.Thumbnail))
+  , Timestamp(frame.Timestamp)
+  , FrameFields(std::move(frame.FrameFields))
+  , FrameTransforms(std::move(frame.FrameTransforms))
+  , CustomFieldsValid(false)
+  , FrameSize(frame.FrameSize)
+  , EncodingFourCC(std::move(frame.EncodingFourCC))
+  , FiducialPointsCoordinatePx(frame.FiducialPointsCoordinatePx)
+{
+  frame.FiducialPointsCoordinatePx = NULL;
+  frame.InvalidateFieldStrings();
+}
+
+//----------------------------------------------------------------------------
+igsioTrackedFrame& igsioTrackedFrame::operator=(igsioTrackedFrame&& trackedFrame)
+{
+  // Handle self-assignment
+  if (this == &trackedFrame)
+  {
+    return *this;
+  }
+
+  this->FrameFields = std::move(trackedFrame.FrameFields);
+  this->FrameTransforms = std::move(trackedFrame.FrameTransforms);
+  this->InvalidateFieldStrings();
+  trackedFrame.InvalidateFieldStrings();
+  this->ImageData = std::move(trackedFrame.ImageData);
+  this->Thumbnail = std::move(trackedFrame.Thumbnail);
+  this->Timestamp = trackedFrame.Timestamp;
+  this->FrameSize = trackedFrame.FrameSize;
+  this->EncodingFourCC = std::move(trackedFrame.EncodingFourCC);
+
+  // Take over the reference of the other frame
+  this->SetFiducialPointsCoordinatePx(NULL);
+  this->FiducialPointsCoordinatePx = trackedFrame.FiducialPointsCoordinatePx;
+  trackedFrame.FiducialPointsCoordinatePx = NULL;
+
+  return *this;
+}
+
 //----------------------------------------------------------------------------
 igsioStatus igsioTrackedFrame::GetTrackedFrameInXmlData(std::string& strXmlData, const std::vector<igsioTransformName>& requestedTransforms)
 {
-  vtkSmartPointer<vtkXMLDataElement> xmlData = vtkSmartPointer<vtkXMLDataElement>::New();
-  igsioStatus status = this->PrintToXML(xmlData, requestedTransforms);
+  // The XML text is written directly, it is the same as printing the element of PrintToXML with igsioCommon::XML::PrintXML
+  strXmlData.clear();
+  AppendXmlElementStart(strXmlData, 0, "TrackedFrame");
+
+  char numberString[igsioCommon::DOUBLE_STRING_BUFFER_SIZE];
+  igsioCommon::FormatDouble(this->Timestamp, numberString);
+  AppendXmlAttribute(strXmlData, "Timestamp", numberString);
+  AppendXmlAttribute(strXmlData, "ImageDataValid", (this->GetImageData()->IsImageValid() ? "true" : "false"));
+
+  if (this->GetImageData()->IsImageValid())
+  {
+    unsigned int numberOfScalarComponents(1);
+    if (this->GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+    {
+      LOG_ERROR("Unable to retrieve number of scalar components.");
+      return IGSIO_FAIL;
+    }
+    if (FrameSize[0] > static_cast<unsigned int>(std::numeric_limits<int>::max()) ||
+        FrameSize[1] > static_cast<unsigned int>(std::numeric_limits<int>::max()) ||
+        FrameSize[2] > static_cast<unsigned int>(std::numeric_limits<int>::max()))
+    {
+      LOG_ERROR("Unable to save frame size elements larger than: " << std::numeric_limits<int>::max());
+      return IGSIO_FAIL;
+    }
+    AppendXmlAttribute(strXmlData, "NumberOfBits", igsioCommon::ToString(this->GetNumberOfBitsPerScalar()).c_str());
+    AppendXmlAttribute(strXmlData, "NumberOfScalarComponents", igsioCommon::ToString(numberOfScalarComponents).c_str());
+    const std::string frameSizeString = igsioCommon::ToString(FrameSize[0]) + " " + igsioCommon::ToString(FrameSize[1]) + " " + igsioCommon::ToString(FrameSize[2]);
+    AppendXmlAttribute(strXmlData, "FrameSize", frameSizeString.c_str());
+  }
 
-  std::ostringstream os;
-  igsioCommon::XML::PrintXML(os, vtkIndent(0), xmlData);
+  std::vector<std::string> fieldNames;
+  this->GetSerializedFieldNameList(requestedTransforms, fieldNames);
+  if (fieldNames.empty() && this->FiducialPointsCoordinatePx == NULL)
+  {
+    strXmlData.append(" />\n");
+    return IGSIO_SUCCESS;
+  }
+  strXmlData.append(">\n");
 
-  strXmlData = os.str();
+  for (std::vector<std::string>::const_iterator fieldIter = fieldNames.begin(); fieldIter != fieldNames.end(); ++fieldIter)
+  {
+    const char* fieldValue = this->GetFrameField(*fieldIter);
+    AppendXmlElementStart(strXmlData, 1, "FrameField");
+    AppendXmlAttribute(strXmlData, "Name", fieldIter->c_str());
+    AppendXmlAttribute(strXmlData, "Value", (fieldValue != NULL ? fieldValue : ""));
+    strXmlData.append(" />\n");
+  }
 
-  return status;
+  if (this->FiducialPointsCoordinatePx != NULL)
+  {
+    const vtkIdType numberOfPoints = this->FiducialPointsCoordinatePx->GetNumberOfPoints();
+    AppendXmlElementStart(strXmlData, 1, "Segmentation");
+    AppendXmlAttribute(strXmlData, "SegmentationStatus", (numberOfPoints == 0 ? "Failed" : (numberOfPoints % 3 != 0 ? "InvalidPatterns" : "OK")));
+    strXmlData.append(">\n");
+
+    AppendXmlElementStart(strXmlData, 2, "SegmentedPoints");
+    if (numberOfPoints == 0)
+    {
+      strXmlData.append(" />\n");
+    }
+    else
+    {
+      strXmlData.append(">\n");
+      std::string positionString;
+      for (vtkIdType i = 0; i < numberOfPoints; i++)
+      {
+        double point[3] = {0};
+        this->FiducialPointsCoordinatePx->GetPoint(i, point);
+        positionString.clear();
+        for (int j = 0; j < 3; ++j)
+        {
+          if (j > 0)
+          {
+            positionString.push_back(' ');
+          }
+          igsioCommon::AppendDouble(positionString, point[j]);
+        }
+        AppendXmlElementStart(strXmlData, 3, "Point");
+        AppendXmlAttribute(strXmlData, "ID", igsioCommon::ToString(i).c_str());
+        AppendXmlAttribute(strXmlData, "Position", positionString.c_str());
+        strXmlData.append(" />\n");
+      }
+      AppendXmlElementEnd(strXmlData, 2, "SegmentedPoints");
+    }
+    AppendXmlElementEnd(strXmlData, 1, "Segmentation");
+  }
+
+  AppendXmlElementEnd(strXmlData, 0, "TrackedFrame");
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::GetSerializedFieldNameList(const std::vector<igsioTransformName>& requestedTransforms, std::vector<std::string>& fieldNames)
+{
+  this->GetFrameFieldNameList(fieldNames);
+  // Only use requested transforms mechanism if the vector is not empty
+  if (requestedTransforms.empty())
+  {
+    return;
+  }
+
+  std::vector<std::string> allFieldNames;
+  allFieldNames.swap(fieldNames);
+  for (auto fieldIter = allFieldNames.begin(); fieldIter != allFieldNames.end(); ++fieldIter)
+  {
+    if (IsTransform(*fieldIter) || IsTransformStatus(*fieldIter))
+    {
+      if (IsTransformStatus(*fieldIter))
+      {
+        continue;
+      }
+      if (std::find(requestedTransforms.begin(), requestedTransforms.end(), igsioTransformName(*fieldIter)) == requestedTransforms.end())
+      {
+        continue;
+      }
+      // The status of a requested transform is always sent, right before the transform
+      fieldNames.push_back(fieldIter->substr(0, fieldIter->length() - TransformPostfix.length()) + TransformStatusPostfix);
+    }
+    fieldNames.push_back(*fieldIter);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -99,7 +554,10 @@ igsioStatus igsioTrackedFrame::PrintToXML(vtkXMLDataElement* trackedFrame, const
   }
 
   trackedFrame->SetName("TrackedFrame");
-  trackedFrame->SetDoubleAttribute("Timestamp", this->Timestamp);
+  // Numbers are written in the shortest representation that reads back to the same value, SetDoubleAttribute may round them
+  char timestampString[igsioCommon::DOUBLE_STRING_BUFFER_SIZE];
+  igsioCommon::FormatDouble(this->Timestamp, timestampString);
+  trackedFrame->SetAttribute("Timestamp", timestampString);
   trackedFrame->SetAttribute("ImageDataValid", (this->GetImageData()->IsImageValid() ? "true" : "false"));
 
   if (this->GetImageData()->IsImageValid())
@@ -123,32 +581,15 @@ igsioStatus igsioTrackedFrame::PrintToXML(vtkXMLDataElement* trackedFrame, const
     trackedFrame->SetVectorAttribute("FrameSize", 3, frameSizeSigned);
   }
 
-  for (auto fieldIter = FrameFields.begin(); fieldIter != FrameFields.end(); ++fieldIter)
+  std::vector<std::string> fieldNames;
+  this->GetSerializedFieldNameList(requestedTransforms, fieldNames);
+  for (auto fieldIter = fieldNames.begin(); fieldIter != fieldNames.end(); ++fieldIter)
   {
-    // Only use requested transforms mechanism if the vector is not empty
-    if (!requestedTransforms.empty() && (IsTransform(fieldIter->first) || IsTransformStatus(fieldIter->first)))
-    {
-      if (IsTransformStatus(fieldIter->first))
-      {
-        continue;
-      }
-      if (std::find(requestedTransforms.begin(), requestedTransforms.end(), igsioTransformName(fieldIter->first)) == requestedTransforms.end())
-      {
-        continue;
-      }
-      auto statusName = fieldIter->first;
-      statusName = statusName.substr(0, fieldIter->first.length() - TransformPostfix.length());
-      statusName = statusName.append(TransformStatusPostfix);
-      vtkSmartPointer<vtkXMLDataElement> customField = vtkSmartPointer<vtkXMLDataElement>::New();
-      customField->SetName("FrameField");
-      customField->SetAttribute("Name", statusName.c_str());
-      customField->SetAttribute("Value", FrameFields[statusName].c_str());
-      trackedFrame->AddNestedElement(customField);
-    }
+    const char* fieldValue = this->GetFrameField(*fieldIter);
     vtkSmartPointer<vtkXMLDataElement> customField = vtkSmartPointer<vtkXMLDataElement>::New();
     customField->SetName("FrameField");
-    customField->SetAttribute("Name", fieldIter->first.c_str());
-    customField->SetAttribute("Value", fieldIter->second.c_str());
+    customField->SetAttribute("Name", fieldIter->c_str());
+    customField->SetAttribute("Value", fieldValue != NULL ? fieldValue : "");
     trackedFrame->AddNestedElement(customField);
   }
 
@@ -167,105 +608,465 @@ igsioStatus igsioTrackedFrame::PrintToXML(vtkXMLDataElement* trackedFrame, const
     }
     else
     {
-      segmentation->SetAttribute("SegmentationStatus", "OK");
+      segmentation->SetAttribute("SegmentationStatus", "OK");
+    }
+
+    vtkSmartPointer<vtkXMLDataElement> segmentedPoints = vtkSmartPointer<vtkXMLDataElement>::New();
+    segmentedPoints->SetName("SegmentedPoints");
+
+    std::string positionString;
+    for (int i = 0; i < FiducialPointsCoordinatePx->GetNumberOfPoints(); i++)
+    {
+      double point[3] = {0};
+      FiducialPointsCoordinatePx->GetPoint(i, point);
+      positionString.clear();
+      for (int j = 0; j < 3; ++j)
+      {
+        if (j > 0)
+        {
+          positionString.push_back(' ');
+        }
+        igsioCommon::AppendDouble(positionString, point[j]);
+      }
+
+      vtkSmartPointer<vtkXMLDataElement> pointElement = vtkSmartPointer<vtkXMLDataElement>::New();
+      pointElement->SetName("Point");
+      pointElement->SetIntAttribute("ID", i);
+      pointElement->SetAttribute("Position", positionString.c_str());
+      segmentedPoints->AddNestedElement(pointElement);
+    }
+
+    segmentation->AddNestedElement(segmentedPoints);
+    trackedFrame->AddNestedElement(segmentation);
+  }
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioTrackedFrame::SetTrackedFrameFromXmlData(const std::string& xmlData)
+{
+  return this->SetTrackedFrameFromXmlData(xmlData.c_str());
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioTrackedFrame::SetTrackedFrameFromXmlData(const char* strXmlData)
+{
+  if (strXmlData == NULL)
+  {
+    LOG_ERROR("Failed to set TrackedFrame from xml data - input xml data string is NULL!");
+    return IGSIO_FAIL;
+  }
+
+  // Read the XML text in a single pass. Fields and points are collected first, so that the frame is not
+  // modified if the XML turns out to be invalid.
+  igsioXmlTagReader reader(strXmlData);
+  std::vector<std::string> openElementNames;
+  std::vector<std::pair<std::string, std::string> > frameFields;
+  vtkSmartPointer<vtkPoints> fiducialPoints;
+  bool rootElementFound(false);
+  bool segmentationFound(false);
+  bool segmentedPointsFound(false);
+  bool inSegmentation(false);
+  bool inSegmentedPoints(false);
+  bool xmlValid(true);
+  while (xmlValid && reader.ReadNextTag())
+  {
+    if (rootElementFound && openElementNames.empty())
+    {
+      // Only one root element is allowed
+      xmlValid = false;
+      break;
+    }
+
+    if (reader.IsEndTag())
+    {
+      if (openElementNames.empty() || openElementNames.back() != reader.GetName())
+      {
+        xmlValid = false;
+        break;
+      }
+      openElementNames.pop_back();
+      if (openElementNames.size() == 1)
+      {
+        inSegmentation = false;
+      }
+      else if (openElementNames.size() == 2)
+      {
+        inSegmentedPoints = false;
+      }
+      continue;
+    }
+
+    // Only the first Segmentation and SegmentedPoints elements are used
+    const std::string& elementName = reader.GetName();
+    const size_t depth = openElementNames.size();
+    if (depth == 0)
+    {
+      rootElementFound = true;
+    }
+    else if (depth == 1 && igsioCommon::IsEqualInsensitive(elementName, "FrameField"))
+    {
+      const char* fieldName = reader.GetAttribute("Name");
+      const char* fieldValue = reader.GetAttribute("Value");
+      if (fieldName == NULL)
+      {
+        LOG_WARNING("Unable to find FrameField Name attribute");
+      }
+      else if (fieldValue == NULL)
+      {
+        LOG_WARNING("Unable to find FrameField Value attribute");
+      }
+      else
+      {
+        frameFields.push_back(std::make_pair(std::string(fieldName), std::string(fieldValue)));
+      }
+    }
+    else if (depth == 1 && !segmentationFound && elementName == "Segmentation")
+    {
+      segmentationFound = true;
+      fiducialPoints = vtkSmartPointer<vtkPoints>::New();
+      inSegmentation = !reader.IsEmptyElement();
+    }
+    else if (depth == 2 && inSegmentation && !segmentedPointsFound && elementName == "SegmentedPoints")
+    {
+      // Segmentation was successful
+      segmentedPointsFound = true;
+      inSegmentedPoints = !reader.IsEmptyElement();
+    }
+    else if (depth == 3 && inSegmentedPoints && STRCASECMP(elementName.c_str(), "Point") == 0)
+    {
+      const char* positionString = reader.GetAttribute("Position");
+      double pos[3] = {0};
+      int numberOfComponents = 0;
+      while (positionString != NULL && numberOfComponents < 3)
+      {
+        const char* end = NULL;
+        const double value = igsioCommon::ParseDouble(positionString, &end);
+        if (end == positionString)
+        {
+          break;
+        }
+        pos[numberOfComponents++] = value;
+        positionString = end;
+      }
+      if (numberOfComponents > 0)
+      {
+        fiducialPoints->InsertNextPoint(pos);
+      }
+    }
+
+    if (!reader.IsEmptyElement())
+    {
+      openElementNames.push_back(elementName);
+    }
+  }
+
+  if (!xmlValid || reader.HasError() || !rootElementFound || !openElementNames.empty())
+  {
+    LOG_ERROR("Failed to set TrackedFrame from xml data - invalid xml data string!");
+    return IGSIO_FAIL;
+  }
+
+  // Add custom fields to tracked frame
+  for (std::vector<std::pair<std::string, std::string> >::iterator field = frameFields.begin(); field != frameFields.end(); ++field)
+  {
+    if (this->SetFrameField(std::move(field->first), std::move(field->second)) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to set TrackedFrame from xml data - unable to set frame fields!");
+      return IGSIO_FAIL;
+    }
+  }
+  if (segmentationFound)
+  {
+    this->SetFiducialPointsCoordinatePx(fiducialPoints);
+  }
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioTrackedFrame::GetTrackedFrameInBinaryData(std::vector<unsigned char>& binaryData, bool includePixelData)
+{
+  binaryData.clear();
+
+  const bool imageValid = this->ImageData.IsImageValid();
+  if (imageValid && this->ImageData.GetConstImage() == NULL)
+  {
+    LOG_ERROR("Unable to serialize tracked frame to binary data - encoded frames are not supported");
+    return IGSIO_FAIL;
+  }
+  const FrameSizeType frameSize = this->GetFrameSize();
+  unsigned int numberOfScalarComponents(0);
+  igsioCommon::VTKScalarPixelType pixelType(VTK_VOID);
+  unsigned long pixelDataSize(0);
+  if (imageValid)
+  {
+    if (this->GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+    {
+      LOG_ERROR("Unable to retrieve number of scalar components.");
+      return IGSIO_FAIL;
+    }
+    pixelType = this->ImageData.GetVTKScalarPixelType();
+    pixelDataSize = this->ImageData.GetFrameSizeInBytes();
+  }
+
+  BinaryDataWriter writer(binaryData);
+  writer.AppendBytes(BINARY_DATA_MAGIC, sizeof(BINARY_DATA_MAGIC));
+  writer.AppendUnsigned(BINARY_DATA_VERSION, 2);
+  writer.AppendUnsigned(IsComputerBigEndian() ? BINARY_DATA_FLAG_PIXELS_BIG_ENDIAN : 0, 2);
+  writer.AppendDouble(this->Timestamp);
+  for (int i = 0; i < 3; ++i)
+  {
+    writer.AppendUnsigned(frameSize[i], 4);
+  }
+  writer.AppendUnsigned(pixelType, 2);
+  writer.AppendUnsigned(numberOfScalarComponents, 2);
+  writer.AppendUnsigned(this->ImageData.GetImageOrientation(), 2);
+  writer.AppendUnsigned(this->ImageData.GetImageType(), 2);
+  writer.AppendUnsigned(this->FrameFields.size(), 4);
+  writer.AppendUnsigned(this->FrameTransforms.size(), 4);
+  writer.AppendUnsigned(this->FiducialPointsCoordinatePx != NULL ? this->FiducialPointsCoordinatePx->GetNumberOfPoints() : BINARY_DATA_NO_FIDUCIAL_POINTS, 4);
+  const size_t pixelDataOffsetPosition = binaryData.size();
+  writer.AppendUnsigned(0, 8); // set when the size of the fields is known
+  writer.AppendUnsigned(pixelDataSize, 8);
+
+  igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
+  for (FieldIdMapType::const_iterator fieldIter = this->FrameFields.begin(); fieldIter != this->FrameFields.end(); ++fieldIter)
+  {
+    writer.AppendString(fieldNameTable->GetName(fieldIter->first));
+    writer.AppendString(fieldIter->second);
+  }
+
+  for (TransformMapType::const_iterator transformIter = this->FrameTransforms.begin(); transformIter != this->FrameTransforms.end(); ++transformIter)
+  {
+    const FrameTransformEntry& entry = transformIter->second;
+    writer.AppendString(fieldNameTable->GetName(transformIter->first));
+    writer.AppendUnsigned((entry.IsMatrixDefined ? BINARY_DATA_TRANSFORM_MATRIX_DEFINED : 0) | (entry.IsStatusDefined ? BINARY_DATA_TRANSFORM_STATUS_DEFINED : 0), 1);
+    writer.AppendUnsigned(entry.IsMatrixDefined ? entry.NumberOfMatrixElements : 0, 1);
+    writer.AppendUnsigned(entry.Status, 1);
+    writer.AppendUnsigned(0, 1);
+    for (int i = 0; entry.IsMatrixDefined && i < entry.NumberOfMatrixElements; ++i)
+    {
+      writer.AppendDouble(entry.Matrix[i]);
     }
+  }
 
-    vtkSmartPointer<vtkXMLDataElement> segmentedPoints = vtkSmartPointer<vtkXMLDataElement>::New();
-    segmentedPoints->SetName("SegmentedPoints");
-
-    for (int i = 0; i < FiducialPointsCoordinatePx->GetNumberOfPoints(); i++)
+  if (this->FiducialPointsCoordinatePx != NULL)
+  {
+    for (vtkIdType i = 0; i < this->FiducialPointsCoordinatePx->GetNumberOfPoints(); ++i)
     {
       double point[3] = {0};
-      FiducialPointsCoordinatePx->GetPoint(i, point);
-
-      vtkSmartPointer<vtkXMLDataElement> pointElement = vtkSmartPointer<vtkXMLDataElement>::New();
-      pointElement->SetName("Point");
-      pointElement->SetIntAttribute("ID", i);
-      pointElement->SetVectorAttribute("Position", 3, point);
-      segmentedPoints->AddNestedElement(pointElement);
+      this->FiducialPointsCoordinatePx->GetPoint(i, point);
+      writer.AppendDouble(point[0]);
+      writer.AppendDouble(point[1]);
+      writer.AppendDouble(point[2]);
     }
+  }
 
-    segmentation->AddNestedElement(segmentedPoints);
-    trackedFrame->AddNestedElement(segmentation);
+  // Pixel data starts at an aligned offset, so that it can be used in place by SetTrackedFrameFromBinaryData
+  writer.AppendZeros((BINARY_DATA_PIXEL_ALIGNMENT - binaryData.size() % BINARY_DATA_PIXEL_ALIGNMENT) % BINARY_DATA_PIXEL_ALIGNMENT);
+  writer.SetUnsigned(pixelDataOffsetPosition, binaryData.size(), 8);
+  if (includePixelData && pixelDataSize > 0)
+  {
+    writer.AppendBytes(this->ImageData.GetConstScalarPointer(), pixelDataSize);
   }
 
   return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioTrackedFrame::SetTrackedFrameFromXmlData(const std::string& xmlData)
-{
-  return this->SetTrackedFrameFromXmlData(xmlData.c_str());
-}
-
-//----------------------------------------------------------------------------
-igsioStatus igsioTrackedFrame::SetTrackedFrameFromXmlData(const char* strXmlData)
+igsioStatus igsioTrackedFrame::SetTrackedFrameFromBinaryData(const unsigned char* binaryData, size_t binaryDataSize, bool copyPixelData)
 {
-  if (strXmlData == NULL)
+  if (binaryData == NULL)
   {
-    LOG_ERROR("Failed to set TrackedFrame from xml data - input xml data string is NULL!");
+    LOG_ERROR("Failed to set TrackedFrame from binary data - input data is NULL!");
+    return IGSIO_FAIL;
+  }
+  if (binaryDataSize < BINARY_DATA_HEADER_SIZE || memcmp(binaryData, BINARY_DATA_MAGIC, sizeof(BINARY_DATA_MAGIC)) != 0)
+  {
+    LOG_ERROR("Failed to set TrackedFrame from binary data - input is not tracked frame binary data!");
     return IGSIO_FAIL;
   }
 
-  vtkSmartPointer<vtkXMLDataElement> trackedFrame = vtkSmartPointer<vtkXMLDataElement>::Take(vtkXMLUtilities::ReadElementFromString(strXmlData));
-
-  if (trackedFrame == NULL)
+  BinaryDataReader reader(binaryData + sizeof(BINARY_DATA_MAGIC), binaryDataSize - sizeof(BINARY_DATA_MAGIC));
+  const unsigned long long version = reader.ReadUnsigned(2);
+  if (version != BINARY_DATA_VERSION)
   {
-    LOG_ERROR("Failed to set TrackedFrame from xml data - invalid xml data string!");
+    LOG_ERROR("Failed to set TrackedFrame from binary data - unsupported version: " << version);
+    return IGSIO_FAIL;
+  }
+  const unsigned long long flags = reader.ReadUnsigned(2);
+  const double timestamp = reader.ReadDouble();
+  FrameSizeType frameSize = {0, 0, 0};
+  for (int i = 0; i < 3; ++i)
+  {
+    frameSize[i] = static_cast<unsigned int>(reader.ReadUnsigned(4));
+  }
+  const igsioCommon::VTKScalarPixelType pixelType = static_cast<igsioCommon::VTKScalarPixelType>(reader.ReadUnsigned(2));
+  const unsigned int numberOfScalarComponents = static_cast<unsigned int>(reader.ReadUnsigned(2));
+  const unsigned long long imageOrientation = reader.ReadUnsigned(2);
+  const unsigned long long imageType = reader.ReadUnsigned(2);
+  const unsigned long long numberOfFields = reader.ReadUnsigned(4);
+  const unsigned long long numberOfTransforms = reader.ReadUnsigned(4);
+  const unsigned long long numberOfFiducialPoints = reader.ReadUnsigned(4);
+  const unsigned long long pixelDataOffset = reader.ReadUnsigned(8);
+  const unsigned long long pixelDataSize = reader.ReadUnsigned(8);
+  if (imageOrientation >= US_IMG_ORIENT_LAST || imageType >= US_IMG_TYPE_LAST)
+  {
+    LOG_ERROR("Failed to set TrackedFrame from binary data - invalid image orientation (" << imageOrientation << ") or image type (" << imageType << ")");
     return IGSIO_FAIL;
   }
 
-  // Add custom fields to tracked frame
-  for (int i = 0; i < trackedFrame->GetNumberOfNestedElements(); ++i)
+  // Read the fields first, so that the frame is not modified if the data turns out to be invalid
+  std::vector<std::pair<std::string, std::string> > frameFields;
+  for (unsigned long long i = 0; i < numberOfFields && !reader.HasError(); ++i)
+  {
+    frameFields.push_back(std::pair<std::string, std::string>());
+    reader.ReadString(frameFields.back().first);
+    reader.ReadString(frameFields.back().second);
+  }
+
+  igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
+  TransformMapType frameTransforms;
+  std::string transformFieldName;
+  for (unsigned long long i = 0; i < numberOfTransforms && !reader.HasError(); ++i)
   {
-    vtkXMLDataElement* nestedElement = trackedFrame->GetNestedElement(i);
-    if (!igsioCommon::IsEqualInsensitive(nestedElement->GetName(), "FrameField"))
+    reader.ReadString(transformFieldName);
+    const unsigned long long transformFlags = reader.ReadUnsigned(1);
+    const unsigned long long numberOfMatrixElements = reader.ReadUnsigned(1);
+    const unsigned long long status = reader.ReadUnsigned(1);
+    reader.ReadUnsigned(1);
+    if (reader.HasError())
     {
-      continue;
+      break;
     }
-
-    const char* fieldName = nestedElement->GetAttribute("Name");
-    if (fieldName == NULL)
+    // Validate the name before interning it, so that invalid input does not add names to the table
+    if (!IsTransform(transformFieldName) || numberOfMatrixElements > 16 || status > TOOL_PATH_NOT_FOUND)
     {
-      LOG_WARNING("Unable to find FrameField Name attribute");
-      continue;
+      LOG_ERROR("Failed to set TrackedFrame from binary data - invalid transform: " << transformFieldName);
+      return IGSIO_FAIL;
     }
-
-    const char* fieldValue = nestedElement->GetAttribute("Value");
-    if (fieldValue == NULL)
+    const igsioFieldNameId transformFieldId = fieldNameTable->Intern(transformFieldName);
+    if (fieldNameTable->GetTransformFieldId(transformFieldId) != transformFieldId || transformFieldId == igsioFieldNameTable::INVALID_ID)
     {
-      LOG_WARNING("Unable to find FrameField Value attribute");
-      continue;
+      LOG_ERROR("Failed to set TrackedFrame from binary data - unable to add transform: " << transformFieldName);
+      return IGSIO_FAIL;
     }
+    FrameTransformEntry& entry = frameTransforms[transformFieldId];
+    entry.IsMatrixDefined = (transformFlags & BINARY_DATA_TRANSFORM_MATRIX_DEFINED) != 0;
+    entry.IsStatusDefined = (transformFlags & BINARY_DATA_TRANSFORM_STATUS_DEFINED) != 0;
+    entry.Status = static_cast<ToolStatus>(status);
+    entry.NumberOfMatrixElements = static_cast<int>(numberOfMatrixElements);
+    for (int j = 0; entry.IsMatrixDefined && j < entry.NumberOfMatrixElements; ++j)
+    {
+      entry.Matrix[j] = reader.ReadDouble();
+    }
+  }
 
-    this->SetFrameField(fieldName, fieldValue);
+  vtkSmartPointer<vtkPoints> fiducialPoints;
+  if (numberOfFiducialPoints != BINARY_DATA_NO_FIDUCIAL_POINTS)
+  {
+    fiducialPoints = vtkSmartPointer<vtkPoints>::New();
+    for (unsigned long long i = 0; i < numberOfFiducialPoints && !reader.HasError(); ++i)
+    {
+      double point[3] = {0};
+      point[0] = reader.ReadDouble();
+      point[1] = reader.ReadDouble();
+      point[2] = reader.ReadDouble();
+      fiducialPoints->InsertNextPoint(point);
+    }
   }
 
-  vtkXMLDataElement* segmentation = trackedFrame->FindNestedElementWithName("Segmentation");
+  if (reader.HasError())
+  {
+    LOG_ERROR("Failed to set TrackedFrame from binary data - data is truncated!");
+    return IGSIO_FAIL;
+  }
 
-  if (segmentation != NULL)
+  igsioVideoFrame imageData;
+  imageData.SetImageOrientation(static_cast<US_IMAGE_ORIENTATION>(imageOrientation));
+  imageData.SetImageType(static_cast<US_IMAGE_TYPE>(imageType));
+  if (pixelDataSize > 0)
   {
-    this->FiducialPointsCoordinatePx = vtkSmartPointer<vtkPoints>::New();
+    const int bytesPerScalar = igsioVideoFrame::GetNumberOfBytesPerScalar(pixelType);
+    if (bytesPerScalar <= 0 || numberOfScalarComponents == 0)
+    {
+      LOG_ERROR("Failed to set TrackedFrame from binary data - unsupported pixel type: " << pixelType);
+      return IGSIO_FAIL;
+    }
+    unsigned long long expectedPixelDataSize = static_cast<unsigned long long>(bytesPerScalar) * numberOfScalarComponents;
+    for (int i = 0; i < 3; ++i)
+    {
+      expectedPixelDataSize = (frameSize[i] == 0 || expectedPixelDataSize > pixelDataSize / frameSize[i]) ? 0 : expectedPixelDataSize * frameSize[i];
+    }
+    if (expectedPixelDataSize != pixelDataSize)
+    {
+      LOG_ERROR("Failed to set TrackedFrame from binary data - pixel data size (" << pixelDataSize << ") does not match the frame size: "
+                << frameSize[0] << "x" << frameSize[1] << "x" << frameSize[2]);
+      return IGSIO_FAIL;
+    }
+    if (pixelDataOffset < sizeof(BINARY_DATA_MAGIC) + reader.GetPosition() || pixelDataOffset > binaryDataSize || pixelDataSize > binaryDataSize - pixelDataOffset)
+    {
+      LOG_ERROR("Failed to set TrackedFrame from binary data - pixel data is out of range!");
+      return IGSIO_FAIL;
+    }
 
-    vtkXMLDataElement* segmentedPoints = segmentation->FindNestedElementWithName("SegmentedPoints");
-    if (segmentedPoints != NULL)   // Segmentation was successful
+    const unsigned char* pixels = binaryData + pixelDataOffset;
+    const bool swapBytes = bytesPerScalar > 1 && ((flags & BINARY_DATA_FLAG_PIXELS_BIG_ENDIAN) != 0) != IsComputerBigEndian();
+    const bool pixelsAligned = reinterpret_cast<size_t>(pixels) % bytesPerScalar == 0;
+    if (!copyPixelData && !swapBytes && pixelsAligned)
     {
-      for (int i = 0; i < segmentedPoints->GetNumberOfNestedElements(); ++i)
+      if (imageData.SetExternalPixelBuffer(pixels, frameSize, pixelType, numberOfScalarComponents) != IGSIO_SUCCESS)
       {
-        vtkXMLDataElement* pointElement = segmentedPoints->GetNestedElement(i);
-        if (STRCASECMP(pointElement->GetName(), "Point") != 0)
-        {
-          continue;
-        }
-
-        double pos[3] = {0};
-        if (pointElement->GetVectorAttribute("Position", 3, pos))
+        LOG_ERROR("Failed to set TrackedFrame from binary data - unable to use the pixel data in place!");
+        return IGSIO_FAIL;
+      }
+    }
+    else
+    {
+      if (!copyPixelData)
+      {
+        LOG_DEBUG("Pixel data of the binary tracked frame is copied, because it is " << (swapBytes ? "in a different byte order" : "not aligned"));
+      }
+      if (imageData.AllocateFrame(frameSize, pixelType, numberOfScalarComponents) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to set TrackedFrame from binary data - unable to allocate memory for the image!");
+        return IGSIO_FAIL;
+      }
+      unsigned char* imagePixels = static_cast<unsigned char*>(imageData.GetScalarPointer());
+      if (swapBytes)
+      {
+        const std::array<int, 3> noClip = { igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP };
+        if (igsioVideoFrame::FlipClipImage(pixels, frameSize, 0, 0, pixelType, numberOfScalarComponents, igsioVideoFrame::FlipInfoType(), noClip, noClip,
+                                           imagePixels, 0, 0, true) != IGSIO_SUCCESS)
         {
-          this->FiducialPointsCoordinatePx->InsertNextPoint(pos);
+          LOG_ERROR("Failed to set TrackedFrame from binary data - unable to convert the byte order of the pixel data!");
+          return IGSIO_FAIL;
         }
       }
+      else
+      {
+        memcpy(imagePixels, pixels, static_cast<size_t>(pixelDataSize));
+      }
+    }
+  }
+
+  this->SetImageData(std::move(imageData));
+  this->Thumbnail = igsioVideoFrame();
+  this->FrameFields.clear();
+  this->FrameTransforms = std::move(frameTransforms);
+  this->InvalidateFieldStrings();
+  for (std::vector<std::pair<std::string, std::string> >::iterator field = frameFields.begin(); field != frameFields.end(); ++field)
+  {
+    if (this->SetFrameField(std::move(field->first), std::move(field->second)) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to set TrackedFrame from binary data - unable to set frame fields!");
+      return IGSIO_FAIL;
     }
   }
+  this->Timestamp = timestamp;
+  this->SetFiducialPointsCoordinatePx(fiducialPoints);
 
   return IGSIO_SUCCESS;
 }
@@ -291,15 +1092,71 @@ void igsioTrackedFrame::SetImageData(const igsioVideoFrame& value)
 
   // Update our cached frame size
   this->ImageData.GetFrameSize(this->FrameSize);
+
+  // The stored hash belongs to the previous image
+  if (this->FrameFields.erase(GetImageHashFieldId()) > 0)
+  {
+    this->CustomFieldsValid = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::SetImageData(igsioVideoFrame&& value)
+{
+  this->ImageData = std::move(value);
+
+  // Update our cached frame size
+  this->ImageData.GetFrameSize(this->FrameSize);
+
+  // The stored hash belongs to the previous image
+  if (this->FrameFields.erase(GetImageHashFieldId()) > 0)
+  {
+    this->CustomFieldsValid = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioTrackedFrame::GetImageHash(unsigned long long& hash)
+{
+  const char* hashString = this->GetFrameField(FIELD_IMAGE_HASH);
+  if (hashString != NULL)
+  {
+    return igsioVideoFrame::GetHashFromString(hashString, hash);
+  }
+  return this->ImageData.ComputeHash(hash);
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioTrackedFrame::UpdateImageHashField()
+{
+  unsigned long long hash(0);
+  if (this->ImageData.ComputeHash(hash) != IGSIO_SUCCESS)
+  {
+    return IGSIO_FAIL;
+  }
+  return this->SetFrameField(FIELD_IMAGE_HASH, igsioVideoFrame::GetHashAsString(hash));
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::SetThumbnail(const igsioVideoFrame& value)
+{
+  this->Thumbnail = value;
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::SetThumbnail(igsioVideoFrame&& value)
+{
+  this->Thumbnail = std::move(value);
 }
 
 //----------------------------------------------------------------------------
 void igsioTrackedFrame::SetTimestamp(double value)
 {
   this->Timestamp = value;
-  std::ostringstream strTimestamp;
-  strTimestamp << std::setprecision(FLOATING_POINT_PRECISION) << this->Timestamp;
-  this->FrameFields["Timestamp"] = strTimestamp.str();
+  char timestampString[igsioCommon::DOUBLE_STRING_BUFFER_SIZE];
+  igsioCommon::FormatDouble(this->Timestamp, timestampString);
+  this->FrameFields[GetTimestampFieldId()] = timestampString;
+  this->CustomFieldsValid = false;
 }
 
 //----------------------------------------------------------------------------
@@ -351,7 +1208,7 @@ void igsioTrackedFrame::SetFiducialPointsCoordinatePx(vtkPoints* fiducialPoints)
 }
 
 //----------------------------------------------------------------------------
-void igsioTrackedFrame::SetFrameField(std::string name, std::string value)
+igsioStatus igsioTrackedFrame::SetFrameField(std::string name, std::string value)
 {
   if (STRCASECMP(name.c_str(), "Timestamp") == 0)
   {
@@ -366,7 +1223,112 @@ void igsioTrackedFrame::SetFrameField(std::string name, std::string value)
     }
   }
 
-  this->FrameFields[name] = value;
+  igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
+  const igsioFieldNameId fieldId = fieldNameTable->Intern(name);
+  if (fieldId == igsioFieldNameTable::INVALID_ID)
+  {
+    LOG_ERROR("Unable to set frame field " << name);
+    return IGSIO_FAIL;
+  }
+  const igsioFieldNameId transformFieldId = fieldNameTable->GetTransformFieldId(fieldId);
+  if (transformFieldId == igsioFieldNameTable::INVALID_ID)
+  {
+    this->FrameFields[fieldId] = std::move(value);
+    this->CustomFieldsValid = false;
+    return IGSIO_SUCCESS;
+  }
+
+  // Transforms are parsed once, only the parsed values are stored
+  FrameTransformEntry& entry = this->FrameTransforms[transformFieldId];
+  this->InvalidateTransformFieldString(transformFieldId, transformFieldId != fieldId);
+  if (transformFieldId != fieldId)
+  {
+    entry.Status = igsioCommon::ConvertStringToToolStatus(value);
+    entry.IsStatusDefined = true;
+  }
+  else
+  {
+    entry.NumberOfMatrixElements = ParseTransformString(value.c_str(), entry.Matrix);
+    entry.IsMatrixDefined = true;
+  }
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioTrackedFrame::TransformMapType::iterator igsioTrackedFrame::FindTransformEntry(igsioFieldNameId fieldId, bool& isStatusField)
+{
+  const igsioFieldNameId transformFieldId = igsioFieldNameTable::GetInstance()->GetTransformFieldId(fieldId);
+  if (transformFieldId == igsioFieldNameTable::INVALID_ID)
+  {
+    return this->FrameTransforms.end();
+  }
+  isStatusField = (transformFieldId != fieldId);
+  TransformMapType::iterator entryIterator = this->FrameTransforms.find(transformFieldId);
+  if (entryIterator == this->FrameTransforms.end())
+  {
+    return entryIterator;
+  }
+  const FrameTransformEntry& entry = entryIterator->second;
+  if (isStatusField ? !entry.IsStatusDefined : !entry.IsMatrixDefined)
+  {
+    return this->FrameTransforms.end();
+  }
+  return entryIterator;
+}
+
+//----------------------------------------------------------------------------
+igsioTrackedFrame::TransformMapType::iterator igsioTrackedFrame::FindTransformEntryByName(const std::string& transformFieldName)
+{
+  igsioFieldNameId transformFieldId(igsioFieldNameTable::INVALID_ID);
+  if (!igsioFieldNameTable::GetInstance()->Find(transformFieldName.c_str(), transformFieldId))
+  {
+    return this->FrameTransforms.end();
+  }
+  return this->FrameTransforms.find(transformFieldId);
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::FormatTransformField(const FrameTransformEntry& entry, bool isStatusField, std::string& value)
+{
+  if (isStatusField)
+  {
+    value = igsioCommon::ConvertToolStatusToString(entry.Status);
+    return;
+  }
+
+  // Shortest representation that reads back to the same value, independent of the locale
+  value.clear();
+  for (int i = 0; i < entry.NumberOfMatrixElements; ++i)
+  {
+    igsioCommon::AppendDouble(value, entry.Matrix[i]);
+    value.push_back(' ');
+  }
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::InvalidateFieldStrings()
+{
+  this->TransformFieldStringCache.clear();
+  this->CustomFields.clear();
+  this->CustomFieldsValid = false;
+}
+
+//----------------------------------------------------------------------------
+void igsioTrackedFrame::InvalidateTransformFieldString(igsioFieldNameId transformFieldId, bool isStatusField)
+{
+  std::map<igsioFieldNameId, TransformFieldStrings>::iterator cacheIterator = this->TransformFieldStringCache.find(transformFieldId);
+  if (cacheIterator != this->TransformFieldStringCache.end())
+  {
+    if (isStatusField)
+    {
+      cacheIterator->second.IsStatusStringValid = false;
+    }
+    else
+    {
+      cacheIterator->second.IsMatrixStringValid = false;
+    }
+  }
+  this->CustomFieldsValid = false;
 }
 
 //----------------------------------------------------------------------------
@@ -378,12 +1340,34 @@ const char* igsioTrackedFrame::GetFrameField(const char* fieldName)
     return NULL;
   }
 
-  FieldMapType::iterator fieldIterator;
-  fieldIterator = this->FrameFields.find(fieldName);
+  // Names that were never interned cannot be defined in any frame
+  igsioFieldNameId fieldId(igsioFieldNameTable::INVALID_ID);
+  if (!igsioFieldNameTable::GetInstance()->Find(fieldName, fieldId))
+  {
+    return NULL;
+  }
+
+  FieldIdMapType::iterator fieldIterator = this->FrameFields.find(fieldId);
   if (fieldIterator != this->FrameFields.end())
   {
     return fieldIterator->second.c_str();
   }
+
+  bool isStatusField(false);
+  TransformMapType::iterator entryIterator = this->FindTransformEntry(fieldId, isStatusField);
+  if (entryIterator != this->FrameTransforms.end())
+  {
+    // The string is only created when it is requested and kept until the transform is modified
+    TransformFieldStrings& strings = this->TransformFieldStringCache[entryIterator->first];
+    std::string& value = (isStatusField ? strings.StatusString : strings.MatrixString);
+    bool& isValueValid = (isStatusField ? strings.IsStatusStringValid : strings.IsMatrixStringValid);
+    if (!isValueValid)
+    {
+      FormatTransformField(entryIterator->second, isStatusField, value);
+      isValueValid = true;
+    }
+    return value.c_str();
+  }
   return NULL;
 }
 
@@ -402,11 +1386,38 @@ igsioStatus igsioTrackedFrame::DeleteFrameField(const char* fieldName)
     return IGSIO_FAIL;
   }
 
-  FieldMapType::iterator field = this->FrameFields.find(fieldName);
-  if (field != this->FrameFields.end())
+  igsioFieldNameId fieldId(igsioFieldNameTable::INVALID_ID);
+  if (igsioFieldNameTable::GetInstance()->Find(fieldName, fieldId))
   {
-    this->FrameFields.erase(field);
-    return IGSIO_SUCCESS;
+    FieldIdMapType::iterator field = this->FrameFields.find(fieldId);
+    if (field != this->FrameFields.end())
+    {
+      this->FrameFields.erase(field);
+      this->CustomFieldsValid = false;
+      return IGSIO_SUCCESS;
+    }
+
+    bool isStatusField(false);
+    TransformMapType::iterator entryIterator = this->FindTransformEntry(fieldId, isStatusField);
+    if (entryIterator != this->FrameTransforms.end())
+    {
+      FrameTransformEntry& entry = entryIterator->second;
+      this->InvalidateTransformFieldString(entryIterator->first, isStatusField);
+      if (isStatusField)
+      {
+        entry.IsStatusDefined = false;
+      }
+      else
+      {
+        entry.IsMatrixDefined = false;
+      }
+      if (!entry.IsStatusDefined && !entry.IsMatrixDefined)
+      {
+        this->TransformFieldStringCache.erase(entryIterator->first);
+        this->FrameTransforms.erase(entryIterator);
+      }
+      return IGSIO_SUCCESS;
+    }
   }
   LOG_DEBUG("Failed to delete frame field - could find field " << fieldName);
   return IGSIO_FAIL;
@@ -417,17 +1428,13 @@ igsioStatus igsioTrackedFrame::DeleteFrameField(const char* fieldName)
 bool igsioTrackedFrame::IsFrameTransformNameDefined(const igsioTransformName& transformName)
 {
   std::string toolTransformName;
-  if (transformName.GetTransformName(toolTransformName) != IGSIO_SUCCESS)
+  if (GetTransformFieldName(transformName, toolTransformName) != IGSIO_SUCCESS)
   {
     return false;
   }
-  // Append Transform to the end of the transform name
-  if (!IsTransform(toolTransformName))
-  {
-    toolTransformName.append(TransformPostfix);
-  }
 
-  return this->IsFrameFieldDefined(toolTransformName.c_str());
+  TransformMapType::const_iterator entryIterator = this->FindTransformEntryByName(toolTransformName);
+  return (entryIterator != this->FrameTransforms.end() && entryIterator->second.IsMatrixDefined);
 }
 
 //----------------------------------------------------------------------------
@@ -439,48 +1446,39 @@ bool igsioTrackedFrame::IsFrameFieldDefined(const char* fieldName)
     return false;
   }
 
-  FieldMapType::iterator fieldIterator;
-  fieldIterator = this->FrameFields.find(fieldName);
-  if (fieldIterator != this->FrameFields.end())
+  igsioFieldNameId fieldId(igsioFieldNameTable::INVALID_ID);
+  if (!igsioFieldNameTable::GetInstance()->Find(fieldName, fieldId))
+  {
+    return false;
+  }
+  if (this->FrameFields.find(fieldId) != this->FrameFields.end())
   {
     // field is found
     return true;
   }
-  // field is undefined
-  return false;
+  bool isStatusField(false);
+  return this->FindTransformEntry(fieldId, isStatusField) != this->FrameTransforms.end();
 }
 
 //----------------------------------------------------------------------------
 igsioStatus igsioTrackedFrame::GetFrameTransform(const igsioTransformName& frameTransformName, double transform[16])
 {
   std::string transformName;
-  if (frameTransformName.GetTransformName(transformName) != IGSIO_SUCCESS)
+  if (GetTransformFieldName(frameTransformName, transformName) != IGSIO_SUCCESS)
   {
     LOG_ERROR("Unable to get custom transform, transform name is wrong!");
     return IGSIO_FAIL;
   }
 
-  // Append Transform to the end of the transform name
-  if (!IsTransform(transformName))
-  {
-    transformName.append(TransformPostfix);
-  }
-
-  const char* frameTransformStr = GetFrameField(transformName.c_str());
-  if (frameTransformStr == NULL)
+  TransformMapType::const_iterator entryIterator = this->FindTransformEntryByName(transformName);
+  if (entryIterator == this->FrameTransforms.end() || !entryIterator->second.IsMatrixDefined)
   {
     LOG_ERROR("Unable to get custom transform from name: " << transformName);
     return IGSIO_FAIL;
   }
 
-  // Find default frame transform
-  std::istringstream transformFieldValue(frameTransformStr);
-  double item;
-  int i = 0;
-  while (transformFieldValue >> item && i < 16)
-  {
-    transform[i++] = item;
-  }
+  const FrameTransformEntry& entry = entryIterator->second;
+  std::copy(entry.Matrix, entry.Matrix + entry.NumberOfMatrixElements, transform);
   return IGSIO_SUCCESS;
 }
 
@@ -498,58 +1496,44 @@ igsioStatus igsioTrackedFrame::GetFrameTransform(const igsioTransformName& frame
 igsioStatus igsioTrackedFrame::GetFrameTransformStatus(const igsioTransformName& frameTransformName, ToolStatus& status)
 {
   status = TOOL_INVALID;
-  std::string transformStatusName;
-  if (frameTransformName.GetTransformName(transformStatusName) != IGSIO_SUCCESS)
+  std::string transformName;
+  if (GetTransformFieldName(frameTransformName, transformName) != IGSIO_SUCCESS)
   {
     LOG_ERROR("Unable to get custom transform status, transform name is wrong!");
     return IGSIO_FAIL;
   }
 
-  // Append TransformStatus to the end of the transform name
-  if (IsTransform(transformStatusName))
-  {
-    transformStatusName.append("Status");
-  }
-  else if (!IsTransformStatus(transformStatusName))
-  {
-    transformStatusName.append(TransformStatusPostfix);
-  }
-
-  const char* strStatus = this->GetFrameField(transformStatusName.c_str());
-  if (strStatus == NULL)
+  TransformMapType::const_iterator entryIterator = this->FindTransformEntryByName(transformName);
+  if (entryIterator == this->FrameTransforms.end() || !entryIterator->second.IsStatusDefined)
   {
-    LOG_ERROR("Unable to get custom transform status from name: " << transformStatusName);
+    LOG_ERROR("Unable to get custom transform status from name: " << transformName << STATUS_POSTFIX);
     return IGSIO_FAIL;
   }
 
-  status = igsioCommon::ConvertStringToToolStatus(strStatus);
-
+  status = entryIterator->second.Status;
   return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
 igsioStatus igsioTrackedFrame::SetFrameTransformStatus(const igsioTransformName& frameTransformName, ToolStatus status)
 {
-  std::string transformStatusName;
-  if (frameTransformName.GetTransformName(transformStatusName) != IGSIO_SUCCESS)
+  std::string transformName;
+  if (GetTransformFieldName(frameTransformName, transformName) != IGSIO_SUCCESS)
   {
     LOG_ERROR("Unable to set custom transform status, transform name is wrong!");
     return IGSIO_FAIL;
   }
 
-  // Append TransformStatus to the end of the transform name
-  if (IsTransform(transformStatusName))
-  {
-    transformStatusName.append("Status");
-  }
-  else if (!IsTransformStatus(transformStatusName))
+  const igsioFieldNameId transformFieldId = igsioFieldNameTable::GetInstance()->Intern(transformName);
+  if (transformFieldId == igsioFieldNameTable::INVALID_ID)
   {
-    transformStatusName.append(TransformStatusPostfix);
+    LOG_ERROR("Unable to set custom transform status: " << transformName << STATUS_POSTFIX);
+    return IGSIO_FAIL;
   }
-
-  std::string strStatus = igsioCommon::ConvertToolStatusToString(status);
-
-  this->SetFrameField(transformStatusName, strStatus);
+  FrameTransformEntry& entry = this->FrameTransforms[transformFieldId];
+  entry.Status = status;
+  entry.IsStatusDefined = true;
+  this->InvalidateTransformFieldString(transformFieldId, true);
 
   return IGSIO_SUCCESS;
 }
@@ -557,26 +1541,24 @@ igsioStatus igsioTrackedFrame::SetFrameTransformStatus(const igsioTransformName&
 //----------------------------------------------------------------------------
 igsioStatus igsioTrackedFrame::SetFrameTransform(const igsioTransformName& frameTransformName, double transform[16])
 {
-  std::ostringstream strTransform;
-  for (int i = 0; i < 16; ++i)
-  {
-    strTransform << std::setprecision(FLOATING_POINT_PRECISION) << transform[ i ] << " ";
-  }
-
   std::string transformName;
-  if (frameTransformName.GetTransformName(transformName) != IGSIO_SUCCESS)
+  if (GetTransformFieldName(frameTransformName, transformName) != IGSIO_SUCCESS)
   {
     LOG_ERROR("Unable to get custom transform, transform name is wrong!");
     return IGSIO_FAIL;
   }
 
-  // Append Transform to the end of the transform name
-  if (!IsTransform(transformName))
+  const igsioFieldNameId transformFieldId = igsioFieldNameTable::GetInstance()->Intern(transformName);
+  if (transformFieldId == igsioFieldNameTable::INVALID_ID)
   {
-    transformName.append(TransformPostfix);
+    LOG_ERROR("Unable to set custom transform: " << transformName);
+    return IGSIO_FAIL;
   }
-
-  SetFrameField(transformName, strTransform.str());
+  FrameTransformEntry& entry = this->FrameTransforms[transformFieldId];
+  std::copy(transform, transform + 16, entry.Matrix);
+  entry.NumberOfMatrixElements = 16;
+  entry.IsMatrixDefined = true;
+  this->InvalidateTransformFieldString(transformFieldId, false);
 
   return IGSIO_SUCCESS;
 }
@@ -626,48 +1608,86 @@ std::string igsioTrackedFrame::ConvertFieldStatusToString(TrackedFrameFieldStatu
 //----------------------------------------------------------------------------
 void igsioTrackedFrame::GetFrameFieldNameList(std::vector<std::string>& fieldNames)
 {
+  igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
   fieldNames.clear();
-  for (FieldMapType::const_iterator it = this->FrameFields.begin(); it != this->FrameFields.end(); it++)
+  fieldNames.reserve(this->FrameFields.size() + 2 * this->FrameTransforms.size());
+  for (FieldIdMapType::const_iterator it = this->FrameFields.begin(); it != this->FrameFields.end(); it++)
+  {
+    fieldNames.push_back(fieldNameTable->GetName(it->first));
+  }
+  for (TransformMapType::const_iterator it = this->FrameTransforms.begin(); it != this->FrameTransforms.end(); it++)
+  {
+    const std::string& transformFieldName = fieldNameTable->GetName(it->first);
+    if (it->second.IsMatrixDefined)
+    {
+      fieldNames.push_back(transformFieldName);
+    }
+    if (it->second.IsStatusDefined)
+    {
+      fieldNames.push_back(transformFieldName + STATUS_POSTFIX);
+    }
+  }
+  std::sort(fieldNames.begin(), fieldNames.end());
+}
+
+//----------------------------------------------------------------------------
+const igsioTrackedFrame::FieldMapType& igsioTrackedFrame::GetCustomFields()
+{
+  if (this->CustomFieldsValid)
   {
-    fieldNames.push_back(it->first);
+    return this->CustomFields;
   }
+  igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
+  FieldMapType& customFields = this->CustomFields;
+  customFields.clear();
+  for (FieldIdMapType::const_iterator it = this->FrameFields.begin(); it != this->FrameFields.end(); it++)
+  {
+    customFields[fieldNameTable->GetName(it->first)] = it->second;
+  }
+  for (TransformMapType::const_iterator it = this->FrameTransforms.begin(); it != this->FrameTransforms.end(); it++)
+  {
+    const std::string& transformFieldName = fieldNameTable->GetName(it->first);
+    if (it->second.IsMatrixDefined)
+    {
+      FormatTransformField(it->second, false, customFields[transformFieldName]);
+    }
+    if (it->second.IsStatusDefined)
+    {
+      FormatTransformField(it->second, true, customFields[transformFieldName + STATUS_POSTFIX]);
+    }
+  }
+  this->CustomFieldsValid = true;
+  return customFields;
 }
 
 //----------------------------------------------------------------------------
 void igsioTrackedFrame::GetFrameTransformNameList(std::vector<igsioTransformName>& transformNames)
 {
+  igsioFieldNameTable* fieldNameTable = igsioFieldNameTable::GetInstance();
   transformNames.clear();
-  for (FieldMapType::const_iterator it = this->FrameFields.begin(); it != this->FrameFields.end(); it++)
+  transformNames.reserve(this->FrameTransforms.size());
+  for (TransformMapType::const_iterator it = this->FrameTransforms.begin(); it != this->FrameTransforms.end(); it++)
   {
-    if (IsTransform(it->first))
+    if (it->second.IsMatrixDefined)
     {
+      const std::string& transformFieldName = fieldNameTable->GetName(it->first);
       igsioTransformName trName;
-      trName.SetTransformName(it->first.substr(0, it->first.length() - TransformPostfix.length()).c_str());
+      trName.SetTransformName(transformFieldName.substr(0, transformFieldName.length() - TransformPostfix.length()).c_str());
       transformNames.push_back(trName);
     }
   }
 }
 
 //----------------------------------------------------------------------------
-bool igsioTrackedFrame::IsTransform(std::string str)
+bool igsioTrackedFrame::IsTransform(const std::string& str)
 {
-  if (str.length() <= TransformPostfix.length())
-  {
-    return false;
-  }
-
-  return igsioCommon::IsEqualInsensitive(str.substr(str.length() - TransformPostfix.length()), TransformPostfix);
+  return EndsWithInsensitive(str, TransformPostfix);
 }
 
 //----------------------------------------------------------------------------
-bool igsioTrackedFrame::IsTransformStatus(std::string str)
+bool igsioTrackedFrame::IsTransformStatus(const std::string& str)
 {
-  if (str.length() <= TransformStatusPostfix.length())
-  {
-    return false;
-  }
-
-  return igsioCommon::IsEqualInsensitive(str.substr(str.length() - TransformStatusPostfix.length()), TransformStatusPostfix);
+  return EndsWithInsensitive(str, TransformStatusPostfix);
 }
 
 //----------------------------------------------------------------------------
@@ -9,6 +9,8 @@
 
 #include "vtkigsiocommon_export.h"
 
+#include "igsioFieldNameTable.h"
+#include "igsioFlatMap.h"
 #include "igsioVideoFrame.h"
 
 class vtkMatrix4x4;
@@ -23,6 +25,8 @@ class VTKIGSIOCOMMON_EXPORT igsioTrackedFrame
 {
 public:
   static const char* FIELD_FRIENDLY_DEVICE_NAME;
+  /*! Frame field that stores the hash of the image data, see UpdateImageHashField */
+  static const char* FIELD_IMAGE_HASH;
 
 public:
   static const std::string TransformPostfix;
@@ -34,24 +38,56 @@ public:
   ~igsioTrackedFrame();
   igsioTrackedFrame(const igsioTrackedFrame& frame);
   igsioTrackedFrame& operator=(igsioTrackedFrame const& trackedFrame);
+  /*! Move constructor, takes over the image and the fields of the other frame without copying them */
+  igsioTrackedFrame(igsioTrackedFrame&& frame);
+  /*! Move assignment, takes over the image and the fields of the other frame without copying them */
+  igsioTrackedFrame& operator=(igsioTrackedFrame&& trackedFrame);
 
 public:
   /*! Set image data */
   void SetImageData(const igsioVideoFrame& value);
+  /*! Set image data, taking over the image of the video frame without copying the pixels */
+  void SetImageData(igsioVideoFrame&& value);
 
   /*! Get image data */
   igsioVideoFrame* GetImageData() { return &(this->ImageData); };
 
+  /*!
+    Get the hash of the image data (see igsioVideoFrame::ComputeHash). The value stored in the image hash
+    frame field is returned if it is defined, otherwise the hash is computed.
+  */
+  igsioStatus GetImageHash(unsigned long long& hash);
+
+  /*!
+    Compute the hash of the image data and store it in the image hash frame field. The field is removed
+    when new image data is set, but it is not updated if the pixels are modified through GetImageData().
+  */
+  igsioStatus UpdateImageHashField();
+
+  /*! Set the downsampled version of the image data (see igsioVideoFrame::Downsample) */
+  void SetThumbnail(const igsioVideoFrame& value);
+  /*! Set the downsampled version of the image data, taking over the image of the video frame without copying the pixels */
+  void SetThumbnail(igsioVideoFrame&& value);
+
+  /*! Get the downsampled version of the image data. The thumbnail is empty if it was not created. */
+  igsioVideoFrame* GetThumbnail() { return &(this->Thumbnail); };
+
+  /*! Return true if a thumbnail image is available */
+  bool HasThumbnail() const { return this->Thumbnail.IsImageValid(); };
+
   /*! Set timestamp */
   void SetTimestamp(double value);
 
   /*! Get timestamp */
   double GetTimestamp() { return this->Timestamp; };
 
-  /*! Set frame field */
-  void SetFrameField(std::string name, std::string value);
+  /*! Set frame field. Fails if the name cannot be added to the field name table (see igsioFieldNameTable). */
+  igsioStatus SetFrameField(std::string name, std::string value);
 
-  /*! Get frame field value */
+  /*!
+    Get frame field value, NULL if the field is not defined. The returned string is owned by the frame and
+    remains valid until a field of the frame is set or deleted.
+  */
   const char* GetFrameField(const char* fieldName);
   const char* GetFrameField(const std::string& fieldName);
 
@@ -86,7 +122,7 @@ public:
   /*! Set frame transform */
   igsioStatus SetFrameTransform(const igsioTransformName& frameTransformName, vtkMatrix4x4* transform);
 
-  /*! Get the list of the name of all frame fields */
+  /*! Get the list of the name of all frame fields, including the transform and transform status fields (sorted by name) */
   void GetFrameFieldNameList(std::vector<std::string>& fieldNames);
 
   /*! Get the list of the transform name of all frame transforms*/
@@ -118,41 +154,137 @@ public:
   */
   igsioStatus PrintToXML(vtkXMLDataElement* xmlData, const std::vector<igsioTransformName>& requestedTransforms);
 
-  /*! Serialize Tracked frame human readable data to xml data and return in string */
+  /*!
+    Serialize Tracked frame human readable data to xml data and return in string.
+    The text is written directly (no XML elements are created), the result is the same as printing the element
+    created by PrintToXML. The capacity of the string is reused, so the same string can be used for all frames.
+  */
   igsioStatus GetTrackedFrameInXmlData(std::string& strXmlData, const std::vector<igsioTransformName>& requestedTransforms);
 
-  /*! Deserialize TrackedFrame human readable data from xml data string */
+  /*!
+    Deserialize TrackedFrame human readable data from xml data string.
+    The string is parsed in a single pass, without building an XML document. The frame is not modified if the XML is invalid.
+  */
   igsioStatus SetTrackedFrameFromXmlData(const char* strXmlData);
   /*! Deserialize TrackedFrame human readable data from xml data string */
   igsioStatus SetTrackedFrameFromXmlData(const std::string& xmlData);
 
+  /*!
+    Serialize the tracked frame to compact binary data, e.g., for sending it to another process. Little-endian layout:
+    \li header (64 bytes): "IGTF" magic, format version (uint16), flags (uint16, 1 if the pixel data is big-endian),
+      timestamp (double), frame size (3x uint32), VTK pixel type (uint16), number of scalar components (uint16),
+      image orientation (uint16), image type (uint16), number of fields, transforms and fiducial points (3x uint32,
+      0xFFFFFFFF points if no fiducial points are set), pixel data offset and size in bytes (2x uint64)
+    \li fields: name and value (uint32 length followed by the characters) of each field, except transforms
+    \li transforms: transform field name, flags (uint8, 1: matrix defined, 2: status defined), number of matrix elements (uint8),
+      status (uint8), reserved (uint8), then the matrix elements (double)
+    \li fiducial points: x, y, z (double)
+    \li zero padding to a multiple of 64 bytes, then the pixels, rows and slices tightly packed, in the byte order of the computer
+    Transforms are written in binary form, their string representation is recreated when they are read.
+    Encoded frames and thumbnails are not serialized. The capacity of the vector is reused, so the same vector can be used for all frames.
+    \param includePixelData if false then the data ends at the pixel data offset, the pixels (see igsioVideoFrame::GetConstScalarPointer)
+      can be sent right after it without copying them to the vector
+  */
+  igsioStatus GetTrackedFrameInBinaryData(std::vector<unsigned char>& binaryData, bool includePixelData = true);
+
+  /*!
+    Deserialize the tracked frame from binary data created by GetTrackedFrameInBinaryData. All fields, transforms,
+    fiducial points and the image of the frame are replaced. The frame is not modified if the data is invalid.
+    \param copyPixelData if false then the image of the frame uses the pixels in the input buffer without copying them
+      (see igsioVideoFrame::SetExternalPixelBuffer), the buffer must remain valid while the image of this frame (or a copy of it) is used.
+      The pixels are copied anyway if they are not aligned to the scalar size or their byte order has to be swapped.
+  */
+  igsioStatus SetTrackedFrameFromBinaryData(const unsigned char* binaryData, size_t binaryDataSize, bool copyPixelData = true);
+
   /*! Convert from field status string to field status enum */
   static TrackedFrameFieldStatus ConvertFieldStatusFromString(const char* statusStr);
 
   /*! Convert from field status enum to field status string */
   static std::string ConvertFieldStatusToString(TrackedFrameFieldStatus status);
 
-  /*! Return all custom fields in a map */
-  const FieldMapType& GetCustomFields() { return this->FrameFields; }
+  /*!
+    Return all custom fields in a map. Transforms and transform statuses are converted to strings.
+    The map is rebuilt when it is requested after the fields are modified.
+  */
+  const FieldMapType& GetCustomFields();
 
   /*! Returns true if the input string ends with "Transform", else false */
-  static bool IsTransform(std::string str);
+  static bool IsTransform(const std::string& str);
 
   /*! Returns true if the input string ends with "TransformStatus", else false */
-  static bool IsTransformStatus(std::string str);
+  static bool IsTransformStatus(const std::string& str);
 
 public:
-  bool operator< (igsioTrackedFrame data) { return Timestamp < data.Timestamp; }
+  bool operator< (const igsioTrackedFrame& data) const { return Timestamp < data.Timestamp; }
   bool operator== (const igsioTrackedFrame& data) const
   {
     return (Timestamp == data.Timestamp);
   }
 
+protected:
+  /*!
+    Transform and transform status fields are stored in binary form, so that they are not parsed each time
+    they are accessed. String representations are created from the binary form when the fields are requested.
+  */
+  struct FrameTransformEntry
+  {
+    FrameTransformEntry();
+    double Matrix[16];
+    int NumberOfMatrixElements; // less than 16 if the transform was set from a string with missing elements
+    ToolStatus Status;
+    bool IsMatrixDefined;
+    bool IsStatusDefined;
+  };
+  /*!
+    Transform entries keyed by the interned name of the transform field (e.g., ProbeToTrackerTransform).
+    Stored separately from the other fields, so transforms can be listed without checking the field names.
+  */
+  typedef igsioFlatMap<igsioFieldNameId, FrameTransformEntry> TransformMapType;
+  /*! Field values keyed by the interned field name, see igsioFieldNameTable */
+  typedef igsioFlatMap<igsioFieldNameId, std::string> FieldIdMapType;
+
+  /*! Get the transform entry that stores a transform or transform status field, end() if not found or not a transform field */
+  TransformMapType::iterator FindTransformEntry(igsioFieldNameId fieldId, bool& isStatusField);
+  /*! Get the transform entry of a transform field name (e.g., ProbeToTrackerTransform), end() if not found */
+  TransformMapType::iterator FindTransformEntryByName(const std::string& transformFieldName);
+
+  /*! Get the name of the fields that are serialized by PrintToXML, in the order they are written */
+  void GetSerializedFieldNameList(const std::vector<igsioTransformName>& requestedTransforms, std::vector<std::string>& fieldNames);
+
+  /*! Format the value of a transform or transform status field into a string */
+  static void FormatTransformField(const FrameTransformEntry& entry, bool isStatusField, std::string& value);
+
+  /*! Discard the string representations of all fields, called when all fields of the frame are replaced */
+  void InvalidateFieldStrings();
+  /*! Mark the string representation of a transform or transform status field out of date */
+  void InvalidateTransformFieldString(igsioFieldNameId transformFieldId, bool isStatusField);
+
 protected:
   igsioVideoFrame ImageData;
+  igsioVideoFrame Thumbnail;
   double Timestamp;
 
-  FieldMapType FrameFields;
+  /*! Frame fields, except transforms and transform statuses */
+  FieldIdMapType FrameFields;
+  TransformMapType FrameTransforms;
+
+  /*! String representations of a transform entry, created by GetFrameField */
+  struct TransformFieldStrings
+  {
+    TransformFieldStrings() : IsMatrixStringValid(false), IsStatusStringValid(false) {}
+    std::string MatrixString;
+    std::string StatusString;
+    bool IsMatrixStringValid;
+    bool IsStatusStringValid;
+  };
+  /*!
+    Strings returned by GetFrameField for transform fields, keyed by the transform field id.
+    An entry is only marked out of date when its transform is modified.
+  */
+  std::map<igsioFieldNameId, TransformFieldStrings> TransformFieldStringCache;
+  /*! All fields as strings, created by GetCustomFields */
+  FieldMapType CustomFields;
+  bool CustomFieldsValid;
 
   FrameSizeType FrameSize;
   std::string   EncodingFourCC;
@@ -175,6 +307,7 @@ enum TrackedFrameValidationRequirements
   REQUIRE_CHANGED_ENCODER_POSITION = 0x0004, /*!<  the stepper encoder position shall be different from the previous ones  */
   REQUIRE_SPEED_BELOW_THRESHOLD = 0x0008, /*!<  the frame acquisition speed shall be less than a threshold */
   REQUIRE_CHANGED_TRANSFORM = 0x0010, /*!<  the transform defined by name shall be different from the previous ones  */
+  REQUIRE_CHANGED_IMAGE = 0x0020, /*!<  the image shall be different from the image of the previous frame  */
 };
 
 /*!
@@ -7,1281 +7,2889 @@ See License.txt for details.
 // Local includes
 //#include "PlusConfigure.h"
 #include "igsioVideoFrame.h"
+#include "igsioVideoFrameBufferPool.h"
+#include "igsioVideoFrameKernels.h"
+#include "igsioVideoFrameView.h"
 
 // VTK includes
 #include <vtkBMPReader.h>
+#include <vtkDataArray.h>
 #include <vtkExtractVOI.h>
 #include <vtkImageData.h>
-#include <vtkImageImport.h>
 #include <vtkImageReader.h>
+#include <vtkInformation.h>
+#include <vtkInformationIntegerKey.h>
+#include <vtkMultiThreader.h>
 #include <vtkObjectFactory.h>
 #include <vtkPNMReader.h>
+#include <vtkPointData.h>
 #include <vtkSmartPointer.h>
 #include <vtkTIFFReader.h>
 #include <vtkTrivialProducer.h>
 #include <vtkUnsignedCharArray.h>
+#include <vtkVersionMacros.h>
 
 // STL includes
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 
 namespace
 {
+  // Minimum number of output bytes processed by a thread, smaller images are not split between threads
+  const vtkIdType MINIMUM_FLIP_CLIP_BYTES_PER_THREAD = 64 * 1024;
+
+  // Number of threads used by FlipClipImage and FlipClipImages, 0 means vtkMultiThreader default
+  std::atomic<int> FlipClipNumberOfThreads(1);
+
+  // Number of threads used by ConvertPixelType and ConvertPixelTypes, 0 means vtkMultiThreader default
+  std::atomic<int> PixelConversionNumberOfThreads(1);
+
+  // If enabled then copies of a video frame share the pixel buffer until one of them is modified
+  std::atomic<bool> CopyOnWriteEnabled(false);
+
+  // Alignment of the first pixel of newly allocated pixel buffers in bytes, 0 means default VTK allocation
+  std::atomic<unsigned int> PixelBufferAlignment(0);
+
+  // On Windows memory allocated by _aligned_malloc can only be released by VTK 8.1 and later
+#if defined(_WIN32) && !(VTK_MAJOR_VERSION > 8 || (VTK_MAJOR_VERSION == 8 && VTK_MINOR_VERSION >= 1))
+  const bool ALIGNED_ALLOCATION_SUPPORTED = false;
+#else
+  const bool ALIGNED_ALLOCATION_SUPPORTED = true;
+#endif
+
   //----------------------------------------------------------------------------
-  template<class ScalarType>
-  igsioStatus FlipClipImageGeneric(vtkImageData* inputImage, const igsioVideoFrame::FlipInfoType& flipInfo, const std::array<int, 3>& clipRectangleOrigin, const std::array<int, 3>& clipRectangleSize, vtkImageData* outputImage)
+  bool IsPointerAligned(const void* pointer, unsigned int alignmentInBytes)
   {
-    const int numberOfScalarComponents = inputImage->GetNumberOfScalarComponents();
-
-    int dims[3] = {0, 0, 0};
-    inputImage->GetDimensions(dims);
+    return alignmentInBytes == 0 || reinterpret_cast<size_t>(pointer) % alignmentInBytes == 0;
+  }
 
-    int localClipRectangleSize[3] = {clipRectangleSize[0], clipRectangleSize[1], clipRectangleSize[2]};
+  //----------------------------------------------------------------------------
+  // All parameters needed for converting one image, described by raw pointers and strides (in bytes),
+  // so that the same implementation serves vtkImageData and plain memory buffers. The work is split into
+  // units (output rows, output slices or output columns, depending on the operation) that can be processed independently.
+  struct FlipClipTask
+  {
+    const unsigned char* InputPixels;
+    unsigned char* OutputPixels;
+    int InputDimensions[3];
+    int OutputDimensions[3];
+    vtkIdType InputRowStride;
+    vtkIdType InputSliceStride;
+    vtkIdType OutputRowStride;
+    vtkIdType OutputSliceStride;
+    int ScalarSize;
+    int NumberOfScalarComponents;
+    igsioVideoFrame::FlipInfoType FlipInfo;
+    std::array<int, 3> ClipRectangleOrigin;
+    std::array<int, 3> ClipRectangleSize;
+    bool SwapBytes; // reverse the byte order of each scalar while copying, only set for multi-byte scalars
+  };
 
-    int inputWidth(dims[0]);
-    int inputHeight(dims[1]);
-    // TODO : when flipping of 3D data is implemented, inputDepth will be needed
-    //int inputDepth( dims[2] );
+  //----------------------------------------------------------------------------
+  // Marks pixel arrays that wrap memory owned by the caller of SetExternalPixelBuffer
+  vtkInformationIntegerKey* GetExternalPixelBufferKey()
+  {
+    static vtkInformationIntegerKey* key = vtkInformationIntegerKey::MakeKey("EXTERNAL_PIXEL_BUFFER", "igsioVideoFrame");
+    return key;
+  }
 
-    int outputDims[3] = {0, 0, 0};
-    outputImage->GetDimensions(outputDims);
-    int outputWidth(outputDims[0]);
-    int outputHeight(outputDims[1]);
-    int outputDepth(outputDims[2]);
+  //----------------------------------------------------------------------------
+  // Marks pixel arrays that were shared between frames by a copy made while copy-on-write was enabled
+  vtkInformationIntegerKey* GetSharedPixelBufferKey()
+  {
+    static vtkInformationIntegerKey* key = vtkInformationIntegerKey::MakeKey("SHARED_PIXEL_BUFFER", "igsioVideoFrame");
+    return key;
+  }
 
-    void* inBuff = inputImage->GetScalarPointer();
-    void* outBuff = outputImage->GetScalarPointer();
+  //----------------------------------------------------------------------------
+  bool IsExternalScalars(vtkDataArray* scalars)
+  {
+    return scalars != NULL && scalars->HasInformation() && scalars->GetInformation()->Has(GetExternalPixelBufferKey());
+  }
 
-    vtkIdType pixelIncrement(0);
-    vtkIdType inputRowIncrement(0);
-    vtkIdType inputImageIncrement(0);
-    inputImage->GetIncrements(pixelIncrement, inputRowIncrement, inputImageIncrement);
+  //----------------------------------------------------------------------------
+  bool IsSharedScalars(vtkDataArray* scalars)
+  {
+    return scalars != NULL && scalars->HasInformation() && scalars->GetInformation()->Has(GetSharedPixelBufferKey());
+  }
 
-    vtkIdType outputRowIncrement(0);
-    vtkIdType outputImageIncrement(0);
-    outputImage->GetIncrements(pixelIncrement, outputRowIncrement, outputImageIncrement);
+  //----------------------------------------------------------------------------
+  // Remove the sharing marks from a pixel array that is owned by a single frame
+  void ClearPixelBufferKeys(vtkDataArray* scalars)
+  {
+    if (scalars != NULL && scalars->HasInformation())
+    {
+      scalars->GetInformation()->Remove(GetExternalPixelBufferKey());
+      scalars->GetInformation()->Remove(GetSharedPixelBufferKey());
+    }
+  }
 
-    if (flipInfo.doubleRow)
+  //----------------------------------------------------------------------------
+  // Offer the pixel buffer of an image to the frame buffer pool, if no other image uses the same buffer.
+  // External buffers are never pooled, their memory is owned by the caller.
+  void ReturnImageScalarsToPool(vtkImageData* image)
+  {
+    vtkDataArray* scalars = image->GetPointData()->GetScalars();
+    if (scalars != NULL && scalars->GetReferenceCount() == 1 && !IsExternalScalars(scalars))
     {
-      if (inputHeight % 2 != 0)
-      {
-        LOG_ERROR("Cannot flip image with pairs of rows kept together, as number of rows is odd (" << inputHeight << ")");
-        return IGSIO_FAIL;
-      }
-      // TODO : I don't think this is correct if transposition is happening... double check
-      inputWidth *= 2;
-      outputWidth *= 2;
+      ClearPixelBufferKeys(scalars);
+      igsioVideoFrameBufferPool::GetInstance()->Return(scalars);
+    }
+  }
 
-      inputHeight /= 2;
-      outputHeight /= 2;
+  //----------------------------------------------------------------------------
+  // Create a pixel array in a memory block that starts at an alignmentInBytes boundary. The block size is rounded
+  // up to a multiple of the alignment, so that vectorized loops may access the whole last vector of the buffer.
+  // Returns NULL if the allocation failed.
+  vtkDataArray* CreateAlignedScalars(int pixelType, int numberOfScalarComponents, vtkIdType numberOfPixels, unsigned int alignmentInBytes)
+  {
+    vtkDataArray* scalars = vtkDataArray::CreateDataArray(pixelType);
+    if (scalars == NULL)
+    {
+      return NULL;
+    }
+    const vtkIdType numberOfValues = numberOfPixels * numberOfScalarComponents;
+    size_t blockSizeInBytes = static_cast<size_t>(numberOfValues) * scalars->GetDataTypeSize();
+    blockSizeInBytes = std::max<size_t>((blockSizeInBytes + alignmentInBytes - 1) / alignmentInBytes * alignmentInBytes, alignmentInBytes);
+
+    void* block = NULL;
+#if defined(_WIN32)
+#if VTK_MAJOR_VERSION > 8 || (VTK_MAJOR_VERSION == 8 && VTK_MINOR_VERSION >= 1)
+    block = _aligned_malloc(blockSizeInBytes, alignmentInBytes);
+    const int deleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_ALIGNED_FREE;
+#else
+    const int deleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+#endif
+#else
+    if (posix_memalign(&block, alignmentInBytes, blockSizeInBytes) != 0)
+    {
+      block = NULL;
+    }
+    const int deleteMethod = vtkAbstractArray::VTK_DATA_ARRAY_FREE;
+#endif
+    if (block == NULL)
+    {
+      scalars->Delete();
+      return NULL;
+    }
 
-      localClipRectangleSize[0] *= 2;
-      localClipRectangleSize[1] /= 2;
+    scalars->SetNumberOfComponents(numberOfScalarComponents);
+    scalars->SetVoidArray(block, numberOfValues, 0, deleteMethod);
+    return scalars;
+  }
 
-      inputRowIncrement *= 2;
-      outputRowIncrement *= 2;
+  //----------------------------------------------------------------------------
+  // Create a pixel array, taken from the frame buffer pool if the pool is enabled.
+  // If an alignment is set then the first pixel of the array is aligned (pooled buffers that are not aligned are released).
+  vtkDataArray* CreateScalars(int pixelType, int numberOfScalarComponents, vtkIdType numberOfPixels)
+  {
+    const unsigned int alignmentInBytes = PixelBufferAlignment.load();
+    vtkDataArray* scalars = igsioVideoFrameBufferPool::GetInstance()->Acquire(pixelType, numberOfScalarComponents, numberOfPixels);
+    if (scalars != NULL && !IsPointerAligned(scalars->GetVoidPointer(0), alignmentInBytes))
+    {
+      scalars->Delete();
+      scalars = NULL;
     }
-    if (flipInfo.doubleColumn)
+    if (scalars == NULL && alignmentInBytes > 0)
     {
-      if (inputWidth % 2 != 0)
+      scalars = CreateAlignedScalars(pixelType, numberOfScalarComponents, numberOfPixels, alignmentInBytes);
+      if (scalars == NULL)
       {
-        LOG_ERROR("Cannot flip image with pairs of columns kept together, as number of columns is odd (" << inputWidth << ")");
-        return IGSIO_FAIL;
+        LOG_WARNING("Failed to allocate aligned pixel buffer, the default allocation is used");
       }
     }
-
-    if (!flipInfo.hFlip && flipInfo.vFlip && !flipInfo.eFlip && flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_NONE)
+    if (scalars == NULL)
     {
-      // flip Y
-      for (int z = 0; z < outputDepth; z++)
+      scalars = vtkDataArray::CreateDataArray(pixelType);
+      if (scalars != NULL)
       {
-        // Set the input position to be the first unclipped pixel in the input image
-        ScalarType* inputPixel = (ScalarType*)inBuff + (clipRectangleOrigin[2] + z) * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * pixelIncrement;
-
-        // Set the target position pointer to the first pixel of the last row of each output image
-        ScalarType* outputPixel = (ScalarType*)outBuff + outputImageIncrement * z + (outputHeight - 1) * outputRowIncrement;
-        // Copy the image row-by-row, reversing the row order
-        for (int y = 0; y < outputHeight; y++)
-        {
-          memcpy(outputPixel, inputPixel, outputWidth * pixelIncrement);
-          inputPixel += inputRowIncrement;
-          outputPixel -= outputRowIncrement;
-        }
+        scalars->SetNumberOfComponents(numberOfScalarComponents);
+        scalars->SetNumberOfTuples(numberOfPixels);
       }
     }
-    else if (flipInfo.hFlip && !flipInfo.vFlip && !flipInfo.eFlip && flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_NONE)
+    return scalars;
+  }
+
+  //----------------------------------------------------------------------------
+  // Delete the image of a video frame, recycling its pixel buffer if the image is not used elsewhere
+  void DeleteImage(vtkImageData*& image)
+  {
+    if (image != NULL && image->GetReferenceCount() == 1)
+    {
+      ReturnImageScalarsToPool(image);
+    }
+    DELETE_IF_NOT_NULL(image);
+  }
+
+  //----------------------------------------------------------------------------
+  bool IsRowOperation(const igsioVideoFrame::FlipInfoType& flipInfo)
+  {
+    return flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_NONE;
+  }
+
+  //----------------------------------------------------------------------------
+  // Compute the clip rectangle that is actually applied and the size of the output image.
+  // If the requested clip rectangle does not fit in the input image then no clipping is performed.
+  void ComputeFlipClipGeometry(const int inputDimensions[3], const igsioVideoFrame::FlipInfoType& flipInfo,
+                               const std::array<int, 3>& clipRectangleOrigin, const std::array<int, 3>& clipRectangleSize,
+                               std::array<int, 3>& finalClipOrigin, std::array<int, 3>& finalClipSize, int finalOutputSize[3], bool logWarnings)
+  {
+    finalClipOrigin[0] = 0;
+    finalClipOrigin[1] = 0;
+    finalClipOrigin[2] = 0;
+    finalClipSize[0] = inputDimensions[0];
+    finalClipSize[1] = inputDimensions[1];
+    finalClipSize[2] = inputDimensions[2];
+    if (igsioCommon::IsClippingRequested(clipRectangleOrigin, clipRectangleSize))
     {
-      // flip X
-      if (flipInfo.doubleColumn)
+      // Clipping requested, validate that source image is bigger than requested clip size
+      int inExtents[6] = {0, inputDimensions[0] - 1, 0, inputDimensions[1] - 1, 0, inputDimensions[2] - 1};
+      if (!igsioCommon::IsClippingWithinExtents(clipRectangleOrigin, clipRectangleSize, inExtents))
       {
-        // flip X double column
-        for (int z = 0; z < outputDepth; z++)
+        if (logWarnings)
         {
-          // Set the input position to be the first unclipped pixel in the input image
-          ScalarType* inputPixel = (ScalarType*)inBuff + (clipRectangleOrigin[2] + z) * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * 2 * pixelIncrement;
-
-          // Set the target position pointer to the last pixel of the first row of each output image
-          ScalarType* outputPixel = (ScalarType*)outBuff + outputImageIncrement * z + outputWidth * 2 * pixelIncrement - 2 * pixelIncrement;
-          // Copy the image row-by-row, reversing the pixel order in each row
-          for (int y = 0; y < outputHeight; y++)
-          {
-            for (int x = 0; x < outputWidth; x++)
-            {
-              // For each scalar, copy it
-              for (int s = 0; s < numberOfScalarComponents; ++s)
-              {
-                *(outputPixel - 1 * numberOfScalarComponents + s) = *(inputPixel + s);
-                *(outputPixel + s) = *(inputPixel + 1 * numberOfScalarComponents + s);
-              }
-              inputPixel += 2 * pixelIncrement;
-              outputPixel -= 2 * pixelIncrement;
-            }
-            // bring the output back to the end of the next row
-            outputPixel += 2 * outputRowIncrement;
-            // wrap the input to the beginning of the next clipped row
-            inputPixel += (inputWidth - localClipRectangleSize[0]) * 2 * pixelIncrement;
-          }
+          LOG_WARNING("Clipping information cannot fit within the original image. No clipping will be performed. Origin=[" << clipRectangleOrigin[0] << "," << clipRectangleOrigin[1] << "," << clipRectangleOrigin[2] <<
+                      "]. Size=[" << clipRectangleSize[0] << "," << clipRectangleSize[1] << "," << clipRectangleSize[2] << "].");
         }
       }
       else
       {
-        // flip X single column
-        for (int z = 0; z < outputDepth; z++)
-        {
-          // Set the input position to be the first unclipped pixel in the input image
-          ScalarType* inputPixel = (ScalarType*)inBuff + (clipRectangleOrigin[2] + z) * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * pixelIncrement;
-
-          // Set the target position pointer to the last pixel of the first row of each output image
-          ScalarType* outputPixel = (ScalarType*)outBuff + z * outputImageIncrement + (outputWidth - 1) * pixelIncrement;
-          // Copy the image row-by-row, reversing the pixel order in each row
-          for (int y = 0; y < outputHeight; y++)
-          {
-            for (int x = 0; x < outputWidth; x++)
-            {
-              // For each scalar, copy it
-              for (int s = 0; s < numberOfScalarComponents; ++s)
-              {
-                *(outputPixel + s) = *(inputPixel + s);
-              }
-              inputPixel += pixelIncrement;
-              outputPixel -= pixelIncrement;
-            }
-            // bring the output back to the end of the next row
-            outputPixel += 2 * outputRowIncrement;
-            // wrap the input to the beginning of the next clipped row
-            inputPixel += (inputWidth - localClipRectangleSize[0]) * pixelIncrement;
-          }
-        }
+        finalClipOrigin = clipRectangleOrigin;
+        finalClipSize = clipRectangleSize;
       }
     }
-    else if (flipInfo.hFlip && flipInfo.vFlip && !flipInfo.eFlip && flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_NONE)
+
+    finalOutputSize[0] = finalClipSize[0];
+    finalOutputSize[1] = finalClipSize[1];
+    finalOutputSize[2] = finalClipSize[2];
+
+    // Adjust output image dimensions to account for transposition of axes
+    if (flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_IJKtoKIJ)
+    {
+      finalOutputSize[0] = finalClipSize[2];
+      finalOutputSize[1] = finalClipSize[0];
+      finalOutputSize[2] = finalClipSize[1];
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  igsioStatus ValidateFlipClipTask(const FlipClipTask& task)
+  {
+    const igsioVideoFrame::FlipInfoType& flipInfo = task.FlipInfo;
+    const int* inputDims = task.InputDimensions;
+    const int* outputDims = task.OutputDimensions;
+
+    if (flipInfo.doubleRow && (inputDims[1] % 2 != 0 || (IsRowOperation(flipInfo) && outputDims[1] % 2 != 0)))
+    {
+      LOG_ERROR("Cannot flip image with pairs of rows kept together, as number of rows is odd (" << inputDims[1] << ", clipped: " << outputDims[1] << ")");
+      return IGSIO_FAIL;
+    }
+    if (flipInfo.doubleColumn && (inputDims[0] % 2 != 0 || (flipInfo.hFlip && outputDims[0] % 2 != 0)))
+    {
+      LOG_ERROR("Cannot flip image with pairs of columns kept together, as number of columns is odd (" << inputDims[0] << ", clipped: " << outputDims[0] << ")");
+      return IGSIO_FAIL;
+    }
+
+    if (!IsRowOperation(flipInfo) && (flipInfo.hFlip || flipInfo.vFlip || flipInfo.eFlip))
+    {
+      LOG_ERROR("Operation not permitted. " << std::endl << "flipInfo.hFlip: " << (flipInfo.hFlip ? "TRUE" : "FALSE") << std::endl <<
+                "flipInfo.vFlip: " << (flipInfo.vFlip ? "TRUE" : "FALSE") << std::endl <<
+                "flipInfo.eFlip: " << (flipInfo.eFlip ? "TRUE" : "FALSE") << std::endl <<
+                "flipInfo.tranpose: " << igsioVideoFrame::TransposeToString(flipInfo.tranpose) << std::endl <<
+                "flipInfo.doubleColumn: " << (flipInfo.doubleColumn ? "TRUE" : "FALSE") << std::endl <<
+                "flipInfo.doubleRow: " << (flipInfo.doubleRow ? "TRUE" : "FALSE"));
+      return IGSIO_FAIL;
+    }
+
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  vtkIdType GetNumberOfFlipClipWorkUnits(const FlipClipTask& task)
+  {
+    const int* outputDims = task.OutputDimensions;
+    if (IsRowOperation(task.FlipInfo))
+    {
+      // one unit is one output row
+      return static_cast<vtkIdType>(outputDims[1]) * outputDims[2];
+    }
+    if (!task.FlipInfo.doubleRow && !task.FlipInfo.doubleColumn)
+    {
+      // transposition: one unit is one output slice (one input row in all input slices)
+      return outputDims[2];
+    }
+    // transposition keeping pairs of rows or columns together: one unit is one output column (one input slice)
+    return outputDims[0];
+  }
+
+  //----------------------------------------------------------------------------
+  // Flip along any combination of the X, Y and Z axes (or just clip). Each output row is copied from an input row,
+  // reversing the pixel order if horizontal flip is requested. The reversal is done by the fastest
+  // kernel that the CPU supports. With doubleColumn, pairs of columns are kept together; with doubleRow,
+  // pairs of rows are kept together (horizontal flip reverses the two rows of a pair as one concatenated row).
+  // The flip axes are template parameters, so the row loop does not test them.
+  template<bool HorizontalFlip, bool VerticalFlip, bool ElevationFlip>
+  igsioStatus FlipRows(const FlipClipTask& task, vtkIdType firstUnit, vtkIdType lastUnit)
+  {
+    const igsioVideoFrame::FlipInfoType& flipInfo = task.FlipInfo;
+    const int outputWidth(task.OutputDimensions[0]);
+    const int outputHeight(task.OutputDimensions[1]);
+    const int outputDepth(task.OutputDimensions[2]);
+
+    // A group is the unit that is kept together while reversing the order in a row
+    const size_t pixelSizeInBytes = task.ScalarSize * task.NumberOfScalarComponents;
+    const size_t pixelsPerGroup = (flipInfo.doubleColumn ? 2 : 1);
+    const size_t groupSizeInBytes = pixelsPerGroup * pixelSizeInBytes;
+    const size_t groupsPerRow = outputWidth / pixelsPerGroup;
+    const size_t rowSizeInBytes = outputWidth * pixelSizeInBytes;
+    const size_t scalarsPerRow = rowSizeInBytes / task.ScalarSize;
+    igsioVideoFrameKernels::ReverseGroupsFunctionType reverseGroups = igsioVideoFrameKernels::GetReverseGroupsFunction(groupSizeInBytes);
+    igsioVideoFrameKernels::SwapBytesFunctionType swapBytes = (task.SwapBytes ? igsioVideoFrameKernels::GetSwapBytesFunction(task.ScalarSize) : NULL);
+
+    const unsigned char* inputFirstPixel = task.InputPixels + task.ClipRectangleOrigin[2] * task.InputSliceStride
+                                           + task.ClipRectangleOrigin[1] * task.InputRowStride + task.ClipRectangleOrigin[0] * pixelSizeInBytes;
+
+    // vertical flip keeps the row order within a pair, horizontal flip swaps the two rows
+    const int rowPairSwap = ((flipInfo.doubleRow && VerticalFlip != HorizontalFlip) ? 1 : 0);
+
+    for (vtkIdType unit = firstUnit; unit < lastUnit; ++unit)
     {
-      // flip X and Y
-      if (flipInfo.doubleColumn)
+      const int z = static_cast<int>(unit / outputHeight);
+      const int y = static_cast<int>(unit % outputHeight);
+
+      // Determine which input row is written into output row y of slice z
+      const int inputSlice = (ElevationFlip ? outputDepth - 1 - z : z);
+      const int inputRow = (VerticalFlip ? outputHeight - 1 - y : y) ^ rowPairSwap;
+
+      const unsigned char* inputPixel = inputFirstPixel + inputSlice * task.InputSliceStride + inputRow * task.InputRowStride;
+      unsigned char* outputPixel = task.OutputPixels + z * task.OutputSliceStride + y * task.OutputRowStride;
+      if (HorizontalFlip)
       {
-        // flip X and Y double column
-        for (int z = 0; z < outputDepth; z++)
+        reverseGroups(outputPixel, inputPixel, groupsPerRow, groupSizeInBytes);
+        if (swapBytes != NULL)
         {
-          // Set the input position to be the first unclipped pixel in the input image
-          ScalarType* inputPixel = (ScalarType*)inBuff + (clipRectangleOrigin[2] + z) * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * 2 * pixelIncrement;
-
-          // Set the target position pointer to the last pixel of each output image
-          ScalarType* outputPixel = (ScalarType*)outBuff + outputImageIncrement * (z + 1) - 2 * pixelIncrement;
-          // Copy the image pixel-by-pixel, reversing the pixel order
-          for (int y = 0; y < outputHeight; y++)
-          {
-            for (int x = 0; x < outputWidth; x++)
-            {
-              // For each scalar, copy it
-              for (int s = 0; s < numberOfScalarComponents; ++s)
-              {
-                *(outputPixel + s) = *(inputPixel + s);
-              }
-              inputPixel += 2 * pixelIncrement;
-              outputPixel -= 2 * pixelIncrement;
-            }
-            // wrap the input to the beginning of the next clipped row
-            inputPixel += (inputWidth - localClipRectangleSize[0]) * 2 * pixelIncrement;
-          }
+          // the row was just written, swap it while it is still in the cache
+          swapBytes(outputPixel, outputPixel, scalarsPerRow);
         }
       }
+      else if (swapBytes != NULL)
+      {
+        swapBytes(outputPixel, inputPixel, scalarsPerRow);
+      }
       else
       {
-        // flip X and Y single column
-        for (int z = 0; z < outputDepth; z++)
-        {
-          // Set the input position to be the first unclipped pixel in the input image
-          ScalarType* inputPixel = (ScalarType*)inBuff + (clipRectangleOrigin[2] + z) * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * pixelIncrement;
-
-          // Set the target position pointer to the last pixel of each output image
-          ScalarType* outputPixel = (ScalarType*)outBuff + outputImageIncrement * (z + 1) - 1 * pixelIncrement;
-          // Copy the image pixel-by-pixel, reversing the pixel order
-          for (int y = 0; y < outputHeight; y++)
-          {
-            for (int x = 0; x < outputWidth; x++)
-            {
-              // For each scalar, copy it
-              for (int s = 0; s < numberOfScalarComponents; ++s)
-              {
-                *(outputPixel + s) = *(inputPixel + s);
-              }
-              inputPixel += pixelIncrement;
-              outputPixel -= pixelIncrement;
-            }
-            // wrap the input to the beginning of the next clipped row
-            inputPixel += (inputWidth - localClipRectangleSize[0]) * pixelIncrement;
-          }
-        }
+        memcpy(outputPixel, inputPixel, rowSizeInBytes);
       }
     }
-    else if (!flipInfo.hFlip && !flipInfo.vFlip && flipInfo.eFlip && flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_NONE)
-    {
-      // flip Z
 
-      // Set the input position to the first unclipped pixel
-      ScalarType* inputPixel = (ScalarType*)inBuff + clipRectangleOrigin[2] * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * pixelIncrement;
+    return IGSIO_SUCCESS;
+  }
 
-      for (int z = outputDepth - 1; z >= 0; z--)
-      {
-        // Set the target position pointer to the first pixel of the each image
-        ScalarType* outputPixel = (ScalarType*)outBuff + z * outputImageIncrement;
+  //----------------------------------------------------------------------------
+  // Transpose an image in KIJ layout to IJK layout. Units are output slices. Each output slice
+  // is the transpose of a 2D array that contains the same input row from all input slices,
+  // which is done by a cache blocked kernel specialized for the pixel size.
+  igsioStatus TransposeSlices(const FlipClipTask& task, vtkIdType firstUnit, vtkIdType lastUnit)
+  {
+    const size_t pixelSizeInBytes = task.ScalarSize * task.NumberOfScalarComponents;
+    igsioVideoFrameKernels::TransposeFunctionType transpose = igsioVideoFrameKernels::GetTransposeFunction(pixelSizeInBytes);
+    igsioVideoFrameKernels::SwapBytesFunctionType swapBytes = (task.SwapBytes ? igsioVideoFrameKernels::GetSwapBytesFunction(task.ScalarSize) : NULL);
+    const size_t scalarsPerRow = task.OutputDimensions[0] * task.NumberOfScalarComponents;
 
-        // Copy the image row-by-row
-        for (int y = 0; y < outputHeight; y++)
+    const unsigned char* inputFirstPixel = task.InputPixels + task.ClipRectangleOrigin[2] * task.InputSliceStride
+                                           + task.ClipRectangleOrigin[1] * task.InputRowStride + task.ClipRectangleOrigin[0] * pixelSizeInBytes;
+
+    for (vtkIdType slice = firstUnit; slice < lastUnit; ++slice)
+    {
+      // Rows of the transposed array are input slices (output columns), columns are input columns (output rows)
+      transpose(task.OutputPixels + slice * task.OutputSliceStride, task.OutputRowStride,
+                inputFirstPixel + slice * task.InputRowStride, task.InputSliceStride,
+                task.OutputDimensions[0], task.OutputDimensions[1], pixelSizeInBytes);
+      if (swapBytes != NULL)
+      {
+        // swap the rows of the slice that was just written, while they are still in the cache
+        for (int row = 0; row < task.OutputDimensions[1]; ++row)
         {
-          memcpy(outputPixel, inputPixel, outputRowIncrement);
-          inputPixel += inputRowIncrement;
-          outputPixel += outputRowIncrement;
+          unsigned char* outputRow = task.OutputPixels + slice * task.OutputSliceStride + row * task.OutputRowStride;
+          swapBytes(outputRow, outputRow, scalarsPerRow);
         }
       }
     }
-    else if (!flipInfo.hFlip && !flipInfo.vFlip && !flipInfo.eFlip && flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_IJKtoKIJ)
+
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  // Reverse the byte order of a scalar, compilers turn this into a single byte swap instruction
+  template<class ScalarType>
+  inline ScalarType ReverseScalarBytes(ScalarType value)
+  {
+    unsigned char bytes[sizeof(ScalarType)];
+    memcpy(bytes, &value, sizeof(ScalarType));
+    std::reverse(bytes, bytes + sizeof(ScalarType));
+    memcpy(&value, bytes, sizeof(ScalarType));
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  // Transpose an image in KIJ layout to IJK layout, keeping pairs of rows or columns together.
+  // Units are output columns (input slices). NumberOfScalarComponents is 0 if the number of components
+  // is only known at runtime, otherwise the component loop has a constant trip count and is unrolled.
+  // Output pixels are written with a large stride, so the byte order is reversed scalar by scalar as they are copied.
+  template<class ScalarType, int NumberOfScalarComponents, bool DoubleColumn, bool SwapBytes>
+  igsioStatus TransposeGeneric(const FlipClipTask& task, vtkIdType firstUnit, vtkIdType lastUnit)
+  {
+    const igsioVideoFrame::FlipInfoType& flipInfo = task.FlipInfo;
+    const std::array<int, 3>& clipRectangleOrigin = task.ClipRectangleOrigin;
+    const int numberOfScalarComponents = (NumberOfScalarComponents > 0 ? NumberOfScalarComponents : task.NumberOfScalarComponents);
+
+    int localClipRectangleSize[3] = {task.ClipRectangleSize[0], task.ClipRectangleSize[1], task.ClipRectangleSize[2]};
+    int inputWidth(task.InputDimensions[0]);
+    int inputHeight(task.InputDimensions[1]);
+    int outputHeight(task.OutputDimensions[1]);
+    int outputDepth(task.OutputDimensions[2]);
+
+    // Increments in scalars
+    vtkIdType pixelIncrement(numberOfScalarComponents);
+    vtkIdType inputRowIncrement(task.InputRowStride / task.ScalarSize);
+    vtkIdType inputImageIncrement(task.InputSliceStride / task.ScalarSize);
+    vtkIdType outputRowIncrement(task.OutputRowStride / task.ScalarSize);
+    vtkIdType outputImageIncrement(task.OutputSliceStride / task.ScalarSize);
+
+    if (flipInfo.doubleRow)
     {
-      // Transpose an image in KIJ layout to IJK layout
-      if (flipInfo.doubleColumn)
-      {
-        // Transpose an image in KIJ layout to IJK layout double column
+      // TODO : I don't think this is correct if transposition is happening... double check
+      inputWidth *= 2;
+      inputHeight /= 2;
+      outputHeight /= 2;
+      localClipRectangleSize[0] *= 2;
+      localClipRectangleSize[1] /= 2;
+      inputRowIncrement *= 2;
+      outputRowIncrement *= 2;
+    }
 
-        // Set the input position to the first unclipped pixel
-        ScalarType* inputPixel = (ScalarType*)inBuff + clipRectangleOrigin[2] * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * 2 * pixelIncrement;
+    const vtkIdType columnStep = (DoubleColumn ? 2 : 1) * pixelIncrement;
+    // Distance between the first unclipped pixels of consecutive input slices
+    const vtkIdType inputSliceStep = outputDepth * inputWidth * columnStep + (inputHeight - localClipRectangleSize[1]) * inputRowIncrement;
 
-        // Copy the image column->row, each column from the next image
-        for (int z = 0; z < outputWidth; ++z)
-        {
-          for (int y = 0; y < outputDepth; ++y)
-          {
-            for (int x = 0; x < outputHeight; ++x)
-            {
-              // Set the target position pointer to the correct output pixel offset
-              // ZXY -> XYZ
-              ScalarType* outputPixel = (ScalarType*)(outBuff) + + z * 2 * pixelIncrement + x * outputRowIncrement + y * outputImageIncrement;
-
-              // For each scalar, copy it
-              for (int s = 0; s < numberOfScalarComponents; ++s)
-              {
-                *(outputPixel + s) = *(inputPixel + s);
-              }
-              inputPixel += 2 * pixelIncrement;
-            }
-            // wrap the input to the beginning of the next row's unclipped pixel
-            inputPixel += (inputWidth - localClipRectangleSize[0]) * 2 * pixelIncrement;
-          }
-          // wrap the input to the beginning of the next image's unclipped row
-          inputPixel += (inputHeight - localClipRectangleSize[1]) * inputRowIncrement;
-        }
-      }
-      else
-      {
-        // Transpose an image IJK to KIJ
-        // Set the input position to the first unclipped pixel
-        ScalarType* inputPixel = (ScalarType*)inBuff + clipRectangleOrigin[2] * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * pixelIncrement;
+    // Set the input position to the first unclipped pixel of the first slice processed
+    const ScalarType* inputPixel = (const ScalarType*)task.InputPixels + clipRectangleOrigin[2] * inputImageIncrement + clipRectangleOrigin[1] * inputRowIncrement + clipRectangleOrigin[0] * columnStep
+                                   + firstUnit * inputSliceStep;
 
-        for (int z = 0; z < outputWidth; ++z)
+    // Copy the image column->row, each column from the next image
+    for (vtkIdType z = firstUnit; z < lastUnit; ++z)
+    {
+      for (int y = 0; y < outputDepth; ++y)
+      {
+        for (int x = 0; x < outputHeight; ++x)
         {
-          for (int y = 0; y < outputDepth; ++y)
+          // Set the target position pointer to the correct output pixel offset
+          // X,Y,Z -> Z,X,Y
+          ScalarType* outputPixel = (ScalarType*)task.OutputPixels + z * columnStep + x * outputRowIncrement + y * outputImageIncrement;
+
+          // For each scalar, copy it
+          for (int s = 0; s < numberOfScalarComponents; ++s)
           {
-            for (int x = 0; x < outputHeight; ++x)
-            {
-              // Set the target position pointer to the correct output pixel offset
-              // X,Y,Z -> Z,X,Y
-              ScalarType* outputPixel = (ScalarType*)(outBuff) + z * pixelIncrement + x * outputRowIncrement + y * outputImageIncrement;
-
-              // For each scalar, copy it
-              for (int s = 0; s < numberOfScalarComponents; ++s)
-              {
-                *(outputPixel + s) = *(inputPixel + s);
-              }
-              inputPixel += pixelIncrement;
-            }
-            // wrap the input to the beginning of the next row's unclipped pixel
-            inputPixel += (inputWidth - localClipRectangleSize[0]) * pixelIncrement;
+            *(outputPixel + s) = (SwapBytes ? ReverseScalarBytes(*(inputPixel + s)) : *(inputPixel + s));
           }
-          // wrap the input to the beginning of the next image's unclipped row
-          inputPixel += (inputHeight - localClipRectangleSize[1]) * inputRowIncrement;
+          inputPixel += columnStep;
         }
+        // wrap the input to the beginning of the next row's unclipped pixel
+        inputPixel += (inputWidth - localClipRectangleSize[0]) * columnStep;
       }
-    }
-    else
-    {
-      LOG_ERROR("Operation not permitted. " << std::endl << "flipInfo.hFlip: " << (flipInfo.hFlip ? "TRUE" : "FALSE") << std::endl <<
-                "flipInfo.vFlip: " << (flipInfo.vFlip ? "TRUE" : "FALSE") << std::endl <<
-                "flipInfo.eFlip: " << (flipInfo.eFlip ? "TRUE" : "FALSE") << std::endl <<
-                "flipInfo.tranpose: " << igsioVideoFrame::TransposeToString(flipInfo.tranpose) << std::endl <<
-                "flipInfo.doubleColumn: " << (flipInfo.doubleColumn ? "TRUE" : "FALSE") << std::endl <<
-                "flipInfo.doubleRow: " << (flipInfo.doubleRow ? "TRUE" : "FALSE"));
+      // wrap the input to the beginning of the next image's unclipped row
+      inputPixel += (inputHeight - localClipRectangleSize[1]) * inputRowIncrement;
     }
 
     return IGSIO_SUCCESS;
   }
-}
-
-//----------------------------------------------------------------------------
-igsioVideoFrame::igsioVideoFrame()
-  : Image(NULL)
-  , EncodedFrame(NULL)
-  , FrameType(FRAME_KEY)
-  , ImageType(US_IMG_BRIGHTNESS)
-  , ImageOrientation(US_IMG_ORIENT_MF)
-{
-}
-
-//----------------------------------------------------------------------------
-igsioVideoFrame::igsioVideoFrame(const igsioVideoFrame& videoItem)
-  : Image(NULL)
-  , EncodedFrame(NULL)
-  , FrameType(FRAME_KEY)
-  , ImageType(US_IMG_BRIGHTNESS)
-  , ImageOrientation(US_IMG_ORIENT_MF)
-{
-  *this = videoItem;
-}
 
-//----------------------------------------------------------------------------
-igsioVideoFrame::~igsioVideoFrame()
-{
-  DELETE_IF_NOT_NULL(this->Image);
-  DELETE_IF_NOT_NULL(this->EncodedFrame);
-}
+  //----------------------------------------------------------------------------
+  // Processes the work units [firstUnit, lastUnit) of a task
+  typedef igsioStatus(*FlipClipRangeFunctionType)(const FlipClipTask& task, vtkIdType firstUnit, vtkIdType lastUnit);
 
-//----------------------------------------------------------------------------
-igsioVideoFrame& igsioVideoFrame::operator=(igsioVideoFrame const& videoItem)
-{
-  // Handle self-assignment
-  if (this == &videoItem)
+  //----------------------------------------------------------------------------
+  template<class ScalarType>
+  FlipClipRangeFunctionType GetTransposeGenericFunction(int numberOfScalarComponents, bool doubleColumn, bool swapBytes)
   {
-    return *this;
+    // Indexed by number of components (0 = any other count) and double column
+    static const FlipClipRangeFunctionType functions[5][2] =
+    {
+      { &TransposeGeneric<ScalarType, 0, false, false>, &TransposeGeneric<ScalarType, 0, true, false> },
+      { &TransposeGeneric<ScalarType, 1, false, false>, &TransposeGeneric<ScalarType, 1, true, false> },
+      { &TransposeGeneric<ScalarType, 2, false, false>, &TransposeGeneric<ScalarType, 2, true, false> },
+      { &TransposeGeneric<ScalarType, 3, false, false>, &TransposeGeneric<ScalarType, 3, true, false> },
+      { &TransposeGeneric<ScalarType, 4, false, false>, &TransposeGeneric<ScalarType, 4, true, false> }
+    };
+    const int componentIndex = (numberOfScalarComponents >= 1 && numberOfScalarComponents <= 4 ? numberOfScalarComponents : 0);
+    if (swapBytes)
+    {
+      // Byte swapping is rare (big-endian files only), do not specialize it for the number of components
+      return (doubleColumn ? &TransposeGeneric<ScalarType, 0, true, true> : &TransposeGeneric<ScalarType, 0, false, true>);
+    }
+    return functions[componentIndex][doubleColumn ? 1 : 0];
   }
 
-  this->ImageType = videoItem.ImageType;
-  this->ImageOrientation = videoItem.ImageOrientation;
-
-  // Copy the pixels. Don't use image duplicator, because that wouldn't reuse the existing buffer
-  if (videoItem.GetFrameSizeInBytes() > 0)
+  //----------------------------------------------------------------------------
+  // Select the implementation for a task, once per image rather than per row or pixel.
+  // Returns NULL if the task cannot be processed.
+  FlipClipRangeFunctionType GetFlipClipRangeFunction(const FlipClipTask& task)
   {
-    FrameSizeType frameSize = {0, 0, 0};
-    videoItem.GetFrameSize(frameSize);
-
-    unsigned int numberOfScalarComponents(1);
-    if (videoItem.GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+    const igsioVideoFrame::FlipInfoType& flipInfo = task.FlipInfo;
+    if (IsRowOperation(flipInfo))
     {
-      LOG_ERROR("Unable to retrieve number of scalar components.");
+      // Indexed by horizontal, vertical and elevation flip
+      static const FlipClipRangeFunctionType flipRowsFunctions[2][2][2] =
+      {
+        { { &FlipRows<false, false, false>, &FlipRows<false, false, true> }, { &FlipRows<false, true, false>, &FlipRows<false, true, true> } },
+        { { &FlipRows<true, false, false>, &FlipRows<true, false, true> }, { &FlipRows<true, true, false>, &FlipRows<true, true, true> } }
+      };
+      return flipRowsFunctions[flipInfo.hFlip ? 1 : 0][flipInfo.vFlip ? 1 : 0][flipInfo.eFlip ? 1 : 0];
     }
-    if (this->AllocateFrame(frameSize, videoItem.GetVTKScalarPixelType(), numberOfScalarComponents) != IGSIO_SUCCESS)
+    if (!flipInfo.doubleRow && !flipInfo.doubleColumn)
     {
-      LOG_ERROR("Failed to allocate memory for the new frame in the buffer!");
+      return &TransposeSlices;
     }
-    else
+
+    switch (task.ScalarSize)
     {
-      this->Image->DeepCopy(videoItem.GetImage());
+      case 1:
+        return GetTransposeGenericFunction<vtkTypeUInt8>(task.NumberOfScalarComponents, flipInfo.doubleColumn, task.SwapBytes);
+      case 2:
+        return GetTransposeGenericFunction<vtkTypeUInt16>(task.NumberOfScalarComponents, flipInfo.doubleColumn, task.SwapBytes);
+      case 4:
+        return GetTransposeGenericFunction<vtkTypeUInt32>(task.NumberOfScalarComponents, flipInfo.doubleColumn, task.SwapBytes);
+      case 8:
+        return GetTransposeGenericFunction<vtkTypeUInt64>(task.NumberOfScalarComponents, flipInfo.doubleColumn, task.SwapBytes);
+      default:
+        LOG_ERROR("Unsupported bit depth: " << task.ScalarSize << " bytes per scalar");
+        return NULL;
     }
   }
 
-  return *this;
-}
-
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::DeepCopy(igsioVideoFrame* videoItem)
-{
-  if (videoItem == NULL)
+  //----------------------------------------------------------------------------
+  // Resolve a thread count option, 0 or less means vtkMultiThreader default
+  int GetEffectiveNumberOfThreads(int numberOfThreads)
   {
-    LOG_ERROR("Failed to deep copy video buffer item - buffer item NULL!");
-    return IGSIO_FAIL;
+    if (numberOfThreads <= 0)
+    {
+      numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+    return std::max(1, std::min(numberOfThreads, VTK_MAX_THREADS));
   }
 
-  (*this) = (*videoItem);
+  //----------------------------------------------------------------------------
+  int GetEffectiveFlipClipNumberOfThreads()
+  {
+    return GetEffectiveNumberOfThreads(FlipClipNumberOfThreads.load());
+  }
 
-  return IGSIO_SUCCESS;
-}
+  //----------------------------------------------------------------------------
+  struct FlipClipThreadData
+  {
+    const FlipClipTask* Task;
+    FlipClipRangeFunctionType RangeFunction;
+    vtkIdType NumberOfUnits;
+    std::vector<igsioStatus> ThreadStatus;
+  };
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::FillBlank()
-{
-  if (!this->IsImageValid())
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE FlipClipThreadFunction(void* arg)
   {
-    LOG_ERROR("Unable to fill image to blank, image data is NULL.");
-    return IGSIO_FAIL;
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    FlipClipThreadData* data = static_cast<FlipClipThreadData*>(info->UserData);
+    const vtkIdType firstUnit = data->NumberOfUnits * info->ThreadID / info->NumberOfThreads;
+    const vtkIdType lastUnit = data->NumberOfUnits * (info->ThreadID + 1) / info->NumberOfThreads;
+    data->ThreadStatus[info->ThreadID] = data->RangeFunction(*data->Task, firstUnit, lastUnit);
+    return VTK_THREAD_RETURN_VALUE;
   }
 
-  memset(this->GetScalarPointer(), 0, this->GetFrameSizeInBytes());
+  //----------------------------------------------------------------------------
+  // Validate and run a task, splitting the work between at most maximumNumberOfThreads threads
+  igsioStatus ExecuteFlipClipTask(const FlipClipTask& task, int maximumNumberOfThreads)
+  {
+    if (ValidateFlipClipTask(task) != IGSIO_SUCCESS)
+    {
+      return IGSIO_FAIL;
+    }
+    FlipClipRangeFunctionType rangeFunction = GetFlipClipRangeFunction(task);
+    if (rangeFunction == NULL)
+    {
+      return IGSIO_FAIL;
+    }
 
-  return IGSIO_SUCCESS;
-}
+    // Do not start more threads than worth it for the image size
+    const vtkIdType numberOfUnits = GetNumberOfFlipClipWorkUnits(task);
+    const vtkIdType outputSizeInBytes = static_cast<vtkIdType>(task.OutputDimensions[0]) * task.OutputDimensions[1] * task.OutputDimensions[2]
+                                        * task.NumberOfScalarComponents * task.ScalarSize;
+    vtkIdType numberOfThreads = std::min<vtkIdType>(maximumNumberOfThreads, numberOfUnits);
+    numberOfThreads = std::min<vtkIdType>(numberOfThreads, outputSizeInBytes / MINIMUM_FLIP_CLIP_BYTES_PER_THREAD);
+    if (numberOfThreads <= 1)
+    {
+      return rangeFunction(task, 0, numberOfUnits);
+    }
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::AllocateFrame(vtkImageData* image, const FrameSizeType& imageSize, igsioCommon::VTKScalarPixelType pixType, unsigned int numberOfScalarComponents)
-{
-  if (imageSize[0] > 0 && imageSize[1] > 0 && imageSize[2] == 0)
+    FlipClipThreadData threadData;
+    threadData.Task = &task;
+    threadData.RangeFunction = rangeFunction;
+    threadData.NumberOfUnits = numberOfUnits;
+    threadData.ThreadStatus.resize(numberOfThreads, IGSIO_FAIL);
+    vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+    threader->SetNumberOfThreads(static_cast<int>(numberOfThreads));
+    threader->SetSingleMethod(FlipClipThreadFunction, &threadData);
+    threader->SingleMethodExecute();
+
+    for (std::vector<igsioStatus>::iterator it = threadData.ThreadStatus.begin(); it != threadData.ThreadStatus.end(); ++it)
+    {
+      if (*it != IGSIO_SUCCESS)
+      {
+        return IGSIO_FAIL;
+      }
+    }
+    return IGSIO_SUCCESS;
+  }
+
+  //----------------------------------------------------------------------------
+  // Converts one image, splitting the work between at most maximumNumberOfThreads threads
+  igsioStatus FlipClipImageInternal(vtkImageData* inUsImage,
+                                    const igsioVideoFrame::FlipInfoType& flipInfo,
+                                    const std::array<int, 3>& clipRectangleOrigin,
+                                    const std::array<int, 3>& clipRectangleSize,
+                                    vtkImageData* outUsOrientedImage,
+                                    int maximumNumberOfThreads)
+  {
+    if (inUsImage == NULL)
+    {
+      LOG_ERROR("Failed to convert image data to the requested orientation - input image is null!");
+      return IGSIO_FAIL;
+    }
+
+    if (outUsOrientedImage == NULL)
+    {
+      LOG_ERROR("Failed to convert image data to the requested orientation - output image is null!");
+      return IGSIO_FAIL;
+    }
+
+    if (!flipInfo.hFlip && !flipInfo.vFlip && !flipInfo.eFlip && flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_NONE)
+    {
+      if (igsioCommon::IsClippingRequested(clipRectangleOrigin, clipRectangleSize))
+      {
+        // No flip or transpose, but clipping requested, let vtk do the heavy lifting
+        vtkSmartPointer<vtkExtractVOI> extract = vtkSmartPointer<vtkExtractVOI>::New();
+        vtkSmartPointer<vtkTrivialProducer> tp = vtkSmartPointer<vtkTrivialProducer>::New();
+        tp->SetOutput(inUsImage);
+        extract->SetInputConnection(tp->GetOutputPort());
+        extract->SetVOI(
+          clipRectangleOrigin[0], clipRectangleOrigin[0] + clipRectangleSize[0] - 1,
+          clipRectangleOrigin[1], clipRectangleOrigin[1] + clipRectangleSize[1] - 1,
+          clipRectangleOrigin[2], clipRectangleOrigin[2] + clipRectangleSize[2] - 1
+        );
+        extract->SetOutput(outUsOrientedImage);
+        extract->Update();
+        return IGSIO_SUCCESS;
+      }
+      else
+      {
+        // no flip, clip or transpose
+        outUsOrientedImage->DeepCopy(inUsImage);
+        return IGSIO_SUCCESS;
+      }
+    }
+
+    FlipClipTask task;
+    task.FlipInfo = flipInfo;
+    task.SwapBytes = false;
+    inUsImage->GetDimensions(task.InputDimensions);
+    ComputeFlipClipGeometry(task.InputDimensions, flipInfo, clipRectangleOrigin, clipRectangleSize, task.ClipRectangleOrigin, task.ClipRectangleSize, task.OutputDimensions, true);
+
+    // Update the output image if the dimensions don't match the final clip size (which might be the same as the input image)
+    int outDimensions[3] = {0, 0, 0};
+    outUsOrientedImage->GetDimensions(outDimensions);
+    if (outDimensions[0] != task.OutputDimensions[0] || outDimensions[1] != task.OutputDimensions[1] || outDimensions[2] != task.OutputDimensions[2] || outUsOrientedImage->GetScalarType() != inUsImage->GetScalarType() || outUsOrientedImage->GetNumberOfScalarComponents() != inUsImage->GetNumberOfScalarComponents())
+    {
+      // Allocate the output image, adjust for 1 based sizes to 0 based extents
+      outUsOrientedImage->SetExtent(0, task.OutputDimensions[0] - 1, 0, task.OutputDimensions[1] - 1, 0, task.OutputDimensions[2] - 1);
+      outUsOrientedImage->AllocateScalars(inUsImage->GetScalarType(), inUsImage->GetNumberOfScalarComponents());
+    }
+
+    task.ScalarSize = igsioVideoFrame::GetNumberOfBytesPerScalar(inUsImage->GetScalarType());
+    task.NumberOfScalarComponents = inUsImage->GetNumberOfScalarComponents();
+    vtkIdType pixelIncrement(0);
+    inUsImage->GetIncrements(pixelIncrement, task.InputRowStride, task.InputSliceStride);
+    outUsOrientedImage->GetIncrements(pixelIncrement, task.OutputRowStride, task.OutputSliceStride);
+    task.InputRowStride *= task.ScalarSize;
+    task.InputSliceStride *= task.ScalarSize;
+    task.OutputRowStride *= task.ScalarSize;
+    task.OutputSliceStride *= task.ScalarSize;
+    task.InputPixels = static_cast<const unsigned char*>(inUsImage->GetScalarPointer());
+    task.OutputPixels = static_cast<unsigned char*>(outUsOrientedImage->GetScalarPointer());
+
+    return ExecuteFlipClipTask(task, maximumNumberOfThreads);
+  }
+
+  //----------------------------------------------------------------------------
+  struct FlipClipBatchThreadData
   {
-    LOG_WARNING("Single slice images should have a dimension of z=1");
+    const std::vector<vtkImageData*>* InputImages;
+    const std::vector<vtkImageData*>* OutputImages;
+    igsioVideoFrame::FlipInfoType FlipInfo;
+    std::array<int, 3> ClipRectangleOrigin;
+    std::array<int, 3> ClipRectangleSize;
+    std::vector<igsioStatus> ThreadStatus;
+  };
+
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE FlipClipBatchThreadFunction(void* arg)
+  {
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    FlipClipBatchThreadData* data = static_cast<FlipClipBatchThreadData*>(info->UserData);
+    igsioStatus status = IGSIO_SUCCESS;
+    // Interleave the frames between threads, each frame is converted on a single thread
+    for (size_t i = info->ThreadID; i < data->InputImages->size(); i += info->NumberOfThreads)
+    {
+      if (FlipClipImageInternal((*data->InputImages)[i], data->FlipInfo, data->ClipRectangleOrigin, data->ClipRectangleSize, (*data->OutputImages)[i], 1) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to convert frame " << i << " of the batch");
+        status = IGSIO_FAIL;
+      }
+    }
+    data->ThreadStatus[info->ThreadID] = status;
+    return VTK_THREAD_RETURN_VALUE;
   }
 
-  if (image != NULL)
+  //----------------------------------------------------------------------------
+  igsioVideoFrameKernels::ScalarType GetKernelScalarType(igsioCommon::VTKScalarPixelType pixelType)
   {
-    int imageExtents[6] = { 0, 0, 0, 0, 0, 0 };
-    image->GetExtent(imageExtents);
-    if (imageSize[0] == imageExtents[1] - imageExtents[0] + 1 &&
-        imageSize[1] == imageExtents[3] - imageExtents[2] + 1 &&
-        imageSize[2] == imageExtents[5] - imageExtents[4] + 1 &&
-        image->GetScalarType() == pixType &&
-        image->GetNumberOfScalarComponents() == numberOfScalarComponents)
+    switch (pixelType)
     {
-      // already allocated, no change
-      return IGSIO_SUCCESS;
+      case VTK_CHAR:
+      case VTK_SIGNED_CHAR:
+        return igsioVideoFrameKernels::SCALAR_TYPE_INT8;
+      case VTK_UNSIGNED_CHAR:
+        return igsioVideoFrameKernels::SCALAR_TYPE_UINT8;
+      case VTK_SHORT:
+        return igsioVideoFrameKernels::SCALAR_TYPE_INT16;
+      case VTK_UNSIGNED_SHORT:
+        return igsioVideoFrameKernels::SCALAR_TYPE_UINT16;
+      case VTK_INT:
+        return igsioVideoFrameKernels::SCALAR_TYPE_INT32;
+      case VTK_UNSIGNED_INT:
+        return igsioVideoFrameKernels::SCALAR_TYPE_UINT32;
+      case VTK_FLOAT:
+        return igsioVideoFrameKernels::SCALAR_TYPE_FLOAT;
+      case VTK_DOUBLE:
+        return igsioVideoFrameKernels::SCALAR_TYPE_DOUBLE;
+      default:
+        return igsioVideoFrameKernels::SCALAR_TYPE_UNKNOWN;
     }
   }
 
-  image->SetExtent(0, imageSize[0] - 1, 0, imageSize[1] - 1, 0, imageSize[2] - 1);
-  image->AllocateScalars(pixType, numberOfScalarComponents);
+  //----------------------------------------------------------------------------
+  igsioVideoFrameKernels::YuvFormat GetKernelYuvFormat(const std::string& fourCC)
+  {
+    if (fourCC == "I420")
+    {
+      return igsioVideoFrameKernels::YUV_FORMAT_I420;
+    }
+    else if (fourCC == "NV12")
+    {
+      return igsioVideoFrameKernels::YUV_FORMAT_NV12;
+    }
+    else if (fourCC == "YUY2")
+    {
+      return igsioVideoFrameKernels::YUV_FORMAT_YUY2;
+    }
+    return igsioVideoFrameKernels::YUV_FORMAT_UNKNOWN;
+  }
 
-  return IGSIO_SUCCESS;
-}
+  //----------------------------------------------------------------------------
+  struct ConvertPixelTypeThreadData
+  {
+    igsioVideoFrameKernels::ConvertScalarsFunctionType ConvertScalars;
+    const unsigned char* InputScalars;
+    unsigned char* OutputScalars;
+    size_t NumberOfScalars;
+    size_t InputScalarSize;
+    size_t OutputScalarSize;
+    double Scale;
+    double Offset;
+  };
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::AllocateFrame(const FrameSizeType& imageSize, igsioCommon::VTKScalarPixelType pixType, unsigned int numberOfScalarComponents)
-{
-  if (this->GetImage() == NULL)
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE ConvertPixelTypeThreadFunction(void* arg)
   {
-    this->SetImageData(vtkImageData::New());
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    ConvertPixelTypeThreadData* data = static_cast<ConvertPixelTypeThreadData*>(info->UserData);
+    const size_t firstScalar = data->NumberOfScalars * info->ThreadID / info->NumberOfThreads;
+    const size_t lastScalar = data->NumberOfScalars * (info->ThreadID + 1) / info->NumberOfThreads;
+    data->ConvertScalars(data->OutputScalars + firstScalar * data->OutputScalarSize, data->InputScalars + firstScalar * data->InputScalarSize,
+                         lastScalar - firstScalar, data->Scale, data->Offset);
+    return VTK_THREAD_RETURN_VALUE;
   }
-  igsioStatus allocStatus = igsioVideoFrame::AllocateFrame(this->GetImage(), imageSize, pixType, numberOfScalarComponents);
-  return allocStatus;
-}
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::AllocateEncodedFrame(vtkUnsignedCharArray* frameData, const unsigned long size)
-{
-  if (!frameData != NULL)
+  //----------------------------------------------------------------------------
+  // Convert the pixels of one frame, splitting the work between at most maximumNumberOfThreads threads
+  igsioStatus ConvertPixelTypeInternal(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, igsioCommon::VTKScalarPixelType outputPixelType,
+                                       double scale, double offset, int maximumNumberOfThreads)
   {
-    return IGSIO_FAIL;
+    if (&inputFrame == &outputFrame)
+    {
+      LOG_ERROR("Failed to convert pixel type - input and output frames must be different");
+      return IGSIO_FAIL;
+    }
+    if (inputFrame.GetConstImage() == NULL || !inputFrame.IsImageValid())
+    {
+      LOG_ERROR("Failed to convert pixel type - the input frame has no image data");
+      return IGSIO_FAIL;
+    }
+    igsioVideoFrameKernels::ConvertScalarsFunctionType convertScalars = igsioVideoFrameKernels::GetConvertScalarsFunction(
+          GetKernelScalarType(inputFrame.GetVTKScalarPixelType()), GetKernelScalarType(outputPixelType));
+    if (convertScalars == NULL)
+    {
+      LOG_ERROR("Failed to convert pixel type from " << igsioVideoFrame::GetStringFromVTKPixelType(inputFrame.GetVTKScalarPixelType())
+                << " to " << igsioVideoFrame::GetStringFromVTKPixelType(outputPixelType) << " - unsupported pixel type");
+      return IGSIO_FAIL;
+    }
+
+    FrameSizeType frameSize = {0, 0, 0};
+    inputFrame.GetFrameSize(frameSize);
+    unsigned int numberOfScalarComponents(1);
+    inputFrame.GetNumberOfScalarComponents(numberOfScalarComponents);
+    if (outputFrame.AllocateFrame(frameSize, outputPixelType, numberOfScalarComponents) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to convert pixel type - cannot allocate output frame");
+      return IGSIO_FAIL;
+    }
+    outputFrame.SetImageType(inputFrame.GetImageType());
+    outputFrame.SetImageOrientation(inputFrame.GetImageOrientation());
+
+    ConvertPixelTypeThreadData threadData;
+    threadData.ConvertScalars = convertScalars;
+    threadData.InputScalars = static_cast<const unsigned char*>(inputFrame.GetConstScalarPointer());
+    threadData.OutputScalars = static_cast<unsigned char*>(outputFrame.GetScalarPointer());
+    threadData.NumberOfScalars = static_cast<size_t>(frameSize[0]) * frameSize[1] * frameSize[2] * numberOfScalarComponents;
+    threadData.InputScalarSize = inputFrame.GetNumberOfBytesPerScalar();
+    threadData.OutputScalarSize = outputFrame.GetNumberOfBytesPerScalar();
+    threadData.Scale = scale;
+    threadData.Offset = offset;
+
+    // Do not start more threads than worth it for the image size
+    const size_t outputSizeInBytes = threadData.NumberOfScalars * threadData.OutputScalarSize;
+    const int numberOfThreads = static_cast<int>(std::min<size_t>(maximumNumberOfThreads, outputSizeInBytes / MINIMUM_FLIP_CLIP_BYTES_PER_THREAD));
+    if (numberOfThreads <= 1)
+    {
+      convertScalars(threadData.OutputScalars, threadData.InputScalars, threadData.NumberOfScalars, scale, offset);
+      return IGSIO_SUCCESS;
+    }
+
+    vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(ConvertPixelTypeThreadFunction, &threadData);
+    threader->SingleMethodExecute();
+    return IGSIO_SUCCESS;
   }
 
-  if (!frameData->Allocate(size))
+  //----------------------------------------------------------------------------
+  struct ConvertPixelTypeBatchThreadData
   {
-    return IGSIO_FAIL;
-  }
+    const std::vector<igsioVideoFrame*>* Frames;
+    igsioCommon::VTKScalarPixelType OutputPixelType;
+    double Scale;
+    double Offset;
+    std::vector<igsioStatus> ThreadStatus;
+  };
 
-  return IGSIO_SUCCESS;
-}
+  //----------------------------------------------------------------------------
+  // Convert every frameStep-th frame in place, starting with firstFrame
+  igsioStatus ConvertPixelTypeBatchRange(const ConvertPixelTypeBatchThreadData& data, size_t firstFrame, size_t frameStep)
+  {
+    igsioStatus status = IGSIO_SUCCESS;
+    for (size_t i = firstFrame; i < data.Frames->size(); i += frameStep)
+    {
+      igsioVideoFrame convertedFrame;
+      if (ConvertPixelTypeInternal(*(*data.Frames)[i], convertedFrame, data.OutputPixelType, data.Scale, data.Offset, 1) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to convert pixel type of frame " << i << " of the batch");
+        status = IGSIO_FAIL;
+        continue;
+      }
+      convertedFrame.SetFrameType((*data.Frames)[i]->GetFrameType());
+      *(*data.Frames)[i] = std::move(convertedFrame);
+    }
+    return status;
+  }
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::AllocateEncodedFrame(const unsigned long size)
-{
-  if (this->GetEncodedFrame() == NULL)
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE ConvertPixelTypeBatchThreadFunction(void* arg)
   {
-    this->SetEncodedFrame(vtkUnsignedCharArray::New());
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    ConvertPixelTypeBatchThreadData* data = static_cast<ConvertPixelTypeBatchThreadData*>(info->UserData);
+    // Interleave the frames between threads, each frame is converted on a single thread
+    data->ThreadStatus[info->ThreadID] = ConvertPixelTypeBatchRange(*data, info->ThreadID, info->NumberOfThreads);
+    return VTK_THREAD_RETURN_VALUE;
   }
-  igsioStatus allocStatus = igsioVideoFrame::AllocateEncodedFrame(this->GetEncodedFrame(), size);
-  return allocStatus;
-}
 
-//----------------------------------------------------------------------------
-unsigned long igsioVideoFrame::GetFrameSizeInBytes() const
-{
-  if (!this->IsImageValid())
+  //----------------------------------------------------------------------------
+  // Add the pixels of a region of a frame to the statistics, the region must be within the frame
+  void AccumulateRegionStatistics(const igsioVideoFrame& frame, igsioVideoFrameKernels::AccumulateStatisticsFunctionType accumulateStatistics,
+                                  const std::array<int, 3>& origin, const std::array<int, 3>& size, igsioVideoFrameKernels::StatisticsAccumulator& accumulator)
   {
-    return 0;
+    FrameSizeType frameSize = {0, 0, 0};
+    frame.GetFrameSize(frameSize);
+    unsigned int numberOfScalarComponents(1);
+    frame.GetNumberOfScalarComponents(numberOfScalarComponents);
+    const unsigned char* pixels = static_cast<const unsigned char*>(frame.GetConstScalarPointer());
+    const vtkIdType rowStride = frame.GetRowStrideInBytes();
+    const vtkIdType sliceStride = frame.GetSliceStrideInBytes();
+    const size_t numberOfScalarsPerRow = static_cast<size_t>(size[0]) * numberOfScalarComponents;
+    const bool contiguousRows = (size[0] == static_cast<int>(frameSize[0]) && rowStride == static_cast<vtkIdType>(numberOfScalarsPerRow * frame.GetNumberOfBytesPerScalar()));
+    for (int z = origin[2]; z < origin[2] + size[2]; ++z)
+    {
+      const unsigned char* firstPixel = pixels + z * sliceStride + origin[1] * rowStride + origin[0] * frame.GetNumberOfBytesPerPixel();
+      if (contiguousRows)
+      {
+        // the rows of the region form one block, process them as one long row
+        accumulateStatistics(firstPixel, numberOfScalarsPerRow * size[1], 1, 0, accumulator);
+      }
+      else
+      {
+        accumulateStatistics(firstPixel, numberOfScalarsPerRow, size[1], rowStride, accumulator);
+      }
+    }
   }
-  FrameSizeType frameSize = {0, 0, 0};
-  this->GetFrameSize(frameSize);
 
-  int bytesPerScalar = GetNumberOfBytesPerScalar();
-  if (bytesPerScalar != 1 && bytesPerScalar != 2 && bytesPerScalar != 4 && bytesPerScalar != 8)
+  //----------------------------------------------------------------------------
+  struct StatisticsBatchThreadData
+  {
+    const std::vector<const igsioVideoFrame*>* Frames;
+    std::vector<igsioVideoFrame::ImageStatisticsType>* Statistics;
+    std::array<int, 3> RegionOrigin;
+    std::array<int, 3> RegionSize;
+    unsigned int NumberOfBins;
+    double HistogramMinimum;
+    double HistogramMaximum;
+    std::vector<igsioStatus> ThreadStatus;
+  };
+
+  //----------------------------------------------------------------------------
+  // Compute the statistics of every frameStep-th frame, starting with firstFrame
+  igsioStatus ComputeStatisticsBatchRange(const StatisticsBatchThreadData& data, size_t firstFrame, size_t frameStep)
   {
-    LOG_ERROR("Unsupported scalar size: " << bytesPerScalar << " bytes/scalar component");
+    igsioStatus status = IGSIO_SUCCESS;
+    for (size_t i = firstFrame; i < data.Frames->size(); i += frameStep)
+    {
+      if ((*data.Frames)[i]->ComputeStatistics((*data.Statistics)[i], data.RegionOrigin, data.RegionSize, data.NumberOfBins, data.HistogramMinimum, data.HistogramMaximum) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to compute statistics of frame " << i << " of the batch");
+        status = IGSIO_FAIL;
+      }
+    }
+    return status;
   }
-  unsigned int numberOfScalarComponents(1);
-  if (this->GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE StatisticsBatchThreadFunction(void* arg)
   {
-    LOG_ERROR("Unable to retrieve number of scalar components.");
-    return 0;
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    StatisticsBatchThreadData* data = static_cast<StatisticsBatchThreadData*>(info->UserData);
+    // Interleave the frames between threads, each frame is processed on a single thread
+    data->ThreadStatus[info->ThreadID] = ComputeStatisticsBatchRange(*data, info->ThreadID, info->NumberOfThreads);
+    return VTK_THREAD_RETURN_VALUE;
   }
-  unsigned long frameSizeInBytes = frameSize[0] * frameSize[1] * frameSize[2] * bytesPerScalar * numberOfScalarComponents;
-  return frameSizeInBytes;
-}
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::DeepCopyFrom(vtkImageData* frame)
-{
-  if (frame == NULL)
+  //----------------------------------------------------------------------------
+  struct DownsampleThreadData
+  {
+    igsioVideoFrameKernels::Downsample2xFunctionType Downsample2x;
+    const unsigned char* InputPixels;
+    unsigned char* OutputPixels;
+    size_t Width;
+    size_t Height;
+    size_t NumberOfSlices;
+    size_t NumberOfScalarComponents;
+    size_t InputSliceSizeInBytes;
+    size_t OutputSliceSizeInBytes;
+  };
+
+  //----------------------------------------------------------------------------
+  void DownsampleSlices(const DownsampleThreadData& data, size_t firstSlice, size_t lastSlice)
   {
-    LOG_ERROR("Failed to deep copy from vtk image data - input frame is NULL!");
-    return IGSIO_FAIL;
+    for (size_t slice = firstSlice; slice < lastSlice; ++slice)
+    {
+      data.Downsample2x(data.OutputPixels + slice * data.OutputSliceSizeInBytes, data.InputPixels + slice * data.InputSliceSizeInBytes,
+                        data.Width, data.Height, data.NumberOfScalarComponents);
+    }
   }
 
-  int* frameExtent = frame->GetExtent();
-  if ((frameExtent[1] - frameExtent[0] + 1) < 0 || (frameExtent[3] - frameExtent[2] + 1) < 0 || (frameExtent[5] - frameExtent[4] + 1) < 0)
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE DownsampleThreadFunction(void* arg)
   {
-    LOG_ERROR("Negative frame extents. Cannot DeepCopy frame.");
-    return IGSIO_FAIL;
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    DownsampleThreadData* data = static_cast<DownsampleThreadData*>(info->UserData);
+    DownsampleSlices(*data, data->NumberOfSlices * info->ThreadID / info->NumberOfThreads, data->NumberOfSlices * (info->ThreadID + 1) / info->NumberOfThreads);
+    return VTK_THREAD_RETURN_VALUE;
   }
-  FrameSizeType frameSize = {static_cast<unsigned int>(frameExtent[1] - frameExtent[0] + 1), static_cast<unsigned int>(frameExtent[3] - frameExtent[2] + 1), static_cast<unsigned int>(frameExtent[5] - frameExtent[4] + 1) };
 
-  if (this->AllocateFrame(frameSize, frame->GetScalarType(), frame->GetNumberOfScalarComponents()) != IGSIO_SUCCESS)
+  //----------------------------------------------------------------------------
+  // Downsample the rows and columns of a frame by 2. Slices of volumes are distributed between threads.
+  igsioStatus Downsample2xInternal(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame)
   {
-    LOG_ERROR("Failed to allocate memory for plus video frame!");
-    return IGSIO_FAIL;
+    if (inputFrame.GetConstImage() == NULL || !inputFrame.IsImageValid())
+    {
+      LOG_ERROR("Failed to downsample frame - the input frame has no image data");
+      return IGSIO_FAIL;
+    }
+    if (inputFrame.GetImageType() == US_IMG_RF_IQ_LINE || inputFrame.GetImageType() == US_IMG_RF_I_LINE_Q_LINE)
+    {
+      LOG_ERROR("Failed to downsample frame - " << igsioVideoFrame::GetStringFromUsImageType(inputFrame.GetImageType()) << " images cannot be downsampled");
+      return IGSIO_FAIL;
+    }
+    unsigned int numberOfScalarComponents(1);
+    inputFrame.GetNumberOfScalarComponents(numberOfScalarComponents);
+    igsioVideoFrameKernels::Downsample2xFunctionType downsample2x = igsioVideoFrameKernels::GetDownsample2xFunction(
+          GetKernelScalarType(inputFrame.GetVTKScalarPixelType()), numberOfScalarComponents);
+    if (downsample2x == NULL)
+    {
+      LOG_ERROR("Failed to downsample frame - unsupported pixel type: " << igsioVideoFrame::GetStringFromVTKPixelType(inputFrame.GetVTKScalarPixelType()));
+      return IGSIO_FAIL;
+    }
+
+    FrameSizeType inputFrameSize = {0, 0, 0};
+    inputFrame.GetFrameSize(inputFrameSize);
+    const FrameSizeType outputFrameSize = { (inputFrameSize[0] + 1) / 2, (inputFrameSize[1] + 1) / 2, inputFrameSize[2] };
+    if (outputFrame.AllocateFrame(outputFrameSize, inputFrame.GetVTKScalarPixelType(), numberOfScalarComponents) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to downsample frame - cannot allocate output frame");
+      return IGSIO_FAIL;
+    }
+    outputFrame.SetImageType(inputFrame.GetImageType());
+    outputFrame.SetImageOrientation(inputFrame.GetImageOrientation());
+
+    const size_t bytesPerPixel = inputFrame.GetNumberOfBytesPerPixel();
+    DownsampleThreadData threadData;
+    threadData.Downsample2x = downsample2x;
+    threadData.InputPixels = static_cast<const unsigned char*>(inputFrame.GetConstScalarPointer());
+    threadData.OutputPixels = static_cast<unsigned char*>(outputFrame.GetScalarPointer());
+    threadData.Width = inputFrameSize[0];
+    threadData.Height = inputFrameSize[1];
+    threadData.NumberOfSlices = inputFrameSize[2];
+    threadData.NumberOfScalarComponents = numberOfScalarComponents;
+    threadData.InputSliceSizeInBytes = static_cast<size_t>(inputFrameSize[0]) * inputFrameSize[1] * bytesPerPixel;
+    threadData.OutputSliceSizeInBytes = static_cast<size_t>(outputFrameSize[0]) * outputFrameSize[1] * bytesPerPixel;
+
+    // Do not start more threads than worth it for the image size
+    const size_t inputSizeInBytes = threadData.InputSliceSizeInBytes * threadData.NumberOfSlices;
+    const int numberOfThreads = static_cast<int>(std::min<size_t>(std::min<size_t>(GetEffectiveNumberOfThreads(PixelConversionNumberOfThreads.load()), threadData.NumberOfSlices),
+                                inputSizeInBytes / MINIMUM_FLIP_CLIP_BYTES_PER_THREAD));
+    if (numberOfThreads <= 1)
+    {
+      DownsampleSlices(threadData, 0, threadData.NumberOfSlices);
+      return IGSIO_SUCCESS;
+    }
+
+    vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(DownsampleThreadFunction, &threadData);
+    threader->SingleMethodExecute();
+    return IGSIO_SUCCESS;
   }
+}
 
-  memcpy(this->Image->GetScalarPointer(), frame->GetScalarPointer(), this->GetFrameSizeInBytes());
+//----------------------------------------------------------------------------
+igsioVideoFrame::igsioVideoFrame()
+  : Image(NULL)
+  , EncodedFrame(NULL)
+  , FrameType(FRAME_KEY)
+  , ImageType(US_IMG_BRIGHTNESS)
+  , ImageOrientation(US_IMG_ORIENT_MF)
+{
+}
 
-  return IGSIO_SUCCESS;
+//----------------------------------------------------------------------------
+igsioVideoFrame::igsioVideoFrame(const igsioVideoFrame& videoItem)
+  : Image(NULL)
+  , EncodedFrame(NULL)
+  , FrameType(FRAME_KEY)
+  , ImageType(US_IMG_BRIGHTNESS)
+  , ImageOrientation(US_IMG_ORIENT_MF)
+{
+  *this = videoItem;
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::ShallowCopyFrom(vtkImageData* frame)
+igsioVideoFrame::igsioVideoFrame(igsioVideoFrame&& videoItem)
+  : Image(videoItem.Image)
+  , EncodedFrame(videoItem.EncodedFrame)
+  , EncodingFourCC(std::move(videoItem.EncodingFourCC))
+  , FrameType(videoItem.FrameType)
+  , ImageType(videoItem.ImageType)
+  , ImageOrientation(videoItem.ImageOrientation)
 {
-  if (frame == NULL)
+  videoItem.Image = NULL;
+  videoItem.EncodedFrame = NULL;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrame::~igsioVideoFrame()
+{
+  DeleteImage(this->Image);
+  DELETE_IF_NOT_NULL(this->EncodedFrame);
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrame& igsioVideoFrame::operator=(igsioVideoFrame const& videoItem)
+{
+  // Handle self-assignment
+  if (this == &videoItem)
+  {
+    return *this;
+  }
+
+  this->ImageType = videoItem.ImageType;
+  this->ImageOrientation = videoItem.ImageOrientation;
+
+  if (videoItem.GetFrameSizeInBytes() > 0 && CopyOnWriteEnabled.load())
+  {
+    // Share the pixel buffer, it is copied when the pixels of one of the frames are modified
+    if (this->Image == NULL)
+    {
+      this->SetImageData(vtkImageData::New());
+    }
+    else
+    {
+      ReturnImageScalarsToPool(this->Image);
+    }
+    this->Image->ShallowCopy(videoItem.Image);
+    // The mark is stored on the pixel array, so it is seen by every frame that uses the array
+    vtkDataArray* scalars = this->Image->GetPointData()->GetScalars();
+    if (scalars != NULL && !IsExternalScalars(scalars))
+    {
+      scalars->GetInformation()->Set(GetSharedPixelBufferKey(), 1);
+    }
+    return *this;
+  }
+
+  // Copy the pixels. Don't use image duplicator, because that wouldn't reuse the existing buffer
+  if (videoItem.GetFrameSizeInBytes() > 0)
+  {
+    // DeepCopy replaces the pixel array, so a buffer shared with other frames is not modified
+    FrameSizeType frameSize = {0, 0, 0};
+    videoItem.GetFrameSize(frameSize);
+
+    unsigned int numberOfScalarComponents(1);
+    if (videoItem.GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+    {
+      LOG_ERROR("Unable to retrieve number of scalar components.");
+    }
+    if (this->AllocateFrame(frameSize, videoItem.GetVTKScalarPixelType(), numberOfScalarComponents) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to allocate memory for the new frame in the buffer!");
+    }
+    else
+    {
+      this->Image->DeepCopy(videoItem.Image);
+      // The deep copy of an external or shared buffer is owned by this frame
+      ClearPixelBufferKeys(this->Image->GetPointData()->GetScalars());
+    }
+  }
+
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrame& igsioVideoFrame::operator=(igsioVideoFrame&& videoItem)
+{
+  // Handle self-assignment
+  if (this == &videoItem)
+  {
+    return *this;
+  }
+
+  DeleteImage(this->Image);
+  DELETE_IF_NOT_NULL(this->EncodedFrame);
+
+  this->Image = videoItem.Image;
+  this->EncodedFrame = videoItem.EncodedFrame;
+  this->EncodingFourCC = std::move(videoItem.EncodingFourCC);
+  this->FrameType = videoItem.FrameType;
+  this->ImageType = videoItem.ImageType;
+  this->ImageOrientation = videoItem.ImageOrientation;
+  videoItem.Image = NULL;
+  videoItem.EncodedFrame = NULL;
+
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::DeepCopy(igsioVideoFrame* videoItem)
+{
+  if (videoItem == NULL)
+  {
+    LOG_ERROR("Failed to deep copy video buffer item - buffer item NULL!");
+    return IGSIO_FAIL;
+  }
+
+  (*this) = (*videoItem);
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::FillBlank()
+{
+  if (!this->IsImageValid())
+  {
+    LOG_ERROR("Unable to fill image to blank, image data is NULL.");
+    return IGSIO_FAIL;
+  }
+
+  // All pixels are overwritten, no need to copy a shared buffer
+  if (this->MakePixelBufferUnique(false) != IGSIO_SUCCESS)
+  {
+    return IGSIO_FAIL;
+  }
+  memset(this->Image->GetScalarPointer(), 0, this->GetFrameSizeInBytes());
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::AllocateFrame(vtkImageData* image, const FrameSizeType& imageSize, igsioCommon::VTKScalarPixelType pixType, unsigned int numberOfScalarComponents)
+{
+  if (imageSize[0] > 0 && imageSize[1] > 0 && imageSize[2] == 0)
+  {
+    LOG_WARNING("Single slice images should have a dimension of z=1");
+  }
+
+  if (image != NULL)
+  {
+    int imageExtents[6] = { 0, 0, 0, 0, 0, 0 };
+    image->GetExtent(imageExtents);
+    if (imageSize[0] == imageExtents[1] - imageExtents[0] + 1 &&
+        imageSize[1] == imageExtents[3] - imageExtents[2] + 1 &&
+        imageSize[2] == imageExtents[5] - imageExtents[4] + 1 &&
+        image->GetScalarType() == pixType &&
+        image->GetNumberOfScalarComponents() == numberOfScalarComponents)
+    {
+      // already allocated, no change
+      return IGSIO_SUCCESS;
+    }
+  }
+
+  image->SetExtent(0, imageSize[0] - 1, 0, imageSize[1] - 1, 0, imageSize[2] - 1);
+
+  if (igsioVideoFrameBufferPool::GetInstance()->IsEnabled() || PixelBufferAlignment.load() > 0)
+  {
+    // Recycle the previous buffer and take the new one from the pool or allocate an aligned buffer
+    ReturnImageScalarsToPool(image);
+    vtkDataArray* scalars = CreateScalars(pixType, numberOfScalarComponents, static_cast<vtkIdType>(imageSize[0]) * imageSize[1] * imageSize[2]);
+    if (scalars != NULL)
+    {
+      image->GetPointData()->SetScalars(scalars);
+      scalars->Delete();
+      return IGSIO_SUCCESS;
+    }
+  }
+
+  image->AllocateScalars(pixType, numberOfScalarComponents);
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::AllocateFrame(const FrameSizeType& imageSize, igsioCommon::VTKScalarPixelType pixType, unsigned int numberOfScalarComponents)
+{
+  if (this->Image == NULL)
+  {
+    this->SetImageData(vtkImageData::New());
+  }
+  igsioStatus allocStatus = igsioVideoFrame::AllocateFrame(this->Image, imageSize, pixType, numberOfScalarComponents);
+  if (allocStatus == IGSIO_SUCCESS)
+  {
+    // The buffer is kept if the size did not change, make sure that it is not shared with other frames
+    allocStatus = this->MakePixelBufferUnique(true);
+  }
+  return allocStatus;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::AllocateEncodedFrame(vtkUnsignedCharArray* frameData, const unsigned long size)
+{
+  if (!frameData != NULL)
+  {
+    return IGSIO_FAIL;
+  }
+
+  if (!frameData->Allocate(size))
+  {
+    return IGSIO_FAIL;
+  }
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::AllocateEncodedFrame(const unsigned long size)
+{
+  if (this->GetEncodedFrame() == NULL)
+  {
+    this->SetEncodedFrame(vtkUnsignedCharArray::New());
+  }
+  igsioStatus allocStatus = igsioVideoFrame::AllocateEncodedFrame(this->GetEncodedFrame(), size);
+  return allocStatus;
+}
+
+//----------------------------------------------------------------------------
+unsigned long igsioVideoFrame::GetFrameSizeInBytes() const
+{
+  if (!this->IsImageValid())
+  {
+    return 0;
+  }
+  FrameSizeType frameSize = {0, 0, 0};
+  this->GetFrameSize(frameSize);
+
+  int bytesPerScalar = GetNumberOfBytesPerScalar();
+  if (bytesPerScalar != 1 && bytesPerScalar != 2 && bytesPerScalar != 4 && bytesPerScalar != 8)
+  {
+    LOG_ERROR("Unsupported scalar size: " << bytesPerScalar << " bytes/scalar component");
+  }
+  unsigned int numberOfScalarComponents(1);
+  if (this->GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+  {
+    LOG_ERROR("Unable to retrieve number of scalar components.");
+    return 0;
+  }
+  unsigned long frameSizeInBytes = frameSize[0] * frameSize[1] * frameSize[2] * bytesPerScalar * numberOfScalarComponents;
+  return frameSizeInBytes;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::DeepCopyFrom(vtkImageData* frame)
+{
+  if (frame == NULL)
+  {
+    LOG_ERROR("Failed to deep copy from vtk image data - input frame is NULL!");
+    return IGSIO_FAIL;
+  }
+
+  int* frameExtent = frame->GetExtent();
+  if ((frameExtent[1] - frameExtent[0] + 1) < 0 || (frameExtent[3] - frameExtent[2] + 1) < 0 || (frameExtent[5] - frameExtent[4] + 1) < 0)
+  {
+    LOG_ERROR("Negative frame extents. Cannot DeepCopy frame.");
+    return IGSIO_FAIL;
+  }
+  FrameSizeType frameSize = {static_cast<unsigned int>(frameExtent[1] - frameExtent[0] + 1), static_cast<unsigned int>(frameExtent[3] - frameExtent[2] + 1), static_cast<unsigned int>(frameExtent[5] - frameExtent[4] + 1) };
+
+  if (this->AllocateFrame(frameSize, frame->GetScalarType(), frame->GetNumberOfScalarComponents()) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to allocate memory for plus video frame!");
+    return IGSIO_FAIL;
+  }
+
+  memcpy(this->Image->GetScalarPointer(), frame->GetScalarPointer(), this->GetFrameSizeInBytes());
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ShallowCopyFrom(vtkImageData* frame)
+{
+  if (frame == NULL)
+  {
+    LOG_ERROR("Failed to shallow copy from vtk image data - input frame is NULL!");
+    return IGSIO_FAIL;
+  }
+  // Sharing the pixels with the input image is requested explicitly, writes are not redirected to a private copy
+  // unless the pixel array is also shared by copies of frames or it is an external buffer
+  this->Image->ShallowCopy(frame);
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int igsioVideoFrame::GetNumberOfBytesPerScalar() const
+{
+  return igsioVideoFrame::GetNumberOfBytesPerScalar(GetVTKScalarPixelType());
+}
+
+//----------------------------------------------------------------------------
+int igsioVideoFrame::GetNumberOfBytesPerPixel() const
+{
+  unsigned int numberOfScalarComponents(1);
+  if (this->GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+  {
+    LOG_ERROR("Unable to retrieve number of scalar components.");
+    return -1;
+  }
+  return this->GetNumberOfBytesPerScalar() * numberOfScalarComponents;
+}
+
+//----------------------------------------------------------------------------
+US_IMAGE_ORIENTATION igsioVideoFrame::GetImageOrientation() const
+{
+  return this->ImageOrientation;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetImageOrientation(US_IMAGE_ORIENTATION imgOrientation)
+{
+  this->ImageOrientation = imgOrientation;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::GetNumberOfScalarComponents(unsigned int& scalarComponents) const
+{
+  if (IsImageValid())
+  {
+    scalarComponents = static_cast<unsigned int>(this->Image->GetNumberOfScalarComponents());
+    return IGSIO_SUCCESS;
+  }
+
+  return IGSIO_FAIL;
+}
+
+//----------------------------------------------------------------------------
+US_IMAGE_TYPE igsioVideoFrame::GetImageType() const
+{
+  return this->ImageType;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetImageType(US_IMAGE_TYPE imgType)
+{
+  this->ImageType = imgType;
+}
+
+//----------------------------------------------------------------------------
+void* igsioVideoFrame::GetScalarPointer()
+{
+  if (!this->IsImageValid())
+  {
+    LOG_ERROR("Cannot get buffer pointer, the buffer hasn't been created yet");
+    return NULL;
+  }
+
+  if (this->MakePixelBufferUnique(true) != IGSIO_SUCCESS)
+  {
+    return NULL;
+  }
+  return this->Image->GetScalarPointer();
+}
+
+//----------------------------------------------------------------------------
+void* igsioVideoFrame::GetScalarPointer() const
+{
+  return const_cast<void*>(this->GetConstScalarPointer());
+}
+
+//----------------------------------------------------------------------------
+const void* igsioVideoFrame::GetConstScalarPointer() const
+{
+  if (!this->IsImageValid())
+  {
+    LOG_ERROR("Cannot get buffer pointer, the buffer hasn't been created yet");
+    return NULL;
+  }
+
+  return this->Image->GetScalarPointer();
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::GetFrameSize(FrameSizeType& frameSize) const
+{
+  if (!this->IsImageValid())
+  {
+    frameSize[0] = frameSize[1] = frameSize[2] = 0;
+    return IGSIO_FAIL;
+  }
+
+  int frameSizeSigned[3];
+  this->Image->GetDimensions(frameSizeSigned);
+
+  if (frameSizeSigned[0] < 0)
+  {
+    frameSizeSigned[0] = 0;
+  }
+  if (frameSizeSigned[1] < 0)
+  {
+    frameSizeSigned[1] = 0;
+  }
+  if (frameSizeSigned[2] < 0)
+  {
+    frameSizeSigned[2] = 0;
+  }
+  frameSize[0] = static_cast<unsigned int>(frameSizeSigned[0]);
+  frameSize[1] = static_cast<unsigned int>(frameSizeSigned[1]);
+  frameSize[2] = static_cast<unsigned int>(frameSizeSigned[2]);
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetEncodingFourCC(std::string encodingFourCC)
+{
+  this->EncodingFourCC = encodingFourCC;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::GetEncodingFourCC(std::string& encoding) const
+{
+  if (!this->IsImageValid())
+  {
+    encoding = "";
+    return IGSIO_FAIL;
+  }
+
+  if (this->Image)
+  {
+    encoding = "";
+    return IGSIO_SUCCESS;
+  }
+
+  if (this->EncodedFrame)
+  {
+    encoding = this->EncodingFourCC;
+    return IGSIO_SUCCESS;
+  }
+
+  encoding = "";
+  return IGSIO_FAIL;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetFrameType(FRAME_TYPE FrameType)
+{
+  this->FrameType = FrameType;
+}
+
+//----------------------------------------------------------------------------
+FRAME_TYPE igsioVideoFrame::GetFrameType()
+{
+  return this->FrameType;
+}
+
+//----------------------------------------------------------------------------
+igsioCommon::VTKScalarPixelType igsioVideoFrame::GetVTKScalarPixelType() const
+{
+  if (this->Image == NULL || !this->IsImageValid())
+  {
+    return VTK_VOID;
+  }
+  return this->Image->GetScalarType();
+}
+
+//----------------------------------------------------------------------------
+US_IMAGE_ORIENTATION igsioVideoFrame::GetUsImageOrientationFromString(const char* imgOrientationStr)
+{
+  US_IMAGE_ORIENTATION imgOrientation = US_IMG_ORIENT_XX;
+  if (imgOrientationStr == NULL)
+  {
+    return imgOrientation;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UF"))
+  {
+    imgOrientation = US_IMG_ORIENT_UF;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UN"))
+  {
+    imgOrientation = US_IMG_ORIENT_UN;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MF"))
+  {
+    imgOrientation = US_IMG_ORIENT_MF;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MN"))
+  {
+    imgOrientation = US_IMG_ORIENT_MN;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UFA"))
+  {
+    imgOrientation = US_IMG_ORIENT_UFA;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UNA"))
+  {
+    imgOrientation = US_IMG_ORIENT_UNA;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MFA"))
+  {
+    imgOrientation = US_IMG_ORIENT_MFA;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MNA"))
+  {
+    imgOrientation = US_IMG_ORIENT_MNA;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "AMF"))
+  {
+    imgOrientation = US_IMG_ORIENT_AMF;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UFD"))
+  {
+    imgOrientation = US_IMG_ORIENT_UFD;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UND"))
+  {
+    imgOrientation = US_IMG_ORIENT_UND;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MFD"))
+  {
+    imgOrientation = US_IMG_ORIENT_MFD;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MND"))
+  {
+    imgOrientation = US_IMG_ORIENT_MND;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "FU"))
+  {
+    imgOrientation = US_IMG_ORIENT_FU;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "NU"))
+  {
+    imgOrientation = US_IMG_ORIENT_NU;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "FM"))
+  {
+    imgOrientation = US_IMG_ORIENT_FM;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "NM"))
+  {
+    imgOrientation = US_IMG_ORIENT_NM;
+  }
+
+  return imgOrientation;
+}
+
+//----------------------------------------------------------------------------
+US_IMAGE_ORIENTATION igsioVideoFrame::GetUsImageOrientationFromString(const std::string& imgOrientationStr)
+{
+  return igsioVideoFrame::GetUsImageOrientationFromString(imgOrientationStr.c_str());
+}
+
+//----------------------------------------------------------------------------
+std::string igsioVideoFrame::GetStringFromUsImageOrientation(US_IMAGE_ORIENTATION imgOrientation)
+{
+  switch (imgOrientation)
+  {
+    case US_IMG_ORIENT_FM:
+      return "FM";
+    case US_IMG_ORIENT_NM:
+      return "NM";
+    case US_IMG_ORIENT_FU:
+      return "FU";
+    case US_IMG_ORIENT_NU:
+      return "NU";
+    case US_IMG_ORIENT_UFA:
+      return "UFA";
+    case US_IMG_ORIENT_UNA:
+      return "UNA";
+    case US_IMG_ORIENT_MFA:
+      return "MFA";
+    case US_IMG_ORIENT_MNA:
+      return "MNA";
+    case US_IMG_ORIENT_AMF:
+      return "AMF";
+    case US_IMG_ORIENT_UFD:
+      return "UFD";
+    case US_IMG_ORIENT_UND:
+      return "UND";
+    case US_IMG_ORIENT_MFD:
+      return "MFD";
+    case US_IMG_ORIENT_MND:
+      return "MND";
+    default:
+      return "XX";
+  }
+}
+
+//----------------------------------------------------------------------------
+US_IMAGE_TYPE igsioVideoFrame::GetUsImageTypeFromString(const char* imgTypeStr)
+{
+  return igsioVideoFrame::GetUsImageTypeFromString(std::string(imgTypeStr));
+}
+
+//----------------------------------------------------------------------------
+US_IMAGE_TYPE igsioVideoFrame::GetUsImageTypeFromString(const std::string& imgTypeStr)
+{
+  std::string imgTypeUpper(imgTypeStr);
+  std::transform(imgTypeUpper.begin(), imgTypeUpper.end(), imgTypeUpper.begin(), ::toupper);
+
+  US_IMAGE_TYPE imgType = US_IMG_TYPE_XX;
+  if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "BRIGHTNESS"))
+  {
+    imgType = US_IMG_BRIGHTNESS;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RF_REAL"))
+  {
+    imgType = US_IMG_RF_REAL;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RF_IQ_LINE"))
+  {
+    imgType = US_IMG_RF_IQ_LINE;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RF_I_LINE_Q_LINE"))
+  {
+    imgType = US_IMG_RF_I_LINE_Q_LINE;
+  }
+  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RGB_COLOR"))
+  {
+    imgType = US_IMG_RGB_COLOR;
+  }
+  return imgType;
+}
+
+//----------------------------------------------------------------------------
+std::string igsioVideoFrame::GetStringFromUsImageType(US_IMAGE_TYPE imgType)
+{
+  switch (imgType)
+  {
+    case US_IMG_BRIGHTNESS:
+      return "BRIGHTNESS";
+    case US_IMG_RF_REAL:
+      return "RF_REAL";
+    case US_IMG_RF_IQ_LINE:
+      return "RF_IQ_LINE";
+    case US_IMG_RF_I_LINE_Q_LINE:
+      return "RF_I_LINE_Q_LINE";
+    case US_IMG_RGB_COLOR:
+      return "RGB_COLOR";
+    default:
+      return "XX";
+  }
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::GetFlipAxes(US_IMAGE_ORIENTATION usImageOrientation1, US_IMAGE_TYPE usImageType1, US_IMAGE_ORIENTATION usImageOrientation2, FlipInfoType& flipInfo)
+{
+  flipInfo.doubleRow = false;
+  flipInfo.doubleColumn = false;
+  if (usImageType1 == US_IMG_RF_I_LINE_Q_LINE)
+  {
+    if (usImageOrientation1 == US_IMG_ORIENT_FM
+        || usImageOrientation1 == US_IMG_ORIENT_FU
+        || usImageOrientation1 == US_IMG_ORIENT_NM
+        || usImageOrientation1 == US_IMG_ORIENT_NU)
+    {
+      // keep line pairs together
+      flipInfo.doubleRow = true;
+    }
+    else
+    {
+      LOG_ERROR("RF scanlines are expected to be in image rows");
+      return IGSIO_FAIL;
+    }
+  }
+  else if (usImageType1 == US_IMG_RF_IQ_LINE)
+  {
+    if (usImageOrientation1 == US_IMG_ORIENT_FM
+        || usImageOrientation1 == US_IMG_ORIENT_FU
+        || usImageOrientation1 == US_IMG_ORIENT_NM
+        || usImageOrientation1 == US_IMG_ORIENT_NU)
+    {
+      // keep IQ value pairs together
+      flipInfo.doubleColumn = true;
+    }
+    else
+    {
+      LOG_ERROR("RF scanlines are expected to be in image rows");
+      return IGSIO_FAIL;
+    }
+  }
+
+  flipInfo.hFlip = false; // horizontal
+  flipInfo.vFlip = false; // vertical
+  flipInfo.eFlip = false; // elevational
+  flipInfo.tranpose = TRANSPOSE_NONE; // no transpose
+  if (usImageOrientation1 == US_IMG_ORIENT_XX)
+  {
+    LOG_ERROR("Failed to determine the necessary image flip - unknown input image orientation 1");
+    return IGSIO_FAIL;
+  }
+
+  if (usImageOrientation2 == US_IMG_ORIENT_XX)
+  {
+    LOG_ERROR("Failed to determine the necessary image flip - unknown input image orientation 2");
+    return IGSIO_SUCCESS;
+  }
+  if (usImageOrientation1 == usImageOrientation2)
+  {
+    // no flip
+    return IGSIO_SUCCESS;
+  }
+
+  if ((usImageOrientation1 == US_IMG_ORIENT_UF && usImageOrientation2 == US_IMG_ORIENT_MF) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MF && usImageOrientation2 == US_IMG_ORIENT_UF) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UN && usImageOrientation2 == US_IMG_ORIENT_MN) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MN && usImageOrientation2 == US_IMG_ORIENT_UN) ||
+      (usImageOrientation1 == US_IMG_ORIENT_FU && usImageOrientation2 == US_IMG_ORIENT_NU) ||
+      (usImageOrientation1 == US_IMG_ORIENT_NU && usImageOrientation2 == US_IMG_ORIENT_FU) ||
+      (usImageOrientation1 == US_IMG_ORIENT_FM && usImageOrientation2 == US_IMG_ORIENT_NM) ||
+      (usImageOrientation1 == US_IMG_ORIENT_NM && usImageOrientation2 == US_IMG_ORIENT_FM)
+     )
+  {
+    // flip x
+    flipInfo.hFlip = true;
+    return IGSIO_SUCCESS;
+  }
+  if ((usImageOrientation1 == US_IMG_ORIENT_UF && usImageOrientation2 == US_IMG_ORIENT_UN) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MF && usImageOrientation2 == US_IMG_ORIENT_MN) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UN && usImageOrientation2 == US_IMG_ORIENT_UF) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MN && usImageOrientation2 == US_IMG_ORIENT_MF) ||
+      (usImageOrientation1 == US_IMG_ORIENT_FU && usImageOrientation2 == US_IMG_ORIENT_FM) ||
+      (usImageOrientation1 == US_IMG_ORIENT_NU && usImageOrientation2 == US_IMG_ORIENT_NM) ||
+      (usImageOrientation1 == US_IMG_ORIENT_FM && usImageOrientation2 == US_IMG_ORIENT_FU) ||
+      (usImageOrientation1 == US_IMG_ORIENT_NM && usImageOrientation2 == US_IMG_ORIENT_NU)
+     )
+  {
+    // flip y
+    flipInfo.vFlip = true;
+    return IGSIO_SUCCESS;
+  }
+  if ((usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_UFD) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UFD && usImageOrientation2 == US_IMG_ORIENT_UFA) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MFA && usImageOrientation2 == US_IMG_ORIENT_MFD) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MFD && usImageOrientation2 == US_IMG_ORIENT_MFA) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UNA && usImageOrientation2 == US_IMG_ORIENT_UND) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UND && usImageOrientation2 == US_IMG_ORIENT_UNA) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MNA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_MNA)
+     )
+  {
+    // flip z
+    flipInfo.eFlip = true;
+    return IGSIO_SUCCESS;
+  }
+  if ((usImageOrientation1 == US_IMG_ORIENT_UF && usImageOrientation2 == US_IMG_ORIENT_MN) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MF && usImageOrientation2 == US_IMG_ORIENT_UN) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UN && usImageOrientation2 == US_IMG_ORIENT_MF) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MN && usImageOrientation2 == US_IMG_ORIENT_UF) ||
+      (usImageOrientation1 == US_IMG_ORIENT_FU && usImageOrientation2 == US_IMG_ORIENT_NM) ||
+      (usImageOrientation1 == US_IMG_ORIENT_NU && usImageOrientation2 == US_IMG_ORIENT_FM) ||
+      (usImageOrientation1 == US_IMG_ORIENT_FM && usImageOrientation2 == US_IMG_ORIENT_NU) ||
+      (usImageOrientation1 == US_IMG_ORIENT_NM && usImageOrientation2 == US_IMG_ORIENT_FU)
+     )
+  {
+    // flip xy
+    flipInfo.hFlip = true;
+    flipInfo.vFlip = true;
+    return IGSIO_SUCCESS;
+  }
+  if ((usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_MFD) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MFD && usImageOrientation2 == US_IMG_ORIENT_UFA) ||
+      (usImageOrientation1 == US_IMG_ORIENT_UNA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
+      (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_UNA)
+     )
   {
-    LOG_ERROR("Failed to shallow copy from vtk image data - input frame is NULL!");
-    return IGSIO_FAIL;
+    // flip xz
+    flipInfo.hFlip = true;
+    flipInfo.eFlip = true;
+    return IGSIO_SUCCESS;
   }
-  this->Image->ShallowCopy(frame);
-  return IGSIO_SUCCESS;
-}
-
-//----------------------------------------------------------------------------
-int igsioVideoFrame::GetNumberOfBytesPerScalar() const
-{
-  return igsioVideoFrame::GetNumberOfBytesPerScalar(GetVTKScalarPixelType());
-}
-
-//----------------------------------------------------------------------------
-int igsioVideoFrame::GetNumberOfBytesPerPixel() const
-{
-  unsigned int numberOfScalarComponents(1);
-  if (this->GetNumberOfScalarComponents(numberOfScalarComponents) == IGSIO_FAIL)
+  if (
+    (usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_UND) ||
+    (usImageOrientation1 == US_IMG_ORIENT_UND && usImageOrientation2 == US_IMG_ORIENT_UFA) ||
+    (usImageOrientation1 == US_IMG_ORIENT_MFA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
+    (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_MFA)
+  )
   {
-    LOG_ERROR("Unable to retrieve number of scalar components.");
-    return -1;
+    // flip yz
+    flipInfo.vFlip = true;
+    flipInfo.eFlip = true;
+    return IGSIO_SUCCESS;
   }
-  return this->GetNumberOfBytesPerScalar() * numberOfScalarComponents;
-}
-
-//----------------------------------------------------------------------------
-US_IMAGE_ORIENTATION igsioVideoFrame::GetImageOrientation() const
-{
-  return this->ImageOrientation;
-}
-
-//----------------------------------------------------------------------------
-void igsioVideoFrame::SetImageOrientation(US_IMAGE_ORIENTATION imgOrientation)
-{
-  this->ImageOrientation = imgOrientation;
-}
-
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetNumberOfScalarComponents(unsigned int& scalarComponents) const
-{
-  if (IsImageValid())
+  if (
+    (usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
+    (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_UFA)
+  )
   {
-    scalarComponents = static_cast<unsigned int>(this->Image->GetNumberOfScalarComponents());
+    // flip xyz
+    flipInfo.hFlip = true;
+    flipInfo.vFlip = true;
+    flipInfo.eFlip = true;
+    return IGSIO_SUCCESS;
+  }
+  if (
+    (usImageOrientation1 == US_IMG_ORIENT_AMF && usImageOrientation2 == US_IMG_ORIENT_MFA) ||
+    (usImageOrientation1 == US_IMG_ORIENT_MFA && usImageOrientation2 == US_IMG_ORIENT_AMF)
+  )
+  {
+    // Transpose J KI images to K IJ images
+    flipInfo.tranpose = TRANSPOSE_IJKtoKIJ;
     return IGSIO_SUCCESS;
   }
 
+  assert(0);
+  LOG_ERROR("Image orientation conversion between orientations " << igsioVideoFrame::GetStringFromUsImageOrientation(usImageOrientation1)
+            << " and " << igsioVideoFrame::GetStringFromUsImageOrientation(usImageOrientation2)
+            << " is not supported. Only reordering of rows, columns and slices.");
   return IGSIO_FAIL;
 }
 
 //----------------------------------------------------------------------------
-US_IMAGE_TYPE igsioVideoFrame::GetImageType() const
-{
-  return this->ImageType;
-}
-
-//----------------------------------------------------------------------------
-void igsioVideoFrame::SetImageType(US_IMAGE_TYPE imgType)
-{
-  this->ImageType = imgType;
-}
-
-//----------------------------------------------------------------------------
-void* igsioVideoFrame::GetScalarPointer() const
+igsioStatus igsioVideoFrame::GetOrientedClippedImage(vtkImageData* inUsImage,
+    FlipInfoType flipInfo,
+    US_IMAGE_TYPE inUsImageType,
+    vtkImageData* outUsOrientedImage,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize)
 {
-  if (!this->IsImageValid())
+  if (inUsImage == NULL)
   {
-    LOG_ERROR("Cannot get buffer pointer, the buffer hasn't been created yet");
-    return NULL;
+    LOG_ERROR("Failed to convert image data to the requested orientation - input image is null!");
+    return IGSIO_FAIL;
   }
 
-  return this->Image->GetScalarPointer();
-}
-
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetFrameSize(FrameSizeType& frameSize) const
-{
-  if (!this->IsImageValid())
+  if (outUsOrientedImage == NULL)
   {
-    frameSize[0] = frameSize[1] = frameSize[2] = 0;
+    LOG_ERROR("Failed to convert image data to the requested orientation - output image is null!");
     return IGSIO_FAIL;
   }
 
-  int frameSizeSigned[3];
-  this->Image->GetDimensions(frameSizeSigned);
+  return igsioVideoFrame::FlipClipImage(inUsImage, flipInfo, clipRectangleOrigin, clipRectangleSize, outUsOrientedImage);
+}
 
-  if (frameSizeSigned[0] < 0)
-  {
-    frameSizeSigned[0] = 0;
-  }
-  if (frameSizeSigned[1] < 0)
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::GetOrientedClippedImage(unsigned char* imageDataPtr,
+    FlipInfoType flipInfo, US_IMAGE_TYPE inUsImageType,
+    igsioCommon::VTKScalarPixelType inUsImagePixelType,
+    unsigned int numberOfScalarComponents,
+    const FrameSizeType& inputFrameSizeInPx,
+    igsioVideoFrame& outBufferItem,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize)
+{
+  if (outBufferItem.Image == NULL)
   {
-    frameSizeSigned[1] = 0;
+    outBufferItem.SetImageData(vtkImageData::New());
   }
-  if (frameSizeSigned[2] < 0)
+  // All pixels are overwritten, no need to copy a shared buffer
+  if (outBufferItem.MakePixelBufferUnique(false) != IGSIO_SUCCESS)
   {
-    frameSizeSigned[2] = 0;
+    return IGSIO_FAIL;
   }
-  frameSize[0] = static_cast<unsigned int>(frameSizeSigned[0]);
-  frameSize[1] = static_cast<unsigned int>(frameSizeSigned[1]);
-  frameSize[2] = static_cast<unsigned int>(frameSizeSigned[2]);
-  return IGSIO_SUCCESS;
-}
-
-//----------------------------------------------------------------------------
-void igsioVideoFrame::SetEncodingFourCC(std::string encodingFourCC)
-{
-  this->EncodingFourCC = encodingFourCC;
+  return igsioVideoFrame::GetOrientedClippedImage(imageDataPtr, flipInfo, inUsImageType, inUsImagePixelType,
+         numberOfScalarComponents, inputFrameSizeInPx, outBufferItem.Image, clipRectangleOrigin, clipRectangleSize);
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetEncodingFourCC(std::string& encoding) const
+igsioStatus igsioVideoFrame::GetOrientedClippedImage(unsigned char* imageDataPtr,
+    FlipInfoType flipInfo,
+    US_IMAGE_TYPE inUsImageType,
+    igsioCommon::VTKScalarPixelType inUsImagePixelType,
+    unsigned int numberOfScalarComponents,
+    const FrameSizeType& inputFrameSizeInPx,
+    vtkImageData* outUsOrientedImage,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize)
 {
-  if (!this->IsImageValid())
+  if (imageDataPtr == NULL)
   {
-    encoding = "";
+    LOG_ERROR("Failed to convert image data to MF orientation - input image is null!");
     return IGSIO_FAIL;
   }
 
-  if (this->Image)
+  if (outUsOrientedImage == NULL)
   {
-    encoding = "";
-    return IGSIO_SUCCESS;
+    LOG_ERROR("Failed to convert image data to MF orientation - output image is null!");
+    return IGSIO_FAIL;
   }
 
-  if (this->EncodedFrame)
+  // Allocate the output image if it does not match the oriented and clipped size already
+  FrameSizeType outputFrameSizeInPx = igsioVideoFrame::GetFlipClipOutputSize(inputFrameSizeInPx, flipInfo, clipRectangleOrigin, clipRectangleSize);
+  if (igsioVideoFrame::AllocateFrame(outUsOrientedImage, outputFrameSizeInPx, inUsImagePixelType, numberOfScalarComponents) != IGSIO_SUCCESS)
   {
-    encoding = this->EncodingFourCC;
-    return IGSIO_SUCCESS;
+    LOG_ERROR("Failed to allocate output image for orientation conversion");
+    return IGSIO_FAIL;
   }
 
-  encoding = "";
-  return IGSIO_FAIL;
-}
-
-//----------------------------------------------------------------------------
-void igsioVideoFrame::SetFrameType(FRAME_TYPE FrameType)
-{
-  this->FrameType = FrameType;
+  return igsioVideoFrame::FlipClipImage(imageDataPtr, inputFrameSizeInPx, 0, 0, inUsImagePixelType, numberOfScalarComponents,
+                                        flipInfo, clipRectangleOrigin, clipRectangleSize,
+                                        static_cast<unsigned char*>(outUsOrientedImage->GetScalarPointer()), 0, 0);
 }
 
 //----------------------------------------------------------------------------
-FRAME_TYPE igsioVideoFrame::GetFrameType()
+FrameSizeType igsioVideoFrame::GetFlipClipOutputSize(const FrameSizeType& inputFrameSizeInPx,
+    const FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize)
 {
-  return this->FrameType;
+  const int inputDimensions[3] = {static_cast<int>(inputFrameSizeInPx[0]), static_cast<int>(inputFrameSizeInPx[1]), std::max(1, static_cast<int>(inputFrameSizeInPx[2]))};
+  std::array<int, 3> finalClipOrigin;
+  std::array<int, 3> finalClipSize;
+  int outputDimensions[3] = {0, 0, 0};
+  ComputeFlipClipGeometry(inputDimensions, flipInfo, clipRectangleOrigin, clipRectangleSize, finalClipOrigin, finalClipSize, outputDimensions, false);
+  FrameSizeType outputFrameSizeInPx = {static_cast<unsigned int>(outputDimensions[0]), static_cast<unsigned int>(outputDimensions[1]), static_cast<unsigned int>(outputDimensions[2])};
+  return outputFrameSizeInPx;
 }
 
 //----------------------------------------------------------------------------
-igsioCommon::VTKScalarPixelType igsioVideoFrame::GetVTKScalarPixelType() const
+igsioStatus igsioVideoFrame::GetOrientedClippedView(const FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize,
+    igsioVideoFrameView& view) const
 {
-  if (this->Image == NULL || !this->IsImageValid())
+  if (this->Image == NULL)
   {
-    return VTK_VOID;
+    view.Reset();
+    LOG_ERROR("Failed to create oriented view - the frame has no image data");
+    return IGSIO_FAIL;
   }
-  return this->Image->GetScalarType();
+  return view.SetInput(this->Image, flipInfo, clipRectangleOrigin, clipRectangleSize);
 }
 
 //----------------------------------------------------------------------------
-US_IMAGE_ORIENTATION igsioVideoFrame::GetUsImageOrientationFromString(const char* imgOrientationStr)
+igsioStatus igsioVideoFrame::ConvertRfIqLayout(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, US_IMAGE_TYPE outputImageType)
 {
-  US_IMAGE_ORIENTATION imgOrientation = US_IMG_ORIENT_XX;
-  if (imgOrientationStr == NULL)
-  {
-    return imgOrientation;
-  }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UF"))
+  if (&inputFrame == &outputFrame)
   {
-    imgOrientation = US_IMG_ORIENT_UF;
+    LOG_ERROR("Failed to convert RF data layout - input and output frames must be different");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UN"))
+  if (inputFrame.GetConstImage() == NULL || !inputFrame.IsImageValid())
   {
-    imgOrientation = US_IMG_ORIENT_UN;
+    LOG_ERROR("Failed to convert RF data layout - the input frame has no image data");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MF"))
+  const US_IMAGE_TYPE inputImageType = inputFrame.GetImageType();
+  if ((inputImageType != US_IMG_RF_IQ_LINE && inputImageType != US_IMG_RF_I_LINE_Q_LINE)
+      || (outputImageType != US_IMG_RF_IQ_LINE && outputImageType != US_IMG_RF_I_LINE_Q_LINE))
   {
-    imgOrientation = US_IMG_ORIENT_MF;
+    LOG_ERROR("Failed to convert RF data layout from " << igsioVideoFrame::GetStringFromUsImageType(inputImageType) << " to " << igsioVideoFrame::GetStringFromUsImageType(outputImageType)
+              << " - only " << igsioVideoFrame::GetStringFromUsImageType(US_IMG_RF_IQ_LINE) << " and " << igsioVideoFrame::GetStringFromUsImageType(US_IMG_RF_I_LINE_Q_LINE) << " are supported");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MN"))
+  if (inputImageType == outputImageType)
   {
-    imgOrientation = US_IMG_ORIENT_MN;
+    outputFrame = inputFrame;
+    return IGSIO_SUCCESS;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UFA"))
+
+  unsigned int numberOfScalarComponents(1);
+  if (inputFrame.GetNumberOfScalarComponents(numberOfScalarComponents) != IGSIO_SUCCESS || numberOfScalarComponents != 1)
   {
-    imgOrientation = US_IMG_ORIENT_UFA;
+    LOG_ERROR("Failed to convert RF data layout - RF data must have one scalar component, found " << numberOfScalarComponents);
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UNA"))
+
+  FrameSizeType inputFrameSize = {0, 0, 0};
+  inputFrame.GetFrameSize(inputFrameSize);
+  const bool deinterleave = (inputImageType == US_IMG_RF_IQ_LINE);
+  if ((deinterleave && inputFrameSize[0] % 2 != 0) || (!deinterleave && inputFrameSize[1] % 2 != 0))
   {
-    imgOrientation = US_IMG_ORIENT_UNA;
+    LOG_ERROR("Failed to convert RF data layout - " << (deinterleave ? "the number of columns" : "the number of rows") << " must be even, frame size: "
+              << inputFrameSize[0] << "x" << inputFrameSize[1] << "x" << inputFrameSize[2]);
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MFA"))
+
+  // One I/Q scanline pair is one row of the interleaved image or two rows of the separated image
+  const unsigned int samplesPerLine = (deinterleave ? inputFrameSize[0] / 2 : inputFrameSize[0]);
+  const unsigned int linesPerSlice = (deinterleave ? inputFrameSize[1] : inputFrameSize[1] / 2);
+  FrameSizeType outputFrameSize = inputFrameSize;
+  if (deinterleave)
   {
-    imgOrientation = US_IMG_ORIENT_MFA;
+    outputFrameSize[0] = samplesPerLine;
+    outputFrameSize[1] = linesPerSlice * 2;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MNA"))
+  else
   {
-    imgOrientation = US_IMG_ORIENT_MNA;
+    outputFrameSize[0] = samplesPerLine * 2;
+    outputFrameSize[1] = linesPerSlice;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "AMF"))
+  if (outputFrame.AllocateFrame(outputFrameSize, inputFrame.GetVTKScalarPixelType(), 1) != IGSIO_SUCCESS)
   {
-    imgOrientation = US_IMG_ORIENT_AMF;
+    LOG_ERROR("Failed to convert RF data layout - cannot allocate output frame");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UFD"))
+  outputFrame.SetImageType(outputImageType);
+  outputFrame.SetImageOrientation(inputFrame.GetImageOrientation());
+
+  const size_t sampleSizeInBytes = inputFrame.GetNumberOfBytesPerScalar();
+  const unsigned char* inputPixels = static_cast<const unsigned char*>(inputFrame.GetConstScalarPointer());
+  unsigned char* outputPixels = static_cast<unsigned char*>(outputFrame.GetScalarPointer());
+  const vtkIdType inputRowStride = inputFrame.GetRowStrideInBytes();
+  const vtkIdType inputSliceStride = inputFrame.GetSliceStrideInBytes();
+  const vtkIdType outputRowStride = outputFrame.GetRowStrideInBytes();
+  const vtkIdType outputSliceStride = outputFrame.GetSliceStrideInBytes();
+  if (deinterleave)
   {
-    imgOrientation = US_IMG_ORIENT_UFD;
+    igsioVideoFrameKernels::DeinterleaveFunctionType deinterleaveLine = igsioVideoFrameKernels::GetDeinterleaveFunction(sampleSizeInBytes);
+    for (unsigned int z = 0; z < inputFrameSize[2]; ++z)
+    {
+      for (unsigned int line = 0; line < linesPerSlice; ++line)
+      {
+        unsigned char* outputLine = outputPixels + z * outputSliceStride + 2 * line * outputRowStride;
+        deinterleaveLine(outputLine, outputLine + outputRowStride, inputPixels + z * inputSliceStride + line * inputRowStride, samplesPerLine, sampleSizeInBytes);
+      }
+    }
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "UND"))
+  else
   {
-    imgOrientation = US_IMG_ORIENT_UND;
+    igsioVideoFrameKernels::InterleaveFunctionType interleaveLine = igsioVideoFrameKernels::GetInterleaveFunction(sampleSizeInBytes);
+    for (unsigned int z = 0; z < inputFrameSize[2]; ++z)
+    {
+      for (unsigned int line = 0; line < linesPerSlice; ++line)
+      {
+        const unsigned char* inputLine = inputPixels + z * inputSliceStride + 2 * line * inputRowStride;
+        interleaveLine(outputPixels + z * outputSliceStride + line * outputRowStride, inputLine, inputLine + inputRowStride, samplesPerLine, sampleSizeInBytes);
+      }
+    }
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MFD"))
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ConvertPixelType(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, igsioCommon::VTKScalarPixelType outputPixelType, double scale, double offset)
+{
+  return ConvertPixelTypeInternal(inputFrame, outputFrame, outputPixelType, scale, offset, GetEffectiveNumberOfThreads(PixelConversionNumberOfThreads.load()));
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ConvertPixelType(igsioCommon::VTKScalarPixelType outputPixelType, double scale, double offset)
+{
+  if (this->GetVTKScalarPixelType() == outputPixelType && scale == 1.0 && offset == 0.0)
   {
-    imgOrientation = US_IMG_ORIENT_MFD;
+    return IGSIO_SUCCESS;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "MND"))
+  igsioVideoFrame convertedFrame;
+  if (igsioVideoFrame::ConvertPixelType(*this, convertedFrame, outputPixelType, scale, offset) != IGSIO_SUCCESS)
   {
-    imgOrientation = US_IMG_ORIENT_MND;
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "FU"))
+  convertedFrame.SetFrameType(this->FrameType);
+  *this = std::move(convertedFrame);
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ConvertPixelTypeWindowLevel(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, double window, double level)
+{
+  if (window <= 0)
   {
-    imgOrientation = US_IMG_ORIENT_FU;
+    LOG_ERROR("Failed to convert pixel type - window must be positive, got " << window);
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "NU"))
+  const double scale = 255.0 / window;
+  const double offset = -(level - window / 2.0) * scale;
+  return igsioVideoFrame::ConvertPixelType(inputFrame, outputFrame, VTK_UNSIGNED_CHAR, scale, offset);
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ConvertPixelTypes(const std::vector<igsioVideoFrame*>& frames, igsioCommon::VTKScalarPixelType outputPixelType, double scale, double offset)
+{
+  if (frames.empty())
   {
-    imgOrientation = US_IMG_ORIENT_NU;
+    return IGSIO_SUCCESS;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "FM"))
+
+  ConvertPixelTypeBatchThreadData threadData;
+  threadData.Frames = &frames;
+  threadData.OutputPixelType = outputPixelType;
+  threadData.Scale = scale;
+  threadData.Offset = offset;
+  const int numberOfThreads = std::min<int>(GetEffectiveNumberOfThreads(PixelConversionNumberOfThreads.load()), static_cast<int>(std::min<size_t>(frames.size(), VTK_MAX_THREADS)));
+  if (numberOfThreads <= 1)
   {
-    imgOrientation = US_IMG_ORIENT_FM;
+    return ConvertPixelTypeBatchRange(threadData, 0, 1);
   }
-  else if (igsioCommon::IsEqualInsensitive(imgOrientationStr, "NM"))
+
+  threadData.ThreadStatus.resize(numberOfThreads, IGSIO_FAIL);
+  vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(ConvertPixelTypeBatchThreadFunction, &threadData);
+  threader->SingleMethodExecute();
+
+  for (std::vector<igsioStatus>::iterator it = threadData.ThreadStatus.begin(); it != threadData.ThreadStatus.end(); ++it)
   {
-    imgOrientation = US_IMG_ORIENT_NM;
+    if (*it != IGSIO_SUCCESS)
+    {
+      return IGSIO_FAIL;
+    }
   }
+  return IGSIO_SUCCESS;
+}
 
-  return imgOrientation;
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetPixelConversionNumberOfThreads(int numberOfThreads)
+{
+  PixelConversionNumberOfThreads.store(numberOfThreads);
 }
 
 //----------------------------------------------------------------------------
-US_IMAGE_ORIENTATION igsioVideoFrame::GetUsImageOrientationFromString(const std::string& imgOrientationStr)
+int igsioVideoFrame::GetPixelConversionNumberOfThreads()
 {
-  return igsioVideoFrame::GetUsImageOrientationFromString(imgOrientationStr.c_str());
+  return PixelConversionNumberOfThreads.load();
 }
 
 //----------------------------------------------------------------------------
-std::string igsioVideoFrame::GetStringFromUsImageOrientation(US_IMAGE_ORIENTATION imgOrientation)
+igsioStatus igsioVideoFrame::Downsample(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, unsigned int level)
 {
-  switch (imgOrientation)
+  if (level == 0)
   {
-    case US_IMG_ORIENT_FM:
-      return "FM";
-    case US_IMG_ORIENT_NM:
-      return "NM";
-    case US_IMG_ORIENT_FU:
-      return "FU";
-    case US_IMG_ORIENT_NU:
-      return "NU";
-    case US_IMG_ORIENT_UFA:
-      return "UFA";
-    case US_IMG_ORIENT_UNA:
-      return "UNA";
-    case US_IMG_ORIENT_MFA:
-      return "MFA";
-    case US_IMG_ORIENT_MNA:
-      return "MNA";
-    case US_IMG_ORIENT_AMF:
-      return "AMF";
-    case US_IMG_ORIENT_UFD:
-      return "UFD";
-    case US_IMG_ORIENT_UND:
-      return "UND";
-    case US_IMG_ORIENT_MFD:
-      return "MFD";
-    case US_IMG_ORIENT_MND:
-      return "MND";
-    default:
-      return "XX";
+    outputFrame = inputFrame;
+    return IGSIO_SUCCESS;
+  }
+  std::vector<igsioVideoFrame> pyramid;
+  if (igsioVideoFrame::BuildPyramid(inputFrame, pyramid, level) != IGSIO_SUCCESS)
+  {
+    return IGSIO_FAIL;
   }
+  outputFrame = std::move(pyramid.back());
+  return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-US_IMAGE_TYPE igsioVideoFrame::GetUsImageTypeFromString(const char* imgTypeStr)
+igsioStatus igsioVideoFrame::BuildPyramid(const igsioVideoFrame& inputFrame, std::vector<igsioVideoFrame>& pyramid, unsigned int numberOfLevels)
 {
-  return igsioVideoFrame::GetUsImageTypeFromString(std::string(imgTypeStr));
+  // Each level is computed from the previous one, the output vector may alias the input frame
+  std::vector<igsioVideoFrame> levels(numberOfLevels);
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    const igsioVideoFrame& levelInput = (level == 0 ? inputFrame : levels[level - 1]);
+    if (Downsample2xInternal(levelInput, levels[level]) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to compute level " << level + 1 << " of the image pyramid");
+      return IGSIO_FAIL;
+    }
+    levels[level].SetFrameType(inputFrame.FrameType);
+  }
+  pyramid = std::move(levels);
+  return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-US_IMAGE_TYPE igsioVideoFrame::GetUsImageTypeFromString(const std::string& imgTypeStr)
+bool igsioVideoFrame::IsYuvFourCC(const std::string& fourCC)
 {
-  std::string imgTypeUpper(imgTypeStr);
-  std::transform(imgTypeUpper.begin(), imgTypeUpper.end(), imgTypeUpper.begin(), ::toupper);
+  return GetKernelYuvFormat(fourCC) != igsioVideoFrameKernels::YUV_FORMAT_UNKNOWN;
+}
 
-  US_IMAGE_TYPE imgType = US_IMG_TYPE_XX;
-  if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "BRIGHTNESS"))
+//----------------------------------------------------------------------------
+unsigned long igsioVideoFrame::GetYuvDataSizeInBytes(const std::string& yuvFourCC, const FrameSizeType& frameSize)
+{
+  return static_cast<unsigned long>(igsioVideoFrameKernels::GetYuvBufferSize(GetKernelYuvFormat(yuvFourCC), frameSize[0], frameSize[1] * frameSize[2]));
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ConvertRgbToYuv(const igsioVideoFrame& rgbFrame, const std::string& yuvFourCC, vtkUnsignedCharArray* yuvData)
+{
+  if (yuvData == NULL)
   {
-    imgType = US_IMG_BRIGHTNESS;
+    LOG_ERROR("Failed to convert RGB frame to YUV - output buffer is null!");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RF_REAL"))
+  igsioVideoFrameKernels::RgbToYuvFunctionType rgbToYuv = igsioVideoFrameKernels::GetRgbToYuvFunction(GetKernelYuvFormat(yuvFourCC));
+  if (rgbToYuv == NULL)
   {
-    imgType = US_IMG_RF_REAL;
+    LOG_ERROR("Failed to convert RGB frame to YUV - unsupported YUV format: " << yuvFourCC);
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RF_IQ_LINE"))
+  if (rgbFrame.GetConstImage() == NULL)
   {
-    imgType = US_IMG_RF_IQ_LINE;
+    LOG_ERROR("Failed to convert RGB frame to YUV - input frame has no image data");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RF_I_LINE_Q_LINE"))
+  unsigned int numberOfScalarComponents(0);
+  rgbFrame.GetNumberOfScalarComponents(numberOfScalarComponents);
+  if (rgbFrame.GetVTKScalarPixelType() != VTK_UNSIGNED_CHAR || numberOfScalarComponents != 3)
   {
-    imgType = US_IMG_RF_I_LINE_Q_LINE;
+    LOG_ERROR("Failed to convert RGB frame to YUV - only unsigned char images with 3 components are supported");
+    return IGSIO_FAIL;
   }
-  else if (igsioCommon::IsEqualInsensitive(imgTypeUpper, "RGB_COLOR"))
+
+  // Slices of a volume are stacked vertically
+  FrameSizeType frameSize = {0, 0, 0};
+  rgbFrame.GetFrameSize(frameSize);
+  yuvData->SetNumberOfComponents(1);
+  yuvData->SetNumberOfTuples(igsioVideoFrame::GetYuvDataSizeInBytes(yuvFourCC, frameSize));
+  rgbToYuv(yuvData->GetPointer(0), static_cast<const unsigned char*>(rgbFrame.GetConstScalarPointer()), frameSize[0], frameSize[1] * frameSize[2]);
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ConvertYuvToRgb(const unsigned char* yuvData, unsigned long yuvDataSizeInBytes, const std::string& yuvFourCC,
+    const FrameSizeType& frameSize, igsioVideoFrame& rgbFrame)
+{
+  igsioVideoFrameKernels::YuvToRgbFunctionType yuvToRgb = igsioVideoFrameKernels::GetYuvToRgbFunction(GetKernelYuvFormat(yuvFourCC));
+  if (yuvToRgb == NULL)
   {
-    imgType = US_IMG_RGB_COLOR;
+    LOG_ERROR("Failed to convert YUV data to RGB - unsupported YUV format: " << yuvFourCC);
+    return IGSIO_FAIL;
   }
-  return imgType;
+  if (yuvData == NULL || yuvDataSizeInBytes < igsioVideoFrame::GetYuvDataSizeInBytes(yuvFourCC, frameSize))
+  {
+    LOG_ERROR("Failed to convert YUV data to RGB - " << yuvDataSizeInBytes << " bytes of " << yuvFourCC << " data is not enough for a "
+              << frameSize[0] << "x" << frameSize[1] << "x" << frameSize[2] << " frame");
+    return IGSIO_FAIL;
+  }
+
+  if (rgbFrame.AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 3) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to convert YUV data to RGB - failed to allocate output frame");
+    return IGSIO_FAIL;
+  }
+  rgbFrame.SetImageType(US_IMG_RGB_COLOR);
+  yuvToRgb(static_cast<unsigned char*>(rgbFrame.GetScalarPointer()), yuvData, frameSize[0], frameSize[1] * frameSize[2]);
+  return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-std::string igsioVideoFrame::GetStringFromUsImageType(US_IMAGE_TYPE imgType)
+igsioStatus igsioVideoFrame::ConvertRfIqLayout(US_IMAGE_TYPE outputImageType)
 {
-  switch (imgType)
+  if (this->ImageType == outputImageType)
   {
-    case US_IMG_BRIGHTNESS:
-      return "BRIGHTNESS";
-    case US_IMG_RF_REAL:
-      return "RF_REAL";
-    case US_IMG_RF_IQ_LINE:
-      return "RF_IQ_LINE";
-    case US_IMG_RF_I_LINE_Q_LINE:
-      return "RF_I_LINE_Q_LINE";
-    case US_IMG_RGB_COLOR:
-      return "RGB_COLOR";
-    default:
-      return "XX";
+    return IGSIO_SUCCESS;
   }
+  igsioVideoFrame convertedFrame;
+  if (igsioVideoFrame::ConvertRfIqLayout(*this, convertedFrame, outputImageType) != IGSIO_SUCCESS)
+  {
+    return IGSIO_FAIL;
+  }
+  convertedFrame.SetFrameType(this->FrameType);
+  *this = std::move(convertedFrame);
+  return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetFlipAxes(US_IMAGE_ORIENTATION usImageOrientation1, US_IMAGE_TYPE usImageType1, US_IMAGE_ORIENTATION usImageOrientation2, FlipInfoType& flipInfo)
+igsioStatus igsioVideoFrame::FlipClipImage(const unsigned char* inputPixels,
+    const FrameSizeType& inputFrameSizeInPx,
+    vtkIdType inputRowStride,
+    vtkIdType inputSliceStride,
+    igsioCommon::VTKScalarPixelType pixelType,
+    unsigned int numberOfScalarComponents,
+    const FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize,
+    unsigned char* outputPixels,
+    vtkIdType outputRowStride,
+    vtkIdType outputSliceStride,
+    bool swapBytes)
 {
-  flipInfo.doubleRow = false;
-  flipInfo.doubleColumn = false;
-  if (usImageType1 == US_IMG_RF_I_LINE_Q_LINE)
+  if (inputPixels == NULL || outputPixels == NULL)
   {
-    if (usImageOrientation1 == US_IMG_ORIENT_FM
-        || usImageOrientation1 == US_IMG_ORIENT_FU
-        || usImageOrientation1 == US_IMG_ORIENT_NM
-        || usImageOrientation1 == US_IMG_ORIENT_NU)
-    {
-      // keep line pairs together
-      flipInfo.doubleRow = true;
-    }
-    else
-    {
-      LOG_ERROR("RF scanlines are expected to be in image rows");
-      return IGSIO_FAIL;
-    }
+    LOG_ERROR("Failed to convert image data to the requested orientation - " << (inputPixels == NULL ? "input" : "output") << " buffer is null!");
+    return IGSIO_FAIL;
   }
-  else if (usImageType1 == US_IMG_RF_IQ_LINE)
+
+  FlipClipTask task;
+  task.InputPixels = inputPixels;
+  task.OutputPixels = outputPixels;
+  task.FlipInfo = flipInfo;
+  task.ScalarSize = igsioVideoFrame::GetNumberOfBytesPerScalar(pixelType);
+  task.NumberOfScalarComponents = numberOfScalarComponents;
+  if (task.ScalarSize <= 0 || numberOfScalarComponents == 0)
   {
-    if (usImageOrientation1 == US_IMG_ORIENT_FM
-        || usImageOrientation1 == US_IMG_ORIENT_FU
-        || usImageOrientation1 == US_IMG_ORIENT_NM
-        || usImageOrientation1 == US_IMG_ORIENT_NU)
-    {
-      // keep IQ value pairs together
-      flipInfo.doubleColumn = true;
-    }
-    else
-    {
-      LOG_ERROR("RF scanlines are expected to be in image rows");
-      return IGSIO_FAIL;
-    }
+    LOG_ERROR("Failed to convert image data to the requested orientation - invalid pixel type (" << pixelType << ") or number of components (" << numberOfScalarComponents << ")");
+    return IGSIO_FAIL;
   }
-
-  flipInfo.hFlip = false; // horizontal
-  flipInfo.vFlip = false; // vertical
-  flipInfo.eFlip = false; // elevational
-  flipInfo.tranpose = TRANSPOSE_NONE; // no transpose
-  if (usImageOrientation1 == US_IMG_ORIENT_XX)
+  if (swapBytes && task.ScalarSize > 1 && igsioVideoFrameKernels::GetSwapBytesFunction(task.ScalarSize) == NULL)
   {
-    LOG_ERROR("Failed to determine the necessary image flip - unknown input image orientation 1");
+    LOG_ERROR("Failed to convert image data to the requested orientation - cannot swap the byte order of " << task.ScalarSize << "-byte scalars");
     return IGSIO_FAIL;
   }
+  task.SwapBytes = (swapBytes && task.ScalarSize > 1);
+  task.InputDimensions[0] = inputFrameSizeInPx[0];
+  task.InputDimensions[1] = inputFrameSizeInPx[1];
+  task.InputDimensions[2] = std::max(1, static_cast<int>(inputFrameSizeInPx[2]));
+  ComputeFlipClipGeometry(task.InputDimensions, flipInfo, clipRectangleOrigin, clipRectangleSize, task.ClipRectangleOrigin, task.ClipRectangleSize, task.OutputDimensions, true);
 
-  if (usImageOrientation2 == US_IMG_ORIENT_XX)
+  // Zero stride means tightly packed rows or slices
+  const vtkIdType pixelSizeInBytes = task.ScalarSize * task.NumberOfScalarComponents;
+  task.InputRowStride = (inputRowStride != 0 ? inputRowStride : task.InputDimensions[0] * pixelSizeInBytes);
+  task.InputSliceStride = (inputSliceStride != 0 ? inputSliceStride : task.InputDimensions[1] * task.InputRowStride);
+  task.OutputRowStride = (outputRowStride != 0 ? outputRowStride : task.OutputDimensions[0] * pixelSizeInBytes);
+  task.OutputSliceStride = (outputSliceStride != 0 ? outputSliceStride : task.OutputDimensions[1] * task.OutputRowStride);
+
+  return ExecuteFlipClipTask(task, GetEffectiveFlipClipNumberOfThreads());
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::FlipClipImage(vtkImageData* inUsImage,
+    const igsioVideoFrame::FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize,
+    vtkImageData* outUsOrientedImage)
+{
+  return FlipClipImageInternal(inUsImage, flipInfo, clipRectangleOrigin, clipRectangleSize, outUsOrientedImage, GetEffectiveFlipClipNumberOfThreads());
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::FlipClipImages(const std::vector<vtkImageData*>& inUsImages,
+    const igsioVideoFrame::FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize,
+    const std::vector<vtkImageData*>& outUsOrientedImages)
+{
+  if (inUsImages.size() != outUsOrientedImages.size())
   {
-    LOG_ERROR("Failed to determine the necessary image flip - unknown input image orientation 2");
-    return IGSIO_SUCCESS;
+    LOG_ERROR("Failed to convert images to the requested orientation - number of input (" << inUsImages.size() << ") and output (" << outUsOrientedImages.size() << ") images differ");
+    return IGSIO_FAIL;
   }
-  if (usImageOrientation1 == usImageOrientation2)
+  if (inUsImages.empty())
   {
-    // no flip
     return IGSIO_SUCCESS;
   }
 
-  if ((usImageOrientation1 == US_IMG_ORIENT_UF && usImageOrientation2 == US_IMG_ORIENT_MF) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MF && usImageOrientation2 == US_IMG_ORIENT_UF) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UN && usImageOrientation2 == US_IMG_ORIENT_MN) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MN && usImageOrientation2 == US_IMG_ORIENT_UN) ||
-      (usImageOrientation1 == US_IMG_ORIENT_FU && usImageOrientation2 == US_IMG_ORIENT_NU) ||
-      (usImageOrientation1 == US_IMG_ORIENT_NU && usImageOrientation2 == US_IMG_ORIENT_FU) ||
-      (usImageOrientation1 == US_IMG_ORIENT_FM && usImageOrientation2 == US_IMG_ORIENT_NM) ||
-      (usImageOrientation1 == US_IMG_ORIENT_NM && usImageOrientation2 == US_IMG_ORIENT_FM)
-     )
+  const int numberOfThreads = std::min<int>(GetEffectiveFlipClipNumberOfThreads(), static_cast<int>(std::min<size_t>(inUsImages.size(), VTK_MAX_THREADS)));
+  if (numberOfThreads <= 1)
   {
-    // flip x
-    flipInfo.hFlip = true;
-    return IGSIO_SUCCESS;
+    igsioStatus status = IGSIO_SUCCESS;
+    for (size_t i = 0; i < inUsImages.size(); ++i)
+    {
+      if (FlipClipImageInternal(inUsImages[i], flipInfo, clipRectangleOrigin, clipRectangleSize, outUsOrientedImages[i], 1) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to convert frame " << i << " of the batch");
+        status = IGSIO_FAIL;
+      }
+    }
+    return status;
   }
-  if ((usImageOrientation1 == US_IMG_ORIENT_UF && usImageOrientation2 == US_IMG_ORIENT_UN) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MF && usImageOrientation2 == US_IMG_ORIENT_MN) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UN && usImageOrientation2 == US_IMG_ORIENT_UF) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MN && usImageOrientation2 == US_IMG_ORIENT_MF) ||
-      (usImageOrientation1 == US_IMG_ORIENT_FU && usImageOrientation2 == US_IMG_ORIENT_FM) ||
-      (usImageOrientation1 == US_IMG_ORIENT_NU && usImageOrientation2 == US_IMG_ORIENT_NM) ||
-      (usImageOrientation1 == US_IMG_ORIENT_FM && usImageOrientation2 == US_IMG_ORIENT_FU) ||
-      (usImageOrientation1 == US_IMG_ORIENT_NM && usImageOrientation2 == US_IMG_ORIENT_NU)
-     )
+
+  FlipClipBatchThreadData threadData;
+  threadData.InputImages = &inUsImages;
+  threadData.OutputImages = &outUsOrientedImages;
+  threadData.FlipInfo = flipInfo;
+  threadData.ClipRectangleOrigin = clipRectangleOrigin;
+  threadData.ClipRectangleSize = clipRectangleSize;
+  threadData.ThreadStatus.resize(numberOfThreads, IGSIO_FAIL);
+  vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(FlipClipBatchThreadFunction, &threadData);
+  threader->SingleMethodExecute();
+
+  for (std::vector<igsioStatus>::iterator it = threadData.ThreadStatus.begin(); it != threadData.ThreadStatus.end(); ++it)
   {
-    // flip y
-    flipInfo.vFlip = true;
-    return IGSIO_SUCCESS;
+    if (*it != IGSIO_SUCCESS)
+    {
+      return IGSIO_FAIL;
+    }
+  }
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetFlipClipNumberOfThreads(int numberOfThreads)
+{
+  FlipClipNumberOfThreads.store(numberOfThreads);
+}
+
+//----------------------------------------------------------------------------
+int igsioVideoFrame::GetFlipClipNumberOfThreads()
+{
+  return FlipClipNumberOfThreads.load();
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrame::SetCopyOnWrite(bool enable)
+{
+  CopyOnWriteEnabled.store(enable);
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrame::GetCopyOnWrite()
+{
+  return CopyOnWriteEnabled.load();
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::SetPixelBufferAlignment(unsigned int alignmentInBytes)
+{
+  if ((alignmentInBytes & (alignmentInBytes - 1)) != 0 || (alignmentInBytes > 0 && alignmentInBytes < sizeof(void*)))
+  {
+    LOG_ERROR("Invalid pixel buffer alignment: " << alignmentInBytes << ". It must be 0 or a power of two that is at least " << sizeof(void*) << " bytes.");
+    return IGSIO_FAIL;
   }
-  if ((usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_UFD) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UFD && usImageOrientation2 == US_IMG_ORIENT_UFA) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MFA && usImageOrientation2 == US_IMG_ORIENT_MFD) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MFD && usImageOrientation2 == US_IMG_ORIENT_MFA) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UNA && usImageOrientation2 == US_IMG_ORIENT_UND) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UND && usImageOrientation2 == US_IMG_ORIENT_UNA) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MNA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_MNA)
-     )
+  if (alignmentInBytes > 0 && !ALIGNED_ALLOCATION_SUPPORTED)
   {
-    // flip z
-    flipInfo.eFlip = true;
-    return IGSIO_SUCCESS;
+    LOG_ERROR("Aligned pixel buffers require VTK 8.1 or later on this platform");
+    return IGSIO_FAIL;
   }
-  if ((usImageOrientation1 == US_IMG_ORIENT_UF && usImageOrientation2 == US_IMG_ORIENT_MN) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MF && usImageOrientation2 == US_IMG_ORIENT_UN) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UN && usImageOrientation2 == US_IMG_ORIENT_MF) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MN && usImageOrientation2 == US_IMG_ORIENT_UF) ||
-      (usImageOrientation1 == US_IMG_ORIENT_FU && usImageOrientation2 == US_IMG_ORIENT_NM) ||
-      (usImageOrientation1 == US_IMG_ORIENT_NU && usImageOrientation2 == US_IMG_ORIENT_FM) ||
-      (usImageOrientation1 == US_IMG_ORIENT_FM && usImageOrientation2 == US_IMG_ORIENT_NU) ||
-      (usImageOrientation1 == US_IMG_ORIENT_NM && usImageOrientation2 == US_IMG_ORIENT_FU)
-     )
+  PixelBufferAlignment.store(alignmentInBytes);
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+unsigned int igsioVideoFrame::GetPixelBufferAlignment()
+{
+  return PixelBufferAlignment.load();
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrame::IsPixelBufferAligned(unsigned int alignmentInBytes) const
+{
+  if (!this->IsImageValid())
   {
-    // flip xy
-    flipInfo.hFlip = true;
-    flipInfo.vFlip = true;
-    return IGSIO_SUCCESS;
+    return false;
   }
-  if ((usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_MFD) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MFD && usImageOrientation2 == US_IMG_ORIENT_UFA) ||
-      (usImageOrientation1 == US_IMG_ORIENT_UNA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
-      (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_UNA)
-     )
+  return IsPointerAligned(this->Image->GetScalarPointer(), alignmentInBytes);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType igsioVideoFrame::GetRowStrideInBytes() const
+{
+  if (!this->IsImageValid())
   {
-    // flip xz
-    flipInfo.hFlip = true;
-    flipInfo.eFlip = true;
-    return IGSIO_SUCCESS;
+    return 0;
   }
-  if (
-    (usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_UND) ||
-    (usImageOrientation1 == US_IMG_ORIENT_UND && usImageOrientation2 == US_IMG_ORIENT_UFA) ||
-    (usImageOrientation1 == US_IMG_ORIENT_MFA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
-    (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_MFA)
-  )
+  vtkIdType increments[3] = { 0, 0, 0 };
+  this->Image->GetIncrements(increments);
+  return increments[1] * this->GetNumberOfBytesPerScalar();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType igsioVideoFrame::GetSliceStrideInBytes() const
+{
+  if (!this->IsImageValid())
   {
-    // flip yz
-    flipInfo.vFlip = true;
-    flipInfo.eFlip = true;
-    return IGSIO_SUCCESS;
+    return 0;
   }
-  if (
-    (usImageOrientation1 == US_IMG_ORIENT_UFA && usImageOrientation2 == US_IMG_ORIENT_MND) ||
-    (usImageOrientation1 == US_IMG_ORIENT_MND && usImageOrientation2 == US_IMG_ORIENT_UFA)
-  )
+  vtkIdType increments[3] = { 0, 0, 0 };
+  this->Image->GetIncrements(increments);
+  return increments[2] * this->GetNumberOfBytesPerScalar();
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ComputeHash(unsigned long long& hash) const
+{
+  if (this->Image != NULL && this->IsImageValid())
   {
-    // flip xyz
-    flipInfo.hFlip = true;
-    flipInfo.vFlip = true;
-    flipInfo.eFlip = true;
+    hash = igsioVideoFrameKernels::Hash64(this->GetConstScalarPointer(), this->GetFrameSizeInBytes());
     return IGSIO_SUCCESS;
   }
-  if (
-    (usImageOrientation1 == US_IMG_ORIENT_AMF && usImageOrientation2 == US_IMG_ORIENT_MFA) ||
-    (usImageOrientation1 == US_IMG_ORIENT_MFA && usImageOrientation2 == US_IMG_ORIENT_AMF)
-  )
+  if (this->EncodedFrame != NULL)
   {
-    // Transpose J KI images to K IJ images
-    flipInfo.tranpose = TRANSPOSE_IJKtoKIJ;
+    hash = igsioVideoFrameKernels::Hash64(this->EncodedFrame->GetPointer(0), static_cast<size_t>(this->EncodedFrame->GetNumberOfValues()));
     return IGSIO_SUCCESS;
   }
-
-  assert(0);
-  LOG_ERROR("Image orientation conversion between orientations " << igsioVideoFrame::GetStringFromUsImageOrientation(usImageOrientation1)
-            << " and " << igsioVideoFrame::GetStringFromUsImageOrientation(usImageOrientation2)
-            << " is not supported. Only reordering of rows, columns and slices.");
+  LOG_ERROR("Unable to compute frame hash - the frame has no image data");
   return IGSIO_FAIL;
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetOrientedClippedImage(vtkImageData* inUsImage,
-    FlipInfoType flipInfo,
-    US_IMAGE_TYPE inUsImageType,
-    vtkImageData* outUsOrientedImage,
-    const std::array<int, 3>& clipRectangleOrigin,
-    const std::array<int, 3>& clipRectangleSize)
+std::string igsioVideoFrame::GetHashAsString(unsigned long long hash)
 {
-  if (inUsImage == NULL)
-  {
-    LOG_ERROR("Failed to convert image data to the requested orientation - input image is null!");
-    return IGSIO_FAIL;
-  }
+  std::ostringstream hashString;
+  hashString << std::hex << std::setfill('0') << std::setw(16) << hash;
+  return hashString.str();
+}
 
-  if (outUsOrientedImage == NULL)
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::GetHashFromString(const std::string& hashString, unsigned long long& hash)
+{
+  if (hashString.empty() || hashString.size() > 16 || hashString.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
   {
-    LOG_ERROR("Failed to convert image data to the requested orientation - output image is null!");
+    LOG_ERROR("Invalid frame hash: " << hashString);
     return IGSIO_FAIL;
   }
-
-  return igsioVideoFrame::FlipClipImage(inUsImage, flipInfo, clipRectangleOrigin, clipRectangleSize, outUsOrientedImage);
+  hash = std::stoull(hashString, NULL, 16);
+  return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-// vtkImageImport logs a warning if the image size is (1,1,1) because it thinks
-// the whole extent is not set. Avoid the warning by specifying the extent using
-// a callback
-int* WholeExtentCallback_1_1_1(void*)
+igsioStatus igsioVideoFrame::ComputeFrameDifference(const igsioVideoFrame& frame1, const igsioVideoFrame& frame2, double changeThreshold, FrameDifferenceType& difference)
 {
-  static int defaultextent[6] = {0, 0, 0, 0, 0, 0};
-  return defaultextent;
+  const std::array<int, 3> noClip = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+  return igsioVideoFrame::ComputeFrameDifference(frame1, frame2, changeThreshold, noClip, noClip, difference);
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetOrientedClippedImage(unsigned char* imageDataPtr,
-    FlipInfoType flipInfo, US_IMAGE_TYPE inUsImageType,
-    igsioCommon::VTKScalarPixelType inUsImagePixelType,
-    unsigned int numberOfScalarComponents,
-    const FrameSizeType& inputFrameSizeInPx,
-    igsioVideoFrame& outBufferItem,
-    const std::array<int, 3>& clipRectangleOrigin,
-    const std::array<int, 3>& clipRectangleSize)
+igsioStatus igsioVideoFrame::ComputeFrameDifference(const igsioVideoFrame& frame1, const igsioVideoFrame& frame2, double changeThreshold,
+    const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize, FrameDifferenceType& difference)
 {
-  return igsioVideoFrame::GetOrientedClippedImage(imageDataPtr, flipInfo, inUsImageType, inUsImagePixelType,
-         numberOfScalarComponents, inputFrameSizeInPx, outBufferItem.GetImage(), clipRectangleOrigin, clipRectangleSize);
-}
+  difference = FrameDifferenceType();
+  if (frame1.GetConstImage() == NULL || !frame1.IsImageValid() || frame2.GetConstImage() == NULL || !frame2.IsImageValid())
+  {
+    LOG_ERROR("Failed to compute frame difference - the frames have no image data");
+    return IGSIO_FAIL;
+  }
 
-//----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::GetOrientedClippedImage(unsigned char* imageDataPtr,
-    FlipInfoType flipInfo,
-    US_IMAGE_TYPE inUsImageType,
-    igsioCommon::VTKScalarPixelType inUsImagePixelType,
-    unsigned int numberOfScalarComponents,
-    const FrameSizeType& inputFrameSizeInPx,
-    vtkImageData* outUsOrientedImage,
-    const std::array<int, 3>& clipRectangleOrigin,
-    const std::array<int, 3>& clipRectangleSize)
-{
-  if (imageDataPtr == NULL)
+  FrameSizeType frameSize = {0, 0, 0};
+  FrameSizeType otherFrameSize = {0, 0, 0};
+  frame1.GetFrameSize(frameSize);
+  frame2.GetFrameSize(otherFrameSize);
+  unsigned int numberOfScalarComponents(1);
+  unsigned int otherNumberOfScalarComponents(1);
+  frame1.GetNumberOfScalarComponents(numberOfScalarComponents);
+  frame2.GetNumberOfScalarComponents(otherNumberOfScalarComponents);
+  if (frameSize != otherFrameSize || frame1.GetVTKScalarPixelType() != frame2.GetVTKScalarPixelType() || numberOfScalarComponents != otherNumberOfScalarComponents)
   {
-    LOG_ERROR("Failed to convert image data to MF orientation - input image is null!");
+    LOG_ERROR("Failed to compute frame difference - the frames have different size or pixel type");
     return IGSIO_FAIL;
   }
 
-  if (outUsOrientedImage == NULL)
+  igsioVideoFrameKernels::FrameDifferenceFunctionType frameDifference = igsioVideoFrameKernels::GetFrameDifferenceFunction(GetKernelScalarType(frame1.GetVTKScalarPixelType()));
+  if (frameDifference == NULL)
   {
-    LOG_ERROR("Failed to convert image data to MF orientation - output image is null!");
+    LOG_ERROR("Failed to compute frame difference - unsupported pixel type: " << igsioVideoFrame::GetStringFromVTKPixelType(frame1.GetVTKScalarPixelType()));
     return IGSIO_FAIL;
   }
 
-  // Create a VTK image out of a buffer without copying the pixel data
-  vtkSmartPointer<vtkImageImport> inUsImage = vtkSmartPointer<vtkImageImport>::New();
-  inUsImage->SetImportVoidPointer(imageDataPtr);
+  std::array<int, 3> origin = {0, 0, 0};
+  std::array<int, 3> size = {static_cast<int>(frameSize[0]), static_cast<int>(frameSize[1]), static_cast<int>(frameSize[2])};
+  if (igsioCommon::IsClippingRequested(regionOrigin, regionSize))
+  {
+    const int extents[6] = {0, size[0] - 1, 0, size[1] - 1, 0, size[2] - 1};
+    if (regionSize[0] <= 0 || regionSize[1] <= 0 || regionSize[2] <= 0 || !igsioCommon::IsClippingWithinExtents(regionOrigin, regionSize, extents))
+    {
+      LOG_ERROR("Failed to compute frame difference - the region of interest is outside of the frame");
+      return IGSIO_FAIL;
+    }
+    origin = regionOrigin;
+    size = regionSize;
+  }
 
-  // Avoid warning if image size is (1,1,1)
-  if (inputFrameSizeInPx[0] == 1 && inputFrameSizeInPx[1] == 1 && inputFrameSizeInPx[2] == 1)
+  const unsigned char* pixels1 = static_cast<const unsigned char*>(frame1.GetConstScalarPointer());
+  const unsigned char* pixels2 = static_cast<const unsigned char*>(frame2.GetConstScalarPointer());
+  const size_t bytesPerPixel = frame1.GetNumberOfBytesPerPixel();
+  const size_t rowStride = frame1.GetRowStrideInBytes();
+  const size_t sliceStride = frame1.GetSliceStrideInBytes();
+  const size_t numberOfScalarsPerRow = static_cast<size_t>(size[0]) * numberOfScalarComponents;
+  unsigned long long numberOfChangedScalars = 0;
+  if (size[0] == static_cast<int>(frameSize[0]) && size[1] == static_cast<int>(frameSize[1]) && rowStride * frameSize[1] == sliceStride)
   {
-    inUsImage->SetWholeExtentCallback(WholeExtentCallback_1_1_1);
+    // Whole slices are contiguous
+    for (int z = origin[2]; z < origin[2] + size[2]; ++z)
+    {
+      frameDifference(pixels1 + z * sliceStride, pixels2 + z * sliceStride, numberOfScalarsPerRow * size[1], changeThreshold,
+                      difference.SumOfAbsoluteDifferences, numberOfChangedScalars);
+    }
   }
   else
   {
-    inUsImage->SetWholeExtent(0, inputFrameSizeInPx[0] - 1, 0, inputFrameSizeInPx[1] - 1, 0, inputFrameSizeInPx[2] - 1);
+    for (int z = origin[2]; z < origin[2] + size[2]; ++z)
+    {
+      for (int y = origin[1]; y < origin[1] + size[1]; ++y)
+      {
+        const size_t offset = z * sliceStride + y * rowStride + origin[0] * bytesPerPixel;
+        frameDifference(pixels1 + offset, pixels2 + offset, numberOfScalarsPerRow, changeThreshold, difference.SumOfAbsoluteDifferences, numberOfChangedScalars);
+      }
+    }
   }
 
-  inUsImage->SetDataExtent(0, inputFrameSizeInPx[0] - 1, 0, inputFrameSizeInPx[1] - 1, 0, inputFrameSizeInPx[2] - 1);
-  inUsImage->SetDataScalarType(outUsOrientedImage->GetScalarType());
-  inUsImage->SetNumberOfScalarComponents(outUsOrientedImage->GetNumberOfScalarComponents());
-  inUsImage->Update();
-
-  igsioStatus result = igsioVideoFrame::GetOrientedClippedImage(inUsImage->GetOutput(), flipInfo, inUsImageType,
-                       outUsOrientedImage, clipRectangleOrigin, clipRectangleSize);
+  difference.NumberOfComparedScalars = static_cast<unsigned long long>(numberOfScalarsPerRow) * size[1] * size[2];
+  if (difference.NumberOfComparedScalars > 0)
+  {
+    difference.MeanAbsoluteDifference = difference.SumOfAbsoluteDifferences / difference.NumberOfComparedScalars;
+    difference.ChangedScalarRatio = static_cast<double>(numberOfChangedScalars) / difference.NumberOfComparedScalars;
+  }
+  return IGSIO_SUCCESS;
+}
 
-  return result;
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ComputeStatistics(ImageStatisticsType& statistics, unsigned int numberOfBins, double histogramMinimum, double histogramMaximum) const
+{
+  const std::array<int, 3> noClip = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+  return this->ComputeStatistics(statistics, noClip, noClip, numberOfBins, histogramMinimum, histogramMaximum);
 }
 
 //----------------------------------------------------------------------------
-igsioStatus igsioVideoFrame::FlipClipImage(vtkImageData* inUsImage,
-    const igsioVideoFrame::FlipInfoType& flipInfo,
-    const std::array<int, 3>& clipRectangleOrigin,
-    const std::array<int, 3>& clipRectangleSize,
-    vtkImageData* outUsOrientedImage)
+igsioStatus igsioVideoFrame::ComputeStatistics(ImageStatisticsType& statistics, const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize,
+    unsigned int numberOfBins, double histogramMinimum, double histogramMaximum) const
 {
-  if (inUsImage == NULL)
+  statistics = ImageStatisticsType();
+  if (this->GetConstImage() == NULL || !this->IsImageValid())
   {
-    LOG_ERROR("Failed to convert image data to the requested orientation - input image is null!");
+    LOG_ERROR("Failed to compute image statistics - the frame has no image data");
     return IGSIO_FAIL;
   }
 
-  if (outUsOrientedImage == NULL)
+  const igsioCommon::VTKScalarPixelType pixelType = this->GetVTKScalarPixelType();
+  igsioVideoFrameKernels::AccumulateStatisticsFunctionType accumulateStatistics = igsioVideoFrameKernels::GetAccumulateStatisticsFunction(GetKernelScalarType(pixelType));
+  if (accumulateStatistics == NULL)
   {
-    LOG_ERROR("Failed to convert image data to the requested orientation - output image is null!");
+    LOG_ERROR("Failed to compute image statistics - unsupported pixel type: " << igsioVideoFrame::GetStringFromVTKPixelType(pixelType));
     return IGSIO_FAIL;
   }
 
-  if (!flipInfo.hFlip && !flipInfo.vFlip && !flipInfo.eFlip && flipInfo.tranpose == TRANSPOSE_NONE)
+  FrameSizeType frameSize = {0, 0, 0};
+  this->GetFrameSize(frameSize);
+  std::array<int, 3> origin = {0, 0, 0};
+  std::array<int, 3> size = {static_cast<int>(frameSize[0]), static_cast<int>(frameSize[1]), static_cast<int>(frameSize[2])};
+  if (igsioCommon::IsClippingRequested(regionOrigin, regionSize))
   {
-    if (igsioCommon::IsClippingRequested(clipRectangleOrigin, clipRectangleSize))
+    const int extents[6] = {0, size[0] - 1, 0, size[1] - 1, 0, size[2] - 1};
+    if (regionSize[0] <= 0 || regionSize[1] <= 0 || regionSize[2] <= 0 || !igsioCommon::IsClippingWithinExtents(regionOrigin, regionSize, extents))
     {
-      // No flip or transpose, but clipping requested, let vtk do the heavy lifting
-      vtkSmartPointer<vtkExtractVOI> extract = vtkSmartPointer<vtkExtractVOI>::New();
-      vtkSmartPointer<vtkTrivialProducer> tp = vtkSmartPointer<vtkTrivialProducer>::New();
-      tp->SetOutput(inUsImage);
-      extract->SetInputConnection(tp->GetOutputPort());
-      extract->SetVOI(
-        clipRectangleOrigin[0], clipRectangleOrigin[0] + clipRectangleSize[0] - 1,
-        clipRectangleOrigin[1], clipRectangleOrigin[1] + clipRectangleSize[1] - 1,
-        clipRectangleOrigin[2], clipRectangleOrigin[2] + clipRectangleSize[2] - 1
-      );
-      extract->SetOutput(outUsOrientedImage);
-      extract->Update();
-      return IGSIO_SUCCESS;
+      LOG_ERROR("Failed to compute image statistics - the region of interest is outside of the frame");
+      return IGSIO_FAIL;
     }
-    else
+    origin = regionOrigin;
+    size = regionSize;
+  }
+
+  igsioVideoFrameKernels::StatisticsAccumulator accumulator;
+  if (numberOfBins > 0)
+  {
+    if (histogramMaximum <= histogramMinimum)
     {
-      // no flip, clip or transpose
-      outUsOrientedImage->DeepCopy(inUsImage);
-      return IGSIO_SUCCESS;
+      if (pixelType == VTK_FLOAT || pixelType == VTK_DOUBLE)
+      {
+        // The range is not known in advance, it needs an additional pass
+        AccumulateRegionStatistics(*this, accumulateStatistics, origin, size, accumulator);
+        histogramMinimum = accumulator.Minimum;
+        histogramMaximum = (accumulator.Maximum > accumulator.Minimum ? accumulator.Maximum : accumulator.Minimum + 1.0);
+        accumulator = igsioVideoFrameKernels::StatisticsAccumulator();
+      }
+      else
+      {
+        histogramMinimum = vtkDataArray::GetDataTypeMin(pixelType);
+        histogramMaximum = vtkDataArray::GetDataTypeMax(pixelType) + 1.0;
+      }
     }
+    statistics.Histogram.assign(numberOfBins, 0);
+    statistics.HistogramMinimum = histogramMinimum;
+    statistics.HistogramMaximum = histogramMaximum;
+    accumulator.Histogram = &statistics.Histogram[0];
+    accumulator.NumberOfBins = numberOfBins;
+    accumulator.HistogramMinimum = histogramMinimum;
+    accumulator.HistogramMaximum = histogramMaximum;
   }
+  AccumulateRegionStatistics(*this, accumulateStatistics, origin, size, accumulator);
 
-  // Validate output image is correct dimensions to receive final oriented and/or clipped result
-  int inputDimensions[3] = {0, 0, 0};
-  inUsImage->GetDimensions(inputDimensions);
-  std::array<int, 3> finalClipOrigin = {clipRectangleOrigin[0], clipRectangleOrigin[1], clipRectangleOrigin[2]};
-  std::array<int, 3> finalClipSize = {clipRectangleSize[0], clipRectangleSize[1], clipRectangleSize[2]};
-  int finalOutputSize[3] = {inputDimensions[0], inputDimensions[1], inputDimensions[2]};
-  if (igsioCommon::IsClippingRequested(clipRectangleOrigin, clipRectangleSize))
+  statistics.NumberOfScalars = accumulator.NumberOfScalars;
+  if (accumulator.NumberOfScalars > 0)
   {
-    // Clipping requested, validate that source image is bigger than requested clip size
-    int inExtents[6] = {0, 0, 0, 0, 0, 0};
-    inUsImage->GetExtent(inExtents);
+    statistics.Minimum = accumulator.Minimum;
+    statistics.Maximum = accumulator.Maximum;
+    statistics.Mean = accumulator.Sum / accumulator.NumberOfScalars;
+    const double variance = accumulator.SumOfSquares / accumulator.NumberOfScalars - statistics.Mean * statistics.Mean;
+    statistics.StandardDeviation = (variance > 0.0 ? std::sqrt(variance) : 0.0);
+  }
+  return IGSIO_SUCCESS;
+}
 
-    if (!igsioCommon::IsClippingWithinExtents(clipRectangleOrigin, clipRectangleSize, inExtents))
-    {
-      LOG_WARNING("Clipping information cannot fit within the original image. No clipping will be performed. Origin=[" << clipRectangleOrigin[0] << "," << clipRectangleOrigin[1] << "," << clipRectangleOrigin[2] <<
-                  "]. Size=[" << clipRectangleSize[0] << "," << clipRectangleSize[1] << "," << clipRectangleSize[2] << "].");
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::ComputeFramesStatistics(const std::vector<const igsioVideoFrame*>& frames, std::vector<ImageStatisticsType>& statistics,
+    const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize,
+    unsigned int numberOfBins, double histogramMinimum, double histogramMaximum)
+{
+  statistics.assign(frames.size(), ImageStatisticsType());
+  if (frames.empty())
+  {
+    return IGSIO_SUCCESS;
+  }
 
-      finalClipOrigin[0] = 0;
-      finalClipOrigin[1] = 0;
-      finalClipOrigin[2] = 0;
-      finalClipSize[0] = inputDimensions[0];
-      finalClipSize[1] = inputDimensions[1];
-      finalClipSize[2] = inputDimensions[2];
-      finalOutputSize[0] = inputDimensions[0];
-      finalOutputSize[1] = inputDimensions[1];
-      finalOutputSize[2] = inputDimensions[2];
-    }
-    else
+  StatisticsBatchThreadData threadData;
+  threadData.Frames = &frames;
+  threadData.Statistics = &statistics;
+  threadData.RegionOrigin = regionOrigin;
+  threadData.RegionSize = regionSize;
+  threadData.NumberOfBins = numberOfBins;
+  threadData.HistogramMinimum = histogramMinimum;
+  threadData.HistogramMaximum = histogramMaximum;
+  const int numberOfThreads = std::min<int>(GetEffectiveNumberOfThreads(PixelConversionNumberOfThreads.load()), static_cast<int>(std::min<size_t>(frames.size(), VTK_MAX_THREADS)));
+  if (numberOfThreads <= 1)
+  {
+    return ComputeStatisticsBatchRange(threadData, 0, 1);
+  }
+
+  threadData.ThreadStatus.resize(numberOfThreads, IGSIO_FAIL);
+  vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(StatisticsBatchThreadFunction, &threadData);
+  threader->SingleMethodExecute();
+
+  for (std::vector<igsioStatus>::iterator it = threadData.ThreadStatus.begin(); it != threadData.ThreadStatus.end(); ++it)
+  {
+    if (*it != IGSIO_SUCCESS)
     {
-      // Clip parameters are good, set the final output size to be the clipped size
-      finalOutputSize[0] = clipRectangleSize[0];
-      finalOutputSize[1] = clipRectangleSize[1];
-      finalOutputSize[2] = clipRectangleSize[2];
+      return IGSIO_FAIL;
     }
   }
-  else
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrame::IsPixelBufferShared() const
+{
+  if (this->Image == NULL)
   {
-    finalClipOrigin[0] = 0;
-    finalClipOrigin[1] = 0;
-    finalClipOrigin[2] = 0;
-    finalClipSize[0] = inputDimensions[0];
-    finalClipSize[1] = inputDimensions[1];
-    finalClipSize[2] = inputDimensions[2];
+    return false;
   }
+  vtkDataArray* scalars = this->Image->GetPointData()->GetScalars();
+  if (IsExternalScalars(scalars))
+  {
+    // External buffers are never written, regardless of how the image was obtained
+    return true;
+  }
+  return IsSharedScalars(scalars) && scalars->GetReferenceCount() > 1;
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrame::IsPixelBufferExternal() const
+{
+  return this->Image != NULL && IsExternalScalars(this->Image->GetPointData()->GetScalars());
+}
 
-  // Adjust output image dimensions to account for transposition of axes
-  if (flipInfo.tranpose == TRANSPOSE_IJKtoKIJ)
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::SetExternalPixelBuffer(const void* pixels, const FrameSizeType& frameSize, igsioCommon::VTKScalarPixelType pixelType, unsigned int numberOfScalarComponents)
+{
+  if (pixels == NULL)
+  {
+    LOG_ERROR("Failed to set external pixel buffer - input buffer is NULL!");
+    return IGSIO_FAIL;
+  }
+  if (frameSize[0] == 0 || frameSize[1] == 0 || frameSize[2] == 0 || numberOfScalarComponents == 0)
   {
-    int temp = finalOutputSize[0];
-    finalOutputSize[0] = finalOutputSize[2];
-    finalOutputSize[2] = finalOutputSize[1];
-    finalOutputSize[1] = temp;
+    LOG_ERROR("Failed to set external pixel buffer - invalid frame size: " << frameSize[0] << "x" << frameSize[1] << "x" << frameSize[2]
+              << ", number of scalar components: " << numberOfScalarComponents);
+    return IGSIO_FAIL;
+  }
+  vtkDataArray* scalars = vtkDataArray::CreateDataArray(pixelType);
+  if (scalars == NULL)
+  {
+    LOG_ERROR("Failed to set external pixel buffer - unsupported pixel type: " << pixelType);
+    return IGSIO_FAIL;
   }
 
-  int outDimensions[3] = {0, 0, 0};
-  outUsOrientedImage->GetDimensions(outDimensions);
+  // The array does not release the memory (save = 1) and the frame never writes it, see IsPixelBufferShared
+  const vtkIdType numberOfValues = static_cast<vtkIdType>(frameSize[0]) * frameSize[1] * frameSize[2] * numberOfScalarComponents;
+  scalars->SetNumberOfComponents(numberOfScalarComponents);
+  scalars->SetVoidArray(const_cast<void*>(pixels), numberOfValues, 1);
+  scalars->GetInformation()->Set(GetExternalPixelBufferKey(), 1);
 
-  // Update the output image if the dimensions don't match the final clip size (which might be the same as the input image)
-  if (outDimensions[0] != finalOutputSize[0] || outDimensions[1] != finalOutputSize[1] || outDimensions[2] != finalOutputSize[2] || outUsOrientedImage->GetScalarType() != inUsImage->GetScalarType() || outUsOrientedImage->GetNumberOfScalarComponents() != inUsImage->GetNumberOfScalarComponents())
+  if (this->Image == NULL)
+  {
+    this->SetImageData(vtkImageData::New());
+  }
+  else
   {
-    // Allocate the output image, adjust for 1 based sizes to 0 based extents
-    outUsOrientedImage->SetExtent(0, finalOutputSize[0] - 1, 0, finalOutputSize[1] - 1, 0, finalOutputSize[2] - 1);
-    outUsOrientedImage->AllocateScalars(inUsImage->GetScalarType(), inUsImage->GetNumberOfScalarComponents());
+    ReturnImageScalarsToPool(this->Image);
   }
+  this->Image->SetExtent(0, frameSize[0] - 1, 0, frameSize[1] - 1, 0, frameSize[2] - 1);
+  this->Image->GetPointData()->SetScalars(scalars);
+  scalars->Delete();
+  return IGSIO_SUCCESS;
+}
 
-  int numberOfBytesPerScalar = igsioVideoFrame::GetNumberOfBytesPerScalar(inUsImage->GetScalarType());
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrame::MakePixelBufferUnique(bool copyPixels)
+{
+  if (!this->IsPixelBufferShared())
+  {
+    return IGSIO_SUCCESS;
+  }
 
-  igsioStatus status(IGSIO_FAIL);
-  switch (numberOfBytesPerScalar)
+  vtkDataArray* sharedScalars = this->Image->GetPointData()->GetScalars();
+  vtkDataArray* uniqueScalars = CreateScalars(sharedScalars->GetDataType(), sharedScalars->GetNumberOfComponents(), sharedScalars->GetNumberOfTuples());
+  if (uniqueScalars == NULL)
   {
-    case 1:
-      status = FlipClipImageGeneric<vtkTypeUInt8>(inUsImage, flipInfo, finalClipOrigin, finalClipSize, outUsOrientedImage);
-      break;
-    case 2:
-      status = FlipClipImageGeneric<vtkTypeUInt16>(inUsImage, flipInfo, finalClipOrigin, finalClipSize, outUsOrientedImage);
-      break;
-    case 4:
-      status = FlipClipImageGeneric<vtkTypeUInt32>(inUsImage, flipInfo, finalClipOrigin, finalClipSize, outUsOrientedImage);
-      break;
-    case 8:
-      status = FlipClipImageGeneric<vtkTypeUInt64>(inUsImage, flipInfo, finalClipOrigin, finalClipSize, outUsOrientedImage);
-      break;
-    default:
-      LOG_ERROR("Unsupported bit depth: " << numberOfBytesPerScalar << " bytes per scalar");
-      break;
+    LOG_ERROR("Failed to allocate memory for the private copy of a shared frame buffer");
+    return IGSIO_FAIL;
+  }
+  if (copyPixels)
+  {
+    memcpy(uniqueScalars->GetVoidPointer(0), sharedScalars->GetVoidPointer(0), sharedScalars->GetDataSize() * sharedScalars->GetDataTypeSize());
   }
-  return status;
+  uniqueScalars->SetName(sharedScalars->GetName());
+  this->Image->GetPointData()->SetScalars(uniqueScalars);
+  uniqueScalars->Delete();
+  return IGSIO_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
@@ -1367,8 +2975,24 @@ int igsioVideoFrame::GetNumberOfBytesPerScalar(igsioCommon::VTKScalarPixelType p
   }
 }
 
+//----------------------------------------------------------------------------
+vtkImageData* igsioVideoFrame::GetImage()
+{
+  if (this->MakePixelBufferUnique(true) != IGSIO_SUCCESS)
+  {
+    return NULL;
+  }
+  return this->Image;
+}
+
 //----------------------------------------------------------------------------
 vtkImageData* igsioVideoFrame::GetImage() const
+{
+  return this->GetConstImage();
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* igsioVideoFrame::GetConstImage() const
 {
   return this->Image;
 }
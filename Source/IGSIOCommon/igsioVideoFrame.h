@@ -14,6 +14,11 @@ See License.txt for details.
 #include "vtkImageExport.h"
 #include "vtkImageData.h"
 
+// STL includes
+#include <vector>
+
+class igsioVideoFrameView;
+
 /*!
 \enum US_IMAGE_ORIENTATION
 \brief Defines constant values for ultrasound image orientation
@@ -119,6 +124,12 @@ public:
   /*! Equality operator */
   igsioVideoFrame& operator=(igsioVideoFrame const& videoItem);
 
+  /*! Move constructor, takes over the image and encoded frame of the other frame without copying the pixels. The other frame becomes empty. */
+  igsioVideoFrame(igsioVideoFrame&& videoItem);
+
+  /*! Move assignment, takes over the image and encoded frame of the other frame without copying the pixels. The other frame becomes empty. */
+  igsioVideoFrame& operator=(igsioVideoFrame&& videoItem);
+
   /*! Allocate memory for the image. The image object must be already created. */
   static igsioStatus AllocateFrame(vtkImageData* image, const FrameSizeType& imageSize, igsioCommon::VTKScalarPixelType vtkScalarPixelType, unsigned int numberOfScalarComponents);
   /*! Allocate memory for the image. */
@@ -185,15 +196,126 @@ public:
   /* Get the frame type */
   FRAME_TYPE GetFrameType();
 
-  /*! Get the pointer to the pixel buffer */
+  /*!
+  Get the pointer to the pixel buffer for writing. If the buffer is shared with copies of
+  this frame (see SetCopyOnWrite) then a private copy of the buffer is made first.
+  */
+  void* GetScalarPointer();
+  /*!
+  Get the pointer to the pixel buffer of a const frame, same as GetConstScalarPointer. Never copies the
+  pixel buffer, so the pixels must not be modified through the returned pointer.
+  */
   void* GetScalarPointer() const;
 
+  /*! Get the pointer to the pixel buffer for reading, never copies the pixel buffer */
+  const void* GetConstScalarPointer() const;
+
   /*! Get the pixel buffer size in bytes */
   unsigned long GetFrameSizeInBytes() const;
 
-  /*! Get the VTK image, does not copy the pixel buffer */
+  /*! Get the distance in bytes between the first pixels of consecutive rows, 0 if the image is not valid */
+  vtkIdType GetRowStrideInBytes() const;
+
+  /*! Get the distance in bytes between the first pixels of consecutive slices, 0 if the image is not valid */
+  vtkIdType GetSliceStrideInBytes() const;
+
+  /*!
+  Compute a 64-bit digest (XXH64, see igsioVideoFrameKernels::Hash64) of the pixel buffer, or of the encoded frame
+  data if the frame is encoded. Only the content is hashed, frame size and pixel type are not included.
+  */
+  igsioStatus ComputeHash(unsigned long long& hash) const;
+
+  /*! Get a hash as a string of 16 hexadecimal digits */
+  static std::string GetHashAsString(unsigned long long hash);
+
+  /*! Parse a string created by GetHashAsString */
+  static igsioStatus GetHashFromString(const std::string& hashString, unsigned long long& hash);
+
+  /*! Change metrics of two frames, see ComputeFrameDifference */
+  struct FrameDifferenceType
+  {
+    FrameDifferenceType() : SumOfAbsoluteDifferences(0.0), MeanAbsoluteDifference(0.0), ChangedScalarRatio(0.0), NumberOfComparedScalars(0) {};
+    double SumOfAbsoluteDifferences; // sum of the absolute differences of the compared scalars
+    double MeanAbsoluteDifference; // sum of absolute differences divided by the number of compared scalars
+    double ChangedScalarRatio; // fraction of the compared scalars whose absolute difference is larger than the change threshold
+    unsigned long long NumberOfComparedScalars; // number of pixels in the region multiplied by the number of scalar components
+  };
+
+  /*!
+  Compare the pixels of two frames of the same size and pixel type. A scalar is changed if its absolute difference
+  is larger than changeThreshold (0: any difference). 8-bit images are vectorized.
+  */
+  static igsioStatus ComputeFrameDifference(const igsioVideoFrame& frame1, const igsioVideoFrame& frame2, double changeThreshold, FrameDifferenceType& difference);
+
+  /*!
+  Compare the pixels of two frames within a region of interest.
+  \param regionOrigin the first pixel of the region
+  \param regionSize the size of the region, a value of NO_CLIP in any of the origin or size components means the whole frame is compared
+  */
+  static igsioStatus ComputeFrameDifference(const igsioVideoFrame& frame1, const igsioVideoFrame& frame2, double changeThreshold,
+      const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize, FrameDifferenceType& difference);
+
+  /*! Pixel value statistics of a frame, see ComputeStatistics */
+  struct ImageStatisticsType
+  {
+    ImageStatisticsType() : Minimum(0.0), Maximum(0.0), Mean(0.0), StandardDeviation(0.0), NumberOfScalars(0), HistogramMinimum(0.0), HistogramMaximum(0.0) {}
+    double Minimum;
+    double Maximum;
+    double Mean;
+    double StandardDeviation; // population standard deviation
+    unsigned long long NumberOfScalars; // number of pixels in the region multiplied by the number of scalar components
+    double HistogramMinimum; // lower limit of the first bin, smaller values are counted in the first bin
+    double HistogramMaximum; // upper limit of the last bin, larger values are counted in the last bin
+    std::vector<unsigned long long> Histogram; // number of scalars in each of the equally sized bins of [HistogramMinimum, HistogramMaximum)
+  };
+
+  /*!
+  Compute the minimum, maximum, mean, standard deviation and an optional histogram of the pixel values in a single pass.
+  All scalar components are included. 8-bit images are vectorized.
+  \param numberOfBins number of histogram bins, 0 disables the histogram
+  \param histogramMinimum, histogramMaximum range of the histogram. If histogramMaximum is not larger than histogramMinimum then
+    the full range of the scalar type is used for integer types ([0, 256) for unsigned char) and the range of the pixel values
+    for floating point types (which requires a second pass).
+  */
+  igsioStatus ComputeStatistics(ImageStatisticsType& statistics, unsigned int numberOfBins = 0, double histogramMinimum = 0.0, double histogramMaximum = 0.0) const;
+
+  /*!
+  Compute the pixel value statistics within a region of interest, see ComputeStatistics.
+  \param regionOrigin the first pixel of the region
+  \param regionSize the size of the region, a value of NO_CLIP in any of the origin or size components means the whole frame
+  */
+  igsioStatus ComputeStatistics(ImageStatisticsType& statistics, const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize,
+                                unsigned int numberOfBins = 0, double histogramMinimum = 0.0, double histogramMaximum = 0.0) const;
+
+  /*!
+  Compute the pixel value statistics of multiple frames, statistics[i] belongs to frames[i]. See ComputeStatistics.
+  The frames are distributed between threads (see SetPixelConversionNumberOfThreads), each frame is processed by a single thread.
+  */
+  static igsioStatus ComputeFramesStatistics(const std::vector<const igsioVideoFrame*>& frames, std::vector<ImageStatisticsType>& statistics,
+      const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize,
+      unsigned int numberOfBins = 0, double histogramMinimum = 0.0, double histogramMaximum = 0.0);
+
+  /*! Return true if the first pixel of the buffer is aligned to an alignmentInBytes boundary */
+  bool IsPixelBufferAligned(unsigned int alignmentInBytes = 64) const;
+
+  /*!
+  Get the VTK image for modifying the pixels. If the pixel buffer is shared with copies of this frame
+  (see SetCopyOnWrite) or it is an external buffer then a private copy of the buffer is made first.
+  Returns NULL if the private copy cannot be allocated.
+  */
+  vtkImageData* GetImage();
+  /*!
+  Get the VTK image of a const frame, same as GetConstImage. Never copies the pixel buffer, so the pixels
+  must not be modified through the returned image.
+  */
   vtkImageData* GetImage() const;
 
+  /*!
+  Get the VTK image for reading, never copies the pixel buffer. The pixel buffer of the image may be
+  shared with copies of this frame, the pixels must not be modified through the returned image.
+  */
+  vtkImageData* GetConstImage() const;
+
   /*! Get the encoded frame data, does not copy the frame buffer*/
   vtkUnsignedCharArray* GetEncodedFrame() const;
 
@@ -289,7 +411,8 @@ public:
       const std::array<int, 3>& clipRectangleSize);
 
   /*!
-  Flip a 2D image along one or two axes. This is a performance optimized version of flipping that does not use ITK filters
+  Flip an image along any combination of its axes, or transpose it. This is a performance optimized version of flipping that does not use ITK filters.
+  Large images are split between multiple threads (see SetFlipClipNumberOfThreads).
   \param clipRectangleOrigin the clipping origin relative to the inUsImage data origin
   \param clipRectangleSize the size of the clipping space, a value of NO_CLIP in either [0],[1] or [2] indicates no clipping performed
   */
@@ -299,6 +422,173 @@ public:
                                    const std::array<int, 3>& clipRectangleSize,
                                    vtkImageData* outUsOrientedImage);
 
+  /*!
+  Flip and clip a batch of images with the same parameters. The frames are distributed between
+  the worker threads (see SetFlipClipNumberOfThreads), each frame is converted on a single thread.
+  \param inUsImages input images
+  \param outUsOrientedImages output images, must contain the same number of elements as inUsImages
+  */
+  static igsioStatus FlipClipImages(const std::vector<vtkImageData*>& inUsImages,
+                                    const FlipInfoType& flipInfo,
+                                    const std::array<int, 3>& clipRectangleOrigin,
+                                    const std::array<int, 3>& clipRectangleSize,
+                                    const std::vector<vtkImageData*>& outUsOrientedImages);
+
+  /*!
+  Set the maximum number of threads used by FlipClipImage and FlipClipImages.
+  1 (default) processes images on the calling thread, 0 uses the number of processors.
+  Images are only split between threads if they are large enough (e.g., 3D volumes or large frames).
+  */
+  static void SetFlipClipNumberOfThreads(int numberOfThreads);
+  static int GetFlipClipNumberOfThreads();
+
+  /*!
+  Enable sharing of the pixel buffer between copies of a frame (copy constructor, assignment, DeepCopy).
+  The shared buffer is only copied when the pixels of one of the frames are modified through
+  GetImage, GetScalarPointer, FillBlank, AllocateFrame, DeepCopyFrom or GetOrientedClippedImage, so copying
+  a frame costs the same as copying its metadata. Pixels must not be modified through GetConstImage or
+  GetConstScalarPointer. Disabled by default.
+  */
+  static void SetCopyOnWrite(bool enable);
+  static bool GetCopyOnWrite();
+
+  /*! Return true if the pixel buffer is currently shared with a copy of this frame or it is an external buffer */
+  bool IsPixelBufferShared() const;
+
+  /*!
+  Use pixels stored in a memory buffer owned by the caller as the pixel buffer of the frame, without copying them.
+  Rows and slices must be tightly packed. The frame never modifies or releases the external buffer: a private
+  copy is made when the pixels are modified through GetImage, GetScalarPointer, FillBlank, AllocateFrame, DeepCopyFrom or
+  GetOrientedClippedImage (the same way as for shared buffers, see SetCopyOnWrite), and the buffer is not added
+  to the frame buffer pool. The external buffer must remain valid while this frame or any copy sharing its pixels uses it.
+  */
+  igsioStatus SetExternalPixelBuffer(const void* pixels, const FrameSizeType& frameSize, igsioCommon::VTKScalarPixelType pixelType, unsigned int numberOfScalarComponents);
+
+  /*! Return true if the pixel buffer is an external buffer set by SetExternalPixelBuffer */
+  bool IsPixelBufferExternal() const;
+
+  /*!
+  Set the alignment of the first pixel of pixel buffers allocated by AllocateFrame (and of private copies of shared buffers).
+  64 aligns buffers to cache lines, which allows vectorized kernels to use aligned loads. Aligned buffers are
+  padded to a multiple of the alignment at the end. 0 (default) uses the default VTK allocation.
+  The alignment must be 0 or a power of two that is not smaller than the size of a pointer.
+  Rows are always tightly packed (vtkImageData does not support row padding), use GetRowStrideInBytes in kernels.
+  */
+  static igsioStatus SetPixelBufferAlignment(unsigned int alignmentInBytes);
+  static unsigned int GetPixelBufferAlignment();
+
+  /*!
+  Flip and clip an image stored in a memory buffer, without wrapping it in VTK objects.
+  The output buffer must be large enough for an image of GetFlipClipOutputSize size.
+  \param inputRowStride distance between the first bytes of consecutive input rows, 0 if rows are tightly packed
+  \param inputSliceStride distance between the first bytes of consecutive input slices, 0 if slices are tightly packed
+  \param outputRowStride distance between the first bytes of consecutive output rows, 0 if rows are tightly packed
+  \param outputSliceStride distance between the first bytes of consecutive output slices, 0 if slices are tightly packed
+  \param clipRectangleOrigin the clipping origin relative to the input image origin
+  \param clipRectangleSize the size of the clipping space, a value of NO_CLIP in either [0],[1] or [2] indicates no clipping performed
+  \param swapBytes if true then the byte order of each scalar is reversed while it is copied (e.g., for reading big-endian files)
+  */
+  static igsioStatus FlipClipImage(const unsigned char* inputPixels,
+                                   const FrameSizeType& inputFrameSizeInPx,
+                                   vtkIdType inputRowStride,
+                                   vtkIdType inputSliceStride,
+                                   igsioCommon::VTKScalarPixelType pixelType,
+                                   unsigned int numberOfScalarComponents,
+                                   const FlipInfoType& flipInfo,
+                                   const std::array<int, 3>& clipRectangleOrigin,
+                                   const std::array<int, 3>& clipRectangleSize,
+                                   unsigned char* outputPixels,
+                                   vtkIdType outputRowStride,
+                                   vtkIdType outputSliceStride,
+                                   bool swapBytes = false);
+
+  /*! Get the size of the image produced by FlipClipImage. If the clipping rectangle does not fit in the input image then it is ignored. */
+  static FrameSizeType GetFlipClipOutputSize(const FrameSizeType& inputFrameSizeInPx,
+      const FlipInfoType& flipInfo,
+      const std::array<int, 3>& clipRectangleOrigin,
+      const std::array<int, 3>& clipRectangleSize);
+
+  /*!
+  Set up a view that presents the image flipped, clipped and/or transposed without copying the pixels.
+  The view keeps a reference to the current image of the frame. See igsioVideoFrameView.
+  */
+  igsioStatus GetOrientedClippedView(const FlipInfoType& flipInfo,
+                                     const std::array<int, 3>& clipRectangleOrigin,
+                                     const std::array<int, 3>& clipRectangleSize,
+                                     igsioVideoFrameView& view) const;
+
+  /*!
+  Convert RF data between interleaved I/Q samples in each scanline (US_IMG_RF_IQ_LINE, W x H image) and
+  separate I and Q scanlines (US_IMG_RF_I_LINE_Q_LINE, W/2 x 2H image, even rows are I, odd rows are Q).
+  Scanlines are expected in image rows, as in the FM/FU/NM/NU orientations. Pixels must have one scalar component,
+  typically 16-bit integer or float. The conversion uses the fastest kernel that the CPU supports.
+  \param outputImageType US_IMG_RF_IQ_LINE or US_IMG_RF_I_LINE_Q_LINE, if it is the image type of the input then the frame is copied
+  */
+  static igsioStatus ConvertRfIqLayout(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, US_IMAGE_TYPE outputImageType);
+
+  /*! Convert the RF data of this frame between interleaved and separate I/Q scanlines, see the static overload */
+  igsioStatus ConvertRfIqLayout(US_IMAGE_TYPE outputImageType);
+
+  /*!
+  Convert the pixels of a frame to another scalar type: output = input * scale + offset.
+  Integer outputs are rounded to the nearest integer and saturated to the range of the output type.
+  All scalar components are converted. Conversions of 16-bit integer and float data to unsigned char
+  and float are vectorized. Large frames are split between threads, see SetPixelConversionNumberOfThreads.
+  */
+  static igsioStatus ConvertPixelType(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, igsioCommon::VTKScalarPixelType outputPixelType, double scale = 1.0, double offset = 0.0);
+
+  /*! Convert the pixels of this frame to another scalar type, see the static overload */
+  igsioStatus ConvertPixelType(igsioCommon::VTKScalarPixelType outputPixelType, double scale = 1.0, double offset = 0.0);
+
+  /*! Convert the pixels of a frame to unsigned char, mapping the [level - window/2, level + window/2] range to [0, 255] */
+  static igsioStatus ConvertPixelTypeWindowLevel(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, double window, double level);
+
+  /*!
+  Convert the pixels of multiple frames to another scalar type in place, see ConvertPixelType.
+  The frames are distributed between threads (see SetPixelConversionNumberOfThreads), each frame is converted by a single thread.
+  */
+  static igsioStatus ConvertPixelTypes(const std::vector<igsioVideoFrame*>& frames, igsioCommon::VTKScalarPixelType outputPixelType, double scale = 1.0, double offset = 0.0);
+
+  /*!
+  Set the maximum number of threads used by ConvertPixelType, ConvertPixelTypes, Downsample, BuildPyramid and ComputeFramesStatistics.
+  1 (default) disables multi-threading, 0 uses the vtkMultiThreader default number of threads.
+  */
+  static void SetPixelConversionNumberOfThreads(int numberOfThreads);
+  static int GetPixelConversionNumberOfThreads();
+
+  /*!
+  Decimate the rows and columns of a frame by 2^level (level 1: 2x, level 2: 4x) by repeatedly averaging 2x2 pixel blocks.
+  For odd sizes the last row and column are kept (averaged with themselves). Slices of volumes are not combined,
+  they are downsampled in parallel (see SetPixelConversionNumberOfThreads). Single component images are vectorized.
+  Interleaved RF (I/Q) images cannot be downsampled. Level 0 copies the frame.
+  */
+  static igsioStatus Downsample(const igsioVideoFrame& inputFrame, igsioVideoFrame& outputFrame, unsigned int level);
+
+  /*! Compute numberOfLevels downsampled versions of a frame: pyramid[0] is 2x, pyramid[1] is 4x downsampled, etc. See Downsample. */
+  static igsioStatus BuildPyramid(const igsioVideoFrame& inputFrame, std::vector<igsioVideoFrame>& pyramid, unsigned int numberOfLevels);
+
+  /*! Return true if the fourCC is a YUV layout supported by ConvertRgbToYuv and ConvertYuvToRgb: I420, NV12 or YUY2 */
+  static bool IsYuvFourCC(const std::string& fourCC);
+
+  /*! Get the size of the YUV data of a frame in bytes, 0 if the fourCC is not a supported YUV layout */
+  static unsigned long GetYuvDataSizeInBytes(const std::string& yuvFourCC, const FrameSizeType& frameSize);
+
+  /*!
+  Convert an RGB frame (unsigned char pixels with 3 components) to YUV with subsampled chroma, using the
+  ITU-R BT.601 coefficients with limited range. I420 and NV12 are half the size of the RGB frame, YUY2 is two thirds.
+  Slices of a volume are converted as if they were stacked vertically. The conversion is vectorized if the CPU supports SSSE3.
+  \param yuvFourCC I420, NV12 or YUY2
+  \param yuvData output buffer, resized to GetYuvDataSizeInBytes
+  */
+  static igsioStatus ConvertRgbToYuv(const igsioVideoFrame& rgbFrame, const std::string& yuvFourCC, vtkUnsignedCharArray* yuvData);
+
+  /*!
+  Expand YUV data created by ConvertRgbToYuv into an RGB frame. The frame is allocated with unsigned char
+  pixels and 3 components and its image type is set to US_IMG_RGB_COLOR.
+  */
+  static igsioStatus ConvertYuvToRgb(const unsigned char* yuvData, unsigned long yuvDataSizeInBytes, const std::string& yuvFourCC,
+                                     const FrameSizeType& frameSize, igsioVideoFrame& rgbFrame);
+
   /*! Return true if the image data is valid (e.g. not NULL) */
   bool IsImageValid() const
   {
@@ -327,6 +617,12 @@ protected:
   void SetImageData(vtkImageData* imageData);
   void SetEncodedFrame(vtkUnsignedCharArray* encodedFrame);
 
+  /*!
+  Make a private copy of the pixel buffer if it is shared with a copy of this frame.
+  \param copyPixels if false then the content of the private buffer is undefined (used if all pixels are overwritten)
+  */
+  igsioStatus MakePixelBufferUnique(bool copyPixels);
+
   vtkImageData* Image;
   vtkUnsignedCharArray* EncodedFrame;
   std::string EncodingFourCC;
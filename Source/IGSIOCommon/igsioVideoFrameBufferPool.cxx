@@ -0,0 +1,179 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioVideoFrameBufferPool.h"
+
+//----------------------------------------------------------------------------
+igsioVideoFrameBufferPool* igsioVideoFrameBufferPool::GetInstance()
+{
+  static igsioVideoFrameBufferPool instance;
+  return &instance;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameBufferPool::igsioVideoFrameBufferPool()
+  : MaximumPooledSizeInBytes(0)
+{
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameBufferPool::~igsioVideoFrameBufferPool()
+{
+  this->TrimInternal(0);
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameBufferPool::SetMaximumPooledSizeInBytes(unsigned long long maximumSizeInBytes)
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+  this->MaximumPooledSizeInBytes = maximumSizeInBytes;
+  this->TrimInternal(maximumSizeInBytes);
+}
+
+//----------------------------------------------------------------------------
+unsigned long long igsioVideoFrameBufferPool::GetMaximumPooledSizeInBytes() const
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+  return this->MaximumPooledSizeInBytes;
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameBufferPool::IsEnabled() const
+{
+  return this->GetMaximumPooledSizeInBytes() > 0;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* igsioVideoFrameBufferPool::Acquire(igsioCommon::VTKScalarPixelType pixelType, unsigned int numberOfScalarComponents, vtkIdType numberOfPixels)
+{
+  if (numberOfScalarComponents == 0 || numberOfPixels < 0)
+  {
+    return NULL;
+  }
+
+  BufferKey key = { pixelType, static_cast<int>(numberOfScalarComponents), numberOfPixels };
+  {
+    igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+    if (this->MaximumPooledSizeInBytes == 0)
+    {
+      return NULL;
+    }
+    BufferMapType::iterator bucket = this->Buffers.find(key);
+    if (bucket != this->Buffers.end() && !bucket->second.empty())
+    {
+      vtkDataArray* buffer = bucket->second.back();
+      bucket->second.pop_back();
+      if (bucket->second.empty())
+      {
+        this->Buffers.erase(bucket);
+      }
+      this->PoolStatistics.NumberOfHits++;
+      this->PoolStatistics.NumberOfPooledBuffers--;
+      this->PoolStatistics.PooledSizeInBytes -= buffer->GetDataSize() * buffer->GetDataTypeSize();
+      return buffer;
+    }
+    this->PoolStatistics.NumberOfMisses++;
+  }
+
+  // Allocate outside of the lock, it may take a while for large buffers
+  vtkDataArray* buffer = vtkDataArray::CreateDataArray(pixelType);
+  if (buffer == NULL)
+  {
+    LOG_ERROR("Failed to allocate pooled frame buffer - invalid pixel type: " << pixelType);
+    return NULL;
+  }
+  buffer->SetNumberOfComponents(numberOfScalarComponents);
+  buffer->SetNumberOfTuples(numberOfPixels);
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameBufferPool::Return(vtkDataArray* buffer)
+{
+  if (buffer == NULL)
+  {
+    return;
+  }
+
+  const unsigned long long bufferSizeInBytes = buffer->GetDataSize() * buffer->GetDataTypeSize();
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+  if (this->MaximumPooledSizeInBytes == 0 || bufferSizeInBytes == 0)
+  {
+    return;
+  }
+  if (bufferSizeInBytes > this->MaximumPooledSizeInBytes)
+  {
+    this->PoolStatistics.NumberOfDiscardedBuffers++;
+    return;
+  }
+
+  // Make room for the new buffer
+  this->TrimInternal(this->MaximumPooledSizeInBytes - bufferSizeInBytes);
+
+  BufferKey key = { buffer->GetDataType(), buffer->GetNumberOfComponents(), buffer->GetNumberOfTuples() };
+  buffer->Register(NULL);
+  this->Buffers[key].push_back(buffer);
+  this->PoolStatistics.NumberOfReturnedBuffers++;
+  this->PoolStatistics.NumberOfPooledBuffers++;
+  this->PoolStatistics.PooledSizeInBytes += bufferSizeInBytes;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameBufferPool::Trim(unsigned long long maximumSizeInBytes)
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+  this->TrimInternal(maximumSizeInBytes);
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameBufferPool::TrimInternal(unsigned long long maximumSizeInBytes)
+{
+  // Release the largest buffers first, they are the most expensive to keep
+  while (this->PoolStatistics.PooledSizeInBytes > maximumSizeInBytes && !this->Buffers.empty())
+  {
+    BufferMapType::iterator largestBucket = this->Buffers.begin();
+    unsigned long long largestBufferSizeInBytes = 0;
+    for (BufferMapType::iterator bucket = this->Buffers.begin(); bucket != this->Buffers.end(); ++bucket)
+    {
+      vtkDataArray* buffer = bucket->second.back();
+      const unsigned long long bufferSizeInBytes = buffer->GetDataSize() * buffer->GetDataTypeSize();
+      if (bufferSizeInBytes > largestBufferSizeInBytes)
+      {
+        largestBucket = bucket;
+        largestBufferSizeInBytes = bufferSizeInBytes;
+      }
+    }
+
+    vtkDataArray* buffer = largestBucket->second.back();
+    largestBucket->second.pop_back();
+    if (largestBucket->second.empty())
+    {
+      this->Buffers.erase(largestBucket);
+    }
+    this->PoolStatistics.NumberOfDiscardedBuffers++;
+    this->PoolStatistics.NumberOfPooledBuffers--;
+    this->PoolStatistics.PooledSizeInBytes -= largestBufferSizeInBytes;
+    buffer->UnRegister(NULL);
+  }
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameBufferPool::Statistics igsioVideoFrameBufferPool::GetStatistics() const
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+  return this->PoolStatistics;
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameBufferPool::ResetStatistics()
+{
+  igsioLockGuard<vtkIGSIOSimpleRecursiveCriticalSection> poolGuard(&this->CriticalSection);
+  this->PoolStatistics.NumberOfHits = 0;
+  this->PoolStatistics.NumberOfMisses = 0;
+  this->PoolStatistics.NumberOfReturnedBuffers = 0;
+  this->PoolStatistics.NumberOfDiscardedBuffers = 0;
+}
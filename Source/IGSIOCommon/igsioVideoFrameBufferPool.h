@@ -0,0 +1,120 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioVideoFrameBufferPool_h
+#define __igsioVideoFrameBufferPool_h
+
+#include "vtkigsiocommon_export.h"
+#include "igsioCommon.h"
+#include "vtkIGSIORecursiveCriticalSection.h"
+
+// VTK includes
+#include <vtkDataArray.h>
+
+// STL includes
+#include <map>
+#include <vector>
+
+/*!
+\class igsioVideoFrameBufferPool
+\brief Pool of pixel buffers that igsioVideoFrame images are allocated from
+
+Buffers are bucketed by scalar type, number of components and number of pixels. When a video frame
+is deleted or reallocated, its pixel buffer is returned to the pool (if no other image uses it) and the
+next frame of the same size and type reuses it instead of allocating a new block. This avoids heap
+fragmentation when sequences of large frames are read and discarded repeatedly.
+
+The pool is disabled by default (maximum pooled size is 0), enable it by calling SetMaximumPooledSizeInBytes.
+All methods are thread-safe.
+\ingroup igsioCommon
+*/
+class VTKIGSIOCOMMON_EXPORT igsioVideoFrameBufferPool
+{
+public:
+  struct Statistics
+  {
+    Statistics() : NumberOfHits(0), NumberOfMisses(0), NumberOfReturnedBuffers(0), NumberOfDiscardedBuffers(0), NumberOfPooledBuffers(0), PooledSizeInBytes(0) {};
+    unsigned long long NumberOfHits; // buffer requests served from the pool
+    unsigned long long NumberOfMisses; // buffer requests that required a new allocation
+    unsigned long long NumberOfReturnedBuffers; // buffers that were added to the pool
+    unsigned long long NumberOfDiscardedBuffers; // buffers that were released because the pool was full or trimmed
+    unsigned long long NumberOfPooledBuffers; // number of buffers currently in the pool
+    unsigned long long PooledSizeInBytes; // total size of the buffers currently in the pool
+  };
+
+  /*! Get the pool used by igsioVideoFrame */
+  static igsioVideoFrameBufferPool* GetInstance();
+
+  /*! Constructor */
+  igsioVideoFrameBufferPool();
+
+  /*! Destructor, releases all pooled buffers */
+  virtual ~igsioVideoFrameBufferPool();
+
+  /*! Set the maximum total size of the unused buffers kept in the pool. 0 disables the pool. Trims the pool if needed. */
+  void SetMaximumPooledSizeInBytes(unsigned long long maximumSizeInBytes);
+  unsigned long long GetMaximumPooledSizeInBytes() const;
+
+  /*! Return true if buffers are kept in the pool */
+  bool IsEnabled() const;
+
+  /*!
+  Get a buffer for numberOfPixels pixels. A pooled buffer is returned if available, otherwise a new buffer is allocated.
+  The content of the buffer is undefined. The caller owns the returned reference (must call Delete() or pass it to a smart pointer).
+  Returns NULL if the pool is disabled or the pixel type is invalid.
+  */
+  vtkDataArray* Acquire(igsioCommon::VTKScalarPixelType pixelType, unsigned int numberOfScalarComponents, vtkIdType numberOfPixels);
+
+  /*!
+  Offer a buffer to the pool. The pool registers its own reference if there is room for the buffer,
+  the caller must still release its reference. Buffers that are referenced by anyone else than the caller
+  must not be returned, because they would be handed out to another frame while still in use.
+  */
+  void Return(vtkDataArray* buffer);
+
+  /*! Release pooled buffers until the total pooled size is not larger than maximumSizeInBytes */
+  void Trim(unsigned long long maximumSizeInBytes = 0);
+
+  /*! Get the hit/miss counters and the current pool size */
+  Statistics GetStatistics() const;
+
+  /*! Reset the hit/miss counters (does not release any buffers) */
+  void ResetStatistics();
+
+protected:
+  void TrimInternal(unsigned long long maximumSizeInBytes);
+
+  struct BufferKey
+  {
+    int PixelType;
+    int NumberOfScalarComponents;
+    vtkIdType NumberOfPixels;
+    bool operator<(const BufferKey& other) const
+    {
+      if (this->PixelType != other.PixelType)
+      {
+        return this->PixelType < other.PixelType;
+      }
+      if (this->NumberOfScalarComponents != other.NumberOfScalarComponents)
+      {
+        return this->NumberOfScalarComponents < other.NumberOfScalarComponents;
+      }
+      return this->NumberOfPixels < other.NumberOfPixels;
+    }
+  };
+  typedef std::map<BufferKey, std::vector<vtkDataArray*> > BufferMapType;
+
+  BufferMapType Buffers;
+  unsigned long long MaximumPooledSizeInBytes;
+  Statistics PoolStatistics;
+  mutable vtkIGSIOSimpleRecursiveCriticalSection CriticalSection;
+
+private:
+  igsioVideoFrameBufferPool(const igsioVideoFrameBufferPool&);  // Not implemented.
+  void operator=(const igsioVideoFrameBufferPool&);  // Not implemented.
+};
+
+#endif
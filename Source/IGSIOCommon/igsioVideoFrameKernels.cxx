@@ -0,0 +1,2855 @@
+/*=Plus=header=begin======================================================
+  Program: Plus
+  Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+  See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioCpuFeatures.h"
+#include "igsioVideoFrameKernels.h"
+
+// STL includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(IGSIO_SIMD_X86)
+  #include <immintrin.h>
+#endif
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Scalar implementations
+  //----------------------------------------------------------------------------
+
+  //----------------------------------------------------------------------------
+  // Reverse groups [firstGroup, groupCount). Used as fallback and for the tail of vectorized loops.
+  template<size_t GroupSize>
+  inline void ReverseGroupsRange(unsigned char* output, const unsigned char* input, size_t groupCount, size_t firstGroup)
+  {
+    const unsigned char* inputGroup = input + firstGroup * GroupSize;
+    unsigned char* outputGroup = output + (groupCount - firstGroup) * GroupSize;
+    for (size_t i = firstGroup; i < groupCount; ++i)
+    {
+      outputGroup -= GroupSize;
+      memcpy(outputGroup, inputGroup, GroupSize);
+      inputGroup += GroupSize;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t GroupSize>
+  void ReverseGroupsScalar(unsigned char* output, const unsigned char* input, size_t groupCount, size_t)
+  {
+    ReverseGroupsRange<GroupSize>(output, input, groupCount, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  void ReverseGroupsScalarGeneric(unsigned char* output, const unsigned char* input, size_t groupCount, size_t groupSizeInBytes)
+  {
+    unsigned char* outputGroup = output + groupCount * groupSizeInBytes;
+    for (size_t i = 0; i < groupCount; ++i)
+    {
+      outputGroup -= groupSizeInBytes;
+      memcpy(outputGroup, input, groupSizeInBytes);
+      input += groupSizeInBytes;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Reverse the byte order of the scalars [firstScalar, numberOfScalars). The whole scalar is read before it is
+  // written, so output may be the same as input. Used as fallback and for the tail of vectorized loops.
+  template<size_t ScalarSize>
+  inline void SwapBytesRange(unsigned char* output, const unsigned char* input, size_t numberOfScalars, size_t firstScalar)
+  {
+    input += firstScalar * ScalarSize;
+    output += firstScalar * ScalarSize;
+    for (size_t i = firstScalar; i < numberOfScalars; ++i)
+    {
+      unsigned char scalar[ScalarSize];
+      memcpy(scalar, input, ScalarSize);
+      for (size_t b = 0; b < ScalarSize; ++b)
+      {
+        output[b] = scalar[ScalarSize - 1 - b];
+      }
+      input += ScalarSize;
+      output += ScalarSize;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t ScalarSize>
+  void SwapBytesScalar(unsigned char* output, const unsigned char* input, size_t numberOfScalars)
+  {
+    SwapBytesRange<ScalarSize>(output, input, numberOfScalars, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  // Transpose a tile of at most TileSize x TileSize elements. Writes are sequential, reads are strided
+  // but only touch TileSize input rows, which stay in the cache for the whole tile.
+  template<size_t ElementSize>
+  inline void TransposeTile(unsigned char* output, ptrdiff_t outputRowStride, const unsigned char* input, ptrdiff_t inputRowStride,
+                            size_t numberOfRows, size_t numberOfColumns)
+  {
+    for (size_t column = 0; column < numberOfColumns; ++column)
+    {
+      unsigned char* outputElement = output + column * outputRowStride;
+      const unsigned char* inputElement = input + column * ElementSize;
+      for (size_t row = 0; row < numberOfRows; ++row)
+      {
+        memcpy(outputElement, inputElement, ElementSize);
+        outputElement += ElementSize;
+        inputElement += inputRowStride;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t ElementSize>
+  void TransposeBlocked(unsigned char* output, ptrdiff_t outputRowStride, const unsigned char* input, ptrdiff_t inputRowStride,
+                        size_t numberOfRows, size_t numberOfColumns, size_t)
+  {
+    // A tile is at most 4kB for small elements (or 16 rows/columns for large elements)
+    const size_t tileSize = (ElementSize <= 4 ? 32 : 16);
+    for (size_t firstRow = 0; firstRow < numberOfRows; firstRow += tileSize)
+    {
+      const size_t tileRows = (numberOfRows - firstRow < tileSize ? numberOfRows - firstRow : tileSize);
+      for (size_t firstColumn = 0; firstColumn < numberOfColumns; firstColumn += tileSize)
+      {
+        const size_t tileColumns = (numberOfColumns - firstColumn < tileSize ? numberOfColumns - firstColumn : tileSize);
+        TransposeTile<ElementSize>(output + firstColumn * outputRowStride + firstRow * ElementSize, outputRowStride,
+                                   input + firstRow * inputRowStride + firstColumn * ElementSize, inputRowStride,
+                                   tileRows, tileColumns);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void TransposeBlockedGeneric(unsigned char* output, ptrdiff_t outputRowStride, const unsigned char* input, ptrdiff_t inputRowStride,
+                               size_t numberOfRows, size_t numberOfColumns, size_t elementSizeInBytes)
+  {
+    const size_t tileSize = 16;
+    for (size_t firstRow = 0; firstRow < numberOfRows; firstRow += tileSize)
+    {
+      const size_t lastRow = (numberOfRows - firstRow < tileSize ? numberOfRows : firstRow + tileSize);
+      for (size_t firstColumn = 0; firstColumn < numberOfColumns; firstColumn += tileSize)
+      {
+        const size_t lastColumn = (numberOfColumns - firstColumn < tileSize ? numberOfColumns : firstColumn + tileSize);
+        for (size_t column = firstColumn; column < lastColumn; ++column)
+        {
+          for (size_t row = firstRow; row < lastRow; ++row)
+          {
+            memcpy(output + column * outputRowStride + row * elementSizeInBytes, input + row * inputRowStride + column * elementSizeInBytes, elementSizeInBytes);
+          }
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Deinterleave pairs [firstPair, pairCount). Used as fallback and for the tail of vectorized loops.
+  template<size_t SampleSize>
+  inline void DeinterleaveRange(unsigned char* outputFirst, unsigned char* outputSecond, const unsigned char* input, size_t pairCount, size_t firstPair)
+  {
+    const unsigned char* inputPair = input + firstPair * 2 * SampleSize;
+    for (size_t i = firstPair; i < pairCount; ++i)
+    {
+      memcpy(outputFirst + i * SampleSize, inputPair, SampleSize);
+      memcpy(outputSecond + i * SampleSize, inputPair + SampleSize, SampleSize);
+      inputPair += 2 * SampleSize;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize>
+  void DeinterleaveScalar(unsigned char* outputFirst, unsigned char* outputSecond, const unsigned char* input, size_t pairCount, size_t)
+  {
+    DeinterleaveRange<SampleSize>(outputFirst, outputSecond, input, pairCount, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  void DeinterleaveScalarGeneric(unsigned char* outputFirst, unsigned char* outputSecond, const unsigned char* input, size_t pairCount, size_t sampleSizeInBytes)
+  {
+    for (size_t i = 0; i < pairCount; ++i)
+    {
+      memcpy(outputFirst + i * sampleSizeInBytes, input, sampleSizeInBytes);
+      memcpy(outputSecond + i * sampleSizeInBytes, input + sampleSizeInBytes, sampleSizeInBytes);
+      input += 2 * sampleSizeInBytes;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Interleave pairs [firstPair, pairCount). Used as fallback and for the tail of vectorized loops.
+  template<size_t SampleSize>
+  inline void InterleaveRange(unsigned char* output, const unsigned char* inputFirst, const unsigned char* inputSecond, size_t pairCount, size_t firstPair)
+  {
+    unsigned char* outputPair = output + firstPair * 2 * SampleSize;
+    for (size_t i = firstPair; i < pairCount; ++i)
+    {
+      memcpy(outputPair, inputFirst + i * SampleSize, SampleSize);
+      memcpy(outputPair + SampleSize, inputSecond + i * SampleSize, SampleSize);
+      outputPair += 2 * SampleSize;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize>
+  void InterleaveScalar(unsigned char* output, const unsigned char* inputFirst, const unsigned char* inputSecond, size_t pairCount, size_t)
+  {
+    InterleaveRange<SampleSize>(output, inputFirst, inputSecond, pairCount, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  void InterleaveScalarGeneric(unsigned char* output, const unsigned char* inputFirst, const unsigned char* inputSecond, size_t pairCount, size_t sampleSizeInBytes)
+  {
+    for (size_t i = 0; i < pairCount; ++i)
+    {
+      memcpy(output, inputFirst + i * sampleSizeInBytes, sampleSizeInBytes);
+      memcpy(output + sampleSizeInBytes, inputSecond + i * sampleSizeInBytes, sampleSizeInBytes);
+      output += 2 * sampleSizeInBytes;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Type used for computing output = input * scale + offset. Single precision is exact enough
+  // for 8/16-bit integers and matches the vectorized implementations.
+  template<typename InputType, typename OutputType>
+  struct ConvertScalarsTraits
+  {
+    static const bool IsSinglePrecision = (sizeof(InputType) <= 2 || std::numeric_limits<InputType>::is_iec559) && sizeof(InputType) <= 4
+                                          && (sizeof(OutputType) <= 2 || std::numeric_limits<OutputType>::is_iec559) && sizeof(OutputType) <= 4;
+  };
+
+  template<bool IsSinglePrecision> struct ComputeTypeSelector
+  {
+    typedef double Type;
+  };
+  template<> struct ComputeTypeSelector<true>
+  {
+    typedef float Type;
+  };
+
+  //----------------------------------------------------------------------------
+  // Round and saturate a value to an integer output type, or just cast it to a floating point output type
+  template<typename OutputType, typename ComputeType, bool IsInteger = std::numeric_limits<OutputType>::is_integer>
+  struct ScalarConverter
+  {
+    static inline OutputType Convert(ComputeType value)
+    {
+      return static_cast<OutputType>(value);
+    }
+  };
+
+  template<typename OutputType, typename ComputeType>
+  struct ScalarConverter<OutputType, ComputeType, true>
+  {
+    static inline OutputType Convert(ComputeType value)
+    {
+      const ComputeType minimum = static_cast<ComputeType>(std::numeric_limits<OutputType>::min());
+      const ComputeType maximum = static_cast<ComputeType>(std::numeric_limits<OutputType>::max());
+      // written so that NaN is converted to the minimum, as in the vectorized implementations
+      value = (value > minimum ? value : minimum);
+      value = (value < maximum ? value : maximum);
+      return static_cast<OutputType>(std::llrint(value));
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  // Convert scalars [firstScalar, count). Used as fallback and for the tail of vectorized loops.
+  template<typename InputType, typename OutputType>
+  inline void ConvertScalarsRange(unsigned char* output, const unsigned char* input, size_t count, size_t firstScalar, double scale, double offset)
+  {
+    typedef typename ComputeTypeSelector<ConvertScalarsTraits<InputType, OutputType>::IsSinglePrecision>::Type ComputeType;
+    const ComputeType computeScale = static_cast<ComputeType>(scale);
+    const ComputeType computeOffset = static_cast<ComputeType>(offset);
+    for (size_t i = firstScalar; i < count; ++i)
+    {
+      InputType inputValue;
+      memcpy(&inputValue, input + i * sizeof(InputType), sizeof(InputType));
+      const OutputType outputValue = ScalarConverter<OutputType, ComputeType>::Convert(static_cast<ComputeType>(inputValue) * computeScale + computeOffset);
+      memcpy(output + i * sizeof(OutputType), &outputValue, sizeof(OutputType));
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename InputType, typename OutputType>
+  void ConvertScalarsScalar(unsigned char* output, const unsigned char* input, size_t count, double scale, double offset)
+  {
+    ConvertScalarsRange<InputType, OutputType>(output, input, count, 0, scale, offset);
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename InputType>
+  igsioVideoFrameKernels::ConvertScalarsFunctionType GetConvertScalarsScalarFunction(igsioVideoFrameKernels::ScalarType outputType)
+  {
+    switch (outputType)
+    {
+      case igsioVideoFrameKernels::SCALAR_TYPE_INT8:
+        return &ConvertScalarsScalar<InputType, signed char>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_UINT8:
+        return &ConvertScalarsScalar<InputType, unsigned char>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_INT16:
+        return &ConvertScalarsScalar<InputType, short>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_UINT16:
+        return &ConvertScalarsScalar<InputType, unsigned short>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_INT32:
+        return &ConvertScalarsScalar<InputType, int>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_UINT32:
+        return &ConvertScalarsScalar<InputType, unsigned int>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_FLOAT:
+        return &ConvertScalarsScalar<InputType, float>;
+      case igsioVideoFrameKernels::SCALAR_TYPE_DOUBLE:
+        return &ConvertScalarsScalar<InputType, double>;
+      default:
+        return NULL;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // BT.601 limited range color conversion in 8-bit fixed point. The vectorized implementations compute
+  // exactly the same values, so the output does not depend on the instruction set.
+  inline unsigned char RgbToY(int r, int g, int b)
+  {
+    return static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned char RgbToU(int r, int g, int b)
+  {
+    return static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned char RgbToV(int r, int g, int b)
+  {
+    return static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned char ClampToByte(int value)
+  {
+    return static_cast<unsigned char>(value < 0 ? 0 : (value > 255 ? 255 : value));
+  }
+
+  //----------------------------------------------------------------------------
+  inline void YuvToRgbPixel(unsigned char* rgb, int y, int u, int v)
+  {
+    const int c = y - 16;
+    const int d = u - 128;
+    const int e = v - 128;
+    rgb[0] = ClampToByte((298 * c + 409 * e + 128) >> 8);
+    rgb[1] = ClampToByte((298 * c - 100 * d - 208 * e + 128) >> 8);
+    rgb[2] = ClampToByte((298 * c + 516 * d + 128) >> 8);
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert the pixels [firstPixel, width) of two RGB rows to 4:2:0 YUV. firstPixel must be even.
+  // For the last row of an image with odd height both rows are the same. chromaStep is 1 for planar
+  // and 2 for interleaved chroma. Used as fallback and for the tail of vectorized loops.
+  inline void RgbToYuv420Range(unsigned char* yRow0, unsigned char* yRow1, unsigned char* uRow, unsigned char* vRow, size_t chromaStep,
+                               const unsigned char* rgbRow0, const unsigned char* rgbRow1, size_t width, size_t firstPixel)
+  {
+    for (size_t x = firstPixel; x < width; x += 2)
+    {
+      // the last pixel is replicated if the width is odd
+      const size_t nextX = (x + 1 < width ? x + 1 : x);
+      const unsigned char* p00 = rgbRow0 + x * 3;
+      const unsigned char* p01 = rgbRow0 + nextX * 3;
+      const unsigned char* p10 = rgbRow1 + x * 3;
+      const unsigned char* p11 = rgbRow1 + nextX * 3;
+      yRow0[x] = RgbToY(p00[0], p00[1], p00[2]);
+      yRow0[nextX] = RgbToY(p01[0], p01[1], p01[2]);
+      yRow1[x] = RgbToY(p10[0], p10[1], p10[2]);
+      yRow1[nextX] = RgbToY(p11[0], p11[1], p11[2]);
+      const int r = (p00[0] + p01[0] + p10[0] + p11[0] + 2) >> 2;
+      const int g = (p00[1] + p01[1] + p10[1] + p11[1] + 2) >> 2;
+      const int b = (p00[2] + p01[2] + p10[2] + p11[2] + 2) >> 2;
+      const size_t chromaIndex = (x / 2) * chromaStep;
+      uRow[chromaIndex] = RgbToU(r, g, b);
+      vRow[chromaIndex] = RgbToV(r, g, b);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert the pixels [firstPixel, width) of an RGB row to YUY2. firstPixel must be even.
+  inline void RgbToYuy2Range(unsigned char* yuvRow, const unsigned char* rgbRow, size_t width, size_t firstPixel)
+  {
+    for (size_t x = firstPixel; x < width; x += 2)
+    {
+      const size_t nextX = (x + 1 < width ? x + 1 : x);
+      const unsigned char* p0 = rgbRow + x * 3;
+      const unsigned char* p1 = rgbRow + nextX * 3;
+      const int r = (p0[0] + p1[0] + 1) >> 1;
+      const int g = (p0[1] + p1[1] + 1) >> 1;
+      const int b = (p0[2] + p1[2] + 1) >> 1;
+      unsigned char* yuv = yuvRow + x * 2;
+      yuv[0] = RgbToY(p0[0], p0[1], p0[2]);
+      yuv[1] = RgbToU(r, g, b);
+      yuv[2] = RgbToY(p1[0], p1[1], p1[2]);
+      yuv[3] = RgbToV(r, g, b);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert the pixels [firstPixel, width) of two rows of 4:2:0 YUV to RGB, see RgbToYuv420Range
+  inline void Yuv420ToRgbRange(unsigned char* rgbRow0, unsigned char* rgbRow1, const unsigned char* yRow0, const unsigned char* yRow1,
+                               const unsigned char* uRow, const unsigned char* vRow, size_t chromaStep, size_t width, size_t firstPixel)
+  {
+    for (size_t x = firstPixel; x < width; ++x)
+    {
+      const size_t chromaIndex = (x / 2) * chromaStep;
+      YuvToRgbPixel(rgbRow0 + x * 3, yRow0[x], uRow[chromaIndex], vRow[chromaIndex]);
+      YuvToRgbPixel(rgbRow1 + x * 3, yRow1[x], uRow[chromaIndex], vRow[chromaIndex]);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert the pixels [firstPixel, width) of a YUY2 row to RGB
+  inline void Yuy2ToRgbRange(unsigned char* rgbRow, const unsigned char* yuvRow, size_t width, size_t firstPixel)
+  {
+    for (size_t x = firstPixel; x < width; ++x)
+    {
+      const unsigned char* yuv = yuvRow + (x / 2) * 4;
+      YuvToRgbPixel(rgbRow + x * 3, yuv[(x & 1) * 2], yuv[1], yuv[3]);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void RgbToYuv420RowsScalar(unsigned char* yRow0, unsigned char* yRow1, unsigned char* uRow, unsigned char* vRow, size_t chromaStep,
+                             const unsigned char* rgbRow0, const unsigned char* rgbRow1, size_t width)
+  {
+    RgbToYuv420Range(yRow0, yRow1, uRow, vRow, chromaStep, rgbRow0, rgbRow1, width, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  void RgbToYuy2RowScalar(unsigned char* yuvRow, const unsigned char* rgbRow, size_t width)
+  {
+    RgbToYuy2Range(yuvRow, rgbRow, width, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  void Yuv420ToRgbRowsScalar(unsigned char* rgbRow0, unsigned char* rgbRow1, const unsigned char* yRow0, const unsigned char* yRow1,
+                             const unsigned char* uRow, const unsigned char* vRow, size_t chromaStep, size_t width)
+  {
+    Yuv420ToRgbRange(rgbRow0, rgbRow1, yRow0, yRow1, uRow, vRow, chromaStep, width, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  void Yuy2ToRgbRowScalar(unsigned char* rgbRow, const unsigned char* yuvRow, size_t width)
+  {
+    Yuy2ToRgbRange(rgbRow, yuvRow, width, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  // Image level drivers, the row conversion functions are template parameters so that they can be inlined
+  typedef void (*RgbToYuv420RowsFunctionType)(unsigned char*, unsigned char*, unsigned char*, unsigned char*, size_t,
+      const unsigned char*, const unsigned char*, size_t);
+  typedef void (*Yuv420ToRgbRowsFunctionType)(unsigned char*, unsigned char*, const unsigned char*, const unsigned char*,
+      const unsigned char*, const unsigned char*, size_t, size_t);
+  typedef void (*RgbToYuy2RowFunctionType)(unsigned char*, const unsigned char*, size_t);
+  typedef void (*Yuy2ToRgbRowFunctionType)(unsigned char*, const unsigned char*, size_t);
+
+  //----------------------------------------------------------------------------
+  // Get the layout of the chroma planes of a 4:2:0 image, offsets are relative to the start of the Y plane
+  inline void GetYuv420ChromaLayout(size_t width, size_t height, bool interleavedChroma,
+                                    size_t& uPlaneOffset, size_t& vPlaneOffset, size_t& chromaStep, size_t& chromaRowStride)
+  {
+    const size_t chromaWidth = (width + 1) / 2;
+    const size_t chromaHeight = (height + 1) / 2;
+    uPlaneOffset = width * height;
+    vPlaneOffset = (interleavedChroma ? uPlaneOffset + 1 : uPlaneOffset + chromaWidth * chromaHeight);
+    chromaStep = (interleavedChroma ? 2 : 1);
+    chromaRowStride = chromaWidth * chromaStep;
+  }
+
+  //----------------------------------------------------------------------------
+  template<RgbToYuv420RowsFunctionType ConvertRows, bool InterleavedChroma>
+  void RgbToYuv420(unsigned char* output, const unsigned char* input, size_t width, size_t height)
+  {
+    size_t uPlaneOffset(0);
+    size_t vPlaneOffset(0);
+    size_t chromaStep(0);
+    size_t chromaRowStride(0);
+    GetYuv420ChromaLayout(width, height, InterleavedChroma, uPlaneOffset, vPlaneOffset, chromaStep, chromaRowStride);
+    for (size_t row = 0; row < height; row += 2)
+    {
+      const size_t nextRow = (row + 1 < height ? row + 1 : row);
+      const size_t chromaOffset = (row / 2) * chromaRowStride;
+      ConvertRows(output + row * width, output + nextRow * width, output + uPlaneOffset + chromaOffset, output + vPlaneOffset + chromaOffset, chromaStep,
+                  input + row * width * 3, input + nextRow * width * 3, width);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<Yuv420ToRgbRowsFunctionType ConvertRows, bool InterleavedChroma>
+  void Yuv420ToRgb(unsigned char* output, const unsigned char* input, size_t width, size_t height)
+  {
+    size_t uPlaneOffset(0);
+    size_t vPlaneOffset(0);
+    size_t chromaStep(0);
+    size_t chromaRowStride(0);
+    GetYuv420ChromaLayout(width, height, InterleavedChroma, uPlaneOffset, vPlaneOffset, chromaStep, chromaRowStride);
+    for (size_t row = 0; row < height; row += 2)
+    {
+      const size_t nextRow = (row + 1 < height ? row + 1 : row);
+      const size_t chromaOffset = (row / 2) * chromaRowStride;
+      ConvertRows(output + row * width * 3, output + nextRow * width * 3, input + row * width, input + nextRow * width,
+                  input + uPlaneOffset + chromaOffset, input + vPlaneOffset + chromaOffset, chromaStep, width);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<RgbToYuy2RowFunctionType ConvertRow>
+  void RgbToYuy2(unsigned char* output, const unsigned char* input, size_t width, size_t height)
+  {
+    const size_t outputRowStride = ((width + 1) / 2) * 4;
+    for (size_t row = 0; row < height; ++row)
+    {
+      ConvertRow(output + row * outputRowStride, input + row * width * 3, width);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<Yuy2ToRgbRowFunctionType ConvertRow>
+  void Yuy2ToRgb(unsigned char* output, const unsigned char* input, size_t width, size_t height)
+  {
+    const size_t inputRowStride = ((width + 1) / 2) * 4;
+    for (size_t row = 0; row < height; ++row)
+    {
+      ConvertRow(output + row * width * 3, input + row * inputRowStride, width);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Sum type and rounding of the 2x2 box average
+  template<typename T>
+  struct BoxAverage
+  {
+    typedef long long SumType;
+    static T Average(SumType sum)
+    {
+      return static_cast<T>((sum + 2) >> 2);
+    }
+  };
+
+  template<>
+  struct BoxAverage<signed char>
+  {
+    typedef int SumType;
+    static signed char Average(SumType sum)
+    {
+      return static_cast<signed char>((sum + 2) >> 2);
+    }
+  };
+
+  template<>
+  struct BoxAverage<unsigned char>
+  {
+    typedef int SumType;
+    static unsigned char Average(SumType sum)
+    {
+      return static_cast<unsigned char>((sum + 2) >> 2);
+    }
+  };
+
+  template<>
+  struct BoxAverage<short>
+  {
+    typedef int SumType;
+    static short Average(SumType sum)
+    {
+      return static_cast<short>((sum + 2) >> 2);
+    }
+  };
+
+  template<>
+  struct BoxAverage<unsigned short>
+  {
+    typedef int SumType;
+    static unsigned short Average(SumType sum)
+    {
+      return static_cast<unsigned short>((sum + 2) >> 2);
+    }
+  };
+
+  template<>
+  struct BoxAverage<float>
+  {
+    typedef float SumType;
+    static float Average(SumType sum)
+    {
+      return sum * 0.25f;
+    }
+  };
+
+  template<>
+  struct BoxAverage<double>
+  {
+    typedef double SumType;
+    static double Average(SumType sum)
+    {
+      return sum * 0.25;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  // Compute the output pixels [firstPixel, (inputWidth + 1) / 2) of a 2x downsampled row from two input rows.
+  // For odd input width the last input column is averaged with itself. The pairs of each row are summed first,
+  // as in the vectorized implementations, so that floating point results are identical.
+  template<typename T>
+  inline void Downsample2xRowRange(unsigned char* output, const unsigned char* inputRow0, const unsigned char* inputRow1,
+                                   size_t inputWidth, size_t numberOfComponents, size_t firstPixel)
+  {
+    typedef typename BoxAverage<T>::SumType SumType;
+    T* outputPixels = reinterpret_cast<T*>(output);
+    const T* inputPixels0 = reinterpret_cast<const T*>(inputRow0);
+    const T* inputPixels1 = reinterpret_cast<const T*>(inputRow1);
+    const size_t outputWidth = (inputWidth + 1) / 2;
+    for (size_t x = firstPixel; x < outputWidth; ++x)
+    {
+      const size_t first = 2 * x * numberOfComponents;
+      const size_t second = (2 * x + 1 < inputWidth ? first + numberOfComponents : first);
+      for (size_t component = 0; component < numberOfComponents; ++component)
+      {
+        const SumType sum0 = static_cast<SumType>(inputPixels0[first + component]) + static_cast<SumType>(inputPixels0[second + component]);
+        const SumType sum1 = static_cast<SumType>(inputPixels1[first + component]) + static_cast<SumType>(inputPixels1[second + component]);
+        outputPixels[x * numberOfComponents + component] = BoxAverage<T>::Average(sum0 + sum1);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T>
+  void Downsample2xRowScalar(unsigned char* output, const unsigned char* inputRow0, const unsigned char* inputRow1, size_t inputWidth, size_t numberOfComponents)
+  {
+    Downsample2xRowRange<T>(output, inputRow0, inputRow1, inputWidth, numberOfComponents, 0);
+  }
+
+  //----------------------------------------------------------------------------
+  // Image level driver, for odd input height the last input row is averaged with itself
+  typedef void (*Downsample2xRowFunctionType)(unsigned char*, const unsigned char*, const unsigned char*, size_t, size_t);
+
+  template<Downsample2xRowFunctionType DownsampleRow, typename T>
+  void Downsample2xImage(unsigned char* output, const unsigned char* input, size_t width, size_t height, size_t numberOfComponents)
+  {
+    const size_t inputRowSize = width * numberOfComponents * sizeof(T);
+    const size_t outputRowSize = ((width + 1) / 2) * numberOfComponents * sizeof(T);
+    for (size_t row = 0; row < height; row += 2)
+    {
+      const size_t nextRow = (row + 1 < height ? row + 1 : row);
+      DownsampleRow(output + (row / 2) * outputRowSize, input + row * inputRowSize, input + nextRow * inputRowSize, width, numberOfComponents);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T>
+  igsioVideoFrameKernels::Downsample2xFunctionType GetDownsample2xScalarFunction()
+  {
+    return &Downsample2xImage<&Downsample2xRowScalar<T>, T>;
+  }
+
+  //----------------------------------------------------------------------------
+  // Absolute difference of two scalars. Integer types are compared with integer arithmetic, a scalar is
+  // changed if the difference is larger than the threshold, that is larger than floor(threshold).
+  template<typename T>
+  struct AbsoluteDifference
+  {
+    typedef unsigned long long SumType;
+    typedef long long ThresholdType;
+    static SumType Compute(T value1, T value2)
+    {
+      return (value1 > value2 ? static_cast<SumType>(static_cast<long long>(value1) - value2) : static_cast<SumType>(static_cast<long long>(value2) - value1));
+    }
+    static ThresholdType GetThreshold(double changeThreshold)
+    {
+      // Differences of 32-bit integers fit into 33 bits
+      return (changeThreshold < 0 ? -1 : static_cast<ThresholdType>(std::floor(std::min(changeThreshold, 8589934592.0))));
+    }
+  };
+
+  template<>
+  struct AbsoluteDifference<float>
+  {
+    typedef double SumType;
+    typedef double ThresholdType;
+    static SumType Compute(float value1, float value2)
+    {
+      return std::fabs(static_cast<double>(value1) - value2);
+    }
+    static ThresholdType GetThreshold(double changeThreshold)
+    {
+      return changeThreshold;
+    }
+  };
+
+  template<>
+  struct AbsoluteDifference<double>
+  {
+    typedef double SumType;
+    typedef double ThresholdType;
+    static SumType Compute(double value1, double value2)
+    {
+      return std::fabs(value1 - value2);
+    }
+    static ThresholdType GetThreshold(double changeThreshold)
+    {
+      return changeThreshold;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  // Compare scalars [firstScalar, numberOfScalars). Used as fallback and for the tail of vectorized loops.
+  template<typename T>
+  inline void FrameDifferenceRange(const unsigned char* input1, const unsigned char* input2, size_t numberOfScalars, size_t firstScalar, double changeThreshold,
+                                   double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars)
+  {
+    typedef AbsoluteDifference<T> DifferenceType;
+    const T* scalars1 = reinterpret_cast<const T*>(input1);
+    const T* scalars2 = reinterpret_cast<const T*>(input2);
+    const typename DifferenceType::ThresholdType threshold = DifferenceType::GetThreshold(changeThreshold);
+    typename DifferenceType::SumType sum = 0;
+    unsigned long long changed = 0;
+    for (size_t i = firstScalar; i < numberOfScalars; ++i)
+    {
+      const typename DifferenceType::SumType difference = DifferenceType::Compute(scalars1[i], scalars2[i]);
+      sum += difference;
+      if (static_cast<typename DifferenceType::ThresholdType>(difference) > threshold)
+      {
+        ++changed;
+      }
+    }
+    sumOfAbsoluteDifferences += static_cast<double>(sum);
+    numberOfChangedScalars += changed;
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T>
+  void FrameDifferenceScalar(const unsigned char* input1, const unsigned char* input2, size_t numberOfScalars, double changeThreshold,
+                             double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars)
+  {
+    FrameDifferenceRange<T>(input1, input2, numberOfScalars, 0, changeThreshold, sumOfAbsoluteDifferences, numberOfChangedScalars);
+  }
+
+  //----------------------------------------------------------------------------
+  // 8-bit change threshold for the vectorized implementations, -1 if all scalars are changed
+  inline int GetUint8ChangeThreshold(double changeThreshold)
+  {
+    return static_cast<int>(AbsoluteDifference<unsigned char>::GetThreshold(std::min(changeThreshold, 255.0)));
+  }
+
+  //----------------------------------------------------------------------------
+  // Sums of small integer types are exact in 64-bit integers, other types are summed in double precision
+  template<typename T>
+  struct StatisticsSum
+  {
+    typedef double Type;
+  };
+
+  template<> struct StatisticsSum<signed char>
+  {
+    typedef long long Type;
+  };
+  template<> struct StatisticsSum<unsigned char>
+  {
+    typedef long long Type;
+  };
+  template<> struct StatisticsSum<short>
+  {
+    typedef long long Type;
+  };
+  template<> struct StatisticsSum<unsigned short>
+  {
+    typedef long long Type;
+  };
+
+  //----------------------------------------------------------------------------
+  // Add the partial results of a kernel to the accumulator
+  inline void MergeStatistics(igsioVideoFrameKernels::StatisticsAccumulator& accumulator, double minimum, double maximum,
+                              double sum, double sumOfSquares, unsigned long long numberOfScalars)
+  {
+    if (numberOfScalars == 0)
+    {
+      return;
+    }
+    if (accumulator.NumberOfScalars == 0)
+    {
+      accumulator.Minimum = minimum;
+      accumulator.Maximum = maximum;
+    }
+    else
+    {
+      accumulator.Minimum = std::min(accumulator.Minimum, minimum);
+      accumulator.Maximum = std::max(accumulator.Maximum, maximum);
+    }
+    accumulator.Sum += sum;
+    accumulator.SumOfSquares += sumOfSquares;
+    accumulator.NumberOfScalars += numberOfScalars;
+  }
+
+  //----------------------------------------------------------------------------
+  // Index of the histogram bin of a value, binScale is the number of bins per unit
+  inline unsigned int GetHistogramBin(double value, double histogramMinimum, double binScale, unsigned int numberOfBins)
+  {
+    const double position = (value - histogramMinimum) * binScale;
+    if (!(position >= 0.0))
+    {
+      // below the range (or NaN)
+      return 0;
+    }
+    if (position >= numberOfBins)
+    {
+      return numberOfBins - 1;
+    }
+    return static_cast<unsigned int>(position);
+  }
+
+  //----------------------------------------------------------------------------
+  // Moments of scalars [firstScalar, numberOfScalars) of a row. Used as fallback and for the tail of vectorized loops.
+  template<typename T>
+  inline void AccumulateMomentsRange(const T* scalars, size_t numberOfScalars, size_t firstScalar, T& minimum, T& maximum,
+                                     typename StatisticsSum<T>::Type& sum, typename StatisticsSum<T>::Type& sumOfSquares)
+  {
+    typedef typename StatisticsSum<T>::Type SumType;
+    for (size_t i = firstScalar; i < numberOfScalars; ++i)
+    {
+      const T value = scalars[i];
+      minimum = (value < minimum ? value : minimum);
+      maximum = (value > maximum ? value : maximum);
+      sum += static_cast<SumType>(value);
+      sumOfSquares += static_cast<SumType>(value) * static_cast<SumType>(value);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename T>
+  void AccumulateStatisticsScalar(const unsigned char* input, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+                                  igsioVideoFrameKernels::StatisticsAccumulator& accumulator)
+  {
+    typedef typename StatisticsSum<T>::Type SumType;
+    if (numberOfScalarsPerRow == 0 || numberOfRows == 0)
+    {
+      return;
+    }
+    const bool computeHistogram = (accumulator.Histogram != NULL && accumulator.NumberOfBins > 0);
+    const double binScale = (computeHistogram ? accumulator.NumberOfBins / (accumulator.HistogramMaximum - accumulator.HistogramMinimum) : 0.0);
+
+    T minimum = *reinterpret_cast<const T*>(input);
+    T maximum = minimum;
+    SumType sum = 0;
+    SumType sumOfSquares = 0;
+    for (size_t row = 0; row < numberOfRows; ++row)
+    {
+      const T* scalars = reinterpret_cast<const T*>(input + row * inputRowStride);
+      AccumulateMomentsRange<T>(scalars, numberOfScalarsPerRow, 0, minimum, maximum, sum, sumOfSquares);
+      if (computeHistogram)
+      {
+        // the row is still in the cache
+        for (size_t i = 0; i < numberOfScalarsPerRow; ++i)
+        {
+          ++accumulator.Histogram[GetHistogramBin(static_cast<double>(scalars[i]), accumulator.HistogramMinimum, binScale, accumulator.NumberOfBins)];
+        }
+      }
+    }
+    MergeStatistics(accumulator, static_cast<double>(minimum), static_cast<double>(maximum), static_cast<double>(sum), static_cast<double>(sumOfSquares),
+                    static_cast<unsigned long long>(numberOfScalarsPerRow) * numberOfRows);
+  }
+
+  //----------------------------------------------------------------------------
+  // 8-bit statistics with histogram. The occurrences of each of the 256 values are counted (in 4 tables, so that
+  // consecutive equal values do not wait for each other), all statistics are then derived from the counts.
+  template<typename T>
+  void AccumulateStatisticsByteCounts(const unsigned char* input, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+                                      igsioVideoFrameKernels::StatisticsAccumulator& accumulator)
+  {
+    if (numberOfScalarsPerRow == 0 || numberOfRows == 0)
+    {
+      return;
+    }
+    unsigned long long counts[4][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t row = 0; row < numberOfRows; ++row)
+    {
+      const unsigned char* scalars = input + row * inputRowStride;
+      size_t i = 0;
+      for (; i + 4 <= numberOfScalarsPerRow; i += 4)
+      {
+        ++counts[0][scalars[i]];
+        ++counts[1][scalars[i + 1]];
+        ++counts[2][scalars[i + 2]];
+        ++counts[3][scalars[i + 3]];
+      }
+      for (; i < numberOfScalarsPerRow; ++i)
+      {
+        ++counts[0][scalars[i]];
+      }
+    }
+
+    const bool computeHistogram = (accumulator.Histogram != NULL && accumulator.NumberOfBins > 0);
+    const double binScale = (computeHistogram ? accumulator.NumberOfBins / (accumulator.HistogramMaximum - accumulator.HistogramMinimum) : 0.0);
+    T minimum = std::numeric_limits<T>::max();
+    T maximum = std::numeric_limits<T>::min();
+    long long sum = 0;
+    long long sumOfSquares = 0;
+    for (int byte = 0; byte < 256; ++byte)
+    {
+      const unsigned long long count = counts[0][byte] + counts[1][byte] + counts[2][byte] + counts[3][byte];
+      if (count == 0)
+      {
+        continue;
+      }
+      const T value = static_cast<T>(static_cast<unsigned char>(byte));
+      minimum = std::min(minimum, value);
+      maximum = std::max(maximum, value);
+      sum += static_cast<long long>(value) * static_cast<long long>(count);
+      sumOfSquares += static_cast<long long>(value) * value * static_cast<long long>(count);
+      if (computeHistogram)
+      {
+        accumulator.Histogram[GetHistogramBin(value, accumulator.HistogramMinimum, binScale, accumulator.NumberOfBins)] += count;
+      }
+    }
+    MergeStatistics(accumulator, minimum, maximum, static_cast<double>(sum), static_cast<double>(sumOfSquares),
+                    static_cast<unsigned long long>(numberOfScalarsPerRow) * numberOfRows);
+  }
+
+  //----------------------------------------------------------------------------
+  // XXH64 (https://github.com/Cyan4973/xxHash), 4 independent lanes hide the multiplication latency
+  const unsigned long long XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+  const unsigned long long XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+  const unsigned long long XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+  const unsigned long long XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+  const unsigned long long XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+  //----------------------------------------------------------------------------
+  inline unsigned long long RotateLeft64(unsigned long long value, int bits)
+  {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned long long ReadUInt64(const unsigned char* data)
+  {
+    unsigned long long value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned long long ReadUInt32(const unsigned char* data)
+  {
+    unsigned int value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned long long Xxh64Round(unsigned long long accumulator, unsigned long long input)
+  {
+    accumulator += input * XXH_PRIME64_2;
+    accumulator = RotateLeft64(accumulator, 31);
+    return accumulator * XXH_PRIME64_1;
+  }
+
+  //----------------------------------------------------------------------------
+  inline unsigned long long Xxh64MergeRound(unsigned long long accumulator, unsigned long long value)
+  {
+    accumulator ^= Xxh64Round(0, value);
+    return accumulator * XXH_PRIME64_1 + XXH_PRIME64_4;
+  }
+
+#if defined(IGSIO_SIMD_X86)
+  //----------------------------------------------------------------------------
+  // SSE2 implementations
+  //----------------------------------------------------------------------------
+
+  //----------------------------------------------------------------------------
+  // Reverse the order of the 16-bit words in a vector
+  IGSIO_TARGET_SSE2 inline __m128i ReverseWords_SSE2(__m128i v)
+  {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  }
+
+  //----------------------------------------------------------------------------
+  // Reverse the order of the GroupSize-byte groups in a vector
+  template<size_t GroupSize> IGSIO_TARGET_SSE2 inline __m128i ReverseVector_SSE2(__m128i v);
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i ReverseVector_SSE2<1>(__m128i v)
+  {
+    // swap the bytes within each word, then reverse the words
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    return ReverseWords_SSE2(v);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i ReverseVector_SSE2<2>(__m128i v)
+  {
+    return ReverseWords_SSE2(v);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i ReverseVector_SSE2<4>(__m128i v)
+  {
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i ReverseVector_SSE2<8>(__m128i v)
+  {
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i ReverseVector_SSE2<16>(__m128i v)
+  {
+    return v;
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t GroupSize>
+  IGSIO_TARGET_SSE2 void ReverseGroups_SSE2(unsigned char* output, const unsigned char* input, size_t groupCount, size_t)
+  {
+    const size_t groupsPerVector = 16 / GroupSize;
+    size_t i = 0;
+    for (; i + groupsPerVector <= groupCount; i += groupsPerVector)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * GroupSize));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + (groupCount - i - groupsPerVector) * GroupSize), ReverseVector_SSE2<GroupSize>(v));
+    }
+    ReverseGroupsRange<GroupSize>(output, input, groupCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Gather the first samples of the pairs in the low half and the second samples in the high half of a vector
+  template<size_t SampleSize> IGSIO_TARGET_SSE2 inline __m128i SeparatePairs_SSE2(__m128i v);
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i SeparatePairs_SSE2<2>(__m128i v)
+  {
+    // a0 b0 a1 b1 | a2 b2 a3 b3 -> a0 a1 b0 b1 | a2 a3 b2 b3 -> a0 a1 a2 a3 b0 b1 b2 b3
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 1, 2, 0));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i SeparatePairs_SSE2<4>(__m128i v)
+  {
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i SeparatePairs_SSE2<8>(__m128i v)
+  {
+    return v;
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize>
+  IGSIO_TARGET_SSE2 void Deinterleave_SSE2(unsigned char* outputFirst, unsigned char* outputSecond, const unsigned char* input, size_t pairCount, size_t)
+  {
+    // Two input vectors give one vector of first samples and one vector of second samples
+    const size_t pairsPerIteration = 16 / SampleSize;
+    size_t i = 0;
+    for (; i + pairsPerIteration <= pairCount; i += pairsPerIteration)
+    {
+      __m128i v0 = SeparatePairs_SSE2<SampleSize>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2 * SampleSize)));
+      __m128i v1 = SeparatePairs_SSE2<SampleSize>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2 * SampleSize + 16)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(outputFirst + i * SampleSize), _mm_unpacklo_epi64(v0, v1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(outputSecond + i * SampleSize), _mm_unpackhi_epi64(v0, v1));
+    }
+    DeinterleaveRange<SampleSize>(outputFirst, outputSecond, input, pairCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize> IGSIO_TARGET_SSE2 inline __m128i InterleaveLow_SSE2(__m128i a, __m128i b);
+  template<size_t SampleSize> IGSIO_TARGET_SSE2 inline __m128i InterleaveHigh_SSE2(__m128i a, __m128i b);
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i InterleaveLow_SSE2<2>(__m128i a, __m128i b)
+  {
+    return _mm_unpacklo_epi16(a, b);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i InterleaveHigh_SSE2<2>(__m128i a, __m128i b)
+  {
+    return _mm_unpackhi_epi16(a, b);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i InterleaveLow_SSE2<4>(__m128i a, __m128i b)
+  {
+    return _mm_unpacklo_epi32(a, b);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i InterleaveHigh_SSE2<4>(__m128i a, __m128i b)
+  {
+    return _mm_unpackhi_epi32(a, b);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i InterleaveLow_SSE2<8>(__m128i a, __m128i b)
+  {
+    return _mm_unpacklo_epi64(a, b);
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i InterleaveHigh_SSE2<8>(__m128i a, __m128i b)
+  {
+    return _mm_unpackhi_epi64(a, b);
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize>
+  IGSIO_TARGET_SSE2 void Interleave_SSE2(unsigned char* output, const unsigned char* inputFirst, const unsigned char* inputSecond, size_t pairCount, size_t)
+  {
+    const size_t pairsPerIteration = 16 / SampleSize;
+    size_t i = 0;
+    for (; i + pairsPerIteration <= pairCount; i += pairsPerIteration)
+    {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputFirst + i * SampleSize));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputSecond + i * SampleSize));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2 * SampleSize), InterleaveLow_SSE2<SampleSize>(a, b));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2 * SampleSize + 16), InterleaveHigh_SSE2<SampleSize>(a, b));
+    }
+    InterleaveRange<SampleSize>(output, inputFirst, inputSecond, pairCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Load 16 scalars as 4 vectors of floats
+  template<typename InputType> IGSIO_TARGET_SSE2 inline void Load16_SSE2(const unsigned char* input, __m128 values[4]);
+
+  template<> IGSIO_TARGET_SSE2 inline void Load16_SSE2<unsigned short>(const unsigned char* input, __m128 values[4])
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16));
+    values[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v0, zero));
+    values[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v0, zero));
+    values[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v1, zero));
+    values[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v1, zero));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline void Load16_SSE2<short>(const unsigned char* input, __m128 values[4])
+  {
+    // place each 16-bit value in the upper half of a 32-bit lane, then sign extend by an arithmetic shift
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16));
+    values[0] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v0, v0), 16));
+    values[1] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v0, v0), 16));
+    values[2] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v1, v1), 16));
+    values[3] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v1, v1), 16));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline void Load16_SSE2<float>(const unsigned char* input, __m128 values[4])
+  {
+    const float* floatInput = reinterpret_cast<const float*>(input);
+    values[0] = _mm_loadu_ps(floatInput);
+    values[1] = _mm_loadu_ps(floatInput + 4);
+    values[2] = _mm_loadu_ps(floatInput + 8);
+    values[3] = _mm_loadu_ps(floatInput + 12);
+  }
+
+  //----------------------------------------------------------------------------
+  // Store 4 vectors of floats as 16 scalars
+  template<typename OutputType> IGSIO_TARGET_SSE2 inline void Store16_SSE2(unsigned char* output, const __m128 values[4]);
+
+  template<> IGSIO_TARGET_SSE2 inline void Store16_SSE2<unsigned char>(unsigned char* output, const __m128 values[4])
+  {
+    // Saturate before the conversion, max returns the second operand (0) for NaN
+    const __m128 minimum = _mm_setzero_ps();
+    const __m128 maximum = _mm_set1_ps(255.0f);
+    __m128i integers[4];
+    for (int k = 0; k < 4; ++k)
+    {
+      integers[k] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(values[k], minimum), maximum));
+    }
+    const __m128i words0 = _mm_packs_epi32(integers[0], integers[1]);
+    const __m128i words1 = _mm_packs_epi32(integers[2], integers[3]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(words0, words1));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline void Store16_SSE2<float>(unsigned char* output, const __m128 values[4])
+  {
+    float* floatOutput = reinterpret_cast<float*>(output);
+    _mm_storeu_ps(floatOutput, values[0]);
+    _mm_storeu_ps(floatOutput + 4, values[1]);
+    _mm_storeu_ps(floatOutput + 8, values[2]);
+    _mm_storeu_ps(floatOutput + 12, values[3]);
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename InputType, typename OutputType>
+  IGSIO_TARGET_SSE2 void ConvertScalars_SSE2(unsigned char* output, const unsigned char* input, size_t count, double scale, double offset)
+  {
+    const __m128 scaleVector = _mm_set1_ps(static_cast<float>(scale));
+    const __m128 offsetVector = _mm_set1_ps(static_cast<float>(offset));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+      __m128 values[4];
+      Load16_SSE2<InputType>(input + i * sizeof(InputType), values);
+      for (int k = 0; k < 4; ++k)
+      {
+        values[k] = _mm_add_ps(_mm_mul_ps(values[k], scaleVector), offsetVector);
+      }
+      Store16_SSE2<OutputType>(output + i * sizeof(OutputType), values);
+    }
+    ConvertScalarsRange<InputType, OutputType>(output, input, count, i, scale, offset);
+  }
+
+  //----------------------------------------------------------------------------
+  // Sum the adjacent pairs of bytes of a vector into 8 16-bit values
+  IGSIO_TARGET_SSE2 inline __m128i SumBytePairs_SSE2(__m128i v)
+  {
+    return _mm_add_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(v, 8));
+  }
+
+  //----------------------------------------------------------------------------
+  // 2x downsampling of a single component 8-bit row, 16 output pixels per iteration
+  IGSIO_TARGET_SSE2 void Downsample2xRowUint8_SSE2(unsigned char* output, const unsigned char* inputRow0, const unsigned char* inputRow1, size_t inputWidth, size_t)
+  {
+    const __m128i rounding = _mm_set1_epi16(2);
+    size_t x = 0;
+    for (; 2 * x + 32 <= inputWidth; x += 16)
+    {
+      const __m128i* input0 = reinterpret_cast<const __m128i*>(inputRow0 + 2 * x);
+      const __m128i* input1 = reinterpret_cast<const __m128i*>(inputRow1 + 2 * x);
+      const __m128i low = _mm_add_epi16(SumBytePairs_SSE2(_mm_loadu_si128(input0)), SumBytePairs_SSE2(_mm_loadu_si128(input1)));
+      const __m128i high = _mm_add_epi16(SumBytePairs_SSE2(_mm_loadu_si128(input0 + 1)), SumBytePairs_SSE2(_mm_loadu_si128(input1 + 1)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x),
+                       _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(low, rounding), 2), _mm_srli_epi16(_mm_add_epi16(high, rounding), 2)));
+    }
+    Downsample2xRowRange<unsigned char>(output, inputRow0, inputRow1, inputWidth, 1, x);
+  }
+
+  //----------------------------------------------------------------------------
+  // Sum the adjacent pairs of 16-bit values of a vector into 4 32-bit values
+  template<typename T> IGSIO_TARGET_SSE2 inline __m128i SumWordPairs_SSE2(__m128i v);
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i SumWordPairs_SSE2<unsigned short>(__m128i v)
+  {
+    return _mm_add_epi32(_mm_and_si128(v, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(v, 16));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i SumWordPairs_SSE2<short>(__m128i v)
+  {
+    return _mm_add_epi32(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16), _mm_srai_epi32(v, 16));
+  }
+
+  //----------------------------------------------------------------------------
+  // Pack 8 32-bit averages into 16-bit values. SSE2 has no unsigned saturation from 32-bit, unsigned values
+  // are shifted into the signed range for packing and shifted back.
+  template<typename T> IGSIO_TARGET_SSE2 inline __m128i PackAverages_SSE2(__m128i low, __m128i high);
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i PackAverages_SSE2<unsigned short>(__m128i low, __m128i high)
+  {
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(low, bias32), _mm_sub_epi32(high, bias32));
+    return _mm_xor_si128(packed, _mm_set1_epi16(static_cast<short>(0x8000)));
+  }
+
+  template<> IGSIO_TARGET_SSE2 inline __m128i PackAverages_SSE2<short>(__m128i low, __m128i high)
+  {
+    return _mm_packs_epi32(low, high);
+  }
+
+  //----------------------------------------------------------------------------
+  // 2x downsampling of a single component 16-bit row, 8 output pixels per iteration
+  template<typename T>
+  IGSIO_TARGET_SSE2 void Downsample2xRow16_SSE2(unsigned char* output, const unsigned char* inputRow0, const unsigned char* inputRow1, size_t inputWidth, size_t)
+  {
+    const __m128i rounding = _mm_set1_epi32(2);
+    size_t x = 0;
+    for (; 2 * x + 16 <= inputWidth; x += 8)
+    {
+      const __m128i* input0 = reinterpret_cast<const __m128i*>(inputRow0 + 4 * x);
+      const __m128i* input1 = reinterpret_cast<const __m128i*>(inputRow1 + 4 * x);
+      const __m128i low = _mm_add_epi32(SumWordPairs_SSE2<T>(_mm_loadu_si128(input0)), SumWordPairs_SSE2<T>(_mm_loadu_si128(input1)));
+      const __m128i high = _mm_add_epi32(SumWordPairs_SSE2<T>(_mm_loadu_si128(input0 + 1)), SumWordPairs_SSE2<T>(_mm_loadu_si128(input1 + 1)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 2 * x),
+                       PackAverages_SSE2<T>(_mm_srai_epi32(_mm_add_epi32(low, rounding), 2), _mm_srai_epi32(_mm_add_epi32(high, rounding), 2)));
+    }
+    Downsample2xRowRange<T>(output, inputRow0, inputRow1, inputWidth, 1, x);
+  }
+
+  //----------------------------------------------------------------------------
+  // Sum the adjacent pairs of 8 floats stored in two vectors
+  IGSIO_TARGET_SSE2 inline __m128 SumFloatPairs_SSE2(__m128 first, __m128 second)
+  {
+    return _mm_add_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+
+  //----------------------------------------------------------------------------
+  // 2x downsampling of a single component float row, 4 output pixels per iteration
+  IGSIO_TARGET_SSE2 void Downsample2xRowFloat_SSE2(unsigned char* output, const unsigned char* inputRow0, const unsigned char* inputRow1, size_t inputWidth, size_t)
+  {
+    const float* input0 = reinterpret_cast<const float*>(inputRow0);
+    const float* input1 = reinterpret_cast<const float*>(inputRow1);
+    float* outputPixels = reinterpret_cast<float*>(output);
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    size_t x = 0;
+    for (; 2 * x + 8 <= inputWidth; x += 4)
+    {
+      const __m128 sum0 = SumFloatPairs_SSE2(_mm_loadu_ps(input0 + 2 * x), _mm_loadu_ps(input0 + 2 * x + 4));
+      const __m128 sum1 = SumFloatPairs_SSE2(_mm_loadu_ps(input1 + 2 * x), _mm_loadu_ps(input1 + 2 * x + 4));
+      _mm_storeu_ps(outputPixels + x, _mm_mul_ps(_mm_add_ps(sum0, sum1), quarter));
+    }
+    Downsample2xRowRange<float>(output, inputRow0, inputRow1, inputWidth, 1, x);
+  }
+
+  //----------------------------------------------------------------------------
+  // 8-bit frame difference, 16 scalars per iteration. The changed scalars are counted in 8-bit counters
+  // that are added to the 64-bit totals before they could overflow.
+  IGSIO_TARGET_SSE2 void FrameDifferenceUint8_SSE2(const unsigned char* input1, const unsigned char* input2, size_t numberOfScalars, double changeThreshold,
+      double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars)
+  {
+    const int threshold = GetUint8ChangeThreshold(changeThreshold);
+    const __m128i thresholdVector = _mm_set1_epi8(static_cast<char>(std::max(threshold, 0)));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = zero;
+    __m128i unchangedTotals = zero;
+    __m128i unchangedCounters = zero;
+    int numberOfCountedBlocks = 0;
+    size_t i = 0;
+    for (; i + 16 <= numberOfScalars; i += 16)
+    {
+      const __m128i scalars1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input1 + i));
+      const __m128i scalars2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input2 + i));
+      sums = _mm_add_epi64(sums, _mm_sad_epu8(scalars1, scalars2));
+      const __m128i difference = _mm_or_si128(_mm_subs_epu8(scalars1, scalars2), _mm_subs_epu8(scalars2, scalars1));
+      // all bits set where the difference is not larger than the threshold, subtracting -1 increments the counter
+      unchangedCounters = _mm_sub_epi8(unchangedCounters, _mm_cmpeq_epi8(_mm_subs_epu8(difference, thresholdVector), zero));
+      if (++numberOfCountedBlocks == 255)
+      {
+        unchangedTotals = _mm_add_epi64(unchangedTotals, _mm_sad_epu8(unchangedCounters, zero));
+        unchangedCounters = zero;
+        numberOfCountedBlocks = 0;
+      }
+    }
+    unchangedTotals = _mm_add_epi64(unchangedTotals, _mm_sad_epu8(unchangedCounters, zero));
+
+    unsigned long long lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    sumOfAbsoluteDifferences += static_cast<double>(lanes[0] + lanes[1]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), unchangedTotals);
+    numberOfChangedScalars += (threshold < 0 ? i : i - (lanes[0] + lanes[1]));
+    FrameDifferenceRange<unsigned char>(input1, input2, numberOfScalars, i, changeThreshold, sumOfAbsoluteDifferences, numberOfChangedScalars);
+  }
+
+  //----------------------------------------------------------------------------
+  // 8-bit statistics, 16 scalars per iteration. Squares are summed in 32-bit lanes that are added to
+  // 64-bit totals before they could overflow. If a histogram is requested then the byte counting
+  // implementation is used, it computes all statistics in the same pass.
+  IGSIO_TARGET_SSE2 void AccumulateStatisticsUint8_SSE2(const unsigned char* input, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+      igsioVideoFrameKernels::StatisticsAccumulator& accumulator)
+  {
+    if (accumulator.Histogram != NULL && accumulator.NumberOfBins > 0)
+    {
+      AccumulateStatisticsByteCounts<unsigned char>(input, numberOfScalarsPerRow, numberOfRows, inputRowStride, accumulator);
+      return;
+    }
+    if (numberOfScalarsPerRow == 0 || numberOfRows == 0)
+    {
+      return;
+    }
+    const __m128i zero = _mm_setzero_si128();
+    __m128i minimumVector = _mm_set1_epi8(static_cast<char>(0xFF));
+    __m128i maximumVector = zero;
+    __m128i sums = zero;
+    __m128i squareTotals = zero;
+    unsigned char minimum = 255;
+    unsigned char maximum = 0;
+    long long sum = 0;
+    long long sumOfSquares = 0;
+    for (size_t row = 0; row < numberOfRows; ++row)
+    {
+      const unsigned char* scalars = input + row * inputRowStride;
+      __m128i squareSums = zero;
+      int numberOfSummedBlocks = 0;
+      size_t i = 0;
+      for (; i + 16 <= numberOfScalarsPerRow; i += 16)
+      {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scalars + i));
+        minimumVector = _mm_min_epu8(minimumVector, values);
+        maximumVector = _mm_max_epu8(maximumVector, values);
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(values, zero));
+        const __m128i low = _mm_unpacklo_epi8(values, zero);
+        const __m128i high = _mm_unpackhi_epi8(values, zero);
+        // each 32-bit lane grows by at most 4 * 255^2 per iteration
+        squareSums = _mm_add_epi32(squareSums, _mm_add_epi32(_mm_madd_epi16(low, low), _mm_madd_epi16(high, high)));
+        if (++numberOfSummedBlocks == 4096)
+        {
+          squareTotals = _mm_add_epi64(squareTotals, _mm_add_epi64(_mm_unpacklo_epi32(squareSums, zero), _mm_unpackhi_epi32(squareSums, zero)));
+          squareSums = zero;
+          numberOfSummedBlocks = 0;
+        }
+      }
+      squareTotals = _mm_add_epi64(squareTotals, _mm_add_epi64(_mm_unpacklo_epi32(squareSums, zero), _mm_unpackhi_epi32(squareSums, zero)));
+      AccumulateMomentsRange<unsigned char>(scalars, numberOfScalarsPerRow, i, minimum, maximum, sum, sumOfSquares);
+    }
+
+    unsigned char lanes8[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes8), minimumVector);
+    minimum = std::min(minimum, *std::min_element(lanes8, lanes8 + 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes8), maximumVector);
+    maximum = std::max(maximum, *std::max_element(lanes8, lanes8 + 16));
+    long long lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    sum += lanes[0] + lanes[1];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), squareTotals);
+    sumOfSquares += lanes[0] + lanes[1];
+    MergeStatistics(accumulator, minimum, maximum, static_cast<double>(sum), static_cast<double>(sumOfSquares),
+                    static_cast<unsigned long long>(numberOfScalarsPerRow) * numberOfRows);
+  }
+
+  //----------------------------------------------------------------------------
+  // SSSE3 implementations
+  //----------------------------------------------------------------------------
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 void ReverseBytes_SSSE3(unsigned char* output, const unsigned char* input, size_t groupCount, size_t)
+  {
+    const __m128i mask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    size_t i = 0;
+    for (; i + 16 <= groupCount; i += 16)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + groupCount - i - 16), _mm_shuffle_epi8(v, mask));
+    }
+    ReverseGroupsRange<1>(output, input, groupCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Reverse groups whose size does not divide the vector size (3-byte RGB pixels, 6-byte 16-bit RGB pixels
+  // or 8-bit RGB I/Q pairs). Each iteration reverses as many whole groups as fit in a vector, these are
+  // placed at the end of the vector. The leading bytes of the stored vector spill into the preceding output
+  // group, which is overwritten by the next iteration (or the tail loop).
+  template<size_t GroupSize>
+  IGSIO_TARGET_SSSE3 void ReverseGroupsPacked_SSSE3(unsigned char* output, const unsigned char* input, size_t groupCount, size_t)
+  {
+    const size_t groupsPerVector = 16 / GroupSize;
+    const size_t spillBytes = 16 - groupsPerVector * GroupSize;
+
+    unsigned char maskBytes[16];
+    for (size_t b = 0; b < spillBytes; ++b)
+    {
+      maskBytes[b] = 0x80; // zero the spilled bytes
+    }
+    for (size_t j = 0; j < groupsPerVector; ++j)
+    {
+      for (size_t k = 0; k < GroupSize; ++k)
+      {
+        maskBytes[spillBytes + j * GroupSize + k] = static_cast<unsigned char>((groupsPerVector - 1 - j) * GroupSize + k);
+      }
+    }
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maskBytes));
+
+    // At least one more group must follow in the input, so that the 16-byte load stays within
+    // the input row and the spilled bytes stay within the output row
+    size_t i = 0;
+    for (; i + groupsPerVector + 1 <= groupCount; i += groupsPerVector)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * GroupSize));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + (groupCount - i - groupsPerVector) * GroupSize - spillBytes), _mm_shuffle_epi8(v, mask));
+    }
+    ReverseGroupsRange<GroupSize>(output, input, groupCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Shuffle mask that reverses the bytes of each ScalarSize-byte scalar within a 16-byte block
+  template<size_t ScalarSize>
+  inline void GetSwapBytesMask(unsigned char maskBytes[16])
+  {
+    for (size_t i = 0; i < 16; ++i)
+    {
+      maskBytes[i] = static_cast<unsigned char>((i / ScalarSize) * ScalarSize + ScalarSize - 1 - i % ScalarSize);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t ScalarSize>
+  IGSIO_TARGET_SSSE3 void SwapBytes_SSSE3(unsigned char* output, const unsigned char* input, size_t numberOfScalars)
+  {
+    unsigned char maskBytes[16];
+    GetSwapBytesMask<ScalarSize>(maskBytes);
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maskBytes));
+    const size_t scalarsPerVector = 16 / ScalarSize;
+    size_t i = 0;
+    for (; i + scalarsPerVector <= numberOfScalars; i += scalarsPerVector)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * ScalarSize));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * ScalarSize), _mm_shuffle_epi8(v, mask));
+    }
+    SwapBytesRange<ScalarSize>(output, input, numberOfScalars, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Shuffle masks for converting between 16 packed RGB24 pixels (three vectors) and planar R, G and B vectors
+  struct RgbShuffleMasks_SSSE3
+  {
+    __m128i Split[3][3]; // [channel][packed vector]
+    __m128i Merge[3][3]; // [packed vector][channel]
+  };
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 inline void InitializeRgbShuffleMasks_SSSE3(RgbShuffleMasks_SSSE3& masks)
+  {
+    unsigned char maskBytes[16];
+    for (int channel = 0; channel < 3; ++channel)
+    {
+      for (int vector = 0; vector < 3; ++vector)
+      {
+        // planar byte i is packed byte 3i + channel
+        for (int i = 0; i < 16; ++i)
+        {
+          const int packedIndex = 3 * i + channel - 16 * vector;
+          maskBytes[i] = static_cast<unsigned char>(packedIndex >= 0 && packedIndex < 16 ? packedIndex : 0x80);
+        }
+        masks.Split[channel][vector] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maskBytes));
+
+        // packed byte i belongs to the channel if its index is congruent to the channel modulo 3
+        for (int i = 0; i < 16; ++i)
+        {
+          const int packedIndex = 16 * vector + i;
+          maskBytes[i] = static_cast<unsigned char>(packedIndex % 3 == channel ? packedIndex / 3 : 0x80);
+        }
+        masks.Merge[vector][channel] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maskBytes));
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Load 16 RGB24 pixels into planar R, G, B vectors
+  IGSIO_TARGET_SSSE3 inline void LoadRgb16_SSSE3(const unsigned char* input, const RgbShuffleMasks_SSSE3& masks, __m128i channels[3])
+  {
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 32));
+    for (int channel = 0; channel < 3; ++channel)
+    {
+      channels[channel] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, masks.Split[channel][0]), _mm_shuffle_epi8(v1, masks.Split[channel][1])),
+                                       _mm_shuffle_epi8(v2, masks.Split[channel][2]));
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Store planar R, G, B vectors as 16 RGB24 pixels
+  IGSIO_TARGET_SSSE3 inline void StoreRgb16_SSSE3(unsigned char* output, const RgbShuffleMasks_SSSE3& masks, const __m128i channels[3])
+  {
+    for (int vector = 0; vector < 3; ++vector)
+    {
+      const __m128i packed = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(channels[0], masks.Merge[vector][0]), _mm_shuffle_epi8(channels[1], masks.Merge[vector][1])),
+                                          _mm_shuffle_epi8(channels[2], masks.Merge[vector][2]));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + vector * 16), packed);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Luma of 8 pixels with 16-bit R, G, B values. The weighted sum is at most 56228, it is computed in unsigned 16-bit arithmetic.
+  IGSIO_TARGET_SSSE3 inline __m128i RgbToY8_SSSE3(__m128i r, __m128i g, __m128i b)
+  {
+    const __m128i sum = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(66)), _mm_mullo_epi16(g, _mm_set1_epi16(129))),
+                                      _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(25)), _mm_set1_epi16(128)));
+    return _mm_add_epi16(_mm_srli_epi16(sum, 8), _mm_set1_epi16(16));
+  }
+
+  //----------------------------------------------------------------------------
+  // Luma of 16 pixels with 8-bit R, G, B values
+  IGSIO_TARGET_SSSE3 inline __m128i RgbToY16_SSSE3(const __m128i channels[3])
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = RgbToY8_SSSE3(_mm_unpacklo_epi8(channels[0], zero), _mm_unpacklo_epi8(channels[1], zero), _mm_unpacklo_epi8(channels[2], zero));
+    const __m128i high = RgbToY8_SSSE3(_mm_unpackhi_epi8(channels[0], zero), _mm_unpackhi_epi8(channels[1], zero), _mm_unpackhi_epi8(channels[2], zero));
+    return _mm_packus_epi16(low, high);
+  }
+
+  //----------------------------------------------------------------------------
+  // Chroma of 8 averaged colors with 16-bit R, G, B values, returned as 8 bytes in the low half of the vector
+  IGSIO_TARGET_SSSE3 inline __m128i RgbToChroma8_SSSE3(__m128i r, __m128i g, __m128i b, short rWeight, short gWeight, short bWeight)
+  {
+    const __m128i sum = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(rWeight)), _mm_mullo_epi16(g, _mm_set1_epi16(gWeight))),
+                                      _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(bWeight)), _mm_set1_epi16(128)));
+    const __m128i chroma = _mm_add_epi16(_mm_srai_epi16(sum, 8), _mm_set1_epi16(128));
+    return _mm_packus_epi16(chroma, chroma);
+  }
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 void RgbToYuv420Rows_SSSE3(unsigned char* yRow0, unsigned char* yRow1, unsigned char* uRow, unsigned char* vRow, size_t chromaStep,
+      const unsigned char* rgbRow0, const unsigned char* rgbRow1, size_t width)
+  {
+    RgbShuffleMasks_SSSE3 masks;
+    InitializeRgbShuffleMasks_SSSE3(masks);
+    const __m128i ones = _mm_set1_epi8(1);
+    const __m128i rounding = _mm_set1_epi16(2);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      __m128i row0[3];
+      __m128i row1[3];
+      LoadRgb16_SSSE3(rgbRow0 + x * 3, masks, row0);
+      LoadRgb16_SSSE3(rgbRow1 + x * 3, masks, row1);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow0 + x), RgbToY16_SSSE3(row0));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow1 + x), RgbToY16_SSSE3(row1));
+
+      // Average color of each 2x2 block: sum the horizontal pairs of both rows
+      __m128i average[3];
+      for (int channel = 0; channel < 3; ++channel)
+      {
+        const __m128i sum = _mm_add_epi16(_mm_maddubs_epi16(row0[channel], ones), _mm_maddubs_epi16(row1[channel], ones));
+        average[channel] = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+      }
+      const __m128i u = RgbToChroma8_SSSE3(average[0], average[1], average[2], -38, -74, 112);
+      const __m128i v = RgbToChroma8_SSSE3(average[0], average[1], average[2], 112, -94, -18);
+      if (chromaStep == 1)
+      {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(uRow + x / 2), u);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(vRow + x / 2), v);
+      }
+      else
+      {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uRow + x), _mm_unpacklo_epi8(u, v));
+      }
+    }
+    RgbToYuv420Range(yRow0, yRow1, uRow, vRow, chromaStep, rgbRow0, rgbRow1, width, x);
+  }
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 void RgbToYuy2Row_SSSE3(unsigned char* yuvRow, const unsigned char* rgbRow, size_t width)
+  {
+    RgbShuffleMasks_SSSE3 masks;
+    InitializeRgbShuffleMasks_SSSE3(masks);
+    const __m128i ones = _mm_set1_epi8(1);
+    const __m128i rounding = _mm_set1_epi16(1);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      __m128i row[3];
+      LoadRgb16_SSSE3(rgbRow + x * 3, masks, row);
+      const __m128i y = RgbToY16_SSSE3(row);
+
+      // Average color of each horizontal pair
+      __m128i average[3];
+      for (int channel = 0; channel < 3; ++channel)
+      {
+        average[channel] = _mm_srli_epi16(_mm_add_epi16(_mm_maddubs_epi16(row[channel], ones), rounding), 1);
+      }
+      const __m128i u = RgbToChroma8_SSSE3(average[0], average[1], average[2], -38, -74, 112);
+      const __m128i v = RgbToChroma8_SSSE3(average[0], average[1], average[2], 112, -94, -18);
+      const __m128i uv = _mm_unpacklo_epi8(u, v);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(yuvRow + x * 2), _mm_unpacklo_epi8(y, uv));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(yuvRow + x * 2 + 16), _mm_unpackhi_epi8(y, uv));
+    }
+    RgbToYuy2Range(yuvRow, rgbRow, width, x);
+  }
+
+  //----------------------------------------------------------------------------
+  // Chroma dependent terms of YuvToRgbPixel for 8 pixels. 298c is split into 256c + 42c so that all
+  // intermediate values fit into 16-bit integers, and the multiples of 256 are moved out of the shift:
+  //   R = c + e + ((42c + 153e + 128) >> 8)
+  //   G = c - e + ((42c - 100d + 48e + 128) >> 8)
+  //   B = c + 2d + ((42c + 4d + 128) >> 8)
+  struct YuvChromaTerms_SSSE3
+  {
+    __m128i Outer[3];
+    __m128i Inner[3];
+  };
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 inline void ComputeChromaTerms_SSSE3(__m128i u, __m128i v, YuvChromaTerms_SSSE3& terms)
+  {
+    const __m128i d = _mm_sub_epi16(u, _mm_set1_epi16(128));
+    const __m128i e = _mm_sub_epi16(v, _mm_set1_epi16(128));
+    const __m128i rounding = _mm_set1_epi16(128);
+    terms.Outer[0] = e;
+    terms.Inner[0] = _mm_add_epi16(_mm_mullo_epi16(e, _mm_set1_epi16(153)), rounding);
+    terms.Outer[1] = _mm_sub_epi16(_mm_setzero_si128(), e);
+    terms.Inner[1] = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(d, _mm_set1_epi16(-100)), _mm_mullo_epi16(e, _mm_set1_epi16(48))), rounding);
+    terms.Outer[2] = _mm_add_epi16(d, d);
+    terms.Inner[2] = _mm_add_epi16(_mm_slli_epi16(d, 2), rounding);
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert 8 pixels with 16-bit Y values to 16-bit R, G, B values (not clamped yet)
+  IGSIO_TARGET_SSSE3 inline void YuvToRgb8_SSSE3(__m128i y, const YuvChromaTerms_SSSE3& terms, __m128i channels[3])
+  {
+    const __m128i c = _mm_sub_epi16(y, _mm_set1_epi16(16));
+    const __m128i c42 = _mm_mullo_epi16(c, _mm_set1_epi16(42));
+    for (int channel = 0; channel < 3; ++channel)
+    {
+      channels[channel] = _mm_add_epi16(_mm_add_epi16(c, terms.Outer[channel]), _mm_srai_epi16(_mm_add_epi16(c42, terms.Inner[channel]), 8));
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert 16 pixels given as two halves of 16-bit Y values and store them as RGB24
+  IGSIO_TARGET_SSSE3 inline void YuvToRgb16_SSSE3(unsigned char* output, const RgbShuffleMasks_SSSE3& masks, __m128i yLow, __m128i yHigh,
+      const YuvChromaTerms_SSSE3& termsLow, const YuvChromaTerms_SSSE3& termsHigh)
+  {
+    __m128i low[3];
+    __m128i high[3];
+    YuvToRgb8_SSSE3(yLow, termsLow, low);
+    YuvToRgb8_SSSE3(yHigh, termsHigh, high);
+    __m128i channels[3];
+    for (int channel = 0; channel < 3; ++channel)
+    {
+      channels[channel] = _mm_packus_epi16(low[channel], high[channel]);
+    }
+    StoreRgb16_SSSE3(output, masks, channels);
+  }
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 void Yuv420ToRgbRows_SSSE3(unsigned char* rgbRow0, unsigned char* rgbRow1, const unsigned char* yRow0, const unsigned char* yRow1,
+      const unsigned char* uRow, const unsigned char* vRow, size_t chromaStep, size_t width)
+  {
+    RgbShuffleMasks_SSSE3 masks;
+    InitializeRgbShuffleMasks_SSSE3(masks);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      __m128i u;
+      __m128i v;
+      if (chromaStep == 1)
+      {
+        u = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(uRow + x / 2)), zero);
+        v = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(vRow + x / 2)), zero);
+      }
+      else
+      {
+        const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uRow + x));
+        u = _mm_and_si128(uv, lowByteMask);
+        v = _mm_srli_epi16(uv, 8);
+      }
+
+      // Each chroma sample is used by two neighboring pixels
+      YuvChromaTerms_SSSE3 termsLow;
+      YuvChromaTerms_SSSE3 termsHigh;
+      ComputeChromaTerms_SSSE3(_mm_unpacklo_epi16(u, u), _mm_unpacklo_epi16(v, v), termsLow);
+      ComputeChromaTerms_SSSE3(_mm_unpackhi_epi16(u, u), _mm_unpackhi_epi16(v, v), termsHigh);
+
+      const __m128i y0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow0 + x));
+      YuvToRgb16_SSSE3(rgbRow0 + x * 3, masks, _mm_unpacklo_epi8(y0, zero), _mm_unpackhi_epi8(y0, zero), termsLow, termsHigh);
+      const __m128i y1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow1 + x));
+      YuvToRgb16_SSSE3(rgbRow1 + x * 3, masks, _mm_unpacklo_epi8(y1, zero), _mm_unpackhi_epi8(y1, zero), termsLow, termsHigh);
+    }
+    Yuv420ToRgbRange(rgbRow0, rgbRow1, yRow0, yRow1, uRow, vRow, chromaStep, width, x);
+  }
+
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_SSSE3 void Yuy2ToRgbRow_SSSE3(unsigned char* rgbRow, const unsigned char* yuvRow, size_t width)
+  {
+    RgbShuffleMasks_SSSE3 masks;
+    InitializeRgbShuffleMasks_SSSE3(masks);
+    const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      __m128i y[2];
+      YuvChromaTerms_SSSE3 terms[2];
+      for (int half = 0; half < 2; ++half)
+      {
+        // 8 pixels: Y values in the low bytes, U0 V0 U1 V1 U2 V2 U3 V3 in the high bytes
+        const __m128i yuv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yuvRow + x * 2 + half * 16));
+        y[half] = _mm_and_si128(yuv, lowByteMask);
+        const __m128i chroma = _mm_srli_epi16(yuv, 8);
+        const __m128i u = _mm_shufflehi_epi16(_mm_shufflelo_epi16(chroma, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128i v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(chroma, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+        ComputeChromaTerms_SSSE3(u, v, terms[half]);
+      }
+      YuvToRgb16_SSSE3(rgbRow + x * 3, masks, y[0], y[1], terms[0], terms[1]);
+    }
+    Yuy2ToRgbRange(rgbRow, yuvRow, width, x);
+  }
+
+  //----------------------------------------------------------------------------
+  // AVX2 implementations
+  //----------------------------------------------------------------------------
+
+  //----------------------------------------------------------------------------
+  template<size_t GroupSize> IGSIO_TARGET_AVX2 inline __m256i ReverseVector_AVX2(__m256i v);
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i ReverseVector_AVX2<1>(__m256i v)
+  {
+    const __m256i mask = _mm256_setr_epi8(
+                           15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                           15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    // reverse the bytes within each 128-bit lane, then swap the lanes
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), _MM_SHUFFLE(1, 0, 3, 2));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i ReverseVector_AVX2<2>(__m256i v)
+  {
+    const __m256i mask = _mm256_setr_epi8(
+                           14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                           14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), _MM_SHUFFLE(1, 0, 3, 2));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i ReverseVector_AVX2<4>(__m256i v)
+  {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i ReverseVector_AVX2<8>(__m256i v)
+  {
+    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i ReverseVector_AVX2<16>(__m256i v)
+  {
+    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t GroupSize>
+  IGSIO_TARGET_AVX2 void ReverseGroups_AVX2(unsigned char* output, const unsigned char* input, size_t groupCount, size_t)
+  {
+    const size_t groupsPerVector = 32 / GroupSize;
+    size_t i = 0;
+    for (; i + groupsPerVector <= groupCount; i += groupsPerVector)
+    {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * GroupSize));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + (groupCount - i - groupsPerVector) * GroupSize), ReverseVector_AVX2<GroupSize>(v));
+    }
+    ReverseGroupsRange<GroupSize>(output, input, groupCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Two vectors per iteration to hide the shuffle latency, rows of big-endian images are usually long
+  template<size_t ScalarSize>
+  IGSIO_TARGET_AVX2 void SwapBytes_AVX2(unsigned char* output, const unsigned char* input, size_t numberOfScalars)
+  {
+    unsigned char maskBytes[16];
+    GetSwapBytesMask<ScalarSize>(maskBytes);
+    const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(maskBytes)));
+    const size_t scalarsPerVector = 32 / ScalarSize;
+    size_t i = 0;
+    for (; i + 2 * scalarsPerVector <= numberOfScalars; i += 2 * scalarsPerVector)
+    {
+      __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * ScalarSize));
+      __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * ScalarSize + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * ScalarSize), _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * ScalarSize + 32), _mm256_shuffle_epi8(v1, mask));
+    }
+    for (; i + scalarsPerVector <= numberOfScalars; i += scalarsPerVector)
+    {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * ScalarSize));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * ScalarSize), _mm256_shuffle_epi8(v, mask));
+    }
+    SwapBytesRange<ScalarSize>(output, input, numberOfScalars, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Gather the first samples of the pairs in the low 128-bit lane and the second samples in the high lane
+  template<size_t SampleSize> IGSIO_TARGET_AVX2 inline __m256i SeparatePairs_AVX2(__m256i v);
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i SeparatePairs_AVX2<2>(__m256i v)
+  {
+    const __m256i mask = _mm256_setr_epi8(
+                           0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                           0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+    // separate within each lane, then move the first samples of both lanes to the low lane
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), _MM_SHUFFLE(3, 1, 2, 0));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i SeparatePairs_AVX2<4>(__m256i v)
+  {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i SeparatePairs_AVX2<8>(__m256i v)
+  {
+    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize>
+  IGSIO_TARGET_AVX2 void Deinterleave_AVX2(unsigned char* outputFirst, unsigned char* outputSecond, const unsigned char* input, size_t pairCount, size_t)
+  {
+    const size_t pairsPerIteration = 32 / SampleSize;
+    size_t i = 0;
+    for (; i + pairsPerIteration <= pairCount; i += pairsPerIteration)
+    {
+      __m256i v0 = SeparatePairs_AVX2<SampleSize>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 2 * SampleSize)));
+      __m256i v1 = SeparatePairs_AVX2<SampleSize>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 2 * SampleSize + 32)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(outputFirst + i * SampleSize), _mm256_permute2x128_si256(v0, v1, 0x20));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(outputSecond + i * SampleSize), _mm256_permute2x128_si256(v0, v1, 0x31));
+    }
+    DeinterleaveRange<SampleSize>(outputFirst, outputSecond, input, pairCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize> IGSIO_TARGET_AVX2 inline __m256i InterleaveLow_AVX2(__m256i a, __m256i b);
+  template<size_t SampleSize> IGSIO_TARGET_AVX2 inline __m256i InterleaveHigh_AVX2(__m256i a, __m256i b);
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i InterleaveLow_AVX2<2>(__m256i a, __m256i b)
+  {
+    return _mm256_unpacklo_epi16(a, b);
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i InterleaveHigh_AVX2<2>(__m256i a, __m256i b)
+  {
+    return _mm256_unpackhi_epi16(a, b);
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i InterleaveLow_AVX2<4>(__m256i a, __m256i b)
+  {
+    return _mm256_unpacklo_epi32(a, b);
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i InterleaveHigh_AVX2<4>(__m256i a, __m256i b)
+  {
+    return _mm256_unpackhi_epi32(a, b);
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i InterleaveLow_AVX2<8>(__m256i a, __m256i b)
+  {
+    return _mm256_unpacklo_epi64(a, b);
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline __m256i InterleaveHigh_AVX2<8>(__m256i a, __m256i b)
+  {
+    return _mm256_unpackhi_epi64(a, b);
+  }
+
+  //----------------------------------------------------------------------------
+  template<size_t SampleSize>
+  IGSIO_TARGET_AVX2 void Interleave_AVX2(unsigned char* output, const unsigned char* inputFirst, const unsigned char* inputSecond, size_t pairCount, size_t)
+  {
+    const size_t pairsPerIteration = 32 / SampleSize;
+    size_t i = 0;
+    for (; i + pairsPerIteration <= pairCount; i += pairsPerIteration)
+    {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputFirst + i * SampleSize));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputSecond + i * SampleSize));
+      // unpack works within 128-bit lanes, the lanes of the results are reordered when stored
+      __m256i low = InterleaveLow_AVX2<SampleSize>(a, b);
+      __m256i high = InterleaveHigh_AVX2<SampleSize>(a, b);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * 2 * SampleSize), _mm256_permute2x128_si256(low, high, 0x20));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * 2 * SampleSize + 32), _mm256_permute2x128_si256(low, high, 0x31));
+    }
+    InterleaveRange<SampleSize>(output, inputFirst, inputSecond, pairCount, i);
+  }
+
+  //----------------------------------------------------------------------------
+  // Load 32 scalars as 4 vectors of floats
+  template<typename InputType> IGSIO_TARGET_AVX2 inline void Load32_AVX2(const unsigned char* input, __m256 values[4]);
+
+  template<> IGSIO_TARGET_AVX2 inline void Load32_AVX2<unsigned short>(const unsigned char* input, __m256 values[4])
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      values[k] = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + k * 16))));
+    }
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline void Load32_AVX2<short>(const unsigned char* input, __m256 values[4])
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      values[k] = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + k * 16))));
+    }
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline void Load32_AVX2<float>(const unsigned char* input, __m256 values[4])
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      values[k] = _mm256_loadu_ps(reinterpret_cast<const float*>(input) + k * 8);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Store 4 vectors of floats as 32 scalars
+  template<typename OutputType> IGSIO_TARGET_AVX2 inline void Store32_AVX2(unsigned char* output, const __m256 values[4]);
+
+  template<> IGSIO_TARGET_AVX2 inline void Store32_AVX2<unsigned char>(unsigned char* output, const __m256 values[4])
+  {
+    const __m256 minimum = _mm256_setzero_ps();
+    const __m256 maximum = _mm256_set1_ps(255.0f);
+    __m256i integers[4];
+    for (int k = 0; k < 4; ++k)
+    {
+      integers[k] = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(values[k], minimum), maximum));
+    }
+    // pack works within 128-bit lanes, so the 4-byte groups of the result are reordered at the end
+    const __m256i words01 = _mm256_packs_epi32(integers[0], integers[1]);
+    const __m256i words23 = _mm256_packs_epi32(integers[2], integers[3]);
+    const __m256i bytes = _mm256_packus_epi16(words01, words23);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+  }
+
+  template<> IGSIO_TARGET_AVX2 inline void Store32_AVX2<float>(unsigned char* output, const __m256 values[4])
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      _mm256_storeu_ps(reinterpret_cast<float*>(output) + k * 8, values[k]);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template<typename InputType, typename OutputType>
+  IGSIO_TARGET_AVX2 void ConvertScalars_AVX2(unsigned char* output, const unsigned char* input, size_t count, double scale, double offset)
+  {
+    const __m256 scaleVector = _mm256_set1_ps(static_cast<float>(scale));
+    const __m256 offsetVector = _mm256_set1_ps(static_cast<float>(offset));
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+      __m256 values[4];
+      Load32_AVX2<InputType>(input + i * sizeof(InputType), values);
+      for (int k = 0; k < 4; ++k)
+      {
+        values[k] = _mm256_add_ps(_mm256_mul_ps(values[k], scaleVector), offsetVector);
+      }
+      Store32_AVX2<OutputType>(output + i * sizeof(OutputType), values);
+    }
+    ConvertScalarsRange<InputType, OutputType>(output, input, count, i, scale, offset);
+  }
+  //----------------------------------------------------------------------------
+  IGSIO_TARGET_AVX2 inline __m256i SumBytePairs_AVX2(__m256i v)
+  {
+    return _mm256_add_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x00FF)), _mm256_srli_epi16(v, 8));
+  }
+
+  //----------------------------------------------------------------------------
+  // 2x downsampling of a single component 8-bit row, 32 output pixels per iteration
+  IGSIO_TARGET_AVX2 void Downsample2xRowUint8_AVX2(unsigned char* output, const unsigned char* inputRow0, const unsigned char* inputRow1, size_t inputWidth, size_t)
+  {
+    const __m256i rounding = _mm256_set1_epi16(2);
+    size_t x = 0;
+    for (; 2 * x + 64 <= inputWidth; x += 32)
+    {
+      const __m256i* input0 = reinterpret_cast<const __m256i*>(inputRow0 + 2 * x);
+      const __m256i* input1 = reinterpret_cast<const __m256i*>(inputRow1 + 2 * x);
+      const __m256i low = _mm256_add_epi16(SumBytePairs_AVX2(_mm256_loadu_si256(input0)), SumBytePairs_AVX2(_mm256_loadu_si256(input1)));
+      const __m256i high = _mm256_add_epi16(SumBytePairs_AVX2(_mm256_loadu_si256(input0 + 1)), SumBytePairs_AVX2(_mm256_loadu_si256(input1 + 1)));
+      const __m256i packed = _mm256_packus_epi16(_mm256_srli_epi16(_mm256_add_epi16(low, rounding), 2), _mm256_srli_epi16(_mm256_add_epi16(high, rounding), 2));
+      // packing works within 128-bit lanes, restore the order of the 64-bit blocks
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + x), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    Downsample2xRowRange<unsigned char>(output, inputRow0, inputRow1, inputWidth, 1, x);
+  }
+
+  //----------------------------------------------------------------------------
+  // 8-bit frame difference, 32 scalars per iteration, see FrameDifferenceUint8_SSE2
+  IGSIO_TARGET_AVX2 void FrameDifferenceUint8_AVX2(const unsigned char* input1, const unsigned char* input2, size_t numberOfScalars, double changeThreshold,
+      double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars)
+  {
+    const int threshold = GetUint8ChangeThreshold(changeThreshold);
+    const __m256i thresholdVector = _mm256_set1_epi8(static_cast<char>(std::max(threshold, 0)));
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sums = zero;
+    __m256i unchangedTotals = zero;
+    __m256i unchangedCounters = zero;
+    int numberOfCountedBlocks = 0;
+    size_t i = 0;
+    for (; i + 32 <= numberOfScalars; i += 32)
+    {
+      const __m256i scalars1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input1 + i));
+      const __m256i scalars2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input2 + i));
+      sums = _mm256_add_epi64(sums, _mm256_sad_epu8(scalars1, scalars2));
+      const __m256i difference = _mm256_or_si256(_mm256_subs_epu8(scalars1, scalars2), _mm256_subs_epu8(scalars2, scalars1));
+      unchangedCounters = _mm256_sub_epi8(unchangedCounters, _mm256_cmpeq_epi8(_mm256_subs_epu8(difference, thresholdVector), zero));
+      if (++numberOfCountedBlocks == 255)
+      {
+        unchangedTotals = _mm256_add_epi64(unchangedTotals, _mm256_sad_epu8(unchangedCounters, zero));
+        unchangedCounters = zero;
+        numberOfCountedBlocks = 0;
+      }
+    }
+    unchangedTotals = _mm256_add_epi64(unchangedTotals, _mm256_sad_epu8(unchangedCounters, zero));
+
+    unsigned long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sums);
+    sumOfAbsoluteDifferences += static_cast<double>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), unchangedTotals);
+    numberOfChangedScalars += (threshold < 0 ? i : i - (lanes[0] + lanes[1] + lanes[2] + lanes[3]));
+    FrameDifferenceRange<unsigned char>(input1, input2, numberOfScalars, i, changeThreshold, sumOfAbsoluteDifferences, numberOfChangedScalars);
+  }
+
+
+  //----------------------------------------------------------------------------
+  // 8-bit statistics, 32 scalars per iteration, see AccumulateStatisticsUint8_SSE2
+  IGSIO_TARGET_AVX2 void AccumulateStatisticsUint8_AVX2(const unsigned char* input, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+      igsioVideoFrameKernels::StatisticsAccumulator& accumulator)
+  {
+    if (accumulator.Histogram != NULL && accumulator.NumberOfBins > 0)
+    {
+      AccumulateStatisticsByteCounts<unsigned char>(input, numberOfScalarsPerRow, numberOfRows, inputRowStride, accumulator);
+      return;
+    }
+    if (numberOfScalarsPerRow == 0 || numberOfRows == 0)
+    {
+      return;
+    }
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i minimumVector = _mm256_set1_epi8(static_cast<char>(0xFF));
+    __m256i maximumVector = zero;
+    __m256i sums = zero;
+    __m256i squareTotals = zero;
+    unsigned char minimum = 255;
+    unsigned char maximum = 0;
+    long long sum = 0;
+    long long sumOfSquares = 0;
+    for (size_t row = 0; row < numberOfRows; ++row)
+    {
+      const unsigned char* scalars = input + row * inputRowStride;
+      __m256i squareSums = zero;
+      int numberOfSummedBlocks = 0;
+      size_t i = 0;
+      for (; i + 32 <= numberOfScalarsPerRow; i += 32)
+      {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scalars + i));
+        minimumVector = _mm256_min_epu8(minimumVector, values);
+        maximumVector = _mm256_max_epu8(maximumVector, values);
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(values, zero));
+        const __m256i low = _mm256_unpacklo_epi8(values, zero);
+        const __m256i high = _mm256_unpackhi_epi8(values, zero);
+        squareSums = _mm256_add_epi32(squareSums, _mm256_add_epi32(_mm256_madd_epi16(low, low), _mm256_madd_epi16(high, high)));
+        if (++numberOfSummedBlocks == 4096)
+        {
+          squareTotals = _mm256_add_epi64(squareTotals, _mm256_add_epi64(_mm256_unpacklo_epi32(squareSums, zero), _mm256_unpackhi_epi32(squareSums, zero)));
+          squareSums = zero;
+          numberOfSummedBlocks = 0;
+        }
+      }
+      squareTotals = _mm256_add_epi64(squareTotals, _mm256_add_epi64(_mm256_unpacklo_epi32(squareSums, zero), _mm256_unpackhi_epi32(squareSums, zero)));
+      AccumulateMomentsRange<unsigned char>(scalars, numberOfScalarsPerRow, i, minimum, maximum, sum, sumOfSquares);
+    }
+
+    unsigned char lanes8[32];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes8), minimumVector);
+    minimum = std::min(minimum, *std::min_element(lanes8, lanes8 + 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes8), maximumVector);
+    maximum = std::max(maximum, *std::max_element(lanes8, lanes8 + 32));
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sums);
+    sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), squareTotals);
+    sumOfSquares += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    MergeStatistics(accumulator, minimum, maximum, static_cast<double>(sum), static_cast<double>(sumOfSquares),
+                    static_cast<unsigned long long>(numberOfScalarsPerRow) * numberOfRows);
+  }
+
+#endif
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::ReverseGroupsFunctionType igsioVideoFrameKernels::GetReverseGroupsFunction(size_t groupSizeInBytes)
+{
+#if defined(IGSIO_SIMD_X86)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    switch (groupSizeInBytes)
+    {
+      case 1:
+        return &ReverseGroups_AVX2<1>;
+      case 2:
+        return &ReverseGroups_AVX2<2>;
+      case 4:
+        return &ReverseGroups_AVX2<4>;
+      case 8:
+        return &ReverseGroups_AVX2<8>;
+      case 16:
+        return &ReverseGroups_AVX2<16>;
+    }
+  }
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSSE3)
+  {
+    switch (groupSizeInBytes)
+    {
+      case 1:
+        return &ReverseBytes_SSSE3;
+      case 3:
+        return &ReverseGroupsPacked_SSSE3<3>;
+      case 6:
+        return &ReverseGroupsPacked_SSSE3<6>;
+    }
+  }
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    switch (groupSizeInBytes)
+    {
+      case 1:
+        return &ReverseGroups_SSE2<1>;
+      case 2:
+        return &ReverseGroups_SSE2<2>;
+      case 4:
+        return &ReverseGroups_SSE2<4>;
+      case 8:
+        return &ReverseGroups_SSE2<8>;
+      case 16:
+        return &ReverseGroups_SSE2<16>;
+    }
+  }
+#endif
+
+  switch (groupSizeInBytes)
+  {
+    case 1:
+      return &ReverseGroupsScalar<1>;
+    case 2:
+      return &ReverseGroupsScalar<2>;
+    case 3:
+      return &ReverseGroupsScalar<3>;
+    case 4:
+      return &ReverseGroupsScalar<4>;
+    case 6:
+      return &ReverseGroupsScalar<6>;
+    case 8:
+      return &ReverseGroupsScalar<8>;
+    case 12:
+      return &ReverseGroupsScalar<12>;
+    case 16:
+      return &ReverseGroupsScalar<16>;
+    default:
+      return &ReverseGroupsScalarGeneric;
+  }
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameKernels::ReverseGroups(void* output, const void* input, size_t groupCount, size_t groupSizeInBytes)
+{
+  ReverseGroupsFunctionType reverseGroups = GetReverseGroupsFunction(groupSizeInBytes);
+  reverseGroups(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(input), groupCount, groupSizeInBytes);
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::SwapBytesFunctionType igsioVideoFrameKernels::GetSwapBytesFunction(size_t scalarSizeInBytes)
+{
+#if defined(IGSIO_SIMD_X86)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    switch (scalarSizeInBytes)
+    {
+      case 2:
+        return &SwapBytes_AVX2<2>;
+      case 4:
+        return &SwapBytes_AVX2<4>;
+      case 8:
+        return &SwapBytes_AVX2<8>;
+    }
+  }
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSSE3)
+  {
+    switch (scalarSizeInBytes)
+    {
+      case 2:
+        return &SwapBytes_SSSE3<2>;
+      case 4:
+        return &SwapBytes_SSSE3<4>;
+      case 8:
+        return &SwapBytes_SSSE3<8>;
+    }
+  }
+#endif
+
+  switch (scalarSizeInBytes)
+  {
+    case 2:
+      return &SwapBytesScalar<2>;
+    case 4:
+      return &SwapBytesScalar<4>;
+    case 8:
+      return &SwapBytesScalar<8>;
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::SwapBytes(void* output, const void* input, size_t numberOfScalars, size_t scalarSizeInBytes)
+{
+  if (scalarSizeInBytes == 1)
+  {
+    if (output != input)
+    {
+      memcpy(output, input, numberOfScalars);
+    }
+    return true;
+  }
+  SwapBytesFunctionType swapBytes = GetSwapBytesFunction(scalarSizeInBytes);
+  if (swapBytes == NULL)
+  {
+    return false;
+  }
+  swapBytes(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(input), numberOfScalars);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::TransposeFunctionType igsioVideoFrameKernels::GetTransposeFunction(size_t elementSizeInBytes)
+{
+  switch (elementSizeInBytes)
+  {
+    case 1:
+      return &TransposeBlocked<1>;
+    case 2:
+      return &TransposeBlocked<2>;
+    case 3:
+      return &TransposeBlocked<3>;
+    case 4:
+      return &TransposeBlocked<4>;
+    case 6:
+      return &TransposeBlocked<6>;
+    case 8:
+      return &TransposeBlocked<8>;
+    case 12:
+      return &TransposeBlocked<12>;
+    case 16:
+      return &TransposeBlocked<16>;
+    default:
+      return &TransposeBlockedGeneric;
+  }
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameKernels::Transpose(void* output, ptrdiff_t outputRowStride, const void* input, ptrdiff_t inputRowStride,
+                                       size_t numberOfRows, size_t numberOfColumns, size_t elementSizeInBytes)
+{
+  TransposeFunctionType transpose = GetTransposeFunction(elementSizeInBytes);
+  transpose(static_cast<unsigned char*>(output), outputRowStride, static_cast<const unsigned char*>(input), inputRowStride, numberOfRows, numberOfColumns, elementSizeInBytes);
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::DeinterleaveFunctionType igsioVideoFrameKernels::GetDeinterleaveFunction(size_t sampleSizeInBytes)
+{
+#if defined(IGSIO_SIMD_X86)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    switch (sampleSizeInBytes)
+    {
+      case 2:
+        return &Deinterleave_AVX2<2>;
+      case 4:
+        return &Deinterleave_AVX2<4>;
+      case 8:
+        return &Deinterleave_AVX2<8>;
+    }
+  }
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    switch (sampleSizeInBytes)
+    {
+      case 2:
+        return &Deinterleave_SSE2<2>;
+      case 4:
+        return &Deinterleave_SSE2<4>;
+      case 8:
+        return &Deinterleave_SSE2<8>;
+    }
+  }
+#endif
+
+  switch (sampleSizeInBytes)
+  {
+    case 1:
+      return &DeinterleaveScalar<1>;
+    case 2:
+      return &DeinterleaveScalar<2>;
+    case 4:
+      return &DeinterleaveScalar<4>;
+    case 8:
+      return &DeinterleaveScalar<8>;
+    default:
+      return &DeinterleaveScalarGeneric;
+  }
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameKernels::Deinterleave(void* outputFirst, void* outputSecond, const void* input, size_t pairCount, size_t sampleSizeInBytes)
+{
+  DeinterleaveFunctionType deinterleave = GetDeinterleaveFunction(sampleSizeInBytes);
+  deinterleave(static_cast<unsigned char*>(outputFirst), static_cast<unsigned char*>(outputSecond), static_cast<const unsigned char*>(input), pairCount, sampleSizeInBytes);
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::InterleaveFunctionType igsioVideoFrameKernels::GetInterleaveFunction(size_t sampleSizeInBytes)
+{
+#if defined(IGSIO_SIMD_X86)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    switch (sampleSizeInBytes)
+    {
+      case 2:
+        return &Interleave_AVX2<2>;
+      case 4:
+        return &Interleave_AVX2<4>;
+      case 8:
+        return &Interleave_AVX2<8>;
+    }
+  }
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    switch (sampleSizeInBytes)
+    {
+      case 2:
+        return &Interleave_SSE2<2>;
+      case 4:
+        return &Interleave_SSE2<4>;
+      case 8:
+        return &Interleave_SSE2<8>;
+    }
+  }
+#endif
+
+  switch (sampleSizeInBytes)
+  {
+    case 1:
+      return &InterleaveScalar<1>;
+    case 2:
+      return &InterleaveScalar<2>;
+    case 4:
+      return &InterleaveScalar<4>;
+    case 8:
+      return &InterleaveScalar<8>;
+    default:
+      return &InterleaveScalarGeneric;
+  }
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameKernels::Interleave(void* output, const void* inputFirst, const void* inputSecond, size_t pairCount, size_t sampleSizeInBytes)
+{
+  InterleaveFunctionType interleave = GetInterleaveFunction(sampleSizeInBytes);
+  interleave(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(inputFirst), static_cast<const unsigned char*>(inputSecond), pairCount, sampleSizeInBytes);
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::ConvertScalarsFunctionType igsioVideoFrameKernels::GetConvertScalarsFunction(ScalarType inputType, ScalarType outputType)
+{
+#if defined(IGSIO_SIMD_X86)
+  // Vectorized conversions of 16-bit and float data to 8-bit (display) and float (processing)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    if (outputType == SCALAR_TYPE_UINT8)
+    {
+      switch (inputType)
+      {
+        case SCALAR_TYPE_INT16:
+          return &ConvertScalars_AVX2<short, unsigned char>;
+        case SCALAR_TYPE_UINT16:
+          return &ConvertScalars_AVX2<unsigned short, unsigned char>;
+        case SCALAR_TYPE_FLOAT:
+          return &ConvertScalars_AVX2<float, unsigned char>;
+        default:
+          break;
+      }
+    }
+    else if (outputType == SCALAR_TYPE_FLOAT)
+    {
+      switch (inputType)
+      {
+        case SCALAR_TYPE_INT16:
+          return &ConvertScalars_AVX2<short, float>;
+        case SCALAR_TYPE_UINT16:
+          return &ConvertScalars_AVX2<unsigned short, float>;
+        case SCALAR_TYPE_FLOAT:
+          return &ConvertScalars_AVX2<float, float>;
+        default:
+          break;
+      }
+    }
+  }
+  if (instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    if (outputType == SCALAR_TYPE_UINT8)
+    {
+      switch (inputType)
+      {
+        case SCALAR_TYPE_INT16:
+          return &ConvertScalars_SSE2<short, unsigned char>;
+        case SCALAR_TYPE_UINT16:
+          return &ConvertScalars_SSE2<unsigned short, unsigned char>;
+        case SCALAR_TYPE_FLOAT:
+          return &ConvertScalars_SSE2<float, unsigned char>;
+        default:
+          break;
+      }
+    }
+    else if (outputType == SCALAR_TYPE_FLOAT)
+    {
+      switch (inputType)
+      {
+        case SCALAR_TYPE_INT16:
+          return &ConvertScalars_SSE2<short, float>;
+        case SCALAR_TYPE_UINT16:
+          return &ConvertScalars_SSE2<unsigned short, float>;
+        case SCALAR_TYPE_FLOAT:
+          return &ConvertScalars_SSE2<float, float>;
+        default:
+          break;
+      }
+    }
+  }
+#endif
+
+  switch (inputType)
+  {
+    case SCALAR_TYPE_INT8:
+      return GetConvertScalarsScalarFunction<signed char>(outputType);
+    case SCALAR_TYPE_UINT8:
+      return GetConvertScalarsScalarFunction<unsigned char>(outputType);
+    case SCALAR_TYPE_INT16:
+      return GetConvertScalarsScalarFunction<short>(outputType);
+    case SCALAR_TYPE_UINT16:
+      return GetConvertScalarsScalarFunction<unsigned short>(outputType);
+    case SCALAR_TYPE_INT32:
+      return GetConvertScalarsScalarFunction<int>(outputType);
+    case SCALAR_TYPE_UINT32:
+      return GetConvertScalarsScalarFunction<unsigned int>(outputType);
+    case SCALAR_TYPE_FLOAT:
+      return GetConvertScalarsScalarFunction<float>(outputType);
+    case SCALAR_TYPE_DOUBLE:
+      return GetConvertScalarsScalarFunction<double>(outputType);
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::ConvertScalars(void* output, ScalarType outputType, const void* input, ScalarType inputType, size_t count, double scale, double offset)
+{
+  ConvertScalarsFunctionType convertScalars = GetConvertScalarsFunction(inputType, outputType);
+  if (convertScalars == NULL)
+  {
+    return false;
+  }
+  convertScalars(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(input), count, scale, offset);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+size_t igsioVideoFrameKernels::GetYuvBufferSize(YuvFormat format, size_t width, size_t height)
+{
+  const size_t chromaWidth = (width + 1) / 2;
+  switch (format)
+  {
+    case YUV_FORMAT_I420:
+    case YUV_FORMAT_NV12:
+      return width * height + 2 * chromaWidth * ((height + 1) / 2);
+    case YUV_FORMAT_YUY2:
+      return 4 * chromaWidth * height;
+    default:
+      return 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::RgbToYuvFunctionType igsioVideoFrameKernels::GetRgbToYuvFunction(YuvFormat outputFormat)
+{
+#if defined(IGSIO_SIMD_X86)
+  // Packed RGB24 pixels need byte shuffles, there is no SSE2 implementation
+  if (igsioCpuFeatures::GetInstructionSet() >= igsioCpuFeatures::INSTRUCTION_SET_SSSE3)
+  {
+    switch (outputFormat)
+    {
+      case YUV_FORMAT_I420:
+        return &RgbToYuv420<&RgbToYuv420Rows_SSSE3, false>;
+      case YUV_FORMAT_NV12:
+        return &RgbToYuv420<&RgbToYuv420Rows_SSSE3, true>;
+      case YUV_FORMAT_YUY2:
+        return &RgbToYuy2<&RgbToYuy2Row_SSSE3>;
+      default:
+        return NULL;
+    }
+  }
+#endif
+
+  switch (outputFormat)
+  {
+    case YUV_FORMAT_I420:
+      return &RgbToYuv420<&RgbToYuv420RowsScalar, false>;
+    case YUV_FORMAT_NV12:
+      return &RgbToYuv420<&RgbToYuv420RowsScalar, true>;
+    case YUV_FORMAT_YUY2:
+      return &RgbToYuy2<&RgbToYuy2RowScalar>;
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::RgbToYuv(void* output, YuvFormat outputFormat, const void* input, size_t width, size_t height)
+{
+  RgbToYuvFunctionType rgbToYuv = GetRgbToYuvFunction(outputFormat);
+  if (rgbToYuv == NULL)
+  {
+    return false;
+  }
+  rgbToYuv(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(input), width, height);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::YuvToRgbFunctionType igsioVideoFrameKernels::GetYuvToRgbFunction(YuvFormat inputFormat)
+{
+#if defined(IGSIO_SIMD_X86)
+  if (igsioCpuFeatures::GetInstructionSet() >= igsioCpuFeatures::INSTRUCTION_SET_SSSE3)
+  {
+    switch (inputFormat)
+    {
+      case YUV_FORMAT_I420:
+        return &Yuv420ToRgb<&Yuv420ToRgbRows_SSSE3, false>;
+      case YUV_FORMAT_NV12:
+        return &Yuv420ToRgb<&Yuv420ToRgbRows_SSSE3, true>;
+      case YUV_FORMAT_YUY2:
+        return &Yuy2ToRgb<&Yuy2ToRgbRow_SSSE3>;
+      default:
+        return NULL;
+    }
+  }
+#endif
+
+  switch (inputFormat)
+  {
+    case YUV_FORMAT_I420:
+      return &Yuv420ToRgb<&Yuv420ToRgbRowsScalar, false>;
+    case YUV_FORMAT_NV12:
+      return &Yuv420ToRgb<&Yuv420ToRgbRowsScalar, true>;
+    case YUV_FORMAT_YUY2:
+      return &Yuy2ToRgb<&Yuy2ToRgbRowScalar>;
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::YuvToRgb(void* output, const void* input, YuvFormat inputFormat, size_t width, size_t height)
+{
+  YuvToRgbFunctionType yuvToRgb = GetYuvToRgbFunction(inputFormat);
+  if (yuvToRgb == NULL)
+  {
+    return false;
+  }
+  yuvToRgb(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(input), width, height);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::Downsample2xFunctionType igsioVideoFrameKernels::GetDownsample2xFunction(ScalarType scalarType, size_t numberOfComponents)
+{
+#if defined(IGSIO_SIMD_X86)
+  // Single component images (B-mode, RF) are vectorized
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (numberOfComponents == 1 && instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2 && scalarType == SCALAR_TYPE_UINT8)
+  {
+    return &Downsample2xImage<&Downsample2xRowUint8_AVX2, unsigned char>;
+  }
+  if (numberOfComponents == 1 && instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    switch (scalarType)
+    {
+      case SCALAR_TYPE_UINT8:
+        return &Downsample2xImage<&Downsample2xRowUint8_SSE2, unsigned char>;
+      case SCALAR_TYPE_INT16:
+        return &Downsample2xImage<&Downsample2xRow16_SSE2<short>, short>;
+      case SCALAR_TYPE_UINT16:
+        return &Downsample2xImage<&Downsample2xRow16_SSE2<unsigned short>, unsigned short>;
+      case SCALAR_TYPE_FLOAT:
+        return &Downsample2xImage<&Downsample2xRowFloat_SSE2, float>;
+      default:
+        break;
+    }
+  }
+#endif
+
+  switch (scalarType)
+  {
+    case SCALAR_TYPE_INT8:
+      return GetDownsample2xScalarFunction<signed char>();
+    case SCALAR_TYPE_UINT8:
+      return GetDownsample2xScalarFunction<unsigned char>();
+    case SCALAR_TYPE_INT16:
+      return GetDownsample2xScalarFunction<short>();
+    case SCALAR_TYPE_UINT16:
+      return GetDownsample2xScalarFunction<unsigned short>();
+    case SCALAR_TYPE_INT32:
+      return GetDownsample2xScalarFunction<int>();
+    case SCALAR_TYPE_UINT32:
+      return GetDownsample2xScalarFunction<unsigned int>();
+    case SCALAR_TYPE_FLOAT:
+      return GetDownsample2xScalarFunction<float>();
+    case SCALAR_TYPE_DOUBLE:
+      return GetDownsample2xScalarFunction<double>();
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::Downsample2x(void* output, const void* input, ScalarType scalarType, size_t width, size_t height, size_t numberOfComponents)
+{
+  Downsample2xFunctionType downsample2x = GetDownsample2xFunction(scalarType, numberOfComponents);
+  if (downsample2x == NULL)
+  {
+    return false;
+  }
+  downsample2x(static_cast<unsigned char*>(output), static_cast<const unsigned char*>(input), width, height, numberOfComponents);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::FrameDifferenceFunctionType igsioVideoFrameKernels::GetFrameDifferenceFunction(ScalarType scalarType)
+{
+#if defined(IGSIO_SIMD_X86)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (scalarType == SCALAR_TYPE_UINT8 && instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    return &FrameDifferenceUint8_AVX2;
+  }
+  if (scalarType == SCALAR_TYPE_UINT8 && instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    return &FrameDifferenceUint8_SSE2;
+  }
+#endif
+
+  switch (scalarType)
+  {
+    case SCALAR_TYPE_INT8:
+      return &FrameDifferenceScalar<signed char>;
+    case SCALAR_TYPE_UINT8:
+      return &FrameDifferenceScalar<unsigned char>;
+    case SCALAR_TYPE_INT16:
+      return &FrameDifferenceScalar<short>;
+    case SCALAR_TYPE_UINT16:
+      return &FrameDifferenceScalar<unsigned short>;
+    case SCALAR_TYPE_INT32:
+      return &FrameDifferenceScalar<int>;
+    case SCALAR_TYPE_UINT32:
+      return &FrameDifferenceScalar<unsigned int>;
+    case SCALAR_TYPE_FLOAT:
+      return &FrameDifferenceScalar<float>;
+    case SCALAR_TYPE_DOUBLE:
+      return &FrameDifferenceScalar<double>;
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::FrameDifference(const void* input1, const void* input2, ScalarType scalarType, size_t numberOfScalars, double changeThreshold,
+    double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars)
+{
+  FrameDifferenceFunctionType frameDifference = GetFrameDifferenceFunction(scalarType);
+  if (frameDifference == NULL)
+  {
+    return false;
+  }
+  frameDifference(static_cast<const unsigned char*>(input1), static_cast<const unsigned char*>(input2), numberOfScalars, changeThreshold,
+                  sumOfAbsoluteDifferences, numberOfChangedScalars);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameKernels::AccumulateStatisticsFunctionType igsioVideoFrameKernels::GetAccumulateStatisticsFunction(ScalarType scalarType)
+{
+#if defined(IGSIO_SIMD_X86)
+  const igsioCpuFeatures::InstructionSet instructionSet = igsioCpuFeatures::GetInstructionSet();
+  if (scalarType == SCALAR_TYPE_UINT8 && instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_AVX2)
+  {
+    return &AccumulateStatisticsUint8_AVX2;
+  }
+  if (scalarType == SCALAR_TYPE_UINT8 && instructionSet >= igsioCpuFeatures::INSTRUCTION_SET_SSE2)
+  {
+    return &AccumulateStatisticsUint8_SSE2;
+  }
+#endif
+
+  switch (scalarType)
+  {
+    case SCALAR_TYPE_INT8:
+      return &AccumulateStatisticsByteCounts<signed char>;
+    case SCALAR_TYPE_UINT8:
+      return &AccumulateStatisticsByteCounts<unsigned char>;
+    case SCALAR_TYPE_INT16:
+      return &AccumulateStatisticsScalar<short>;
+    case SCALAR_TYPE_UINT16:
+      return &AccumulateStatisticsScalar<unsigned short>;
+    case SCALAR_TYPE_INT32:
+      return &AccumulateStatisticsScalar<int>;
+    case SCALAR_TYPE_UINT32:
+      return &AccumulateStatisticsScalar<unsigned int>;
+    case SCALAR_TYPE_FLOAT:
+      return &AccumulateStatisticsScalar<float>;
+    case SCALAR_TYPE_DOUBLE:
+      return &AccumulateStatisticsScalar<double>;
+    default:
+      return NULL;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameKernels::AccumulateStatistics(const void* input, ScalarType scalarType, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+    StatisticsAccumulator& accumulator)
+{
+  AccumulateStatisticsFunctionType accumulateStatistics = GetAccumulateStatisticsFunction(scalarType);
+  if (accumulateStatistics == NULL)
+  {
+    return false;
+  }
+  accumulateStatistics(static_cast<const unsigned char*>(input), numberOfScalarsPerRow, numberOfRows, inputRowStride, accumulator);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+unsigned long long igsioVideoFrameKernels::Hash64(const void* data, size_t size, unsigned long long seed)
+{
+  const unsigned char* input = static_cast<const unsigned char*>(data);
+  const unsigned char* const inputEnd = input + size;
+  unsigned long long hash;
+
+  if (size >= 32)
+  {
+    unsigned long long lane1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    unsigned long long lane2 = seed + XXH_PRIME64_2;
+    unsigned long long lane3 = seed;
+    unsigned long long lane4 = seed - XXH_PRIME64_1;
+    const unsigned char* const stripesEnd = inputEnd - 32;
+    do
+    {
+      lane1 = Xxh64Round(lane1, ReadUInt64(input));
+      lane2 = Xxh64Round(lane2, ReadUInt64(input + 8));
+      lane3 = Xxh64Round(lane3, ReadUInt64(input + 16));
+      lane4 = Xxh64Round(lane4, ReadUInt64(input + 24));
+      input += 32;
+    }
+    while (input <= stripesEnd);
+
+    hash = RotateLeft64(lane1, 1) + RotateLeft64(lane2, 7) + RotateLeft64(lane3, 12) + RotateLeft64(lane4, 18);
+    hash = Xxh64MergeRound(hash, lane1);
+    hash = Xxh64MergeRound(hash, lane2);
+    hash = Xxh64MergeRound(hash, lane3);
+    hash = Xxh64MergeRound(hash, lane4);
+  }
+  else
+  {
+    hash = seed + XXH_PRIME64_5;
+  }
+  hash += static_cast<unsigned long long>(size);
+
+  // Remaining bytes
+  for (; input + 8 <= inputEnd; input += 8)
+  {
+    hash ^= Xxh64Round(0, ReadUInt64(input));
+    hash = RotateLeft64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+  }
+  if (input + 4 <= inputEnd)
+  {
+    hash ^= ReadUInt32(input) * XXH_PRIME64_1;
+    hash = RotateLeft64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+    input += 4;
+  }
+  for (; input < inputEnd; ++input)
+  {
+    hash ^= (*input) * XXH_PRIME64_5;
+    hash = RotateLeft64(hash, 11) * XXH_PRIME64_1;
+  }
+
+  // Avalanche
+  hash ^= hash >> 33;
+  hash *= XXH_PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= XXH_PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
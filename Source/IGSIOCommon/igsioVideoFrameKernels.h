@@ -0,0 +1,231 @@
+/*=Plus=header=begin======================================================
+  Program: Plus
+  Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+  See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioVideoFrameKernels_h
+#define __igsioVideoFrameKernels_h
+
+#include "vtkigsiocommon_export.h"
+
+#include <cstddef>
+
+/*!
+  \namespace igsioVideoFrameKernels
+  \brief Low-level pixel processing kernels operating on raw buffers
+
+  The kernels do not depend on VTK and do not validate their inputs, they are
+  intended to be called from igsioVideoFrame after the parameters are checked.
+  Vectorized implementations are selected at runtime based on igsioCpuFeatures.
+  \ingroup igsioCommon
+*/
+namespace igsioVideoFrameKernels
+{
+  /*! Scalar types supported by the type conversion kernels */
+  enum ScalarType
+  {
+    SCALAR_TYPE_UNKNOWN,
+    SCALAR_TYPE_INT8,
+    SCALAR_TYPE_UINT8,
+    SCALAR_TYPE_INT16,
+    SCALAR_TYPE_UINT16,
+    SCALAR_TYPE_INT32,
+    SCALAR_TYPE_UINT32,
+    SCALAR_TYPE_FLOAT,
+    SCALAR_TYPE_DOUBLE
+  };
+
+  /*!
+    YUV layouts supported by the color conversion kernels. Chroma is subsampled by 2 horizontally (and vertically
+    for 4:2:0 formats), for odd image sizes the last chroma sample covers the last pixel column or row only.
+  */
+  enum YuvFormat
+  {
+    YUV_FORMAT_UNKNOWN,
+    YUV_FORMAT_I420, // 4:2:0, Y plane followed by the U plane and the V plane
+    YUV_FORMAT_NV12, // 4:2:0, Y plane followed by a plane of interleaved U/V pairs
+    YUV_FORMAT_YUY2  // 4:2:2, Y0 U Y1 V for each pair of pixels in a row
+  };
+
+  /*!
+    Copy a sequence of pixel groups in reverse order: output[i] = input[groupCount - 1 - i].
+    A group is the unit that is kept together while reversing, for example one RGB pixel (3 bytes)
+    or an I/Q pair of 16-bit samples (4 bytes). Input and output buffers must not overlap.
+  */
+  typedef void (*ReverseGroupsFunctionType)(unsigned char* output, const unsigned char* input, size_t groupCount, size_t groupSizeInBytes);
+
+  /*! Get the reverse copy function for a group size, using the currently allowed instruction set */
+  VTKIGSIOCOMMON_EXPORT ReverseGroupsFunctionType GetReverseGroupsFunction(size_t groupSizeInBytes);
+
+  /*! Convenience function, same as calling the function returned by GetReverseGroupsFunction */
+  VTKIGSIOCOMMON_EXPORT void ReverseGroups(void* output, const void* input, size_t groupCount, size_t groupSizeInBytes);
+
+  /*!
+    Reverse the byte order of each scalar, for converting between big-endian and little-endian data.
+    Output may be the same buffer as input (in-place swap), otherwise the buffers must not overlap.
+  */
+  typedef void (*SwapBytesFunctionType)(unsigned char* output, const unsigned char* input, size_t numberOfScalars);
+
+  /*! Get the byte swap function for a scalar size (2, 4 or 8 bytes) using the currently allowed instruction set, NULL if the size is not supported */
+  VTKIGSIOCOMMON_EXPORT SwapBytesFunctionType GetSwapBytesFunction(size_t scalarSizeInBytes);
+
+  /*! Convenience function, same as calling the function returned by GetSwapBytesFunction. 1-byte scalars are copied. Returns false if the size is not supported. */
+  VTKIGSIOCOMMON_EXPORT bool SwapBytes(void* output, const void* input, size_t numberOfScalars, size_t scalarSizeInBytes);
+
+  /*!
+    Transpose a 2D array of elements: output[column][row] = input[row][column].
+    Strides are the distance between the first bytes of consecutive rows, in bytes. An element is typically
+    one pixel (all scalar components). The array is processed in tiles that fit into the L1 cache, so that
+    neither the reads nor the writes are done with a large stride. Input and output buffers must not overlap.
+  */
+  typedef void (*TransposeFunctionType)(unsigned char* output, ptrdiff_t outputRowStride, const unsigned char* input, ptrdiff_t inputRowStride,
+                                        size_t numberOfRows, size_t numberOfColumns, size_t elementSizeInBytes);
+
+  /*! Get the transpose function specialized for an element size */
+  VTKIGSIOCOMMON_EXPORT TransposeFunctionType GetTransposeFunction(size_t elementSizeInBytes);
+
+  /*! Convenience function, same as calling the function returned by GetTransposeFunction */
+  VTKIGSIOCOMMON_EXPORT void Transpose(void* output, ptrdiff_t outputRowStride, const void* input, ptrdiff_t inputRowStride,
+                                       size_t numberOfRows, size_t numberOfColumns, size_t elementSizeInBytes);
+
+  /*!
+    Split pairs of interleaved samples into two planar arrays: outputFirst[i] = input[2i], outputSecond[i] = input[2i+1].
+    Used for converting RF lines of interleaved I/Q samples into separate I and Q lines. A sample is one scalar
+    (for example 2 bytes for 16-bit integer and 4 bytes for float RF data). Output buffers must not overlap with the input.
+  */
+  typedef void (*DeinterleaveFunctionType)(unsigned char* outputFirst, unsigned char* outputSecond, const unsigned char* input,
+      size_t pairCount, size_t sampleSizeInBytes);
+
+  /*! Get the deinterleave function for a sample size, using the currently allowed instruction set */
+  VTKIGSIOCOMMON_EXPORT DeinterleaveFunctionType GetDeinterleaveFunction(size_t sampleSizeInBytes);
+
+  /*! Convenience function, same as calling the function returned by GetDeinterleaveFunction */
+  VTKIGSIOCOMMON_EXPORT void Deinterleave(void* outputFirst, void* outputSecond, const void* input, size_t pairCount, size_t sampleSizeInBytes);
+
+  /*!
+    Merge two planar arrays into pairs of interleaved samples: output[2i] = inputFirst[i], output[2i+1] = inputSecond[i].
+    Inverse of Deinterleave. The output buffer must not overlap with the inputs.
+  */
+  typedef void (*InterleaveFunctionType)(unsigned char* output, const unsigned char* inputFirst, const unsigned char* inputSecond,
+                                         size_t pairCount, size_t sampleSizeInBytes);
+
+  /*! Get the interleave function for a sample size, using the currently allowed instruction set */
+  VTKIGSIOCOMMON_EXPORT InterleaveFunctionType GetInterleaveFunction(size_t sampleSizeInBytes);
+
+  /*! Convenience function, same as calling the function returned by GetInterleaveFunction */
+  VTKIGSIOCOMMON_EXPORT void Interleave(void* output, const void* inputFirst, const void* inputSecond, size_t pairCount, size_t sampleSizeInBytes);
+
+  /*!
+    Convert scalars to another type: output[i] = input[i] * scale + offset. Integer outputs are rounded to
+    the nearest integer and saturated to the range of the output type (NaN is converted to the minimum).
+    The computation is done in single precision if both types are at most 16-bit integers or float, in double precision otherwise.
+    Input and output buffers must not overlap.
+  */
+  typedef void (*ConvertScalarsFunctionType)(unsigned char* output, const unsigned char* input, size_t count, double scale, double offset);
+
+  /*! Get the conversion function for a pair of scalar types using the currently allowed instruction set, NULL if a type is unknown */
+  VTKIGSIOCOMMON_EXPORT ConvertScalarsFunctionType GetConvertScalarsFunction(ScalarType inputType, ScalarType outputType);
+
+  /*! Convenience function, same as calling the function returned by GetConvertScalarsFunction. Returns false if a type is unknown. */
+  VTKIGSIOCOMMON_EXPORT bool ConvertScalars(void* output, ScalarType outputType, const void* input, ScalarType inputType, size_t count, double scale, double offset);
+
+  /*! Get the size of a width x height image in a YUV format, in bytes. Returns 0 if the format is unknown. */
+  VTKIGSIOCOMMON_EXPORT size_t GetYuvBufferSize(YuvFormat format, size_t width, size_t height);
+
+  /*!
+    Convert a packed RGB24 image (3 bytes per pixel, rows without padding) to YUV, using the ITU-R BT.601
+    coefficients with limited range (Y in [16, 235]), as most video codecs and players expect.
+    Chroma is computed from the average color of the pixels that share the chroma sample.
+    The output buffer must be GetYuvBufferSize bytes and must not overlap with the input.
+  */
+  typedef void (*RgbToYuvFunctionType)(unsigned char* output, const unsigned char* input, size_t width, size_t height);
+
+  /*! Get the RGB24 to YUV conversion function for a format using the currently allowed instruction set, NULL if the format is unknown */
+  VTKIGSIOCOMMON_EXPORT RgbToYuvFunctionType GetRgbToYuvFunction(YuvFormat outputFormat);
+
+  /*! Convenience function, same as calling the function returned by GetRgbToYuvFunction. Returns false if the format is unknown. */
+  VTKIGSIOCOMMON_EXPORT bool RgbToYuv(void* output, YuvFormat outputFormat, const void* input, size_t width, size_t height);
+
+  /*!
+    Convert a YUV image to packed RGB24, inverse of RgbToYuv. Chroma samples are replicated to all
+    pixels that share them. The output buffer must be width * height * 3 bytes and must not overlap with the input.
+  */
+  typedef void (*YuvToRgbFunctionType)(unsigned char* output, const unsigned char* input, size_t width, size_t height);
+
+  /*! Get the YUV to RGB24 conversion function for a format using the currently allowed instruction set, NULL if the format is unknown */
+  VTKIGSIOCOMMON_EXPORT YuvToRgbFunctionType GetYuvToRgbFunction(YuvFormat inputFormat);
+
+  /*! Convenience function, same as calling the function returned by GetYuvToRgbFunction. Returns false if the format is unknown. */
+  VTKIGSIOCOMMON_EXPORT bool YuvToRgb(void* output, const void* input, YuvFormat inputFormat, size_t width, size_t height);
+
+  /*!
+    Downsample an image by 2 in both directions by averaging 2x2 pixel blocks (box filter, which is the same as bilinear
+    interpolation at the block centers). The output is (width + 1) / 2 x (height + 1) / 2 pixels, for odd sizes the last
+    column or row is averaged with itself. Integer results are rounded half up. Rows are packed without padding.
+    Input and output buffers must not overlap.
+  */
+  typedef void (*Downsample2xFunctionType)(unsigned char* output, const unsigned char* input, size_t width, size_t height, size_t numberOfComponents);
+
+  /*! Get the downsampling function for a scalar type using the currently allowed instruction set, NULL if the type is unknown */
+  VTKIGSIOCOMMON_EXPORT Downsample2xFunctionType GetDownsample2xFunction(ScalarType scalarType, size_t numberOfComponents);
+
+  /*! Convenience function, same as calling the function returned by GetDownsample2xFunction. Returns false if the type is unknown. */
+  VTKIGSIOCOMMON_EXPORT bool Downsample2x(void* output, const void* input, ScalarType scalarType, size_t width, size_t height, size_t numberOfComponents);
+
+  /*!
+    Compare two buffers of numberOfScalars scalars. The sum of absolute differences is added to sumOfAbsoluteDifferences and
+    the number of scalars whose absolute difference is larger than changeThreshold is added to numberOfChangedScalars,
+    so the metrics of several rows (e.g. of a region of interest) can be accumulated.
+  */
+  typedef void (*FrameDifferenceFunctionType)(const unsigned char* input1, const unsigned char* input2, size_t numberOfScalars, double changeThreshold,
+      double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars);
+
+  /*! Get the frame difference function for a scalar type using the currently allowed instruction set, NULL if the type is unknown */
+  VTKIGSIOCOMMON_EXPORT FrameDifferenceFunctionType GetFrameDifferenceFunction(ScalarType scalarType);
+
+  /*! Convenience function, same as calling the function returned by GetFrameDifferenceFunction. Returns false if the type is unknown. */
+  VTKIGSIOCOMMON_EXPORT bool FrameDifference(const void* input1, const void* input2, ScalarType scalarType, size_t numberOfScalars, double changeThreshold,
+      double& sumOfAbsoluteDifferences, unsigned long long& numberOfChangedScalars);
+
+  /*!
+    Statistics of scalar values accumulated by the statistics kernels. The histogram counters are only updated
+    if Histogram is not NULL, values below HistogramMinimum are counted in the first bin and values at or above
+    HistogramMaximum are counted in the last bin.
+  */
+  struct StatisticsAccumulator
+  {
+    StatisticsAccumulator() : Minimum(0.0), Maximum(0.0), Sum(0.0), SumOfSquares(0.0), NumberOfScalars(0), Histogram(NULL), NumberOfBins(0), HistogramMinimum(0.0), HistogramMaximum(0.0) {}
+    double Minimum; // only valid if NumberOfScalars > 0
+    double Maximum; // only valid if NumberOfScalars > 0
+    double Sum;
+    double SumOfSquares;
+    unsigned long long NumberOfScalars;
+    unsigned long long* Histogram; // NumberOfBins counters, the bins divide [HistogramMinimum, HistogramMaximum) into equal parts
+    unsigned int NumberOfBins;
+    double HistogramMinimum;
+    double HistogramMaximum; // must be larger than HistogramMinimum if the histogram is computed
+  };
+
+  /*!
+    Add numberOfRows rows of numberOfScalarsPerRow scalars to the statistics in a single pass.
+    Consecutive rows start inputRowStride bytes apart, so regions of interest can be processed without copying.
+  */
+  typedef void (*AccumulateStatisticsFunctionType)(const unsigned char* input, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+      StatisticsAccumulator& accumulator);
+
+  /*! Get the statistics function for a scalar type using the currently allowed instruction set, NULL if the type is unknown */
+  VTKIGSIOCOMMON_EXPORT AccumulateStatisticsFunctionType GetAccumulateStatisticsFunction(ScalarType scalarType);
+
+  /*! Convenience function, same as calling the function returned by GetAccumulateStatisticsFunction. Returns false if the type is unknown. */
+  VTKIGSIOCOMMON_EXPORT bool AccumulateStatistics(const void* input, ScalarType scalarType, size_t numberOfScalarsPerRow, size_t numberOfRows, ptrdiff_t inputRowStride,
+      StatisticsAccumulator& accumulator);
+
+  /*!
+    Compute the 64-bit xxHash (XXH64) digest of a buffer. The result does not depend on the instruction set,
+    so it can be stored in files and compared on other computers. Words are read in little-endian byte order.
+  */
+  VTKIGSIOCOMMON_EXPORT unsigned long long Hash64(const void* data, size_t size, unsigned long long seed = 0);
+}
+
+#endif
@@ -0,0 +1,293 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioVideoFrameView.h"
+#include "igsioVideoFrameKernels.h"
+
+// STL includes
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+igsioVideoFrameView::igsioVideoFrameView()
+{
+  this->Reset();
+}
+
+//----------------------------------------------------------------------------
+igsioVideoFrameView::~igsioVideoFrameView()
+{
+}
+
+//----------------------------------------------------------------------------
+void igsioVideoFrameView::Reset()
+{
+  this->InputImage = NULL;
+  this->InputPixels = NULL;
+  this->InputFrameSize.fill(0);
+  this->InputRowStride = 0;
+  this->InputSliceStride = 0;
+  this->FlipInfo = igsioVideoFrame::FlipInfoType();
+  this->ClipRectangleOrigin.fill(igsioCommon::NO_CLIP);
+  this->ClipRectangleSize.fill(igsioCommon::NO_CLIP);
+  this->PixelType = VTK_VOID;
+  this->NumberOfScalarComponents = 0;
+  this->PixelSizeInBytes = 0;
+  this->FrameSize.fill(0);
+  this->FirstPixel = NULL;
+  this->Increments[0] = 0;
+  this->Increments[1] = 0;
+  this->Increments[2] = 0;
+  this->IndexXor[0] = 0;
+  this->IndexXor[1] = 0;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrameView::SetInput(const unsigned char* inputPixels,
+    const FrameSizeType& inputFrameSizeInPx,
+    vtkIdType inputRowStride,
+    vtkIdType inputSliceStride,
+    igsioCommon::VTKScalarPixelType pixelType,
+    unsigned int numberOfScalarComponents,
+    const igsioVideoFrame::FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize)
+{
+  this->Reset();
+
+  if (inputPixels == NULL)
+  {
+    LOG_ERROR("Failed to create oriented view - input buffer is null!");
+    return IGSIO_FAIL;
+  }
+  const int scalarSize = igsioVideoFrame::GetNumberOfBytesPerScalar(pixelType);
+  if (scalarSize <= 0 || numberOfScalarComponents == 0)
+  {
+    LOG_ERROR("Failed to create oriented view - invalid pixel type (" << pixelType << ") or number of components (" << numberOfScalarComponents << ")");
+    return IGSIO_FAIL;
+  }
+  if (flipInfo.tranpose != igsioVideoFrame::TRANSPOSE_NONE)
+  {
+    if (flipInfo.hFlip || flipInfo.vFlip || flipInfo.eFlip)
+    {
+      LOG_ERROR("Failed to create oriented view - transposition cannot be combined with flipping");
+      return IGSIO_FAIL;
+    }
+    if (flipInfo.doubleRow || flipInfo.doubleColumn)
+    {
+      LOG_ERROR("Failed to create oriented view - transposition of images with pairs of rows or columns kept together is not supported");
+      return IGSIO_FAIL;
+    }
+  }
+
+  const int inputDimensions[3] = {static_cast<int>(inputFrameSizeInPx[0]), static_cast<int>(inputFrameSizeInPx[1]), std::max(1, static_cast<int>(inputFrameSizeInPx[2]))};
+  std::array<int, 3> finalClipOrigin = {0, 0, 0};
+  std::array<int, 3> finalClipSize = {inputDimensions[0], inputDimensions[1], inputDimensions[2]};
+  if (igsioCommon::IsClippingRequested(clipRectangleOrigin, clipRectangleSize))
+  {
+    int inExtents[6] = {0, inputDimensions[0] - 1, 0, inputDimensions[1] - 1, 0, inputDimensions[2] - 1};
+    if (!igsioCommon::IsClippingWithinExtents(clipRectangleOrigin, clipRectangleSize, inExtents))
+    {
+      LOG_WARNING("Clipping information cannot fit within the original image. No clipping will be performed. Origin=[" << clipRectangleOrigin[0] << "," << clipRectangleOrigin[1] << "," << clipRectangleOrigin[2] <<
+                  "]. Size=[" << clipRectangleSize[0] << "," << clipRectangleSize[1] << "," << clipRectangleSize[2] << "].");
+    }
+    else
+    {
+      finalClipOrigin = clipRectangleOrigin;
+      finalClipSize = clipRectangleSize;
+    }
+  }
+
+  // Pairs of columns or rows are swapped by XOR-ing the index, which requires an even number of pixels along the axis
+  const unsigned int columnXor = (flipInfo.doubleColumn && flipInfo.hFlip ? 1 : 0);
+  const unsigned int rowXor = (flipInfo.doubleRow && flipInfo.vFlip != flipInfo.hFlip ? 1 : 0);
+  if ((columnXor && finalClipSize[0] % 2 != 0) || (rowXor && finalClipSize[1] % 2 != 0))
+  {
+    LOG_ERROR("Failed to create oriented view - cannot keep pairs of " << (columnXor ? "columns" : "rows") << " together, as their number is odd");
+    return IGSIO_FAIL;
+  }
+
+  const vtkIdType pixelSizeInBytes = scalarSize * numberOfScalarComponents;
+  const vtkIdType rowStride = (inputRowStride != 0 ? inputRowStride : inputDimensions[0] * pixelSizeInBytes);
+  const vtkIdType sliceStride = (inputSliceStride != 0 ? inputSliceStride : inputDimensions[1] * rowStride);
+
+  this->FirstPixel = inputPixels + finalClipOrigin[2] * sliceStride + finalClipOrigin[1] * rowStride + finalClipOrigin[0] * pixelSizeInBytes;
+  if (flipInfo.tranpose == igsioVideoFrame::TRANSPOSE_IJKtoKIJ)
+  {
+    // X,Y,Z -> Z,X,Y
+    this->FrameSize[0] = finalClipSize[2];
+    this->FrameSize[1] = finalClipSize[0];
+    this->FrameSize[2] = finalClipSize[1];
+    this->Increments[0] = sliceStride;
+    this->Increments[1] = pixelSizeInBytes;
+    this->Increments[2] = rowStride;
+  }
+  else
+  {
+    const bool flipAxes[3] = {flipInfo.hFlip, flipInfo.vFlip, flipInfo.eFlip};
+    this->Increments[0] = pixelSizeInBytes;
+    this->Increments[1] = rowStride;
+    this->Increments[2] = sliceStride;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      this->FrameSize[axis] = finalClipSize[axis];
+      if (flipAxes[axis])
+      {
+        // Start from the last pixel along the axis and step backward
+        this->FirstPixel += (finalClipSize[axis] - 1) * this->Increments[axis];
+        this->Increments[axis] = -this->Increments[axis];
+      }
+    }
+  }
+  this->IndexXor[0] = columnXor;
+  this->IndexXor[1] = rowXor;
+
+  this->InputPixels = inputPixels;
+  this->InputFrameSize = inputFrameSizeInPx;
+  this->InputRowStride = rowStride;
+  this->InputSliceStride = sliceStride;
+  this->FlipInfo = flipInfo;
+  this->ClipRectangleOrigin = finalClipOrigin;
+  this->ClipRectangleSize = finalClipSize;
+  this->PixelType = pixelType;
+  this->NumberOfScalarComponents = numberOfScalarComponents;
+  this->PixelSizeInBytes = static_cast<int>(pixelSizeInBytes);
+
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrameView::SetInput(vtkImageData* inputImage,
+    const igsioVideoFrame::FlipInfoType& flipInfo,
+    const std::array<int, 3>& clipRectangleOrigin,
+    const std::array<int, 3>& clipRectangleSize)
+{
+  if (inputImage == NULL)
+  {
+    this->Reset();
+    LOG_ERROR("Failed to create oriented view - input image is null!");
+    return IGSIO_FAIL;
+  }
+
+  int dimensions[3] = {0, 0, 0};
+  inputImage->GetDimensions(dimensions);
+  FrameSizeType inputFrameSizeInPx = {static_cast<unsigned int>(dimensions[0]), static_cast<unsigned int>(dimensions[1]), static_cast<unsigned int>(dimensions[2])};
+
+  // vtkImageData increments are in scalars
+  vtkIdType increments[3] = {0, 0, 0};
+  inputImage->GetIncrements(increments);
+  const int scalarSize = inputImage->GetScalarSize();
+
+  if (this->SetInput(static_cast<const unsigned char*>(inputImage->GetScalarPointer()), inputFrameSizeInPx, increments[1] * scalarSize, increments[2] * scalarSize,
+                     inputImage->GetScalarType(), inputImage->GetNumberOfScalarComponents(), flipInfo, clipRectangleOrigin, clipRectangleSize) != IGSIO_SUCCESS)
+  {
+    return IGSIO_FAIL;
+  }
+  this->InputImage = inputImage;
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+bool igsioVideoFrameView::IsContiguous() const
+{
+  return this->IsStrided()
+         && this->Increments[0] == this->PixelSizeInBytes
+         && this->Increments[1] == this->FrameSize[0] * this->Increments[0]
+         && (this->FrameSize[2] == 1 || this->Increments[2] == this->FrameSize[1] * this->Increments[1]);
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrameView::CopyRow(unsigned int y, unsigned int z, unsigned char* outputPixels) const
+{
+  if (!this->IsValid() || outputPixels == NULL)
+  {
+    LOG_ERROR("Failed to copy row of oriented view - " << (outputPixels == NULL ? "output buffer is null" : "view is not set up"));
+    return IGSIO_FAIL;
+  }
+  if (y >= this->FrameSize[1] || z >= this->FrameSize[2])
+  {
+    LOG_ERROR("Failed to copy row of oriented view - row " << y << " of slice " << z << " is out of range");
+    return IGSIO_FAIL;
+  }
+
+  const unsigned int width = this->FrameSize[0];
+  const unsigned char* rowFirstPixel = this->GetPixelPointer(0, y, z) - this->IndexXor[0] * this->Increments[0];
+  if (this->Increments[0] == this->PixelSizeInBytes)
+  {
+    memcpy(outputPixels, rowFirstPixel, width * this->PixelSizeInBytes);
+  }
+  else if (this->Increments[0] == -this->PixelSizeInBytes)
+  {
+    // Horizontally flipped row, reverse from the lowest address, keeping pairs of pixels together if needed
+    const size_t pixelsPerGroup = this->IndexXor[0] + 1;
+    igsioVideoFrameKernels::ReverseGroups(outputPixels, rowFirstPixel + (width - 1) * this->Increments[0], width / pixelsPerGroup, pixelsPerGroup * this->PixelSizeInBytes);
+  }
+  else
+  {
+    // Transposed view, pixels of a row are not adjacent in memory
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      memcpy(outputPixels + x * this->PixelSizeInBytes, this->GetPixelPointer(x, y, z), this->PixelSizeInBytes);
+    }
+  }
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrameView::CopyTo(unsigned char* outputPixels, vtkIdType outputRowStride, vtkIdType outputSliceStride) const
+{
+  if (!this->IsValid())
+  {
+    LOG_ERROR("Failed to copy oriented view - view is not set up");
+    return IGSIO_FAIL;
+  }
+  return igsioVideoFrame::FlipClipImage(this->InputPixels, this->InputFrameSize, this->InputRowStride, this->InputSliceStride,
+                                        this->PixelType, this->NumberOfScalarComponents, this->FlipInfo, this->ClipRectangleOrigin, this->ClipRectangleSize,
+                                        outputPixels, outputRowStride, outputSliceStride);
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrameView::CopyTo(vtkImageData* outputImage) const
+{
+  if (!this->IsValid() || outputImage == NULL)
+  {
+    LOG_ERROR("Failed to copy oriented view - " << (outputImage == NULL ? "output image is null" : "view is not set up"));
+    return IGSIO_FAIL;
+  }
+  if (outputImage == this->InputImage.GetPointer())
+  {
+    LOG_ERROR("Failed to copy oriented view - the output image is the input of the view");
+    return IGSIO_FAIL;
+  }
+  if (igsioVideoFrame::AllocateFrame(outputImage, this->FrameSize, this->PixelType, this->NumberOfScalarComponents) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to allocate output image for oriented view");
+    return IGSIO_FAIL;
+  }
+  return this->CopyTo(static_cast<unsigned char*>(outputImage->GetScalarPointer()), 0, 0);
+}
+
+//----------------------------------------------------------------------------
+igsioStatus igsioVideoFrameView::CopyTo(igsioVideoFrame& outputFrame) const
+{
+  if (outputFrame.GetConstImage() != NULL && outputFrame.GetConstImage() == this->InputImage.GetPointer())
+  {
+    LOG_ERROR("Failed to copy oriented view - the output frame is the input of the view");
+    return IGSIO_FAIL;
+  }
+  if (!this->IsValid())
+  {
+    LOG_ERROR("Failed to copy oriented view - view is not set up");
+    return IGSIO_FAIL;
+  }
+  if (outputFrame.AllocateFrame(this->FrameSize, this->PixelType, this->NumberOfScalarComponents) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to allocate output frame for oriented view");
+    return IGSIO_FAIL;
+  }
+  return this->CopyTo(static_cast<unsigned char*>(outputFrame.GetScalarPointer()), 0, 0);
+}
@@ -0,0 +1,149 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioVideoFrameView_h
+#define __igsioVideoFrameView_h
+
+#include "vtkigsiocommon_export.h"
+#include "igsioCommon.h"
+#include "igsioVideoFrame.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+/*!
+\class igsioVideoFrameView
+\brief Reoriented and clipped view of an image buffer, without copying the pixels
+
+The view records the flip, clip and transpose operations of an igsioVideoFrame::FlipInfoType
+as a start address and signed increments over the existing pixel buffer. Pixels can be read
+in the reoriented coordinate system directly from the source buffer, which is useful for consumers
+that only need a region of interest or compute statistics on the image. A contiguous reoriented copy
+is only made when CopyTo is called.
+
+The view does not copy the pixels, therefore the source buffer must not be modified or
+released while the view is used. If the view is created from a vtkImageData object then
+a reference to the image is kept by the view.
+
+Transposition combined with keeping pairs of rows or columns together is not supported by views,
+use igsioVideoFrame::FlipClipImage in that case.
+\ingroup igsioCommon
+*/
+class VTKIGSIOCOMMON_EXPORT igsioVideoFrameView
+{
+public:
+  /*! Constructor, creates an empty view */
+  igsioVideoFrameView();
+
+  /*! Destructor */
+  virtual ~igsioVideoFrameView();
+
+  /*!
+  Set up the view over an image stored in a memory buffer.
+  \param inputPixels first pixel of the input image
+  \param inputFrameSizeInPx size of the input image
+  \param inputRowStride distance between the first bytes of consecutive input rows, 0 if rows are tightly packed
+  \param inputSliceStride distance between the first bytes of consecutive input slices, 0 if slices are tightly packed
+  \param clipRectangleOrigin the clipping origin relative to the input image origin
+  \param clipRectangleSize the size of the clipping space, a value of NO_CLIP in either [0],[1] or [2] indicates no clipping performed
+  */
+  igsioStatus SetInput(const unsigned char* inputPixels,
+                       const FrameSizeType& inputFrameSizeInPx,
+                       vtkIdType inputRowStride,
+                       vtkIdType inputSliceStride,
+                       igsioCommon::VTKScalarPixelType pixelType,
+                       unsigned int numberOfScalarComponents,
+                       const igsioVideoFrame::FlipInfoType& flipInfo,
+                       const std::array<int, 3>& clipRectangleOrigin,
+                       const std::array<int, 3>& clipRectangleSize);
+
+  /*! Set up the view over an image. A reference to the image is kept until the view is reset or set up again. */
+  igsioStatus SetInput(vtkImageData* inputImage,
+                       const igsioVideoFrame::FlipInfoType& flipInfo,
+                       const std::array<int, 3>& clipRectangleOrigin,
+                       const std::array<int, 3>& clipRectangleSize);
+
+  /*! Release the input and make the view empty */
+  void Reset();
+
+  /*! Return true if the view is set up */
+  bool IsValid() const { return this->InputPixels != NULL; }
+
+  /*! Get the dimensions of the reoriented and clipped image in pixels */
+  FrameSizeType GetFrameSize() const { return this->FrameSize; }
+
+  /*! Return the pixel type using VTK enums */
+  igsioCommon::VTKScalarPixelType GetVTKScalarPixelType() const { return this->PixelType; }
+
+  /*! Return the number of scalar components of a pixel */
+  unsigned int GetNumberOfScalarComponents() const { return this->NumberOfScalarComponents; }
+
+  /*! Get the size of a pixel in bytes */
+  int GetNumberOfBytesPerPixel() const { return this->PixelSizeInBytes; }
+
+  /*!
+  Return true if pixels of the view can be addressed by the increments returned by GetIncrements.
+  This is not the case if pairs of rows or columns are kept together while flipping.
+  */
+  bool IsStrided() const { return this->IndexXor[0] == 0 && this->IndexXor[1] == 0; }
+
+  /*! Return true if the pixels of the view are stored in the same order as in a tightly packed image */
+  bool IsContiguous() const;
+
+  /*!
+  Get the distance in bytes between neighbor pixels along the x, y and z axes of the view.
+  Increments may be negative. Only meaningful if IsStrided() returns true.
+  */
+  const vtkIdType* GetIncrements() const { return this->Increments; }
+
+  /*! Get the pointer to the first scalar of a pixel, coordinates are in the reoriented and clipped image */
+  const unsigned char* GetPixelPointer(unsigned int x, unsigned int y, unsigned int z) const
+  {
+    return this->FirstPixel + (x ^ this->IndexXor[0]) * this->Increments[0] + (y ^ this->IndexXor[1]) * this->Increments[1] + z * this->Increments[2];
+  }
+
+  /*! Copy one row of the view into a tightly packed buffer of GetFrameSize()[0] pixels */
+  igsioStatus CopyRow(unsigned int y, unsigned int z, unsigned char* outputPixels) const;
+
+  /*!
+  Copy the reoriented and clipped image into a memory buffer.
+  \param outputRowStride distance between the first bytes of consecutive output rows, 0 if rows are tightly packed
+  \param outputSliceStride distance between the first bytes of consecutive output slices, 0 if slices are tightly packed
+  */
+  igsioStatus CopyTo(unsigned char* outputPixels, vtkIdType outputRowStride, vtkIdType outputSliceStride) const;
+
+  /*! Copy the reoriented and clipped image into a contiguous image, the image is reallocated if needed */
+  igsioStatus CopyTo(vtkImageData* outputImage) const;
+
+  /*! Copy the reoriented and clipped image into a video frame, the frame is reallocated if needed */
+  igsioStatus CopyTo(igsioVideoFrame& outputFrame) const;
+
+protected:
+  /*! Keeps the input image alive if the view is created from a vtkImageData */
+  vtkSmartPointer<vtkImageData> InputImage;
+
+  // Input description, needed for making a copy
+  const unsigned char* InputPixels;
+  FrameSizeType InputFrameSize;
+  vtkIdType InputRowStride;
+  vtkIdType InputSliceStride;
+  igsioVideoFrame::FlipInfoType FlipInfo;
+  std::array<int, 3> ClipRectangleOrigin;
+  std::array<int, 3> ClipRectangleSize;
+
+  // View description
+  igsioCommon::VTKScalarPixelType PixelType;
+  unsigned int NumberOfScalarComponents;
+  int PixelSizeInBytes;
+  FrameSizeType FrameSize;
+  const unsigned char* FirstPixel;
+  vtkIdType Increments[3];
+  /*! 1 along axes where pairs of pixels are kept together while flipping, the index is XOR-ed with it */
+  unsigned int IndexXor[2];
+};
+
+#endif
@@ -0,0 +1,329 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+// Local includes
+#include "igsioXmlTagReader.h"
+
+// STL includes
+#include <cstdlib>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+igsioXmlTagReader::igsioXmlTagReader(const char* xml)
+  : Position(xml != NULL ? xml : "")
+  , NumberOfAttributes(0)
+  , EndTag(false)
+  , EmptyElement(false)
+  , Error(false)
+{
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::ReadNextTag()
+{
+  if (this->Error)
+  {
+    return false;
+  }
+  while (true)
+  {
+    const char* tagStart = strchr(this->Position, '<');
+    if (tagStart == NULL)
+    {
+      // Only character data is left
+      return false;
+    }
+    this->Position = tagStart + 1;
+    if (strncmp(this->Position, "!--", 3) == 0)
+    {
+      if (!this->SkipPast("-->"))
+      {
+        return this->SetError();
+      }
+    }
+    else if (strncmp(this->Position, "![CDATA[", 8) == 0)
+    {
+      if (!this->SkipPast("]]>"))
+      {
+        return this->SetError();
+      }
+    }
+    else if (*this->Position == '?')
+    {
+      if (!this->SkipPast("?>"))
+      {
+        return this->SetError();
+      }
+    }
+    else if (*this->Position == '!')
+    {
+      if (!this->SkipDeclaration())
+      {
+        return this->SetError();
+      }
+    }
+    else
+    {
+      return this->ReadTag();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+const char* igsioXmlTagReader::GetAttribute(const char* attributeName) const
+{
+  for (size_t i = 0; i < this->NumberOfAttributes; ++i)
+  {
+    if (this->Attributes[i].first == attributeName)
+    {
+      return this->Attributes[i].second.c_str();
+    }
+  }
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::SetError()
+{
+  this->Error = true;
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::SkipPast(const char* terminator)
+{
+  const char* end = strstr(this->Position, terminator);
+  if (end == NULL)
+  {
+    return false;
+  }
+  this->Position = end + strlen(terminator);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::SkipDeclaration()
+{
+  int bracketDepth = 0;
+  for (; *this->Position != 0; ++this->Position)
+  {
+    if (*this->Position == '[')
+    {
+      ++bracketDepth;
+    }
+    else if (*this->Position == ']')
+    {
+      --bracketDepth;
+    }
+    else if (*this->Position == '>' && bracketDepth <= 0)
+    {
+      ++this->Position;
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void igsioXmlTagReader::SkipWhitespace()
+{
+  while (*this->Position == ' ' || *this->Position == '\t' || *this->Position == '\r' || *this->Position == '\n')
+  {
+    ++this->Position;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::ReadXmlName(std::string& name)
+{
+  const char* start = this->Position;
+  while (*this->Position != 0 && strchr(" \t\r\n/>=<\"'", *this->Position) == NULL)
+  {
+    ++this->Position;
+  }
+  if (this->Position == start)
+  {
+    return false;
+  }
+  name.assign(start, this->Position - start);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::ReadTag()
+{
+  this->EndTag = (*this->Position == '/');
+  if (this->EndTag)
+  {
+    ++this->Position;
+  }
+  this->EmptyElement = false;
+  this->NumberOfAttributes = 0;
+  if (!this->ReadXmlName(this->Name))
+  {
+    return this->SetError();
+  }
+
+  while (true)
+  {
+    this->SkipWhitespace();
+    if (*this->Position == '>')
+    {
+      ++this->Position;
+      return true;
+    }
+    if (!this->EndTag && this->Position[0] == '/' && this->Position[1] == '>')
+    {
+      this->EmptyElement = true;
+      this->Position += 2;
+      return true;
+    }
+    if (this->EndTag)
+    {
+      // End tags cannot have attributes
+      return this->SetError();
+    }
+
+    if (this->NumberOfAttributes == this->Attributes.size())
+    {
+      this->Attributes.push_back(std::pair<std::string, std::string>());
+    }
+    std::pair<std::string, std::string>& attribute = this->Attributes[this->NumberOfAttributes++];
+    if (!this->ReadXmlName(attribute.first))
+    {
+      return this->SetError();
+    }
+    this->SkipWhitespace();
+    if (*this->Position != '=')
+    {
+      return this->SetError();
+    }
+    ++this->Position;
+    this->SkipWhitespace();
+    const char quote = *this->Position;
+    if ((quote != '"' && quote != '\'') || !this->ReadAttributeValue(quote, attribute.second))
+    {
+      return this->SetError();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::ReadAttributeValue(char quote, std::string& value)
+{
+  value.clear();
+  for (++this->Position; *this->Position != quote; ++this->Position)
+  {
+    switch (*this->Position)
+    {
+      case 0:
+      case '<':
+        return false;
+      case '&':
+        if (!this->ReadReference(value))
+        {
+          return false;
+        }
+        break;
+      case '\r':
+        // Line breaks are normalized to a single space, as in any XML parser
+        if (this->Position[1] != '\n')
+        {
+          value.push_back(' ');
+        }
+        break;
+      case '\n':
+      case '\t':
+        value.push_back(' ');
+        break;
+      default:
+        value.push_back(*this->Position);
+    }
+  }
+  ++this->Position;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::ReadReference(std::string& value)
+{
+  const char* end = strchr(this->Position, ';');
+  if (end == NULL)
+  {
+    return false;
+  }
+  const char* reference = this->Position + 1;
+  const size_t referenceLength = end - reference;
+  if (referenceLength == 3 && strncmp(reference, "amp", 3) == 0)
+  {
+    value.push_back('&');
+  }
+  else if (referenceLength == 2 && strncmp(reference, "lt", 2) == 0)
+  {
+    value.push_back('<');
+  }
+  else if (referenceLength == 2 && strncmp(reference, "gt", 2) == 0)
+  {
+    value.push_back('>');
+  }
+  else if (referenceLength == 4 && strncmp(reference, "quot", 4) == 0)
+  {
+    value.push_back('"');
+  }
+  else if (referenceLength == 4 && strncmp(reference, "apos", 4) == 0)
+  {
+    value.push_back('\'');
+  }
+  else if (referenceLength > 1 && reference[0] == '#')
+  {
+    const bool isHexadecimal = (reference[1] == 'x');
+    const char* digits = reference + (isHexadecimal ? 2 : 1);
+    char* digitsEnd = NULL;
+    const unsigned long code = strtoul(digits, &digitsEnd, isHexadecimal ? 16 : 10);
+    if (digitsEnd != end || digits == end || !AppendUtf8(value, code))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    return false;
+  }
+  this->Position = end;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool igsioXmlTagReader::AppendUtf8(std::string& value, unsigned long code)
+{
+  if (code == 0 || code > 0x10FFFF)
+  {
+    return false;
+  }
+  if (code < 0x80)
+  {
+    value.push_back(static_cast<char>(code));
+  }
+  else if (code < 0x800)
+  {
+    value.push_back(static_cast<char>(0xC0 | (code >> 6)));
+    value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  else if (code < 0x10000)
+  {
+    value.push_back(static_cast<char>(0xE0 | (code >> 12)));
+    value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  else
+  {
+    value.push_back(static_cast<char>(0xF0 | (code >> 18)));
+    value.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+    value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  return true;
+}
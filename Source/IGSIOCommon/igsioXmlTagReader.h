@@ -0,0 +1,75 @@
+/*=Plus=header=begin======================================================
+Program: Plus
+Copyright (c) Laboratory for Percutaneous Surgery. All rights reserved.
+See License.txt for details.
+=========================================================Plus=header=end*/
+
+#ifndef __igsioXmlTagReader_h
+#define __igsioXmlTagReader_h
+
+#include "vtkigsiocommon_export.h"
+
+// STL includes
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+\class igsioXmlTagReader
+\brief Minimal single-pass XML reader
+
+Tags are read one by one, without building a document tree, which is sufficient for small documents with a
+known schema (e.g., the XML representation of a tracked frame). Comments, processing instructions, declarations,
+CDATA sections and character data are skipped. Attribute values are decoded (predefined entities, character
+references, whitespace normalization). Buffers of the element name and attributes are reused between tags.
+
+The reader does not check that start and end tags match, this is left to the caller.
+The input string must remain valid while the reader is used.
+\ingroup igsioCommon
+*/
+class VTKIGSIOCOMMON_EXPORT igsioXmlTagReader
+{
+public:
+  /*! Constructor, xml is a zero-terminated string */
+  igsioXmlTagReader(const char* xml);
+
+  /*! Read the next start or end tag. Returns false at the end of the input or if the XML is invalid (see HasError) */
+  bool ReadNextTag();
+
+  /*! Get the element name of the current tag */
+  const std::string& GetName() const { return this->Name; }
+  /*! Return true if the current tag is an end tag (</Name>) */
+  bool IsEndTag() const { return this->EndTag; }
+  /*! Return true if the current tag is an empty element tag (<Name/>) */
+  bool IsEmptyElement() const { return this->EmptyElement; }
+  /*! Return true if reading stopped because the XML is invalid or truncated */
+  bool HasError() const { return this->Error; }
+
+  /*! Get the value of an attribute of the current tag (case sensitive), NULL if not found */
+  const char* GetAttribute(const char* attributeName) const;
+
+protected:
+  bool SetError();
+  bool SkipPast(const char* terminator);
+  /*! Skip <!DOCTYPE ...> and similar declarations, which may contain an internal subset in brackets */
+  bool SkipDeclaration();
+  void SkipWhitespace();
+  bool ReadXmlName(std::string& name);
+  /*! Read a start or end tag, called with Position at the character after '<' */
+  bool ReadTag();
+  /*! Read a quoted attribute value, called with Position at the opening quote */
+  bool ReadAttributeValue(char quote, std::string& value);
+  /*! Decode an entity or character reference. Position is at '&' and is left at ';'. */
+  bool ReadReference(std::string& value);
+  static bool AppendUtf8(std::string& value, unsigned long code);
+
+  const char* Position;
+  std::string Name;
+  std::vector<std::pair<std::string, std::string> > Attributes;
+  size_t NumberOfAttributes;
+  bool EndTag;
+  bool EmptyElement;
+  bool Error;
+};
+
+#endif
@@ -20,6 +20,7 @@
 // STD includes
 #include <algorithm>
 #include <math.h>
+#include <utility>
 
 //----------------------------------------------------------------------------
 // ************************* vtkIGSIOTrackedFrameList *****************************
@@ -35,8 +36,10 @@ vtkIGSIOTrackedFrameList::vtkIGSIOTrackedFrameList()
   this->MinRequiredAngleDifferenceDeg = 0.0;
   this->MaxAllowedTranslationSpeedMmPerSec = 0.0;
   this->MaxAllowedRotationSpeedDegPerSec = 0.0;
+  this->ImageChangeThreshold = 0.0;
+  this->MinRequiredChangedImageRatio = 0.0;
   this->ValidationRequirements = 0;
-
+  this->ThumbnailLevel = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -179,6 +182,12 @@ igsioStatus vtkIGSIOTrackedFrameList::AddTrackedFrame(igsioTrackedFrame* tracked
   return IGSIO_SUCCESS;
 }
 
+//----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::AddTrackedFrame(igsioTrackedFrame&& trackedFrame, InvalidFrameAction action /*=ADD_INVALID_FRAME_AND_REPORT_ERROR*/)
+{
+  return this->TakeTrackedFrame(new igsioTrackedFrame(std::move(trackedFrame)), action);
+}
+
 //----------------------------------------------------------------------------
 igsioStatus vtkIGSIOTrackedFrameList::TakeTrackedFrame(igsioTrackedFrame* trackedFrame, InvalidFrameAction action /*=ADD_INVALID_FRAME_AND_REPORT_ERROR*/)
 {
@@ -269,6 +278,15 @@ bool vtkIGSIOTrackedFrameList::ValidateData(igsioTrackedFrame* trackedFrame)
     }
   }
 
+  if (this->ValidationRequirements & REQUIRE_CHANGED_IMAGE)
+  {
+    if (! this->ValidateImage(trackedFrame))
+    {
+      LOG_DEBUG("Validation failed - image is not changed");
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -349,6 +367,54 @@ bool vtkIGSIOTrackedFrameList::ValidateStatus(igsioTrackedFrame* trackedFrame)
   return isValid;
 }
 
+//----------------------------------------------------------------------------
+bool vtkIGSIOTrackedFrameList::ValidateImage(igsioTrackedFrame* trackedFrame)
+{
+  if (this->TrackedFrameList.size() < 1)
+  {
+    return true;
+  }
+
+  igsioTrackedFrame* latestFrameInList = this->TrackedFrameList.back();
+  igsioVideoFrame* image = trackedFrame->GetImageData();
+  igsioVideoFrame* latestImage = latestFrameInList->GetImageData();
+  if (!image->IsImageValid() || !latestImage->IsImageValid())
+  {
+    // Frames without image data are validated by the other requirements
+    return true;
+  }
+
+  // Identical stored hashes mean identical images, the pixels don't have to be compared
+  if (this->ImageChangeThreshold == 0.0 && this->MinRequiredChangedImageRatio == 0.0
+      && trackedFrame->IsFrameFieldDefined(igsioTrackedFrame::FIELD_IMAGE_HASH) && latestFrameInList->IsFrameFieldDefined(igsioTrackedFrame::FIELD_IMAGE_HASH))
+  {
+    return std::string(trackedFrame->GetFrameField(igsioTrackedFrame::FIELD_IMAGE_HASH)) != latestFrameInList->GetFrameField(igsioTrackedFrame::FIELD_IMAGE_HASH);
+  }
+
+  FrameSizeType frameSize = {0, 0, 0};
+  FrameSizeType latestFrameSize = {0, 0, 0};
+  image->GetFrameSize(frameSize);
+  latestImage->GetFrameSize(latestFrameSize);
+  unsigned int numberOfScalarComponents(1);
+  unsigned int latestNumberOfScalarComponents(1);
+  image->GetNumberOfScalarComponents(numberOfScalarComponents);
+  latestImage->GetNumberOfScalarComponents(latestNumberOfScalarComponents);
+  if (frameSize != latestFrameSize || image->GetVTKScalarPixelType() != latestImage->GetVTKScalarPixelType()
+      || numberOfScalarComponents != latestNumberOfScalarComponents)
+  {
+    // Different image geometry is a change
+    return true;
+  }
+
+  igsioVideoFrame::FrameDifferenceType difference;
+  if (igsioVideoFrame::ComputeFrameDifference(*image, *latestImage, this->ImageChangeThreshold, difference) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Unable to compare the image to the image of the previous frame");
+    return true;
+  }
+  return difference.ChangedScalarRatio > this->MinRequiredChangedImageRatio;
+}
+
 //----------------------------------------------------------------------------
 bool vtkIGSIOTrackedFrameList::ValidateSpeed(igsioTrackedFrame* trackedFrame)
 {
@@ -474,6 +540,142 @@ igsioCommon::VTKScalarPixelType vtkIGSIOTrackedFrameList::GetPixelType()
   return VTK_VOID;
 }
 
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::ConvertPixelType(igsioCommon::VTKScalarPixelType outputPixelType, double scale, double offset)
+{
+  std::vector<igsioVideoFrame*> frames;
+  frames.reserve(this->GetNumberOfTrackedFrames());
+  for (unsigned int i = 0; i < this->GetNumberOfTrackedFrames(); ++i)
+  {
+    igsioVideoFrame* videoFrame = this->GetTrackedFrame(i)->GetImageData();
+    if (videoFrame->GetConstImage() != NULL && videoFrame->IsImageValid())
+    {
+      frames.push_back(videoFrame);
+    }
+  }
+  return igsioVideoFrame::ConvertPixelTypes(frames, outputPixelType, scale, offset);
+}
+
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::ConvertPixelTypeWindowLevel(double window, double level)
+{
+  if (window <= 0)
+  {
+    LOG_ERROR("Failed to convert pixel type - window must be positive, got " << window);
+    return IGSIO_FAIL;
+  }
+  const double scale = 255.0 / window;
+  return this->ConvertPixelType(VTK_UNSIGNED_CHAR, scale, -(level - window / 2.0) * scale);
+}
+
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::CreateThumbnails(unsigned int level)
+{
+  igsioStatus status = IGSIO_SUCCESS;
+  for (unsigned int i = 0; i < this->GetNumberOfTrackedFrames(); ++i)
+  {
+    igsioTrackedFrame* trackedFrame = this->GetTrackedFrame(i);
+    igsioVideoFrame* videoFrame = trackedFrame->GetImageData();
+    if (videoFrame->GetConstImage() == NULL || !videoFrame->IsImageValid())
+    {
+      continue;
+    }
+    igsioVideoFrame thumbnail;
+    if (igsioVideoFrame::Downsample(*videoFrame, thumbnail, level) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to create thumbnail for frame " << i);
+      status = IGSIO_FAIL;
+      continue;
+    }
+    trackedFrame->SetThumbnail(std::move(thumbnail));
+  }
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::ComputeImageStatistics(std::vector<igsioVideoFrame::ImageStatisticsType>& statistics,
+    unsigned int numberOfBins, double histogramMinimum, double histogramMaximum)
+{
+  const std::array<int, 3> noClip = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+  return this->ComputeImageStatistics(statistics, noClip, noClip, numberOfBins, histogramMinimum, histogramMaximum);
+}
+
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::ComputeImageStatistics(std::vector<igsioVideoFrame::ImageStatisticsType>& statistics,
+    const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize,
+    unsigned int numberOfBins, double histogramMinimum, double histogramMaximum)
+{
+  statistics.assign(this->GetNumberOfTrackedFrames(), igsioVideoFrame::ImageStatisticsType());
+
+  std::vector<const igsioVideoFrame*> frames;
+  std::vector<unsigned int> frameIndices;
+  frames.reserve(this->GetNumberOfTrackedFrames());
+  frameIndices.reserve(this->GetNumberOfTrackedFrames());
+  for (unsigned int i = 0; i < this->GetNumberOfTrackedFrames(); ++i)
+  {
+    const igsioVideoFrame* videoFrame = this->GetTrackedFrame(i)->GetImageData();
+    if (videoFrame->GetConstImage() != NULL && videoFrame->IsImageValid())
+    {
+      frames.push_back(videoFrame);
+      frameIndices.push_back(i);
+    }
+  }
+
+  std::vector<igsioVideoFrame::ImageStatisticsType> frameStatistics;
+  const igsioStatus status = igsioVideoFrame::ComputeFramesStatistics(frames, frameStatistics, regionOrigin, regionSize, numberOfBins, histogramMinimum, histogramMaximum);
+  for (size_t i = 0; i < frameStatistics.size(); ++i)
+  {
+    statistics[frameIndices[i]] = std::move(frameStatistics[i]);
+  }
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::UpdateImageHashes()
+{
+  igsioStatus status = IGSIO_SUCCESS;
+  for (unsigned int i = 0; i < this->GetNumberOfTrackedFrames(); ++i)
+  {
+    igsioTrackedFrame* trackedFrame = this->GetTrackedFrame(i);
+    if (!trackedFrame->GetImageData()->IsImageValid())
+    {
+      continue;
+    }
+    if (trackedFrame->UpdateImageHashField() != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to compute image hash of frame " << i);
+      status = IGSIO_FAIL;
+    }
+  }
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+igsioStatus vtkIGSIOTrackedFrameList::VerifyImageHashes()
+{
+  int numberOfMismatches = 0;
+  for (unsigned int i = 0; i < this->GetNumberOfTrackedFrames(); ++i)
+  {
+    igsioTrackedFrame* trackedFrame = this->GetTrackedFrame(i);
+    const char* storedHashString = trackedFrame->GetFrameField(igsioTrackedFrame::FIELD_IMAGE_HASH);
+    if (storedHashString == NULL)
+    {
+      continue;
+    }
+    unsigned long long storedHash(0);
+    unsigned long long actualHash(0);
+    if (igsioVideoFrame::GetHashFromString(storedHashString, storedHash) != IGSIO_SUCCESS
+        || !trackedFrame->GetImageData()->IsImageValid()
+        || trackedFrame->GetImageData()->ComputeHash(actualHash) != IGSIO_SUCCESS
+        || actualHash != storedHash)
+    {
+      LOG_ERROR("Image data of frame " << i << " does not match its hash (stored: " << storedHashString << ", actual: " << igsioVideoFrame::GetHashAsString(actualHash) << ")");
+      numberOfMismatches++;
+    }
+  }
+  return (numberOfMismatches == 0 ? IGSIO_SUCCESS : IGSIO_FAIL);
+}
+
 //-----------------------------------------------------------------------------
 int vtkIGSIOTrackedFrameList::GetNumberOfScalarComponents()
 {
@@ -487,7 +689,7 @@ int vtkIGSIOTrackedFrameList::GetNumberOfScalarComponents()
   {
     if (this->GetTrackedFrame(i)->GetImageData()->IsImageValid())
     {
-      return this->GetTrackedFrame(i)->GetImageData()->GetImage()->GetNumberOfScalarComponents();
+      return this->GetTrackedFrame(i)->GetImageData()->GetConstImage()->GetNumberOfScalarComponents();
     }
   }
 
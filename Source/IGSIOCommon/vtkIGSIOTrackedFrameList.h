@@ -57,6 +57,9 @@ public:
   /*! Add tracked frame to container. If the frame is invalid then it may not actually add it to the list. */
   virtual igsioStatus AddTrackedFrame(igsioTrackedFrame* trackedFrame, InvalidFrameAction action = ADD_INVALID_FRAME_AND_REPORT_ERROR);
 
+  /*! Add tracked frame to container by moving its content into the list, without copying the pixels. If the frame is invalid then it may not actually add it to the list. */
+  virtual igsioStatus AddTrackedFrame(igsioTrackedFrame&& trackedFrame, InvalidFrameAction action = ADD_INVALID_FRAME_AND_REPORT_ERROR);
+
   /*! Add tracked frame to container by taking ownership of the passed pointer. If the frame is invalid then it may not actually add it to the list (it will be deleted immediately). */
   virtual igsioStatus TakeTrackedFrame(igsioTrackedFrame* trackedFrame, InvalidFrameAction action = ADD_INVALID_FRAME_AND_REPORT_ERROR);
 
@@ -127,6 +130,18 @@ public:
   /*! Get the maximum allowed rotation speed in degree/sec */
   vtkGetMacro(MaxAllowedRotationSpeedDegPerSec, double);
 
+  /*! Set the absolute difference above which a pixel component is considered changed (REQUIRE_CHANGED_IMAGE validation) */
+  vtkSetMacro(ImageChangeThreshold, double);
+
+  /*! Get the absolute difference above which a pixel component is considered changed */
+  vtkGetMacro(ImageChangeThreshold, double);
+
+  /*! Set the fraction of changed pixel components that is required for a new frame to be valid (REQUIRE_CHANGED_IMAGE validation) */
+  vtkSetMacro(MinRequiredChangedImageRatio, double);
+
+  /*! Get the fraction of changed pixel components that is required for a new frame to be valid */
+  vtkGetMacro(MinRequiredChangedImageRatio, double);
+
   /*! Set validation requirements
   \sa TrackedFrameValidationRequirements
   */
@@ -158,6 +173,45 @@ public:
   /*! Get tracked frame pixel type */
   igsioCommon::VTKScalarPixelType GetPixelType();
 
+  /*!
+    Convert the pixels of all valid frames to another scalar type in place: output = input * scale + offset.
+    Frames are converted in parallel, see igsioVideoFrame::ConvertPixelTypes.
+  */
+  igsioStatus ConvertPixelType(igsioCommon::VTKScalarPixelType outputPixelType, double scale = 1.0, double offset = 0.0);
+
+  /*! Convert the pixels of all valid frames to unsigned char, mapping the [level - window/2, level + window/2] range to [0, 255] */
+  igsioStatus ConvertPixelTypeWindowLevel(double window, double level);
+
+  /*!
+    Attach a thumbnail to all frames that have valid image data, downsampled by 2^level (see igsioVideoFrame::Downsample).
+    Existing thumbnails are replaced.
+  */
+  igsioStatus CreateThumbnails(unsigned int level);
+
+  /*!
+    Compute the pixel value statistics of all frames in parallel, see igsioVideoFrame::ComputeStatistics.
+    statistics[i] belongs to frame i, the statistics of frames without valid image data are empty (NumberOfScalars is 0).
+  */
+  igsioStatus ComputeImageStatistics(std::vector<igsioVideoFrame::ImageStatisticsType>& statistics,
+                                     unsigned int numberOfBins = 0, double histogramMinimum = 0.0, double histogramMaximum = 0.0);
+
+  /*! Compute the pixel value statistics of all frames within a region of interest, see ComputeImageStatistics */
+  igsioStatus ComputeImageStatistics(std::vector<igsioVideoFrame::ImageStatisticsType>& statistics,
+                                     const std::array<int, 3>& regionOrigin, const std::array<int, 3>& regionSize,
+                                     unsigned int numberOfBins = 0, double histogramMinimum = 0.0, double histogramMaximum = 0.0);
+
+  /*! Compute the image hash of all frames that have valid image data and store it in their image hash field (see igsioTrackedFrame::UpdateImageHashField) */
+  igsioStatus UpdateImageHashes();
+
+  /*! Check that the image data of all frames that have an image hash field matches the stored hash. Mismatching frames are logged. */
+  igsioStatus VerifyImageHashes();
+
+  /*! Set the downsampling level of the thumbnails created when the list is read from file. 0 (default) disables thumbnail creation. */
+  vtkSetMacro(ThumbnailLevel, unsigned int);
+
+  /*! Get the downsampling level of the thumbnails created when the list is read from file */
+  vtkGetMacro(ThumbnailLevel, unsigned int);
+
   /*! Get number of components */
   int GetNumberOfScalarComponents();
 
@@ -246,6 +300,7 @@ protected:
   bool ValidateStatus(igsioTrackedFrame* trackedFrame);
   bool ValidateEncoderPosition(igsioTrackedFrame* trackedFrame);
   bool ValidateSpeed(igsioTrackedFrame* trackedFrame);
+  bool ValidateImage(igsioTrackedFrame* trackedFrame);
 
   TrackedFrameListType TrackedFrameList;
   FieldMapType CustomFields;
@@ -260,10 +315,16 @@ protected:
   double MaxAllowedTranslationSpeedMmPerSec;
   /*! Validation threshold value */
   double MaxAllowedRotationSpeedDegPerSec;
+  /*! Validation threshold value */
+  double ImageChangeThreshold;
+  /*! Validation threshold value */
+  double MinRequiredChangedImageRatio;
 
   long ValidationRequirements;
   igsioTransformName FrameTransformNameForValidation;
 
+  unsigned int ThumbnailLevel;
+
 private:
   vtkIGSIOTrackedFrameList(const vtkIGSIOTrackedFrameList&);
   void operator=(const vtkIGSIOTrackedFrameList&);
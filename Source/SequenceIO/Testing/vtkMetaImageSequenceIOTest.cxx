@@ -236,6 +236,7 @@ int main(int argc, char** argv)
   writerImageStatus->SetFileName(outputImageSequenceFileName.c_str());
   writerImageStatus->SetTrackedFrameList(dummyTrackedFrame);
   writerImageStatus->UseCompressionOn();
+  writerImageStatus->WriteImageHashesOn();
 
   if (writerImageStatus->Write() != IGSIO_SUCCESS)
   {
@@ -264,6 +265,46 @@ int main(int argc, char** argv)
     return EXIT_FAILURE;
   }
 
+  // Image hashes are written for the frames that have image data and checked when reading
+  if (!trackedFrameListImageStatus->GetTrackedFrame(0)->IsFrameFieldDefined(igsioTrackedFrame::FIELD_IMAGE_HASH)
+      || trackedFrameListImageStatus->GetTrackedFrame(1)->IsFrameFieldDefined(igsioTrackedFrame::FIELD_IMAGE_HASH)
+      || trackedFrameListImageStatus->VerifyImageHashes() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Image hash read/write failed!");
+    numberOfFailures++;
+  }
+
+  // Test writing a transform status without the transform
+  vtkSmartPointer<vtkIGSIOTrackedFrameList> statusOnlyTrackedFrameList = vtkSmartPointer<vtkIGSIOTrackedFrameList>::New();
+  igsioTrackedFrame statusOnlyFrame(validFrame);
+  statusOnlyFrame.SetFrameTransformStatus(igsioTransformName("StatusOnly", "Tracker"), TOOL_MISSING);
+  statusOnlyTrackedFrameList->AddTrackedFrame(&statusOnlyFrame);
+
+  vtkSmartPointer<vtkIGSIOMetaImageSequenceIO> writerStatusOnly = vtkSmartPointer<vtkIGSIOMetaImageSequenceIO>::New();
+  writerStatusOnly->SetFileName(outputImageSequenceFileName.c_str());
+  writerStatusOnly->SetTrackedFrameList(statusOnlyTrackedFrameList);
+  if (writerStatusOnly->Write() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Couldn't write sequence metafile with a transform status only: " << outputImageSequenceFileName);
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkIGSIOMetaImageSequenceIO> readerStatusOnly = vtkSmartPointer<vtkIGSIOMetaImageSequenceIO>::New();
+  readerStatusOnly->SetFileName(outputImageSequenceFileName.c_str());
+  if (readerStatusOnly->Read() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Couldn't read sequence metafile: " << outputImageSequenceFileName);
+    return EXIT_FAILURE;
+  }
+  ToolStatus readStatus(TOOL_OK);
+  if (readerStatusOnly->GetTrackedFrameList()->GetNumberOfTrackedFrames() != 1
+      || readerStatusOnly->GetTrackedFrameList()->GetTrackedFrame(0)->GetFrameTransformStatus(igsioTransformName("StatusOnly", "Tracker"), readStatus) != IGSIO_SUCCESS
+      || readStatus != TOOL_MISSING)
+  {
+    LOG_ERROR("Transform status read/write failed!");
+    numberOfFailures++;
+  }
+
   // Test metafile writting with different sized images
   igsioTrackedFrame differentSizeFrame;
   FrameSizeType frameSizeSmaller = {150, 150, 1};
@@ -22,6 +22,7 @@ See License.txt for details.
 #include "vtkObjectFactory.h"
 #include "vtkIGSIOTrackedFrameList.h"
 #include "igsioTrackedFrame.h"
+#include "igsioVideoFrameKernels.h"
 
 namespace
 {
@@ -162,7 +163,12 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::ReadImageHeader()
         LOG_WARNING("Parsing line failed, cannot get frame number from frame field (" << lineStr << ")");
         continue;
       }
-      SetFrameString(frameNumber, frameFieldName.c_str(), value.c_str());
+      if (SetFrameString(frameNumber, frameFieldName.c_str(), value.c_str()) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to set frame field " << frameFieldName << " of frame " << frameNumber << " in file " << this->FileName);
+        fclose(stream);
+        return IGSIO_FAIL;
+      }
 
       if (ferror(stream))
       {
@@ -282,6 +288,19 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::ReadImageHeader()
       SetUseCompression(false);
     }
 
+    // MetaIO accepts any of these equivalent fields, big-endian files are written by older acquisition systems
+    this->IsPixelDataBigEndian = false;
+    const char* byteOrderFieldNames[] = { "BinaryDataByteOrderMSB", "ElementByteOrderMSB", "ByteOrderMSB" };
+    for (unsigned int i = 0; i < sizeof(byteOrderFieldNames) / sizeof(byteOrderFieldNames[0]); ++i)
+    {
+      const char* byteOrderFieldValue = this->TrackedFrameList->GetCustomString(byteOrderFieldNames[i]);
+      if (byteOrderFieldValue != NULL)
+      {
+        this->IsPixelDataBigEndian = (STRCASECMP(byteOrderFieldValue, "true") == 0);
+        break;
+      }
+    }
+
     if (this->TrackedFrameList->GetCustomString("ElementNumberOfChannels") != NULL)
     {
       // this field is optional
@@ -401,8 +420,32 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::ReadImagePixels()
 
   }
 
+  // Orientation and clipping are the same for all frames
+  FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
+  std::array<int, 3> clipRectOrigin = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+  std::array<int, 3> clipRectSize = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+
+  igsioVideoFrame::FlipInfoType flipInfo;
+  if (igsioVideoFrame::GetFlipAxes(this->ImageOrientationInFile, this->ImageType, this->ImageOrientationInMemory, flipInfo) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to convert image data to the requested orientation, from " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInFile) <<
+              " to " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInMemory));
+    return IGSIO_FAIL;
+  }
+
+  // If the orientation is the same in the file and in memory then uncompressed pixels are read directly into the frames
+  const bool isReorientationNeeded = flipInfo.hFlip || flipInfo.vFlip || flipInfo.eFlip || flipInfo.tranpose != igsioVideoFrame::TRANSPOSE_NONE
+                                     || igsioCommon::IsClippingRequested(clipRectOrigin, clipRectSize);
+
+  // Big-endian scalars are swapped while they are copied to the frame, or in place if the pixels are read directly into the frame
+  const unsigned int scalarSizeInBytes = igsioVideoFrame::GetNumberOfBytesPerScalar(this->PixelType);
+  const bool isByteSwapNeeded = this->IsPixelDataByteSwapNeeded() && scalarSizeInBytes > 1;
+
   std::vector<unsigned char> pixelBuffer;
-  pixelBuffer.resize(frameSizeInBytes);
+  if (isReorientationNeeded && !this->UseCompression)
+  {
+    pixelBuffer.resize(frameSizeInBytes);
+  }
   for (int frameNumber = 0; frameNumber < frameCount; frameNumber++)
   {
     CreateTrackedFrameIfNonExisting(frameNumber);
@@ -429,51 +472,48 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::ReadImagePixels()
     trackedFrame->GetImageData()->SetImageOrientation(this->ImageOrientationInMemory);
     trackedFrame->GetImageData()->SetImageType(this->ImageType);
 
-    FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
-    if (trackedFrame->GetImageData()->AllocateFrame(frameSize, this->PixelType, this->NumberOfScalarComponents) != IGSIO_SUCCESS)
+    // The frame is allocated with the size of the oriented image, the pixels are written into it directly
+    FrameSizeType orientedFrameSize = igsioVideoFrame::GetFlipClipOutputSize(frameSize, flipInfo, clipRectOrigin, clipRectSize);
+    if (trackedFrame->GetImageData()->AllocateFrame(orientedFrameSize, this->PixelType, this->NumberOfScalarComponents) != IGSIO_SUCCESS)
     {
       LOG_ERROR("Cannot allocate memory for frame " << frameNumber);
       numberOfErrors++;
       continue;
     }
 
-    std::array<int, 3> clipRectOrigin = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
-    std::array<int, 3> clipRectSize = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
-
-    igsioVideoFrame::FlipInfoType flipInfo;
-    if (igsioVideoFrame::GetFlipAxes(this->ImageOrientationInFile, this->ImageType, this->ImageOrientationInMemory, flipInfo) != IGSIO_SUCCESS)
-    {
-      LOG_ERROR("Failed to convert image data to the requested orientation, from " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInFile) <<
-                " to " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInMemory));
-      return IGSIO_FAIL;
-    }
-
+    const unsigned char* framePixels = NULL;
     if (!this->UseCompression)
     {
       FilePositionOffsetType offset = PixelDataFileOffset + frameNumber * frameSizeInBytes;
+      unsigned char* readBuffer = (isReorientationNeeded ? &(pixelBuffer[0]) : static_cast<unsigned char*>(trackedFrame->GetImageData()->GetScalarPointer()));
       FSEEK(stream, offset, SEEK_SET);
-      if (fread(&(pixelBuffer[0]), 1, frameSizeInBytes, stream) != frameSizeInBytes)
+      if (fread(readBuffer, 1, frameSizeInBytes, stream) != frameSizeInBytes)
       {
         LOG_ERROR("Could not read " << frameSizeInBytes << " bytes from " << GetPixelDataFilePath());
         numberOfErrors++;
       }
-      FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
-      if (igsioVideoFrame::GetOrientedClippedImage(&(pixelBuffer[0]), flipInfo, this->ImageType, this->PixelType, this->NumberOfScalarComponents, frameSize, *trackedFrame->GetImageData(), clipRectOrigin, clipRectSize) != IGSIO_SUCCESS)
+      if (!isReorientationNeeded)
       {
-        LOG_ERROR("Failed to get oriented image from sequence metafile (frame number: " << frameNumber << ")!");
-        numberOfErrors++;
+        if (isByteSwapNeeded && !igsioVideoFrameKernels::SwapBytes(readBuffer, readBuffer, frameSizeInBytes / scalarSizeInBytes, scalarSizeInBytes))
+        {
+          LOG_ERROR("Cannot swap the byte order of " << scalarSizeInBytes << "-byte scalars in frame " << frameNumber);
+          numberOfErrors++;
+        }
         continue;
       }
+      framePixels = readBuffer;
     }
     else
     {
-      FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
-      if (igsioVideoFrame::GetOrientedClippedImage(&(allFramesPixelBuffer[0]) + frameNumber * frameSizeInBytes, flipInfo, this->ImageType, this->PixelType, this->NumberOfScalarComponents, frameSize, *trackedFrame->GetImageData(), clipRectOrigin, clipRectSize) != IGSIO_SUCCESS)
-      {
-        LOG_ERROR("Failed to get oriented image from sequence metafile (frame number: " << frameNumber << ")!");
-        numberOfErrors++;
-        continue;
-      }
+      framePixels = &(allFramesPixelBuffer[0]) + frameNumber * frameSizeInBytes;
+    }
+
+    if (igsioVideoFrame::FlipClipImage(framePixels, frameSize, 0, 0, this->PixelType, this->NumberOfScalarComponents, flipInfo, clipRectOrigin, clipRectSize,
+                                       static_cast<unsigned char*>(trackedFrame->GetImageData()->GetScalarPointer()), 0, 0, isByteSwapNeeded) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to get oriented image from sequence metafile (frame number: " << frameNumber << ")!");
+      numberOfErrors++;
+      continue;
     }
   }
 
@@ -602,6 +642,9 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::WriteInitialImageHeader()
 
   SetCustomString("BinaryData", "True");
   SetCustomString("BinaryDataByteOrderMSB", "False");
+  // Pixels are converted to little-endian when read, remove the equivalent fields that may remain from a big-endian file
+  SetCustomString("ElementByteOrderMSB", (const char*)(NULL));
+  SetCustomString("ByteOrderMSB", (const char*)(NULL));
 
   // CompressedData
   if (GetUseCompression())
@@ -744,17 +787,17 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::WriteInitialImageHeader()
       || igsioCommon::SplitStringIntoTokens(GetCustomString("Offset"), ' ', false).size() != numSpaceDimensions)
   {
     // Dynamically calculate offset dimensions
-    std::ostringstream offsetStream;
+    std::string offsetString;
     for (int i = 0; i < numSpaceDimensions; ++i)
     {
       // Code assumes all images have the same origin
-      offsetStream << this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetImage()->GetOrigin()[i];
+      igsioCommon::AppendDouble(offsetString, this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetConstImage()->GetOrigin()[i]);
       if (i != numSpaceDimensions - 1)
       {
-        offsetStream << " ";
+        offsetString += " ";
       }
     }
-    SetCustomString("Offset", offsetStream.str());
+    SetCustomString("Offset", offsetString);
   }
   if (GetCustomString("CenterOfRotation") == NULL
       || igsioCommon::SplitStringIntoTokens(GetCustomString("CenterOfRotation"), ' ', false).size() != numSpaceDimensions)
@@ -776,17 +819,17 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::WriteInitialImageHeader()
       || igsioCommon::SplitStringIntoTokens(GetCustomString("ElementSpacing"), ' ', false).size() != numSpaceDimensions)
   {
     // Dynamically calculate the spacing values
-    std::ostringstream spacingStream;
+    std::string spacingString;
     for (int i = 0; i < numSpaceDimensions; ++i)
     {
       // Code assumes all images have the same spacing
-      spacingStream << this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetImage()->GetSpacing()[i];
+      igsioCommon::AppendDouble(spacingString, this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetConstImage()->GetSpacing()[i]);
       if (i != numSpaceDimensions - 1)
       {
-        spacingStream << " ";
+        spacingString += " ";
       }
     }
-    SetCustomString("ElementSpacing", spacingStream.str());
+    SetCustomString("ElementSpacing", spacingString);
   }
 
   if (GetCustomString("AnatomicalOrientation") == NULL)
@@ -841,6 +884,12 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::WriteInitialImageHeader()
 //----------------------------------------------------------------------------
 igsioStatus vtkIGSIOMetaImageSequenceIO::AppendImagesToHeader()
 {
+  if (this->WriteImageHashes && this->EnableImageDataWrite && this->TrackedFrameList->UpdateImageHashes() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to compute the image hashes of the frames");
+    return IGSIO_FAIL;
+  }
+
   FILE* stream = NULL;
   // open in binary mode because we determine the start of the image buffer also during this read
   if (FileOpen(&stream, this->TempHeaderFileName.c_str(), "ab+") != IGSIO_SUCCESS)
@@ -850,21 +899,27 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::AppendImagesToHeader()
   }
 
   // Write frame fields (Seq_Frame0000_... = ...)
+  // Reuse the buffers for all frames, the header of long sequences has many thousands of lines
+  std::vector<std::string> fieldNames;
+  std::string field;
   for (unsigned int frameNumber = this->CurrentFrameOffset; frameNumber < this->TrackedFrameList->GetNumberOfTrackedFrames() + this->CurrentFrameOffset; frameNumber++)
   {
     LOG_DEBUG("Writing frame " << frameNumber);
     unsigned int adjustedFrameNumber = frameNumber - this->CurrentFrameOffset;
     igsioTrackedFrame* trackedFrame = this->TrackedFrameList->GetTrackedFrame(adjustedFrameNumber);
 
-    std::ostringstream frameIndexStr;
-    frameIndexStr << std::setfill('0') << std::setw(4) << frameNumber;
+    // Frame index is zero padded to 4 digits
+    std::string frameIndexStr = igsioCommon::ToString(frameNumber);
+    if (frameIndexStr.length() < 4)
+    {
+      frameIndexStr.insert(0, 4 - frameIndexStr.length(), '0');
+    }
 
-    std::vector<std::string> fieldNames;
     trackedFrame->GetFrameFieldNameList(fieldNames);
 
     for (std::vector<std::string>::iterator it = fieldNames.begin(); it != fieldNames.end(); it++)
     {
-      std::string field = SEQMETA_FIELD_FRAME_FIELD_PREFIX + frameIndexStr.str() + "_" + (*it) + " = " + trackedFrame->GetFrameField(it->c_str()) + "\n";
+      field.assign(SEQMETA_FIELD_FRAME_FIELD_PREFIX).append(frameIndexStr).append("_").append(*it).append(" = ").append(trackedFrame->GetFrameField(*it)).append("\n");
       fputs(field.c_str(), stream);
       TotalBytesWritten += field.length();
     }
@@ -877,7 +932,7 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::AppendImagesToHeader()
       {
         imageStatus = "INVALID";
       }
-      std::string imgStatusField = SEQMETA_FIELD_FRAME_FIELD_PREFIX + frameIndexStr.str() + "_" + SEQMETA_FIELD_IMG_STATUS + " = " + imageStatus + "\n";
+      std::string imgStatusField = SEQMETA_FIELD_FRAME_FIELD_PREFIX + frameIndexStr + "_" + SEQMETA_FIELD_IMG_STATUS + " = " + imageStatus + "\n";
       fputs(imgStatusField.c_str(), stream);
       TotalBytesWritten += imgStatusField.length();
     }
@@ -975,7 +1030,7 @@ igsioStatus vtkIGSIOMetaImageSequenceIO::WriteCompressedImagePixelsToFile(int& c
       }
     }
 
-    strm.next_in = (Bytef*)videoFrame->GetScalarPointer();
+    strm.next_in = (Bytef*)videoFrame->GetConstScalarPointer();
     strm.avail_in = videoFrame->GetFrameSizeInBytes();
 
     // Note: it's possible to request to consume all inputs and delete all history after each frame writing to allow random access
@@ -14,6 +14,7 @@ See License.txt for details.
 #include <vtkImageMapToColors.h>
 #include <vtkLookupTable.h>
 #include <vtkNew.h>
+#include <vtkUnsignedCharArray.h>
 
 // libwebm includes
 #include <mkvwriter.h>
@@ -32,6 +33,9 @@ See License.txt for details.
 #define VTKSEQUENCEIO_RV24_FOURCC "RV24"
 #define VTKSEQUENCEIO_RGB24_FOURCC "RGB"
 #define VTKSEQUENCEIO_GRAYSCALE8_FOURCC "Y800"
+#define VTKSEQUENCEIO_I420_FOURCC "I420"
+#define VTKSEQUENCEIO_NV12_FOURCC "NV12"
+#define VTKSEQUENCEIO_YUY2_FOURCC "YUY2"
 #define VTKSEQUENCEIO_VP8_FOURCC "VP80"
 #define VTKSEQUENCEIO_VP9_FOURCC "VP90"
 #define VTKSEQUENCEIO_H264_FOURCC "H264"
@@ -102,6 +106,7 @@ public:
     , MKVWriteSegment(NULL)
     , MKVReader(NULL)
     , MKVReadSegment(NULL)
+    , YuvFrameData(vtkSmartPointer<vtkUnsignedCharArray>::New())
   {
   };
 
@@ -113,7 +118,7 @@ public:
   //
   virtual bool FourCCRequiresEncoding(std::string fourCC)
   {
-    if (fourCC == "RV24")
+    if (fourCC == "RV24" || igsioVideoFrame::IsYuvFourCC(fourCC))
     {
       return false;
     }
@@ -135,6 +140,11 @@ public:
     {
       return VTKSEQUENCEIO_MKV_UNCOMPRESSED_CODECID;
     }
+    else if (igsioVideoFrame::IsYuvFourCC(fourCC))
+    {
+      // The YUV layout is stored in the colour space of the track
+      return VTKSEQUENCEIO_MKV_UNCOMPRESSED_CODECID;
+    }
     else if (fourCC == VTKSEQUENCEIO_VP8_FOURCC)
     {
       return VTKSEQUENCEIO_MKV_VP8_CODECID;
@@ -217,6 +227,9 @@ public:
   MetadataTrackMap MetadataTracks;
   std::map<std::string, int> VideoNameToTrackMap;
 
+  // Buffer of the YUV track frames, reused to avoid allocating a buffer for each frame
+  vtkSmartPointer<vtkUnsignedCharArray> YuvFrameData;
+
   mkvparser::EBMLHeader* EBMLHeader;
   mkvmuxer::MkvWriter* MKVWriter;
   mkvmuxer::Segment* MKVWriteSegment;
@@ -227,6 +240,7 @@ public:
 //----------------------------------------------------------------------------
 vtkIGSIOMkvSequenceIO::vtkIGSIOMkvSequenceIO()
   : Internal(new vtkInternal(this))
+  , UncompressedColorFourCC(VTKSEQUENCEIO_RV24_FOURCC)
 {
 }
 
@@ -339,7 +353,7 @@ igsioStatus vtkIGSIOMkvSequenceIO::WriteInitialImageHeader()
     return IGSIO_FAIL;
   }
 
-  vtkImageData* image = videoFrame->GetImage();
+  vtkImageData* image = videoFrame->GetConstImage();
   vtkUnsignedCharArray* encodedFrame = videoFrame->GetEncodedFrame();
   if (!encodedFrame && !image)
   {
@@ -366,7 +380,7 @@ igsioStatus vtkIGSIOMkvSequenceIO::WriteInitialImageHeader()
     }
     else if (numberOfComponents == 3)
     {
-      encodingFourCC = VTKSEQUENCEIO_RV24_FOURCC;
+      encodingFourCC = this->UncompressedColorFourCC;
     }
     else
     {
@@ -378,6 +392,7 @@ igsioStatus vtkIGSIOMkvSequenceIO::WriteInitialImageHeader()
     encodingFourCC = frame->GetEncodingFourCC();
   }
 
+  this->Internal->EncodingFourCC = encodingFourCC;
   this->Internal->VideoTrackNumber = this->Internal->AddVideoTrack("Video", encodingFourCC, frameSize[0], frameSize[1]);
   if (this->Internal->VideoTrackNumber < 1)
   {
@@ -395,6 +410,11 @@ igsioStatus vtkIGSIOMkvSequenceIO::WriteInitialImageHeader()
     trackedFrame->GetFrameFieldNameList(fieldNames);
     for (std::vector<std::string>::iterator it = fieldNames.begin(); it != fieldNames.end(); it++)
     {
+      if (*it == igsioTrackedFrame::FIELD_IMAGE_HASH)
+      {
+        // Encoded frames are not bit exact copies of the image data, the hash could not be verified when reading
+        continue;
+      }
       uint64_t trackNumber = this->Internal->FrameFieldTracks[*it];
       if (trackNumber <= 0)
       {
@@ -457,14 +477,27 @@ igsioStatus vtkIGSIOMkvSequenceIO::WriteImages()
 
       double timestamp = trackedFrame->GetTimestamp() - this->Internal->InitialTimestamp;
 
-      vtkImageData* image = videoFrame->GetImage();
+      vtkImageData* image = videoFrame->GetConstImage();
       vtkUnsignedCharArray* encodedFrame = videoFrame->GetEncodedFrame();
-      if (image)
+      if (image && igsioVideoFrame::IsYuvFourCC(this->Internal->EncodingFourCC))
       {
-        int* dimensions = trackedFrame->GetImageData()->GetImage()->GetDimensions();
+        if (igsioVideoFrame::ConvertRgbToYuv(*videoFrame, this->Internal->EncodingFourCC, this->Internal->YuvFrameData) != IGSIO_SUCCESS)
+        {
+          LOG_ERROR("Could not convert frame " << frameNumber << " to " << this->Internal->EncodingFourCC);
+          return IGSIO_FAIL;
+        }
+        if (!this->Internal->WriteFrame(this->Internal->YuvFrameData->GetPointer(0), this->Internal->YuvFrameData->GetNumberOfValues(), true, this->Internal->VideoTrackNumber, timestamp))
+        {
+          LOG_ERROR("Could not write frame to file: " << this->FileName);
+          return IGSIO_FAIL;
+        }
+      }
+      else if (image)
+      {
+        int* dimensions = trackedFrame->GetImageData()->GetConstImage()->GetDimensions();
         int numberOfComponents = image->GetNumberOfScalarComponents();
         uint64_t size = dimensions[0] * dimensions[1] * dimensions[2] * numberOfComponents * image->GetScalarSize();
-        this->Internal->WriteFrame((unsigned char*)trackedFrame->GetImageData()->GetImage()->GetScalarPointer(), size, true, this->Internal->VideoTrackNumber, timestamp);
+        this->Internal->WriteFrame((unsigned char*)trackedFrame->GetImageData()->GetConstScalarPointer(), size, true, this->Internal->VideoTrackNumber, timestamp);
       }
       else if (encodedFrame)
       {
@@ -485,6 +518,10 @@ igsioStatus vtkIGSIOMkvSequenceIO::WriteImages()
       std::map<std::string, std::string> customFields = trackedFrame->GetCustomFields();
       for (std::map<std::string, std::string>::iterator customFieldIt = customFields.begin(); customFieldIt != customFields.end(); ++customFieldIt)
       {
+        if (customFieldIt->first == igsioTrackedFrame::FIELD_IMAGE_HASH)
+        {
+          continue;
+        }
         uint64_t trackID = this->Internal->FrameFieldTracks[customFieldIt->first];
         if (trackID == 0)
         {
@@ -519,6 +556,25 @@ igsioStatus vtkIGSIOMkvSequenceIO::SetFileName(const std::string& aFilename)
   return IGSIO_SUCCESS;
 }
 
+//----------------------------------------------------------------------------
+igsioStatus vtkIGSIOMkvSequenceIO::SetUncompressedColorFourCC(const std::string& fourCC)
+{
+  if (fourCC != VTKSEQUENCEIO_RV24_FOURCC && !igsioVideoFrame::IsYuvFourCC(fourCC))
+  {
+    LOG_ERROR("Unsupported uncompressed color video format: " << fourCC << ". Supported formats are "
+              << VTKSEQUENCEIO_RV24_FOURCC << ", " << VTKSEQUENCEIO_I420_FOURCC << ", " << VTKSEQUENCEIO_NV12_FOURCC << " and " << VTKSEQUENCEIO_YUY2_FOURCC);
+    return IGSIO_FAIL;
+  }
+  this->UncompressedColorFourCC = fourCC;
+  return IGSIO_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkIGSIOMkvSequenceIO::GetUncompressedColorFourCC() const
+{
+  return this->UncompressedColorFourCC;
+}
+
 //----------------------------------------------------------------------------
 igsioStatus vtkIGSIOMkvSequenceIO::UpdateDimensionsCustomStrings(int numberOfFrames, bool isData3D)
 {
@@ -882,10 +938,21 @@ bool vtkIGSIOMkvSequenceIO::vtkInternal::ReadVideoData()
           trackedFrame->GetImageData()->SetImageType(US_IMG_RGB_COLOR);
           trackedFrame->SetTimestamp(timestampSeconds);
           FrameSizeType frameSize = { videoTrack->Width, videoTrack->Height, 1 };
-          if (videoTrack->Encoding.empty())
+          if (videoTrack->Encoding == VTKSEQUENCEIO_RV24_FOURCC && igsioVideoFrame::IsYuvFourCC(videoTrack->ColourSpace))
+          {
+            // Uncompressed YUV track, expand to RGB
+            this->YuvFrameData->SetNumberOfValues(size);
+            frame.Read(this->MKVReader, this->YuvFrameData->GetPointer(0));
+            if (igsioVideoFrame::ConvertYuvToRgb(this->YuvFrameData->GetPointer(0), size, videoTrack->ColourSpace, frameSize, *trackedFrame->GetImageData()) != IGSIO_SUCCESS)
+            {
+              LOG_ERROR("Could not decode " << videoTrack->ColourSpace << " frame " << frameNumber << "!");
+              return false;
+            }
+          }
+          else if (videoTrack->Encoding.empty())
           {
             trackedFrame->GetImageData()->AllocateFrame(frameSize, VTK_UNSIGNED_CHAR, 3);
-            frame.Read(this->MKVReader, (unsigned char*)trackedFrame->GetImageData()->GetImage()->GetScalarPointer());
+            frame.Read(this->MKVReader, (unsigned char*)trackedFrame->GetImageData()->GetScalarPointer());
           }
           else
           {
@@ -967,7 +1034,11 @@ bool vtkIGSIOMkvSequenceIO::vtkInternal::ReadMetadata()
 
             std::string frameField = std::string(frame.len, ' ');
             frame.Read(this->MKVReader, (unsigned char*)frameField.c_str());
-            trackedFrame->SetFrameField(metaDataTrack->Name, frameField);
+            if (trackedFrame->SetFrameField(metaDataTrack->Name, frameField) != IGSIO_SUCCESS)
+            {
+              LOG_ERROR("Could not set frame field " << metaDataTrack->Name << "!");
+              return false;
+            }
             break;
           }
         }
@@ -67,6 +67,15 @@ public:
   */
   virtual igsioStatus SetFileName(const std::string& aFilename);
 
+  /*!
+    Set the layout of uncompressed color (3 component) video tracks written to the file.
+    RV24 (default) stores the RGB pixels as they are. I420 and NV12 store YUV 4:2:0, which is half the size of RV24,
+    YUY2 stores YUV 4:2:2. YUV tracks are expanded to RGB frames when the file is read.
+    YUV conversion is not lossless: chroma is subsampled and rounded to 8 bits.
+  */
+  igsioStatus SetUncompressedColorFourCC(const std::string& fourCC);
+  std::string GetUncompressedColorFourCC() const;
+
 protected:
   vtkIGSIOMkvSequenceIO();
   virtual ~vtkIGSIOMkvSequenceIO();
@@ -101,6 +110,8 @@ protected:
 
   class vtkInternal;
   vtkInternal* Internal;
+
+  std::string UncompressedColorFourCC;
 };
 
 #endif // __vtkIGSIOMkvSequenceIO_h 
@@ -19,6 +19,7 @@ See License.txt for details.
 #endif
 
 #include "igsioTrackedFrame.h"
+#include "igsioVideoFrameKernels.h"
 #include "vtkObjectFactory.h"
 #include "vtkIGSIOTrackedFrameList.h"
 #include "vtksys/SystemTools.hxx"
@@ -182,7 +183,12 @@ igsioStatus vtkIGSIONrrdSequenceIO::ReadImageHeader()
         LOG_WARNING("Parsing line failed, cannot get frame number from frame field (" << lineStr << ")");
         continue;
       }
-      SetFrameString(frameNumber, frameFieldName.c_str(), value.c_str());
+      if (SetFrameString(frameNumber, frameFieldName.c_str(), value.c_str()) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to set frame field " << frameFieldName << " of frame " << frameNumber << " in file " << this->FileName);
+        fclose(stream);
+        return IGSIO_FAIL;
+      }
 
       if (ferror(stream))
       {
@@ -346,6 +352,10 @@ igsioStatus vtkIGSIONrrdSequenceIO::ReadImageHeader()
       LOG_ERROR("Field encoding not found in file: " << this->FileName << ". Unable to read.");
       return IGSIO_FAIL;
     }
+
+    // The endian field is only required for multi-byte scalars, default is little-endian
+    const char* endianFieldValue = this->TrackedFrameList->GetCustomString("endian");
+    this->IsPixelDataBigEndian = (endianFieldValue != NULL && igsioCommon::IsEqualInsensitive(endianFieldValue, "big"));
   }
 
   return IGSIO_SUCCESS;
@@ -429,8 +439,32 @@ igsioStatus vtkIGSIONrrdSequenceIO::ReadImagePixels()
     gzclose(gzStream);
   }
 
+  // Orientation and clipping are the same for all frames
+  FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
+  std::array<int, 3> clipRectOrigin = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+  std::array<int, 3> clipRectSize = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
+
+  igsioVideoFrame::FlipInfoType flipInfo;
+  if (igsioVideoFrame::GetFlipAxes(this->ImageOrientationInFile, this->ImageType, this->ImageOrientationInMemory, flipInfo) != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to convert image data to the requested orientation, from " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInFile) <<
+              " to " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInMemory));
+    return IGSIO_FAIL;
+  }
+
+  // If the orientation is the same in the file and in memory then uncompressed pixels are read directly into the frames
+  const bool isReorientationNeeded = flipInfo.hFlip || flipInfo.vFlip || flipInfo.eFlip || flipInfo.tranpose != igsioVideoFrame::TRANSPOSE_NONE
+                                     || igsioCommon::IsClippingRequested(clipRectOrigin, clipRectSize);
+
+  // Big-endian scalars are swapped while they are copied to the frame, or in place if the pixels are read directly into the frame
+  const unsigned int scalarSizeInBytes = igsioVideoFrame::GetNumberOfBytesPerScalar(this->PixelType);
+  const bool isByteSwapNeeded = this->IsPixelDataByteSwapNeeded() && scalarSizeInBytes > 1;
+
   std::vector<unsigned char> pixelBuffer;
-  pixelBuffer.resize(frameSizeInBytes);
+  if (isReorientationNeeded && !this->UseCompression)
+  {
+    pixelBuffer.resize(frameSizeInBytes);
+  }
   for (int frameNumber = 0; frameNumber < frameCount; frameNumber++)
   {
     this->CreateTrackedFrameIfNonExisting(frameNumber);
@@ -458,51 +492,48 @@ igsioStatus vtkIGSIONrrdSequenceIO::ReadImagePixels()
     trackedFrame->GetImageData()->SetImageOrientation(this->ImageOrientationInMemory);
     trackedFrame->GetImageData()->SetImageType(this->ImageType);
 
-    FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
-    if (trackedFrame->GetImageData()->AllocateFrame(frameSize, this->PixelType, this->NumberOfScalarComponents) != IGSIO_SUCCESS)
+    // The frame is allocated with the size of the oriented image, the pixels are written into it directly
+    FrameSizeType orientedFrameSize = igsioVideoFrame::GetFlipClipOutputSize(frameSize, flipInfo, clipRectOrigin, clipRectSize);
+    if (trackedFrame->GetImageData()->AllocateFrame(orientedFrameSize, this->PixelType, this->NumberOfScalarComponents) != IGSIO_SUCCESS)
     {
       LOG_ERROR("Cannot allocate memory for frame " << frameNumber);
       numberOfErrors++;
       continue;
     }
 
-    std::array<int, 3> clipRectOrigin = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
-    std::array<int, 3> clipRectSize = {igsioCommon::NO_CLIP, igsioCommon::NO_CLIP, igsioCommon::NO_CLIP};
-
-    igsioVideoFrame::FlipInfoType flipInfo;
-    if (igsioVideoFrame::GetFlipAxes(this->ImageOrientationInFile, this->ImageType, this->ImageOrientationInMemory, flipInfo) != IGSIO_SUCCESS)
-    {
-      LOG_ERROR("Failed to convert image data to the requested orientation, from " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInFile) <<
-                " to " << igsioVideoFrame::GetStringFromUsImageOrientation(this->ImageOrientationInMemory));
-      return IGSIO_FAIL;
-    }
-
+    const unsigned char* framePixels = NULL;
     if (!this->UseCompression)
     {
       FilePositionOffsetType offset = this->PixelDataFileOffset + frameNumber * frameSizeInBytes;
+      unsigned char* readBuffer = (isReorientationNeeded ? &(pixelBuffer[0]) : static_cast<unsigned char*>(trackedFrame->GetImageData()->GetScalarPointer()));
       FSEEK(stream, offset, SEEK_SET);
-      if (fread(&(pixelBuffer[0]), 1, frameSizeInBytes, stream) != frameSizeInBytes)
+      if (fread(readBuffer, 1, frameSizeInBytes, stream) != frameSizeInBytes)
       {
         LOG_ERROR("Could not read " << frameSizeInBytes << " bytes from " << GetPixelDataFilePath());
         numberOfErrors++;
       }
-      FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
-      if (igsioVideoFrame::GetOrientedClippedImage(&(pixelBuffer[0]), flipInfo, this->ImageType, this->PixelType, this->NumberOfScalarComponents, frameSize, *trackedFrame->GetImageData(), clipRectOrigin, clipRectSize) != IGSIO_SUCCESS)
+      if (!isReorientationNeeded)
       {
-        LOG_ERROR("Failed to get oriented image from sequence file (frame number: " << frameNumber << ")!");
-        numberOfErrors++;
+        if (isByteSwapNeeded && !igsioVideoFrameKernels::SwapBytes(readBuffer, readBuffer, frameSizeInBytes / scalarSizeInBytes, scalarSizeInBytes))
+        {
+          LOG_ERROR("Cannot swap the byte order of " << scalarSizeInBytes << "-byte scalars in frame " << frameNumber);
+          numberOfErrors++;
+        }
         continue;
       }
+      framePixels = readBuffer;
     }
     else
     {
-      FrameSizeType frameSize = { this->Dimensions[0], this->Dimensions[1], this->Dimensions[2] };
-      if (igsioVideoFrame::GetOrientedClippedImage(gzAllFramesPixelBuffer + frameNumber * frameSizeInBytes, flipInfo, this->ImageType, this->PixelType, this->NumberOfScalarComponents, frameSize, *trackedFrame->GetImageData(), clipRectOrigin, clipRectSize) != IGSIO_SUCCESS)
-      {
-        LOG_ERROR("Failed to get oriented image from sequence file (frame number: " << frameNumber << ")!");
-        numberOfErrors++;
-        continue;
-      }
+      framePixels = gzAllFramesPixelBuffer + frameNumber * frameSizeInBytes;
+    }
+
+    if (igsioVideoFrame::FlipClipImage(framePixels, frameSize, 0, 0, this->PixelType, this->NumberOfScalarComponents, flipInfo, clipRectOrigin, clipRectSize,
+                                       static_cast<unsigned char*>(trackedFrame->GetImageData()->GetScalarPointer()), 0, 0, isByteSwapNeeded) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to get oriented image from sequence file (frame number: " << frameNumber << ")!");
+      numberOfErrors++;
+      continue;
     }
   }
 
@@ -637,7 +668,7 @@ igsioStatus vtkIGSIONrrdSequenceIO::WriteInitialImageHeader()
     }
   }
 
-  // Does endian come from somewhere?
+  // Pixels are converted to the byte order of this computer when read, files are always written in little-endian byte order
   SetCustomString("endian", "little");
 
   // Update sizes field in header
@@ -671,7 +702,9 @@ igsioStatus vtkIGSIONrrdSequenceIO::WriteInitialImageHeader()
   for (int i = 0; i < numSpaceDimensions; ++i)
   {
     // Code assumes all images have the same origin
-    originStr << this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetImage()->GetOrigin()[i];
+    char originString[igsioCommon::DOUBLE_STRING_BUFFER_SIZE];
+    igsioCommon::FormatDouble(this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetConstImage()->GetOrigin()[i], originString);
+    originStr << originString;
     if (i != numSpaceDimensions - 1)
     {
       originStr << ",";
@@ -698,7 +731,9 @@ igsioStatus vtkIGSIONrrdSequenceIO::WriteInitialImageHeader()
       if (i == j)
       {
         // Code assumes all images have the same spacing
-        spaceDirectionStr << this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetImage()->GetSpacing()[i];
+        char spacingString[igsioCommon::DOUBLE_STRING_BUFFER_SIZE];
+        igsioCommon::FormatDouble(this->TrackedFrameList->GetTrackedFrame(0)->GetImageData()->GetConstImage()->GetSpacing()[i], spacingString);
+        spaceDirectionStr << spacingString;
       }
       else
       {
@@ -783,6 +818,12 @@ igsioStatus vtkIGSIONrrdSequenceIO::WriteInitialImageHeader()
 //----------------------------------------------------------------------------
 igsioStatus vtkIGSIONrrdSequenceIO::AppendImagesToHeader()
 {
+  if (this->WriteImageHashes && this->EnableImageDataWrite && this->TrackedFrameList->UpdateImageHashes() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Failed to compute the image hashes of the frames");
+    return IGSIO_FAIL;
+  }
+
   FILE* stream = NULL;
   // open in binary mode because we determine the start of the image buffer also during this read
   if (FileOpen(&stream, this->TempHeaderFileName.c_str(), "ab+") != IGSIO_SUCCESS)
@@ -792,21 +833,27 @@ igsioStatus vtkIGSIONrrdSequenceIO::AppendImagesToHeader()
   }
 
   // Write frame fields (Seq_Frame0000_... = ...)
+  // Reuse the buffers for all frames, the header of long sequences has many thousands of lines
+  std::vector<std::string> fieldNames;
+  std::string field;
   for (unsigned int frameNumber = CurrentFrameOffset; frameNumber < this->TrackedFrameList->GetNumberOfTrackedFrames() + CurrentFrameOffset; frameNumber++)
   {
     LOG_DEBUG("Writing frame " << frameNumber);
     unsigned int adjustedFrameNumber = frameNumber - CurrentFrameOffset;
     igsioTrackedFrame* trackedFrame = this->TrackedFrameList->GetTrackedFrame(adjustedFrameNumber);
 
-    std::ostringstream frameIndexStr;
-    frameIndexStr << std::setfill('0') << std::setw(4) << frameNumber;
+    // Frame index is zero padded to 4 digits
+    std::string frameIndexStr = igsioCommon::ToString(frameNumber);
+    if (frameIndexStr.length() < 4)
+    {
+      frameIndexStr.insert(0, 4 - frameIndexStr.length(), '0');
+    }
 
-    std::vector<std::string> fieldNames;
     trackedFrame->GetFrameFieldNameList(fieldNames);
 
     for (std::vector<std::string>::iterator it = fieldNames.begin(); it != fieldNames.end(); it++)
     {
-      std::string field = SEQUENCE_FIELD_FRAME_FIELD_PREFIX + frameIndexStr.str() + "_" + (*it) + ":=" + trackedFrame->GetFrameField(it->c_str()) + "\n";
+      field.assign(SEQUENCE_FIELD_FRAME_FIELD_PREFIX).append(frameIndexStr).append("_").append(*it).append(":=").append(trackedFrame->GetFrameField(*it)).append("\n");
       fputs(field.c_str(), stream);
       TotalBytesWritten += field.length();
     }
@@ -819,7 +866,7 @@ igsioStatus vtkIGSIONrrdSequenceIO::AppendImagesToHeader()
       {
         imageStatus = "INVALID";
       }
-      std::string imgStatusField = SEQUENCE_FIELD_FRAME_FIELD_PREFIX + frameIndexStr.str() + "_" + SEQUENCE_FIELD_IMG_STATUS + ":=" + imageStatus + "\n";
+      std::string imgStatusField = SEQUENCE_FIELD_FRAME_FIELD_PREFIX + frameIndexStr + "_" + SEQUENCE_FIELD_IMG_STATUS + ":=" + imageStatus + "\n";
       fputs(imgStatusField.c_str(), stream);
       TotalBytesWritten += imgStatusField.length();
     }
@@ -910,7 +957,7 @@ igsioStatus vtkIGSIONrrdSequenceIO::WriteCompressedImagePixelsToFile(int& compre
     }
 
     size_t numberOfBytesReadyForWriting = videoFrame->GetFrameSizeInBytes();
-    if (gzwrite(this->CompressionStream, (Bytef*)videoFrame->GetScalarPointer(), numberOfBytesReadyForWriting) != numberOfBytesReadyForWriting)
+    if (gzwrite(this->CompressionStream, (const Bytef*)videoFrame->GetConstScalarPointer(), numberOfBytesReadyForWriting) != numberOfBytesReadyForWriting)
     {
       LOG_ERROR("Error writing compressed data into file");
       gzclose(this->CompressionStream);
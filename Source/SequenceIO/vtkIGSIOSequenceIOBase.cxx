@@ -30,6 +30,9 @@ vtkIGSIOSequenceIOBase::vtkIGSIOSequenceIOBase()
   , UseCompression(false)
   , CompressedBytesWritten(0)
   , EnableImageDataWrite(true)
+  , WriteImageHashes(false)
+  , VerifyImageHashes(true)
+  , IsPixelDataBigEndian(false)
   , PixelType(VTK_VOID)
   , NumberOfScalarComponents(1)
   , IsDataTimeSeries(true)
@@ -38,6 +41,7 @@ vtkIGSIOSequenceIOBase::vtkIGSIOSequenceIOBase()
   , TotalBytesWritten(0)
   , ImageOrientationInFile(US_IMG_ORIENT_XX)
   , ImageOrientationInMemory(US_IMG_ORIENT_XX)
+  , RfIqLayoutInMemory(US_IMG_TYPE_XX)
   , ImageType(US_IMG_TYPE_XX)
   , PixelDataFileOffset(0)
   , PixelDataFileName("")
@@ -80,6 +84,59 @@ igsioStatus vtkIGSIOSequenceIOBase::Read()
   {
     return IGSIO_FAIL;
   }
+
+  // Stored hashes describe the pixels as they are in the file
+  bool imageDataModified = (this->ImageOrientationInMemory != this->ImageOrientationInFile)
+                           || (this->IsPixelDataByteSwapNeeded() && igsioVideoFrame::GetNumberOfBytesPerScalar(this->PixelType) > 1);
+  if (this->VerifyImageHashes && !imageDataModified && this->TrackedFrameList->VerifyImageHashes() != IGSIO_SUCCESS)
+  {
+    LOG_ERROR("Image data in file " << this->FileName << " does not match the stored image hashes");
+    return IGSIO_FAIL;
+  }
+
+  if ((this->RfIqLayoutInMemory == US_IMG_RF_IQ_LINE || this->RfIqLayoutInMemory == US_IMG_RF_I_LINE_Q_LINE)
+      && (this->ImageType == US_IMG_RF_IQ_LINE || this->ImageType == US_IMG_RF_I_LINE_Q_LINE)
+      && this->ImageType != this->RfIqLayoutInMemory)
+  {
+    int numberOfErrors = 0;
+    for (unsigned int frameNumber = 0; frameNumber < this->TrackedFrameList->GetNumberOfTrackedFrames(); ++frameNumber)
+    {
+      igsioVideoFrame* videoFrame = this->TrackedFrameList->GetTrackedFrame(frameNumber)->GetImageData();
+      if (videoFrame->GetConstImage() == NULL || !videoFrame->IsImageValid())
+      {
+        continue;
+      }
+      if (videoFrame->ConvertRfIqLayout(this->RfIqLayoutInMemory) != IGSIO_SUCCESS)
+      {
+        LOG_ERROR("Failed to convert RF data layout of frame " << frameNumber << " to " << igsioVideoFrame::GetStringFromUsImageType(this->RfIqLayoutInMemory));
+        numberOfErrors++;
+      }
+    }
+    if (numberOfErrors > 0)
+    {
+      return IGSIO_FAIL;
+    }
+    imageDataModified = true;
+  }
+
+  // Update the stored hashes to match the image data in memory
+  if (imageDataModified && this->TrackedFrameList->GetNumberOfTrackedFrames() > 0
+      && this->TrackedFrameList->GetTrackedFrame(0)->IsFrameFieldDefined(igsioTrackedFrame::FIELD_IMAGE_HASH)
+      && this->TrackedFrameList->UpdateImageHashes() != IGSIO_SUCCESS)
+  {
+    return IGSIO_FAIL;
+  }
+
+  // Interleaved RF data cannot be downsampled, thumbnails are only created for images
+  if (this->TrackedFrameList->GetThumbnailLevel() > 0 && this->ImageType != US_IMG_RF_IQ_LINE && this->ImageType != US_IMG_RF_I_LINE_Q_LINE)
+  {
+    if (this->TrackedFrameList->CreateThumbnails(this->TrackedFrameList->GetThumbnailLevel()) != IGSIO_SUCCESS)
+    {
+      LOG_ERROR("Failed to create thumbnails for the frames of file: " << this->FileName);
+      return IGSIO_FAIL;
+    }
+  }
+
   return IGSIO_SUCCESS;
 }
 
@@ -111,8 +168,7 @@ igsioStatus vtkIGSIOSequenceIOBase::SetFrameString(int frameNumber, const char*
     LOG_ERROR("Cannot access frame " << frameNumber);
     return IGSIO_FAIL;
   }
-  trackedFrame->SetFrameField(fieldName, fieldValue);
-  return IGSIO_SUCCESS;
+  return trackedFrame->SetFrameField(fieldName, fieldValue);
 }
 
 //----------------------------------------------------------------------------
@@ -147,9 +203,7 @@ bool vtkIGSIOSequenceIOBase::SetCustomString(const std::string& fieldName, int f
     LOG_ERROR("Invalid field name");
     return IGSIO_FAIL;
   }
-  std::stringstream ss;
-  ss << fieldValue;
-  this->TrackedFrameList->SetCustomString(fieldName, ss.str());
+  this->TrackedFrameList->SetCustomString(fieldName, igsioCommon::ToString(fieldValue));
   return IGSIO_SUCCESS;
 }
 
@@ -178,10 +232,9 @@ void vtkIGSIOSequenceIOBase::CreateTrackedFrameIfNonExisting(unsigned int frameN
     // frame is already created
     return;
   }
-  igsioTrackedFrame emptyFrame;
   for (unsigned int i = this->TrackedFrameList->GetNumberOfTrackedFrames(); i < frameNumber + 1; i++)
   {
-    this->TrackedFrameList->AddTrackedFrame(&emptyFrame, vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
+    this->TrackedFrameList->TakeTrackedFrame(new igsioTrackedFrame, vtkIGSIOTrackedFrameList::ADD_INVALID_FRAME);
   }
 }
 
@@ -365,7 +418,7 @@ igsioStatus vtkIGSIOSequenceIOBase::WriteImages()
         }
 
         size_t writtenSize = 0;
-        igsioStatus status = igsioCommon::RobustFwrite(this->OutputImageFileHandle, videoFrame->GetScalarPointer(),
+        igsioStatus status = igsioCommon::RobustFwrite(this->OutputImageFileHandle, const_cast<void*>(videoFrame->GetConstScalarPointer()),
                             videoFrame->GetFrameSizeInBytes(), writtenSize);
         if (status == IGSIO_FAIL)
         {
@@ -526,6 +579,14 @@ std::string vtkIGSIOSequenceIOBase::GetPixelDataFilePath()
   return path;
 }
 
+//----------------------------------------------------------------------------
+bool vtkIGSIOSequenceIOBase::IsPixelDataByteSwapNeeded() const
+{
+  const unsigned short one = 1;
+  const bool isComputerBigEndian = (*reinterpret_cast<const unsigned char*>(&one) == 0);
+  return this->IsPixelDataBigEndian != isComputerBigEndian;
+}
+
 //----------------------------------------------------------------------------
 igsioStatus vtkIGSIOSequenceIOBase::FileOpen(FILE** stream, const char* filename, const char* flags)
 {
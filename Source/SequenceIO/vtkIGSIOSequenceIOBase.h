@@ -71,6 +71,15 @@ public:
   */
   vtkSetMacro(ImageOrientationInMemory, US_IMAGE_ORIENTATION);
 
+  /*!
+    Set/get the RF I/Q data layout for memory storage (as the result of reading).
+    If it is US_IMG_RF_IQ_LINE or US_IMG_RF_I_LINE_Q_LINE then RF frames that are stored in the file
+    in the other layout are converted after reading (see igsioVideoFrame::ConvertRfIqLayout).
+    US_IMG_TYPE_XX (default) keeps the layout of the file.
+  */
+  vtkSetMacro(RfIqLayoutInMemory, US_IMAGE_TYPE);
+  vtkGetMacro(RfIqLayoutInMemory, US_IMAGE_TYPE);
+
   /*!
     Set input/output file name. The file contains only the image header in case of
     MHD images and the full image (including pixel data) in case of MHA images.
@@ -142,6 +151,28 @@ public:
   /*! Flag to enable/disable writing of image data */
   vtkBooleanMacro(EnableImageDataWrite, bool);
 
+  /*!
+    Flag to store the hash of the image data of each frame in a frame field (see igsioTrackedFrame::FIELD_IMAGE_HASH).
+    Supported by the MetaImage and NRRD writers, disabled by default.
+  */
+  vtkGetMacro(WriteImageHashes, bool);
+  vtkSetMacro(WriteImageHashes, bool);
+  vtkBooleanMacro(WriteImageHashes, bool);
+
+  /*!
+    Flag to check the image data of frames that have a stored hash when reading. The check is skipped if the
+    image orientation in memory differs from the orientation in the file. Enabled by default.
+  */
+  vtkGetMacro(VerifyImageHashes, bool);
+  vtkSetMacro(VerifyImageHashes, bool);
+  vtkBooleanMacro(VerifyImageHashes, bool);
+
+  /*!
+    True if the pixel data in the file that was read is stored in big-endian byte order. Scalars are converted
+    to the byte order of this computer while reading. Files are always written in little-endian byte order.
+  */
+  vtkGetMacro(IsPixelDataBigEndian, bool);
+
 protected:
   /*! Read all the fields in the image file header */
   virtual igsioStatus ReadImageHeader() = 0;
@@ -174,6 +205,9 @@ protected:
   /*! Get full path to the file for storing the pixel data */
   std::string GetPixelDataFilePath();
 
+  /*! Return true if the byte order of the pixel data in the file differs from the byte order of this computer */
+  bool IsPixelDataByteSwapNeeded() const;
+
   /*! Get the largest possible image size in the tracked frame list */
   virtual FrameSizeType GetMaximumImageDimensions();
 
@@ -224,6 +258,12 @@ protected:
   unsigned long long CompressedBytesWritten;
   /*! Whether to enable pixel writing */
   bool EnableImageDataWrite;
+  /*! Whether to store the hash of the image data in the frame fields */
+  bool WriteImageHashes;
+  /*! Whether to verify stored image hashes when reading */
+  bool VerifyImageHashes;
+  /*! Byte order of the pixel data in the file, set when reading the header */
+  bool IsPixelDataBigEndian;
   /*! Integer/float, short/long, signed/unsigned */
   igsioCommon::VTKScalarPixelType PixelType;
   /*! Number of components (or channels) */
@@ -250,6 +290,11 @@ protected:
   */
   US_IMAGE_ORIENTATION ImageOrientationInMemory;
 
+  /*!
+    RF I/Q data layout for reading into memory, US_IMG_TYPE_XX if the layout of the file is kept.
+  */
+  US_IMAGE_TYPE RfIqLayoutInMemory;
+
   /*!
     Image type (B-mode, RF, ...)
   */